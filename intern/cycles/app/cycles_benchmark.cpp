@@ -0,0 +1,840 @@
+/*
+ * Copyright 2011-2020 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Headless benchmark, rendering a fixed set of procedurally generated scenes
+ * (and optionally XML scenes) on the CPU and reporting timings as JSON. */
+
+#include <stdio.h>
+
+#include "device/device.h"
+#include "render/buffers.h"
+#include "render/camera.h"
+#include "render/film.h"
+#include "render/graph.h"
+#include "render/hair.h"
+#include "render/light.h"
+#include "render/mesh.h"
+#include "render/nodes.h"
+#include "render/object.h"
+#include "render/scene.h"
+#include "render/session.h"
+#include "render/shader.h"
+#include "render/stats.h"
+#include "subd/subd_dice.h"
+
+#include "util/util_args.h"
+#include "util/util_foreach.h"
+#include "util/util_guarded_allocator.h"
+#include "util/util_hash.h"
+#include "util/util_logging.h"
+#include "util/util_openimagedenoise.h"
+#include "util/util_path.h"
+#include "util/util_string.h"
+#include "util/util_task.h"
+#include "util/util_time.h"
+#include "util/util_transform.h"
+#include "util/util_version.h"
+
+#include "app/cycles_xml.h"
+
+CCL_NAMESPACE_BEGIN
+
+typedef void (*BenchmarkSceneFunc)(Scene *scene);
+
+struct BenchmarkScene {
+  string name;
+  /* Either a procedural scene generator, or a path to an XML file. */
+  BenchmarkSceneFunc create;
+  string filepath;
+};
+
+struct BenchmarkResult {
+  string name;
+  int width, height, samples;
+
+  double scene_load_time;
+  double scene_update_time;
+  double bvh_build_time;
+  double image_load_time;
+  double render_time;
+  double denoise_time;
+  double idle_thread_time;
+
+  size_t peak_host_memory;
+  size_t peak_device_memory;
+};
+
+struct Options {
+  vector<string> scene_names;
+  vector<string> filepaths;
+  int width, height;
+  int samples;
+  int threads;
+  int2 tile_size;
+  bool denoise;
+  bool list;
+  string output_path;
+} options;
+
+/* Procedural scene helpers. */
+
+static Transform transform_look_at(const float3 eye, const float3 target)
+{
+  /* Cycles cameras look down the positive Z axis, with Y up. */
+  const float3 forward = normalize(target - eye);
+  const float3 right = normalize(cross(forward, make_float3(0.0f, 0.0f, 1.0f)));
+  const float3 up = cross(right, forward);
+
+  return make_transform(right.x,
+                        up.x,
+                        forward.x,
+                        eye.x,
+                        right.y,
+                        up.y,
+                        forward.y,
+                        eye.y,
+                        right.z,
+                        up.z,
+                        forward.z,
+                        eye.z);
+}
+
+static void scene_add_camera(Scene *scene, const float3 eye, const float3 target)
+{
+  Camera *cam = scene->camera;
+  cam->width = options.width;
+  cam->height = options.height;
+  cam->full_width = options.width;
+  cam->full_height = options.height;
+  cam->matrix = transform_look_at(eye, target);
+  cam->compute_auto_viewplane();
+  cam->need_update = true;
+
+  /* Subdivision surfaces are diced from the render camera. */
+  *scene->dicing_camera = *cam;
+}
+
+static Shader *scene_add_diffuse_shader(Scene *scene, const float3 color)
+{
+  ShaderGraph *graph = new ShaderGraph();
+
+  DiffuseBsdfNode *diffuse = graph->create_node<DiffuseBsdfNode>();
+  diffuse->color = color;
+  graph->add(diffuse);
+  graph->connect(diffuse->output("BSDF"), graph->output()->input("Surface"));
+
+  Shader *shader = scene->create_node<Shader>();
+  shader->name = "diffuse";
+  shader->set_graph(graph);
+  shader->tag_update(scene);
+  return shader;
+}
+
+/* Noise texture in object space, used for heterogeneous volumes and displacement. */
+static ShaderNode *graph_add_noise(ShaderGraph *graph, const float scale)
+{
+  TextureCoordinateNode *texco = graph->create_node<TextureCoordinateNode>();
+  graph->add(texco);
+
+  NoiseTextureNode *noise = graph->create_node<NoiseTextureNode>();
+  noise->scale = scale;
+  noise->detail = 4.0f;
+  graph->add(noise);
+
+  graph->connect(texco->output("Object"), noise->input("Vector"));
+  return noise;
+}
+
+static Mesh *scene_add_mesh(Scene *scene, Shader *shader)
+{
+  Mesh *mesh = scene->create_node<Mesh>();
+  mesh->used_shaders.push_back(shader);
+  return mesh;
+}
+
+static Object *scene_add_object(Scene *scene, Geometry *geom, const Transform &tfm)
+{
+  Object *object = scene->create_node<Object>();
+  object->geometry = geom;
+  object->tfm = tfm;
+  object->tag_update(scene);
+  return object;
+}
+
+/* Square grid of quads in the XY plane, centered at the origin. */
+static void mesh_add_grid(Mesh *mesh, const int resolution, const float size, const bool subd)
+{
+  const int verts_per_side = resolution + 1;
+  const int num_verts = verts_per_side * verts_per_side;
+  const int num_quads = resolution * resolution;
+
+  mesh->reserve_mesh(num_verts, subd ? 0 : num_quads * 2);
+  if (subd) {
+    mesh->subdivision_type = Mesh::SUBDIVISION_LINEAR;
+    mesh->reserve_subd_faces(num_quads, 0, num_quads * 4);
+  }
+
+  for (int y = 0; y < verts_per_side; y++) {
+    for (int x = 0; x < verts_per_side; x++) {
+      const float u = (float)x / resolution - 0.5f;
+      const float v = (float)y / resolution - 0.5f;
+      mesh->add_vertex(make_float3(u * size, v * size, 0.0f));
+    }
+  }
+
+  for (int y = 0; y < resolution; y++) {
+    for (int x = 0; x < resolution; x++) {
+      int corners[4] = {y * verts_per_side + x,
+                        y * verts_per_side + x + 1,
+                        (y + 1) * verts_per_side + x + 1,
+                        (y + 1) * verts_per_side + x};
+      if (subd) {
+        mesh->add_subd_face(corners, 4, 0, true);
+      }
+      else {
+        mesh->add_triangle(corners[0], corners[1], corners[2], 0, false);
+        mesh->add_triangle(corners[0], corners[2], corners[3], 0, false);
+      }
+    }
+  }
+}
+
+static void mesh_add_box(Mesh *mesh, const float3 size)
+{
+  /* Vertex index bits are the X, Y and Z coordinates, faces are wound outwards. */
+  static const int faces[6][4] = {{0, 2, 3, 1},
+                                  {4, 5, 7, 6},
+                                  {0, 1, 5, 4},
+                                  {2, 6, 7, 3},
+                                  {0, 4, 6, 2},
+                                  {1, 3, 7, 5}};
+
+  mesh->reserve_mesh(8, 12);
+  for (int i = 0; i < 8; i++) {
+    const float x = (i & 1) ? 0.5f : -0.5f;
+    const float y = (i & 2) ? 0.5f : -0.5f;
+    const float z = (i & 4) ? 0.5f : -0.5f;
+    mesh->add_vertex(make_float3(x, y, z) * size);
+  }
+  for (int i = 0; i < 6; i++) {
+    mesh->add_triangle(faces[i][0], faces[i][1], faces[i][2], 0, false);
+    mesh->add_triangle(faces[i][0], faces[i][2], faces[i][3], 0, false);
+  }
+}
+
+static float3 sphere_point(const int segment, const int ring, const int segments, const int rings)
+{
+  const float theta = M_PI_F * ring / rings;
+  const float phi = M_2PI_F * segment / segments;
+  return make_float3(sinf(theta) * cosf(phi), sinf(theta) * sinf(phi), cosf(theta));
+}
+
+static void mesh_add_sphere(Mesh *mesh, const int segments, const int rings, const float radius)
+{
+  mesh->reserve_mesh(segments * (rings + 1), segments * rings * 2);
+
+  for (int ring = 0; ring <= rings; ring++) {
+    for (int segment = 0; segment < segments; segment++) {
+      mesh->add_vertex(sphere_point(segment, ring, segments, rings) * radius);
+    }
+  }
+
+  for (int ring = 0; ring < rings; ring++) {
+    for (int segment = 0; segment < segments; segment++) {
+      const int next = (segment + 1) % segments;
+      const int v0 = ring * segments + segment;
+      const int v1 = ring * segments + next;
+      const int v2 = (ring + 1) * segments + next;
+      const int v3 = (ring + 1) * segments + segment;
+      mesh->add_triangle(v0, v1, v2, 0, true);
+      mesh->add_triangle(v0, v2, v3, 0, true);
+    }
+  }
+}
+
+static void scene_add_ground(Scene *scene)
+{
+  Mesh *ground = scene_add_mesh(scene, scene_add_diffuse_shader(scene, make_float3(0.5f)));
+  mesh_add_grid(ground, 1, 40.0f, false);
+  scene_add_object(scene, ground, transform_identity());
+}
+
+static void scene_add_sun(Scene *scene, const float3 dir, const float strength)
+{
+  Light *light = scene->create_node<Light>();
+  light->type = LIGHT_DISTANT;
+  light->dir = normalize(dir);
+  light->angle = 0.05f;
+  light->strength = make_float3(strength);
+  light->shader = scene->default_light;
+  light->tag_update(scene);
+}
+
+/* Procedural scenes. */
+
+/* Simple geometry lit by a grid of many small colored point lights. */
+static void scene_many_lights(Scene *scene)
+{
+  scene_add_camera(scene, make_float3(0.0f, -14.0f, 8.0f), make_float3(0.0f, 0.0f, 0.0f));
+  scene_add_ground(scene);
+
+  Mesh *box = scene_add_mesh(scene, scene_add_diffuse_shader(scene, make_float3(0.8f)));
+  mesh_add_box(box, make_float3(0.8f));
+  for (int y = 0; y < 8; y++) {
+    for (int x = 0; x < 8; x++) {
+      const float3 co = make_float3((x - 3.5f) * 2.0f, (y - 3.5f) * 2.0f, 0.4f);
+      scene_add_object(scene, box, transform_translate(co));
+    }
+  }
+
+  const int lights_per_side = 16;
+  for (int y = 0; y < lights_per_side; y++) {
+    for (int x = 0; x < lights_per_side; x++) {
+      const uint seed = y * lights_per_side + x;
+      Light *light = scene->create_node<Light>();
+      light->type = LIGHT_POINT;
+      light->co = make_float3(
+          (x - 7.5f) * 1.2f, (y - 7.5f) * 1.2f, 1.0f + 2.0f * hash_uint2_to_float(seed, 0));
+      light->size = 0.1f;
+      light->strength = make_float3(hash_uint2_to_float(seed, 1),
+                                    hash_uint2_to_float(seed, 2),
+                                    hash_uint2_to_float(seed, 3)) *
+                        20.0f;
+      light->shader = scene->default_light;
+      light->tag_update(scene);
+    }
+  }
+}
+
+/* Many instances of a single sphere mesh. */
+static void scene_instancing(Scene *scene)
+{
+  scene_add_camera(scene, make_float3(0.0f, -18.0f, 10.0f), make_float3(0.0f, 0.0f, 0.0f));
+  scene_add_ground(scene);
+  scene_add_sun(scene, make_float3(-0.3f, 0.5f, -1.0f), 3.0f);
+
+  Mesh *sphere = scene_add_mesh(scene, scene_add_diffuse_shader(scene, make_float3(0.7f)));
+  mesh_add_sphere(sphere, 32, 16, 1.0f);
+
+  const int instances_per_side = 100;
+  for (int y = 0; y < instances_per_side; y++) {
+    for (int x = 0; x < instances_per_side; x++) {
+      const uint seed = y * instances_per_side + x;
+      const float scale = 0.05f + 0.1f * hash_uint2_to_float(seed, 0);
+      const float3 co = make_float3((x - instances_per_side * 0.5f) * 0.3f,
+                                    (y - instances_per_side * 0.5f) * 0.3f,
+                                    scale);
+      scene_add_object(
+          scene, sphere, transform_translate(co) * transform_scale(make_float3(scale)));
+    }
+  }
+}
+
+/* Dense hair curves grown from a sphere. */
+static void scene_hair(Scene *scene)
+{
+  scene_add_camera(scene, make_float3(0.0f, -6.0f, 2.0f), make_float3(0.0f, 0.0f, 1.0f));
+  scene_add_ground(scene);
+  scene_add_sun(scene, make_float3(-0.3f, 0.5f, -1.0f), 3.0f);
+
+  Shader *shader = scene_add_diffuse_shader(scene, make_float3(0.6f, 0.4f, 0.2f));
+  Mesh *head = scene_add_mesh(scene, shader);
+  mesh_add_sphere(head, 32, 16, 1.0f);
+  scene_add_object(scene, head, transform_translate(make_float3(0.0f, 0.0f, 1.0f)));
+
+  Hair *hair = scene->create_node<Hair>();
+  hair->used_shaders.push_back(shader);
+
+  const int num_curves = 100000;
+  const int num_keys = 5;
+  hair->reserve_curves(num_curves, num_curves * num_keys);
+
+  for (int i = 0; i < num_curves; i++) {
+    const float3 root = sphere_point(hash_uint2(i, 0) % 1024, hash_uint2(i, 1) % 512, 1024, 512);
+    const float3 tangent = normalize(make_float3(hash_uint2_to_float(i, 2) - 0.5f,
+                                                 hash_uint2_to_float(i, 3) - 0.5f,
+                                                 -0.5f));
+    const int first_key = hair->curve_keys.size();
+
+    for (int k = 0; k < num_keys; k++) {
+      const float t = (float)k / (num_keys - 1);
+      const float3 co = root * (1.0f + 0.3f * t) + tangent * (0.2f * t * t);
+      hair->add_curve_key(co, 0.005f * (1.0f - 0.8f * t));
+    }
+    hair->add_curve(first_key, 0);
+  }
+
+  scene_add_object(scene, hair, transform_translate(make_float3(0.0f, 0.0f, 1.0f)));
+}
+
+/* Heterogeneous volume in a box, driven by a noise texture. */
+static void scene_volume(Scene *scene)
+{
+  scene_add_camera(scene, make_float3(0.0f, -8.0f, 3.0f), make_float3(0.0f, 0.0f, 1.0f));
+  scene_add_ground(scene);
+  scene_add_sun(scene, make_float3(-0.3f, 0.5f, -1.0f), 3.0f);
+
+  ShaderGraph *graph = new ShaderGraph();
+  ShaderNode *noise = graph_add_noise(graph, 2.0f);
+
+  PrincipledVolumeNode *volume = graph->create_node<PrincipledVolumeNode>();
+  volume->color = make_float3(0.8f);
+  graph->add(volume);
+
+  graph->connect(noise->output("Fac"), volume->input("Density"));
+  graph->connect(volume->output("Volume"), graph->output()->input("Volume"));
+
+  Shader *shader = scene->create_node<Shader>();
+  shader->name = "volume";
+  shader->heterogeneous_volume = true;
+  shader->set_graph(graph);
+  shader->tag_update(scene);
+
+  Mesh *box = scene_add_mesh(scene, shader);
+  mesh_add_box(box, make_float3(4.0f, 4.0f, 2.0f));
+  scene_add_object(scene, box, transform_translate(make_float3(0.0f, 0.0f, 1.0f)));
+}
+
+/* Adaptively subdivided plane with true displacement. */
+static void scene_displacement(Scene *scene)
+{
+  scene_add_camera(scene, make_float3(0.0f, -10.0f, 5.0f), make_float3(0.0f, 0.0f, 0.0f));
+  scene_add_sun(scene, make_float3(-0.3f, 0.5f, -1.0f), 3.0f);
+
+  ShaderGraph *graph = new ShaderGraph();
+  ShaderNode *noise = graph_add_noise(graph, 0.5f);
+
+  DiffuseBsdfNode *diffuse = graph->create_node<DiffuseBsdfNode>();
+  graph->add(diffuse);
+
+  DisplacementNode *displacement = graph->create_node<DisplacementNode>();
+  displacement->scale = 1.5f;
+  graph->add(displacement);
+
+  graph->connect(diffuse->output("BSDF"), graph->output()->input("Surface"));
+  graph->connect(noise->output("Fac"), displacement->input("Height"));
+  graph->connect(displacement->output("Displacement"), graph->output()->input("Displacement"));
+
+  Shader *shader = scene->create_node<Shader>();
+  shader->name = "displacement";
+  shader->displacement_method = DISPLACE_TRUE;
+  shader->set_graph(graph);
+  shader->tag_update(scene);
+
+  Mesh *terrain = scene_add_mesh(scene, shader);
+  mesh_add_grid(terrain, 16, 20.0f, true);
+
+  terrain->subd_params = new SubdParams(terrain);
+  terrain->subd_params->dicing_rate = 1.0f;
+  terrain->subd_params->objecttoworld = transform_identity();
+
+  scene_add_object(scene, terrain, transform_identity());
+}
+
+static const struct {
+  const char *name;
+  BenchmarkSceneFunc create;
+} procedural_scenes[] = {
+    {"many_lights", scene_many_lights},
+    {"instancing", scene_instancing},
+    {"hair", scene_hair},
+    {"volume", scene_volume},
+    {"displacement", scene_displacement},
+};
+
+static const int num_procedural_scenes = sizeof(procedural_scenes) / sizeof(*procedural_scenes);
+
+/* Benchmark */
+
+static BufferParams benchmark_buffer_params(Scene *scene)
+{
+  BufferParams buffer_params;
+  buffer_params.width = scene->camera->width;
+  buffer_params.height = scene->camera->height;
+  buffer_params.full_width = scene->camera->width;
+  buffer_params.full_height = scene->camera->height;
+  buffer_params.denoising_data_pass = options.denoise;
+  return buffer_params;
+}
+
+static SessionParams benchmark_session_params()
+{
+  SessionParams params;
+  params.background = true;
+  params.progressive = false;
+  params.samples = options.samples;
+  params.threads = options.threads;
+  params.tile_size = options.tile_size;
+  params.tile_order = TILE_HILBERT_SPIRAL;
+
+  vector<DeviceInfo> devices = Device::available_devices(DEVICE_MASK_CPU);
+  if (!devices.empty()) {
+    params.device = devices.front();
+  }
+
+  if (options.denoise) {
+    params.denoising.use = true;
+    params.denoising.type = openimagedenoise_supported() ? DENOISER_OPENIMAGEDENOISE :
+                                                           DENOISER_NLM;
+  }
+
+  return params;
+}
+
+static BenchmarkResult benchmark_scene(const BenchmarkScene &bench)
+{
+  BenchmarkResult result;
+  result.name = bench.name;
+
+  util_guarded_reset_mem_peak();
+
+  Session *session = new Session(benchmark_session_params());
+
+  SceneParams scene_params;
+  scene_params.bvh_type = SceneParams::BVH_STATIC;
+  Scene *scene = new Scene(scene_params, session->device);
+  scene->enable_update_stats();
+
+  /* Scene creation, for XML scenes this includes file parsing. */
+  double start_time = time_dt();
+  if (bench.create) {
+    bench.create(scene);
+  }
+  else {
+    xml_read_file(scene, bench.filepath.c_str());
+    if (options.width && options.height) {
+      scene->camera->width = options.width;
+      scene->camera->height = options.height;
+      scene->camera->full_width = options.width;
+      scene->camera->full_height = options.height;
+    }
+    scene->camera->compute_auto_viewplane();
+  }
+  result.scene_load_time = time_dt() - start_time;
+
+  if (options.denoise) {
+    scene->film->denoising_data_pass = true;
+    scene->film->tag_update(scene);
+  }
+
+  result.width = scene->camera->width;
+  result.height = scene->camera->height;
+  result.samples = options.samples;
+
+  BufferParams buffer_params = benchmark_buffer_params(scene);
+  session->scene = scene;
+  session->reset(buffer_params, options.samples);
+  session->start();
+  session->wait();
+
+  /* Scene update timings. */
+  SceneUpdateStats *update_stats = scene->update_stats;
+  /* The scene timer wraps the whole device update, including all other managers. */
+  result.scene_update_time = update_stats->scene.times.total_time;
+
+  result.bvh_build_time = 0.0;
+  foreach (const NamedTimeEntry &entry, update_stats->geometry.times.entries) {
+    if (string_endswith(entry.name, "BVH)") || string_endswith(entry.name, "BVHs)")) {
+      result.bvh_build_time += entry.time;
+    }
+  }
+
+  result.image_load_time = update_stats->image.times.total_time;
+
+  /* Render timings, render time excludes scene updates in background mode. */
+  double total_time, render_time;
+  session->progress.get_time(total_time, render_time);
+
+  RenderStats render_stats;
+  session->collect_statistics(&render_stats);
+
+  result.denoise_time = render_stats.tiles.denoising_time;
+  result.idle_thread_time = render_stats.tiles.idle_thread_time;
+  result.render_time = render_time;
+
+  result.peak_host_memory = util_guarded_get_mem_peak();
+  result.peak_device_memory = session->stats.mem_peak;
+
+  if (session->progress.get_error()) {
+    fprintf(stderr,
+            "Error rendering %s: %s\n",
+            bench.name.c_str(),
+            session->progress.get_error_message().c_str());
+  }
+
+  /* Deletes the scene as well. */
+  delete session;
+
+  return result;
+}
+
+static string json_escape(const string &str)
+{
+  string result;
+  foreach (char c, str) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result;
+}
+
+static string benchmark_result_json(const BenchmarkResult &result)
+{
+  const double pixel_samples = (double)result.width * result.height * result.samples;
+  const double samples_per_second = (result.render_time > 0.0) ?
+                                        pixel_samples / result.render_time :
+                                        0.0;
+
+  return string_printf(
+      "    {\n"
+      "      \"name\": \"%s\",\n"
+      "      \"width\": %d,\n"
+      "      \"height\": %d,\n"
+      "      \"samples\": %d,\n"
+      "      \"times\": {\n"
+      "        \"scene_load\": %f,\n"
+      "        \"scene_update\": %f,\n"
+      "        \"bvh_build\": %f,\n"
+      "        \"image_load\": %f,\n"
+      "        \"render\": %f,\n"
+      "        \"denoise\": %f,\n"
+      "        \"idle_threads\": %f\n"
+      "      },\n"
+      "      \"pixel_samples_per_second\": %f,\n"
+      "      \"peak_host_memory\": %zu,\n"
+      "      \"peak_device_memory\": %zu\n"
+      "    }",
+      json_escape(result.name).c_str(),
+      result.width,
+      result.height,
+      result.samples,
+      result.scene_load_time,
+      result.scene_update_time,
+      result.bvh_build_time,
+      result.image_load_time,
+      result.render_time,
+      result.denoise_time,
+      result.idle_thread_time,
+      samples_per_second,
+      result.peak_host_memory,
+      result.peak_device_memory);
+}
+
+static bool benchmark_write_json(const vector<BenchmarkResult> &results)
+{
+  string json = "{\n";
+  json += string_printf("  \"version\": \"%s\",\n", CYCLES_VERSION_STRING);
+  json += string_printf("  \"threads\": %d,\n", TaskScheduler::num_threads());
+  json += "  \"scenes\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    json += benchmark_result_json(results[i]);
+    json += (i + 1 < results.size()) ? ",\n" : "\n";
+  }
+  json += "  ]\n}\n";
+
+  if (options.output_path.empty()) {
+    printf("%s", json.c_str());
+    return true;
+  }
+
+  return path_write_text(options.output_path, json);
+}
+
+/* Options */
+
+static int files_parse(int argc, const char *argv[])
+{
+  for (int i = 0; i < argc; i++) {
+    options.filepaths.push_back(argv[i]);
+  }
+
+  return 0;
+}
+
+static void options_parse(int argc, const char **argv)
+{
+  options.width = 640;
+  options.height = 360;
+  options.samples = 16;
+  options.threads = 0;
+  options.tile_size = make_int2(32, 32);
+  options.denoise = false;
+  options.list = false;
+
+  string scene_names;
+  bool help = false, debug = false, version = false;
+  int verbosity = 1;
+
+  ArgParse ap;
+  ap.options("Usage: cycles_benchmark [options] [file.xml ...]",
+             "%*",
+             files_parse,
+             "",
+             "--scenes %s",
+             &scene_names,
+             "Comma separated list of procedural scenes to render (default all)",
+             "--list-scenes",
+             &options.list,
+             "List available procedural scenes",
+             "--samples %d",
+             &options.samples,
+             "Number of samples to render",
+             "--threads %d",
+             &options.threads,
+             "CPU Rendering Threads",
+             "--width %d",
+             &options.width,
+             "Image width in pixel",
+             "--height %d",
+             &options.height,
+             "Image height in pixel",
+             "--tile-width %d",
+             &options.tile_size.x,
+             "Tile width in pixels",
+             "--tile-height %d",
+             &options.tile_size.y,
+             "Tile height in pixels",
+             "--denoise",
+             &options.denoise,
+             "Denoise the rendered images",
+             "--output %s",
+             &options.output_path,
+             "File path to write JSON results to (default standard output)",
+#ifdef WITH_CYCLES_LOGGING
+             "--debug",
+             &debug,
+             "Enable debug logging",
+             "--verbose %d",
+             &verbosity,
+             "Set verbosity of the logger",
+#endif
+             "--help",
+             &help,
+             "Print help message",
+             "--version",
+             &version,
+             "Print version number",
+             NULL);
+
+  if (ap.parse(argc, argv) < 0) {
+    fprintf(stderr, "%s\n", ap.geterror().c_str());
+    ap.usage();
+    exit(EXIT_FAILURE);
+  }
+
+  if (debug) {
+    util_logging_start();
+    util_logging_verbosity_set(verbosity);
+  }
+
+  if (help) {
+    ap.usage();
+    exit(EXIT_SUCCESS);
+  }
+  else if (version) {
+    printf("%s\n", CYCLES_VERSION_STRING);
+    exit(EXIT_SUCCESS);
+  }
+  else if (options.list) {
+    printf("Scenes:\n");
+    for (int i = 0; i < num_procedural_scenes; i++) {
+      printf("    %s\n", procedural_scenes[i].name);
+    }
+    exit(EXIT_SUCCESS);
+  }
+
+  if (!scene_names.empty()) {
+    string_split(options.scene_names, scene_names, ",");
+  }
+  else if (options.filepaths.empty()) {
+    for (int i = 0; i < num_procedural_scenes; i++) {
+      options.scene_names.push_back(procedural_scenes[i].name);
+    }
+  }
+
+  if (options.samples <= 0) {
+    fprintf(stderr, "Invalid number of samples: %d\n", options.samples);
+    exit(EXIT_FAILURE);
+  }
+  if (options.width <= 0 || options.height <= 0) {
+    fprintf(stderr, "Invalid resolution: %dx%d\n", options.width, options.height);
+    exit(EXIT_FAILURE);
+  }
+  if (Device::available_devices(DEVICE_MASK_CPU).empty()) {
+    fprintf(stderr, "No CPU device available\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+static vector<BenchmarkScene> benchmark_scenes()
+{
+  vector<BenchmarkScene> scenes;
+
+  foreach (const string &name, options.scene_names) {
+    BenchmarkScene bench;
+    bench.name = name;
+    bench.create = NULL;
+
+    for (int i = 0; i < num_procedural_scenes; i++) {
+      if (name == procedural_scenes[i].name) {
+        bench.create = procedural_scenes[i].create;
+      }
+    }
+
+    if (bench.create == NULL) {
+      fprintf(stderr, "Unknown scene: %s\n", name.c_str());
+      exit(EXIT_FAILURE);
+    }
+
+    scenes.push_back(bench);
+  }
+
+  foreach (const string &filepath, options.filepaths) {
+    BenchmarkScene bench;
+    bench.name = path_filename(filepath);
+    bench.create = NULL;
+    bench.filepath = filepath;
+    scenes.push_back(bench);
+  }
+
+  return scenes;
+}
+
+CCL_NAMESPACE_END
+
+using namespace ccl;
+
+int main(int argc, const char **argv)
+{
+  util_logging_init(argv[0]);
+  path_init();
+  options_parse(argc, argv);
+
+  vector<BenchmarkResult> results;
+  foreach (const BenchmarkScene &bench, benchmark_scenes()) {
+    fprintf(stderr, "Rendering %s\n", bench.name.c_str());
+    results.push_back(benchmark_scene(bench));
+  }
+
+  if (!benchmark_write_json(results)) {
+    fprintf(stderr, "Failed to write %s\n", options.output_path.c_str());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
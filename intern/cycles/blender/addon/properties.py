@@ -698,6 +698,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default='HILBERT_SPIRAL',
         options=set(),  # Not animatable!
     )
+    use_tail_split: BoolProperty(
+        name="Split Last Tiles",
+        description="Subdivide the remaining tiles near the end of a CPU render, "
+        "so all threads keep rendering instead of waiting for the last tiles to finish "
+        "(not used with denoising, baking or progressive refine)",
+        default=False,
+    )
     use_progressive_refine: BoolProperty(
         name="Progressive Refine",
         description="Instead of rendering each tile until it is finished, "
@@ -1368,6 +1375,12 @@ class CyclesRenderLayerSettings(bpy.types.PropertyGroup):
         default=False,
         update=update_render_passes,
     )
+    pass_debug_render_cost: BoolProperty(
+        name="Debug Render Cost",
+        description="Time spent path tracing in microseconds per sample and pixel (CPU only)",
+        default=False,
+        update=update_render_passes,
+    )
     use_pass_volume_direct: BoolProperty(
         name="Volume Direct",
         description="Deliver direct volumetric scattering pass",
@@ -685,6 +685,7 @@ class CYCLES_RENDER_PT_performance_tiles(CyclesButtonsPanel, Panel):
         sub.prop(rd, "tile_x", text="Tiles X")
         sub.prop(rd, "tile_y", text="Y")
         col.prop(cscene, "tile_order", text="Order")
+        col.prop(cscene, "use_tail_split")
 
         sub = col.column()
         sub.active = not rd.use_save_buffers
@@ -842,6 +843,7 @@ class CYCLES_RENDER_PT_passes_data(CyclesButtonsPanel, Panel):
         col = layout.column(heading="Debug", align=True)
         col.prop(cycles_view_layer, "pass_debug_render_time", text="Render Time")
         col.prop(cycles_view_layer, "pass_debug_sample_count", text="Sample Count")
+        col.prop(cycles_view_layer, "pass_debug_render_cost", text="Render Cost")
 
         layout.prop(view_layer, "pass_alpha_threshold")
 
@@ -529,6 +529,7 @@ PassType BlenderSync::get_pass_type(BL::RenderPass &b_pass)
   MAP_PASS("Debug Render Time", PASS_RENDER_TIME);
   MAP_PASS("AdaptiveAuxBuffer", PASS_ADAPTIVE_AUX_BUFFER);
   MAP_PASS("Debug Sample Count", PASS_SAMPLE_COUNT);
+  MAP_PASS("Debug Render Cost", PASS_RENDER_COST);
   if (string_startswith(name, cryptomatte_prefix)) {
     return PASS_CRYPTOMATTE;
   }
@@ -648,6 +649,10 @@ vector<Pass> BlenderSync::sync_render_passes(BL::RenderLayer &b_rlay,
     b_engine.add_pass("Debug Sample Count", 1, "X", b_view_layer.name().c_str());
     Pass::add(PASS_SAMPLE_COUNT, passes, "Debug Sample Count");
   }
+  if (get_boolean(crl, "pass_debug_render_cost")) {
+    b_engine.add_pass("Debug Render Cost", 1, "X", b_view_layer.name().c_str());
+    Pass::add(PASS_RENDER_COST, passes, "Debug Render Cost");
+  }
   if (get_boolean(crl, "use_pass_volume_direct")) {
     b_engine.add_pass("VolumeDir", 3, "RGB", b_view_layer.name().c_str());
     Pass::add(PASS_VOLUME_DIRECT, passes, "VolumeDir");
@@ -897,6 +902,8 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
     params.tile_order = TILE_BOTTOM_TO_TOP;
   }
 
+  params.use_tail_split = background && get_boolean(cscene, "use_tail_split");
+
   /* Denoising */
   params.denoising = get_denoise_params(b_scene, b_view_layer, background);
 
@@ -908,9 +908,30 @@ class CPUDevice : public Device {
     }
   }
 
+  /* Path trace one sample of a pixel while measuring how long it takes. The time is accumulated
+   * in the render cost pass, and attributed to the shader and object seen by the camera ray. */
+  void path_trace_with_cost(
+      KernelGlobals *kg, RenderTile &tile, float *render_buffer, int sample, int x, int y)
+  {
+    ProfilingState &state = kg->profiler;
+    state.reset_primary();
+
+    const double start_time = time_dt();
+    path_trace_kernel()(kg, render_buffer, sample, x, y, tile.offset, tile.stride);
+    const double cost = time_dt() - start_time;
+
+    const int index = tile.offset + x + y * tile.stride;
+    float *buffer = render_buffer + index * kernel_data.film.pass_stride;
+    /* Stored in microseconds, seconds lose too much precision when accumulated as float. */
+    buffer[kernel_data.film.pass_render_cost] += (float)(cost * 1e6);
+
+    state.add_primary_cost(cost);
+  }
+
   void render(DeviceTask &task, RenderTile &tile, KernelGlobals *kg)
   {
     const bool use_coverage = kernel_data.film.cryptomatte_passes & CRYPT_ACCURATE;
+    const bool use_render_cost = kernel_data.film.pass_render_cost != 0;
 
     scoped_timer timer(&tile.buffers->render_time);
 
@@ -938,7 +959,12 @@ class CPUDevice : public Device {
             if (use_coverage) {
               coverage.init_pixel(x, y);
             }
-            path_trace_kernel()(kg, render_buffer, sample, x, y, tile.offset, tile.stride);
+            if (use_render_cost) {
+              path_trace_with_cost(kg, tile, render_buffer, sample, x, y);
+            }
+            else {
+              path_trace_kernel()(kg, render_buffer, sample, x, y, tile.offset, tile.stride);
+            }
           }
         }
       }
@@ -122,7 +122,9 @@ class NetworkDevice : public Device {
   {
     thread_scoped_lock lock(rpc_lock);
 
-    size_t data_size = mem.memory_size();
+    /* Only the requested rows are transferred, like the other devices do. */
+    size_t offset = elem * y * w;
+    size_t data_size = elem * w * h;
 
     RPCSend snd(socket, &error_func, "mem_copy_from");
 
@@ -134,7 +136,7 @@ class NetworkDevice : public Device {
     snd.write();
 
     RPCReceive rcv(socket, &error_func);
-    rcv.read_buffer(mem.host_pointer, data_size);
+    rcv.read_buffer((uint8_t *)mem.host_pointer + offset, data_size);
   }
 
   void mem_zero(device_memory &mem)
@@ -184,7 +186,6 @@ class NetworkDevice : public Device {
 
     RPCSend snd(socket, &error_func, "load_kernels");
     snd.add(requested_features.experimental);
-    snd.add(requested_features.max_closure);
     snd.add(requested_features.max_nodes_group);
     snd.add(requested_features.nodes_features);
     snd.write();
@@ -229,10 +230,12 @@ class NetworkDevice : public Device {
       RPCReceive rcv(socket, &error_func);
 
       if (rcv.name == "acquire_tile") {
+        uint tile_types;
+        rcv.read(tile_types);
         lock.unlock();
 
         /* todo: watch out for recursive calls! */
-        if (the_task.acquire_tile(this, tile)) { /* write return as bool */
+        if (the_task.acquire_tile(this, tile, tile_types)) { /* write return as bool */
           the_tiles.push_back(tile);
 
           lock.lock();
@@ -507,15 +510,16 @@ class DeviceServer {
 
       DataVector &data_v = data_vector_find(client_pointer);
 
-      mem.host_pointer = (device_ptr) & (data_v[0]);
+      mem.host_pointer = (void *)&data_v[0];
 
       device->mem_copy_from(mem, y, w, h, elem);
 
-      size_t data_size = mem.memory_size();
+      size_t offset = elem * y * w;
+      size_t data_size = elem * w * h;
 
       RPCSend snd(socket, &error_func, "mem_copy_from");
       snd.write();
-      snd.write_buffer((uint8_t *)mem.host_pointer, data_size);
+      snd.write_buffer((uint8_t *)mem.host_pointer + offset, data_size);
       lock.unlock();
     }
     else if (rcv.name == "mem_zero") {
@@ -538,7 +542,7 @@ class DeviceServer {
       else {
         /* Allocate host side data buffer. */
         DataVector &data_v = data_vector_insert(client_pointer, data_size);
-        mem.host_pointer = (void *) ? (device_ptr) & (data_v[0]) : 0;
+        mem.host_pointer = (data_size) ? (void *)&(data_v[0]) : 0;
       }
 
       /* Zero memory. */
@@ -578,7 +582,6 @@ class DeviceServer {
     else if (rcv.name == "load_kernels") {
       DeviceRequestedFeatures requested_features;
       rcv.read(requested_features.experimental);
-      rcv.read(requested_features.max_closure);
       rcv.read(requested_features.max_nodes_group);
       rcv.read(requested_features.nodes_features);
 
@@ -610,7 +613,7 @@ class DeviceServer {
       if (task.shader_output)
         task.shader_output = device_ptr_from_client_pointer(task.shader_output);
 
-      task.acquire_tile = function_bind(&DeviceServer::task_acquire_tile, this, _1, _2);
+      task.acquire_tile = function_bind(&DeviceServer::task_acquire_tile, this, _1, _2, _3);
       task.release_tile = function_bind(&DeviceServer::task_release_tile, this, _1);
       task.update_progress_sample = function_bind(&DeviceServer::task_update_progress_sample,
                                                   this);
@@ -660,13 +663,14 @@ class DeviceServer {
     }
   }
 
-  bool task_acquire_tile(Device *, RenderTile &tile)
+  bool task_acquire_tile(Device *, RenderTile &tile, uint tile_types)
   {
     thread_scoped_lock acquire_lock(acquire_mutex);
 
     bool result = false;
 
     RPCSend snd(socket, &error_func, "acquire_tile");
+    snd.add(tile_types);
     snd.write();
 
     do {
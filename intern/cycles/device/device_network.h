@@ -33,6 +33,10 @@
 #  include <iostream>
 #  include <sstream>
 
+#  include <zlib.h>
+
+#  include "device/device_task.h"
+
 #  include "render/buffers.h"
 
 #  include "util/util_foreach.h"
@@ -46,8 +50,6 @@ CCL_NAMESPACE_BEGIN
 using std::cerr;
 using std::cout;
 using std::exception;
-using std::hex;
-using std::setw;
 
 using boost::asio::ip::tcp;
 
@@ -64,6 +66,123 @@ typedef boost::archive::binary_oarchive o_archive;
 typedef boost::archive::binary_iarchive i_archive;
 #  endif
 
+/* Wire framing
+ *
+ * Every message and every bulk buffer is preceded by a fixed size binary header. Bulk buffers
+ * (scene data uploads and render buffer downloads) may be compressed by the sender, the
+ * receiver decodes them based on the header flags. Client and server are expected to share
+ * the same byte order, as is already the case for the binary archives. */
+
+static const uint32_t NETWORK_FRAME_MAGIC = 0x464e5943; /* "CYNF" */
+
+enum NetworkFrameFlag {
+  /* Payload is zlib compressed. */
+  NETWORK_FRAME_COMPRESSED = (1 << 0),
+  /* Bytes of 4 byte words are stored in planes before compression, which makes float
+   * buffers compress much better. */
+  NETWORK_FRAME_SHUFFLED = (1 << 1),
+};
+
+struct NetworkFrameHeader {
+  uint32_t magic;
+  uint32_t flags;
+  /* Number of bytes following the header. */
+  uint64_t size;
+  /* Number of bytes after decoding the payload. */
+  uint64_t data_size;
+};
+
+/* RPC messages only carry small arguments, bulk data is sent as separate buffers. Larger
+ * headers come from a corrupt or hostile stream and are rejected before allocating. */
+static const uint64_t NETWORK_MESSAGE_MAX_SIZE = 64 * 1024 * 1024;
+
+/* Buffers smaller than this are sent uncompressed, the saving is not worth the latency. */
+static const size_t NETWORK_COMPRESS_MIN_SIZE = 64 * 1024;
+
+/* Compression of bulk buffers is on by default, CYCLES_NETWORK_COMPRESSION=0 disables it
+ * for data sent from this process. */
+static inline bool network_compression_enabled()
+{
+  static const bool enabled = []() {
+    const char *env = getenv("CYCLES_NETWORK_COMPRESSION");
+    return (env == NULL) || (atoi(env) != 0);
+  }();
+  return enabled;
+}
+
+static inline void network_buffer_shuffle(const uint8_t *src, uint8_t *dst, size_t size)
+{
+  const size_t num_words = size / 4;
+  for (size_t i = 0; i < num_words; i++) {
+    for (size_t b = 0; b < 4; b++) {
+      dst[b * num_words + i] = src[i * 4 + b];
+    }
+  }
+  memcpy(dst + num_words * 4, src + num_words * 4, size - num_words * 4);
+}
+
+static inline void network_buffer_unshuffle(const uint8_t *src, uint8_t *dst, size_t size)
+{
+  const size_t num_words = size / 4;
+  for (size_t i = 0; i < num_words; i++) {
+    for (size_t b = 0; b < 4; b++) {
+      dst[i * 4 + b] = src[b * num_words + i];
+    }
+  }
+  memcpy(dst + num_words * 4, src + num_words * 4, size - num_words * 4);
+}
+
+/* Encode buffer for sending, returns false when it should be sent as is. */
+static inline bool network_buffer_compress(const uint8_t *data,
+                                           size_t size,
+                                           vector<uint8_t> &compressed,
+                                           uint32_t &flags)
+{
+  if (!network_compression_enabled() || size < NETWORK_COMPRESS_MIN_SIZE ||
+      size > (size_t)UINT32_MAX) {
+    return false;
+  }
+
+  vector<uint8_t> shuffled(size);
+  network_buffer_shuffle(data, &shuffled[0], size);
+
+  uLongf compressed_size = compressBound((uLong)size);
+  compressed.resize(compressed_size);
+
+  if (compress2(&compressed[0], &compressed_size, &shuffled[0], (uLong)size, Z_BEST_SPEED) !=
+          Z_OK ||
+      compressed_size >= size) {
+    return false;
+  }
+
+  compressed.resize(compressed_size);
+  flags = NETWORK_FRAME_COMPRESSED | NETWORK_FRAME_SHUFFLED;
+  return true;
+}
+
+static inline bool network_buffer_decompress(const uint8_t *payload,
+                                             size_t payload_size,
+                                             uint32_t flags,
+                                             uint8_t *data,
+                                             size_t size)
+{
+  vector<uint8_t> decompressed(size);
+  uLongf decompressed_size = size;
+
+  if (uncompress(&decompressed[0], &decompressed_size, payload, (uLong)payload_size) != Z_OK ||
+      decompressed_size != size) {
+    return false;
+  }
+
+  if (flags & NETWORK_FRAME_SHUFFLED) {
+    network_buffer_unshuffle(&decompressed[0], data, size);
+  }
+  else {
+    memcpy(data, &decompressed[0], size);
+  }
+  return true;
+}
+
 /* Serialization of device memory */
 
 class network_device_memory : public device_memory {
@@ -130,7 +249,6 @@ class RPCSend {
     archive &mem.data_type &mem.data_elements &mem.data_size;
     archive &mem.data_width &mem.data_height &mem.data_depth &mem.device_pointer;
     archive &mem.type &string(mem.name);
-    archive &mem.interpolation &mem.extension;
     archive &mem.device_pointer;
   }
 
@@ -165,20 +283,8 @@ class RPCSend {
     /* get string from stream */
     string archive_str = archive_stream.str();
 
-    /* first send fixed size header with size of following data */
-    ostringstream header_stream;
-    header_stream << setw(8) << hex << archive_str.size();
-    string header_str = header_stream.str();
-
-    boost::asio::write(
-        socket, boost::asio::buffer(header_str), boost::asio::transfer_all(), error);
-
-    if (error.value())
-      error_func->network_error(error.message());
-
-    /* then send actual data */
-    boost::asio::write(
-        socket, boost::asio::buffer(archive_str), boost::asio::transfer_all(), error);
+    /* send fixed size header and data in a single write */
+    write_frame(0, archive_str.data(), archive_str.size(), archive_str.size(), error);
 
     if (error.value())
       error_func->network_error(error.message());
@@ -186,18 +292,43 @@ class RPCSend {
     sent = true;
   }
 
-  void write_buffer(void *buffer, size_t size)
+  void write_buffer(const void *buffer, size_t size)
   {
     boost::system::error_code error;
 
-    boost::asio::write(
-        socket, boost::asio::buffer(buffer, size), boost::asio::transfer_all(), error);
+    vector<uint8_t> compressed;
+    uint32_t flags = 0;
+
+    if (network_buffer_compress((const uint8_t *)buffer, size, compressed, flags)) {
+      write_frame(flags, &compressed[0], compressed.size(), size, error);
+    }
+    else {
+      write_frame(0, buffer, size, size, error);
+    }
 
     if (error.value())
       error_func->network_error(error.message());
   }
 
  protected:
+  void write_frame(uint32_t flags,
+                   const void *payload,
+                   size_t size,
+                   size_t data_size,
+                   boost::system::error_code &error)
+  {
+    NetworkFrameHeader header;
+    header.magic = NETWORK_FRAME_MAGIC;
+    header.flags = flags;
+    header.size = size;
+    header.data_size = data_size;
+
+    boost::array<boost::asio::const_buffer, 2> buffers = {
+        boost::asio::buffer(&header, sizeof(header)), boost::asio::buffer(payload, size)};
+
+    boost::asio::write(socket, buffers, boost::asio::transfer_all(), error);
+  }
+
   string name;
   tcp::socket &socket;
   ostringstream archive_stream;
@@ -215,23 +346,16 @@ class RPCReceive {
   {
     error_func = e;
     /* read head with fixed size */
-    vector<char> header(8);
+    NetworkFrameHeader header;
     boost::system::error_code error;
-    size_t len = boost::asio::read(socket, boost::asio::buffer(header), error);
-
-    if (error.value()) {
-      error_func->network_error(error.message());
-    }
 
-    /* verify if we got something */
-    if (len == header.size()) {
-      /* decode header */
-      string header_str(&header[0], header.size());
-      istringstream header_stream(header_str);
-
-      size_t data_size;
-
-      if ((header_stream >> hex >> data_size)) {
+    if (read_header(header)) {
+      if (header.size > NETWORK_MESSAGE_MAX_SIZE) {
+        error_func->network_error("Network receive error: message too large");
+      }
+      /* messages are never compressed */
+      else if (header.flags == 0 && header.size == header.data_size) {
+        size_t data_size = header.size;
 
         vector<char> data(data_size);
         size_t len = boost::asio::read(socket, boost::asio::buffer(data), error);
@@ -253,12 +377,9 @@ class RPCReceive {
         }
       }
       else {
-        error_func->network_error("Network receive error: can't decode data size from header");
+        error_func->network_error("Network receive error: unexpected flags in message header");
       }
     }
-    else {
-      error_func->network_error("Network receive error: invalid header size");
-    }
   }
 
   ~RPCReceive()
@@ -272,7 +393,6 @@ class RPCReceive {
     *archive &mem.data_type &mem.data_elements &mem.data_size;
     *archive &mem.data_width &mem.data_height &mem.data_depth &mem.device_pointer;
     *archive &mem.type &name;
-    *archive &mem.interpolation &mem.extension;
     *archive &mem.device_pointer;
 
     mem.name = name.c_str();
@@ -291,15 +411,54 @@ class RPCReceive {
 
   void read_buffer(void *buffer, size_t size)
   {
+    NetworkFrameHeader header;
+
+    if (!read_header(header)) {
+      return;
+    }
+
+    if (header.data_size != size) {
+      error_func->network_error(
+          "Network receive error: buffer size doesn't match expected size");
+      return;
+    }
+
+    /* The payload size is bounded by the destination buffer, compressed payloads are only
+     * sent when smaller than the decoded data. */
+    if ((header.flags == 0) ? (header.size != size) : (header.size >= size)) {
+      error_func->network_error("Network receive error: invalid payload size in header");
+      return;
+    }
+
     boost::system::error_code error;
-    size_t len = boost::asio::read(socket, boost::asio::buffer(buffer, size), error);
+
+    if (header.flags == 0) {
+      /* uncompressed data goes straight into the destination buffer */
+      size_t len = boost::asio::read(socket, boost::asio::buffer(buffer, size), error);
+
+      if (error.value()) {
+        error_func->network_error(error.message());
+      }
+      else if (len != size) {
+        error_func->network_error("Network receive error: incomplete buffer");
+      }
+      return;
+    }
+
+    vector<uint8_t> payload(header.size);
+    size_t len = boost::asio::read(socket, boost::asio::buffer(payload), error);
 
     if (error.value()) {
       error_func->network_error(error.message());
     }
-
-    if (len != size)
-      cout << "Network receive error: buffer size doesn't match expected size\n";
+    else if (len != header.size) {
+      error_func->network_error("Network receive error: incomplete buffer");
+    }
+    else if (!(header.flags & NETWORK_FRAME_COMPRESSED) ||
+             !network_buffer_decompress(
+                 &payload[0], payload.size(), header.flags, (uint8_t *)buffer, size)) {
+      error_func->network_error("Network receive error: can't decode compressed buffer");
+    }
   }
 
   void read(DeviceTask &task)
@@ -329,6 +488,29 @@ class RPCReceive {
   string name;
 
  protected:
+  bool read_header(NetworkFrameHeader &header)
+  {
+    boost::system::error_code error;
+    size_t len = boost::asio::read(socket, boost::asio::buffer(&header, sizeof(header)), error);
+
+    if (error.value()) {
+      error_func->network_error(error.message());
+      return false;
+    }
+
+    if (len != sizeof(header)) {
+      error_func->network_error("Network receive error: invalid header size");
+      return false;
+    }
+
+    if (header.magic != NETWORK_FRAME_MAGIC) {
+      error_func->network_error("Network receive error: invalid header");
+      return false;
+    }
+
+    return true;
+  }
+
   tcp::socket &socket;
   string archive_str;
   istringstream *archive_stream;
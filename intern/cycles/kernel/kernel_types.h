@@ -374,6 +374,7 @@ typedef enum PassType {
   PASS_AOV_VALUE,
   PASS_ADAPTIVE_AUX_BUFFER,
   PASS_SAMPLE_COUNT,
+  PASS_RENDER_COST,
   PASS_CATEGORY_MAIN_END = 31,
 
   PASS_MIST = 32,
@@ -1254,7 +1255,8 @@ typedef struct KernelFilm {
   int pass_aov_value;
   int pass_aov_color_num;
   int pass_aov_value_num;
-  int pad1, pad2, pad3;
+  int pass_render_cost;
+  int pad2, pad3;
 
   /* XYZ to rendering color space transform. float4 instead of float3 to
    * ensure consistent padding/alignment across devices. */
@@ -1309,6 +1309,7 @@ void GeometryManager::device_update(Device *device,
         progress.set_status("Updating Mesh", msg);
 
         mesh->subd_params->camera = dicing_camera;
+        mesh->subd_params->use_cache = !scene->params.background;
         DiagSplit dsplit(*mesh->subd_params);
         mesh->tessellate(&dsplit);
 
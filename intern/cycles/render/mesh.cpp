@@ -152,6 +152,7 @@ Mesh::Mesh(const NodeType *node_type_, Type geom_type_)
   subd_params = NULL;
 
   patch_table = NULL;
+  subd_cache = NULL;
 }
 
 Mesh::Mesh() : Mesh(node_type, Geometry::MESH)
@@ -162,6 +163,7 @@ Mesh::~Mesh()
 {
   delete patch_table;
   delete subd_params;
+  subd_cache_free();
 }
 
 void Mesh::resize_mesh(int numverts, int numtris)
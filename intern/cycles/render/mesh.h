@@ -162,6 +162,15 @@ class Mesh : public Geometry {
   unordered_map<int, int> vert_to_stitching_key_map; /* real vert index -> stitching index */
   unordered_multimap<int, int>
       vert_stitching_map; /* stitching index -> multiple real vert indices */
+
+  /* Result of the previous tessellation, survives clearing the mesh. */
+  struct SubdCache;
+  SubdCache *subd_cache;
+
+  bool subd_cache_restore(const SubdParams &params);
+  void subd_cache_store(size_t num_control_verts);
+  void subd_cache_free();
+
   friend class DiagSplit;
   friend class GeometryManager;
 
@@ -366,6 +366,197 @@ struct OsdPatch : Patch {
 
 #endif
 
+/* Tessellation Cache
+ *
+ * Interactive renders sync the mesh again on many unrelated updates, which clears the
+ * tessellated triangles. Keep the result of the last tessellation together with everything it
+ * was computed from, so it can be restored when none of those changed. The camera only enters
+ * through a coarse bucket of the raster size at the mesh, so small view changes reuse the
+ * existing dicing. */
+
+struct Mesh::SubdCache {
+  struct Key {
+    int subdivision_type;
+    float dicing_rate;
+    int max_level;
+    bool ptex;
+    int dicing_bucket;
+    Transform objecttoworld;
+
+    array<float3> verts;
+    array<int> face_corners;
+    array<int> faces;
+    array<float> creases;
+
+    void build(const Mesh *mesh, const SubdParams &params)
+    {
+      subdivision_type = mesh->subdivision_type;
+      dicing_rate = params.dicing_rate;
+      max_level = params.max_level;
+      ptex = params.ptex;
+      objecttoworld = params.objecttoworld;
+
+      verts = mesh->verts;
+      face_corners = mesh->subd_face_corners;
+
+      faces.resize(mesh->subd_faces.size() * 5);
+      for (size_t i = 0; i < mesh->subd_faces.size(); i++) {
+        const SubdFace &face = mesh->subd_faces[i];
+        faces[i * 5 + 0] = face.start_corner;
+        faces[i * 5 + 1] = face.num_corners;
+        faces[i * 5 + 2] = face.shader;
+        faces[i * 5 + 3] = face.smooth;
+        faces[i * 5 + 4] = face.ptex_offset;
+      }
+
+      creases.resize(mesh->subd_creases.size() * 3);
+      for (size_t i = 0; i < mesh->subd_creases.size(); i++) {
+        const SubdEdgeCrease &crease = mesh->subd_creases[i];
+        creases[i * 3 + 0] = __int_as_float(crease.v[0]);
+        creases[i * 3 + 1] = __int_as_float(crease.v[1]);
+        creases[i * 3 + 2] = crease.crease;
+      }
+
+      dicing_bucket = 0;
+      if (params.camera && verts.size()) {
+        BoundBox bounds = BoundBox::empty;
+        for (size_t i = 0; i < verts.size(); i++) {
+          bounds.grow(verts[i]);
+        }
+
+        float3 center = transform_point(&objecttoworld, bounds.center());
+        float size = params.camera->world_to_raster_size(center);
+        if (size > 0.0f) {
+          dicing_bucket = (int)floorf(log2f(size) * 4.0f);
+        }
+      }
+    }
+
+    bool operator==(const Key &other) const
+    {
+      if (subdivision_type != other.subdivision_type || dicing_rate != other.dicing_rate ||
+          max_level != other.max_level || ptex != other.ptex ||
+          dicing_bucket != other.dicing_bucket || !(objecttoworld == other.objecttoworld)) {
+        return false;
+      }
+
+      if (!(face_corners == other.face_corners && faces == other.faces &&
+            creases == other.creases && verts.size() == other.verts.size())) {
+        return false;
+      }
+
+      /* Compare per component, the padding of float3 is undefined. */
+      for (size_t i = 0; i < verts.size(); i++) {
+        if (!(verts[i] == other.verts[i])) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+  };
+
+  Key key;
+  bool valid;
+
+  int num_subd_verts;
+  array<float3> verts;
+  array<float3> normals;
+  array<float2> vert_patch_uv;
+  array<int> triangles;
+  array<int> shader;
+  array<bool> smooth;
+  array<int> triangle_patch;
+  unordered_map<int, int> vert_to_stitching_key_map;
+  unordered_multimap<int, int> vert_stitching_map;
+};
+
+bool Mesh::subd_cache_restore(const SubdParams &params)
+{
+  SubdCache::Key key;
+  key.build(this, params);
+
+  if (subd_cache && subd_cache->valid && subd_cache->key == key) {
+    size_t base_verts = verts.size();
+    size_t num_verts = subd_cache->verts.size();
+
+    resize_mesh(base_verts + num_verts, subd_cache->shader.size());
+
+    Attribute *attr_vN = attributes.add(ATTR_STD_VERTEX_NORMAL);
+    if (params.ptex) {
+      attributes.add(ATTR_STD_PTEX_UV);
+      attributes.add(ATTR_STD_PTEX_FACE_ID);
+    }
+
+    memcpy(verts.data() + base_verts, subd_cache->verts.data(), sizeof(float3) * num_verts);
+    memcpy(attr_vN->data_float3() + base_verts,
+           subd_cache->normals.data(),
+           sizeof(float3) * num_verts);
+    memcpy(vert_patch_uv.data() + base_verts,
+           subd_cache->vert_patch_uv.data(),
+           sizeof(float2) * num_verts);
+
+    triangles = subd_cache->triangles;
+    shader = subd_cache->shader;
+    smooth = subd_cache->smooth;
+    triangle_patch = subd_cache->triangle_patch;
+
+    vert_to_stitching_key_map = subd_cache->vert_to_stitching_key_map;
+    vert_stitching_map = subd_cache->vert_stitching_map;
+    num_subd_verts += subd_cache->num_subd_verts;
+
+    return true;
+  }
+
+  if (!subd_cache) {
+    subd_cache = new SubdCache();
+  }
+
+  subd_cache->key = key;
+  subd_cache->valid = false;
+
+  return false;
+}
+
+void Mesh::subd_cache_store(size_t num_control_verts)
+{
+  Attribute *attr_vN = attributes.find(ATTR_STD_VERTEX_NORMAL);
+  if (!subd_cache || !attr_vN) {
+    return;
+  }
+
+  size_t num_verts = verts.size() - num_control_verts;
+
+  subd_cache->num_subd_verts = num_subd_verts;
+
+  subd_cache->verts.resize(num_verts);
+  subd_cache->normals.resize(num_verts);
+  subd_cache->vert_patch_uv.resize(num_verts);
+  memcpy(subd_cache->verts.data(), verts.data() + num_control_verts, sizeof(float3) * num_verts);
+  memcpy(subd_cache->normals.data(),
+         attr_vN->data_float3() + num_control_verts,
+         sizeof(float3) * num_verts);
+  memcpy(subd_cache->vert_patch_uv.data(),
+         vert_patch_uv.data() + num_control_verts,
+         sizeof(float2) * num_verts);
+
+  subd_cache->triangles = triangles;
+  subd_cache->shader = shader;
+  subd_cache->smooth = smooth;
+  subd_cache->triangle_patch = triangle_patch;
+
+  subd_cache->vert_to_stitching_key_map = vert_to_stitching_key_map;
+  subd_cache->vert_stitching_map = vert_stitching_map;
+
+  subd_cache->valid = true;
+}
+
+void Mesh::subd_cache_free()
+{
+  delete subd_cache;
+  subd_cache = NULL;
+}
+
 void Mesh::tessellate(DiagSplit *split)
 {
 #ifdef WITH_OPENSUBDIV
@@ -391,6 +582,20 @@ void Mesh::tessellate(DiagSplit *split)
     }
   }
 
+  /* Reuse the previous tessellation if nothing it depends on changed. Only a mesh without
+   * triangles can be restored, the cache does not store any that existed before dicing. */
+  const SubdParams &params = split->get_params();
+  const bool use_cache = params.use_cache && num_triangles() == 0;
+  const size_t num_control_verts = verts.size();
+  bool cache_hit = false;
+
+  if (use_cache) {
+    cache_hit = subd_cache_restore(params);
+  }
+  else {
+    subd_cache_free();
+  }
+
   int num_faces = subd_faces.size();
 
   Attribute *attr_vN = subd_attributes.find(ATTR_STD_VERTEX_NORMAL);
@@ -410,8 +615,11 @@ void Mesh::tessellate(DiagSplit *split)
   }
 
   /* build patches from faces */
+  if (cache_hit) {
+    /* Triangles were restored from the cache. */
+  }
 #ifdef WITH_OPENSUBDIV
-  if (subdivision_type == SUBDIVISION_CATMULL_CLARK) {
+  else if (subdivision_type == SUBDIVISION_CATMULL_CLARK) {
     vector<OsdPatch> osd_patches(num_patches, &osd_data);
     OsdPatch *patch = osd_patches.data();
 
@@ -534,6 +742,10 @@ void Mesh::tessellate(DiagSplit *split)
     split->split_patches(linear_patches.data(), sizeof(LinearQuadPatch));
   }
 
+  if (use_cache && !cache_hit) {
+    subd_cache_store(num_control_verts);
+  }
+
   /* interpolate center points for attributes */
   foreach (Attribute &attr, subd_attributes.attributes) {
 #ifdef WITH_OPENSUBDIV
@@ -83,6 +83,11 @@ Session::Session(const SessionParams &params_)
   reset_time = 0.0;
   last_update_time = 0.0;
 
+  num_idle_threads = 0;
+  idle_start_time_sum = 0.0;
+  idle_thread_time = 0.0;
+  denoising_time = 0.0;
+
   delayed_reset.do_reset = false;
   delayed_reset.samples = 0;
 
@@ -303,6 +308,7 @@ void Session::run_gpu()
       render(need_denoise);
 
       device->task_wait();
+      update_idle_thread_time();
 
       if (!device->error_message().empty())
         progress.set_cancel(device->error_message());
@@ -399,6 +405,12 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
       denoising_cond.wait(tile_lock);
       continue;
     }
+
+    /* This thread is done, it stays idle until all other threads finished their tiles. */
+    if (tile_types & RenderTile::PATH_TRACE) {
+      num_idle_threads++;
+      idle_start_time_sum += time_dt();
+    }
     return false;
   }
 
@@ -414,6 +426,7 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
 
   if (tile->state == Tile::DENOISE) {
     rtile.task = RenderTile::DENOISE;
+    denoising_start_times[tile->index] = time_dt();
   }
   else if (read_bake_tile_cb) {
     rtile.task = RenderTile::BAKE;
@@ -485,6 +498,17 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
   return true;
 }
 
+void Session::update_idle_thread_time()
+{
+  thread_scoped_lock tile_lock(tile_mutex);
+
+  /* All render threads are finished now, so each idle thread waited from the moment it ran
+   * out of tiles until now. */
+  idle_thread_time += num_idle_threads * time_dt() - idle_start_time_sum;
+  num_idle_threads = 0;
+  idle_start_time_sum = 0.0;
+}
+
 void Session::update_tile_sample(RenderTile &rtile)
 {
   thread_scoped_lock tile_lock(tile_mutex);
@@ -506,6 +530,14 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
 
   progress.add_finished_tile(rtile.task == RenderTile::DENOISE);
 
+  if (rtile.task == RenderTile::DENOISE) {
+    map<int, double>::iterator it = denoising_start_times.find(rtile.tile_index);
+    if (it != denoising_start_times.end()) {
+      denoising_time += time_dt() - it->second;
+      denoising_start_times.erase(it);
+    }
+  }
+
   bool delete_tile;
 
   if (tile_manager.finish_tile(rtile.tile_index, need_denoise, delete_tile)) {
@@ -733,6 +765,7 @@ void Session::run_cpu()
     }
 
     device->task_wait();
+    update_idle_thread_time();
 
     {
       thread_scoped_lock reset_lock(delayed_reset.mutex);
@@ -810,6 +843,13 @@ void Session::reset_(BufferParams &buffer_params, int samples)
     }
   }
 
+  /* Split the last tiles to keep all threads busy, this is only possible when tiles own their
+   * buffers and are not denoised, since split tiles do not follow the regular tile grid. */
+  const bool use_tail_split = params.use_tail_split && params.background &&
+                              !params.progressive && params.device.type == DEVICE_CPU &&
+                              !buffers && !tile_manager.schedule_denoising && !read_bake_tile_cb;
+  tile_manager.tail_split_threshold = use_tail_split ? TaskScheduler::num_threads() : 0;
+
   tile_manager.reset(buffer_params, samples);
   progress.reset_sample();
 
@@ -1205,9 +1245,21 @@ void Session::device_free()
 void Session::collect_statistics(RenderStats *render_stats)
 {
   scene->collect_statistics(render_stats);
+
+  {
+    thread_scoped_lock tile_lock(tile_mutex);
+    render_stats->tiles.num_tiles = tile_manager.state.num_tiles;
+    render_stats->tiles.idle_thread_time = idle_thread_time;
+    render_stats->tiles.denoising_time = denoising_time;
+  }
+
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
+
+  if (Pass::contains(scene->passes, PASS_RENDER_COST) && (params.device.type == DEVICE_CPU)) {
+    render_stats->collect_render_cost(scene, profiler);
+  }
 }
 
 CCL_NAMESPACE_END
@@ -23,6 +23,7 @@
 #include "render/stats.h"
 #include "render/tile.h"
 
+#include "util/util_map.h"
 #include "util/util_progress.h"
 #include "util/util_stats.h"
 #include "util/util_thread.h"
@@ -57,6 +58,7 @@ class SessionParams {
   int pixel_size;
   int threads;
   bool adaptive_sampling;
+  bool use_tail_split;
 
   bool use_profiling;
 
@@ -87,6 +89,7 @@ class SessionParams {
     pixel_size = 1;
     threads = 0;
     adaptive_sampling = false;
+    use_tail_split = false;
 
     use_profiling = false;
 
@@ -111,6 +114,7 @@ class SessionParams {
              tile_size == params.tile_size && start_resolution == params.start_resolution &&
              pixel_size == params.pixel_size && threads == params.threads &&
              adaptive_sampling == params.adaptive_sampling &&
+             use_tail_split == params.use_tail_split &&
              use_profiling == params.use_profiling &&
              display_buffer_linear == params.display_buffer_linear &&
              cancel_timeout == params.cancel_timeout && reset_timeout == params.reset_timeout &&
@@ -222,6 +226,18 @@ class Session {
   double last_update_time;
   double last_display_time;
 
+  /* Render threads which ran out of tiles while others are still rendering, used to measure
+   * how much time is lost at the end of each render pass. */
+  int num_idle_threads;
+  double idle_start_time_sum;
+  double idle_thread_time;
+
+  /* Start time of tiles which are currently being denoised, and the total time spent. */
+  map<int, double> denoising_start_times;
+  double denoising_time;
+
+  void update_idle_thread_time();
+
   /* progressive refine */
   bool update_progressive_refine(bool cancel);
 };
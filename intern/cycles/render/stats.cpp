@@ -252,11 +252,28 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* Tile scheduling statistics. */
+
+TileStats::TileStats() : num_tiles(0), idle_thread_time(0.0), denoising_time(0.0)
+{
+}
+
+string TileStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  string result = "";
+  result += string_printf("%sTiles: %d\n", indent.c_str(), num_tiles);
+  result += string_printf("%sIdle thread time: %.2fs\n", indent.c_str(), idle_thread_time);
+  result += string_printf("%sDenoising time: %.2fs\n", indent.c_str(), denoising_time);
+  return result;
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  has_render_cost = false;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -329,18 +346,50 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
   }
 }
 
+void RenderStats::collect_render_cost(Scene *scene, Profiler &prof)
+{
+  has_render_cost = true;
+
+  shader_cost = NamedTimeStats();
+  foreach (Shader *shader, scene->shaders) {
+    double cost;
+    if (prof.get_shader_cost(shader->id, cost)) {
+      shader_cost.add_entry(NamedTimeEntry(shader->name.string(), cost));
+    }
+  }
+
+  /* Instances share a name, report them as one entry. */
+  unordered_map<ustring, double, ustringHash> object_costs;
+  foreach (Object *object, scene->objects) {
+    double cost;
+    if (prof.get_object_cost(object->get_device_index(), cost)) {
+      object_costs[object->name] += cost;
+    }
+  }
+
+  object_cost = NamedTimeStats();
+  for (const auto &entry : object_costs) {
+    object_cost.add_entry(NamedTimeEntry(entry.first.string(), entry.second));
+  }
+}
+
 string RenderStats::full_report()
 {
   string result = "";
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
+  result += "Tile statistics:\n" + tiles.full_report(1);
   if (has_profiling) {
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
     result += "Object statistics:\n" + objects.full_report(1);
   }
   else {
-    result += "Profiling information not available (only works with CPU rendering)";
+    result += "Profiling information not available (only works with CPU rendering)\n";
+  }
+  if (has_render_cost) {
+    result += "Render cost by shader seen from camera:\n" + shader_cost.full_report(1);
+    result += "Render cost by object seen from camera:\n" + object_cost.full_report(1);
   }
   return result;
 }
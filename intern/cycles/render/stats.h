@@ -168,6 +168,24 @@ class ImageStats {
 };
 
 /* Render process statistics. */
+class TileStats {
+ public:
+  TileStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  /* Number of rendered tiles, including tiles created by splitting the last tiles. */
+  int num_tiles;
+
+  /* Accumulated time render threads spent waiting for other threads to finish their last tile,
+   * in seconds. */
+  double idle_thread_time;
+
+  /* Accumulated time render threads spent denoising tiles, in seconds. */
+  double denoising_time;
+};
+
 class RenderStats {
  public:
   RenderStats();
@@ -178,13 +196,22 @@ class RenderStats {
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
+  /* Collect per shader and object cost measured for the render cost pass. */
+  void collect_render_cost(Scene *scene, Profiler &prof);
+
   bool has_profiling;
+  bool has_render_cost;
 
   MeshStats mesh;
   ImageStats image;
+  TileStats tiles;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+
+  /* Time spent on pixels where the shader or object is the first one hit by the camera ray. */
+  NamedTimeStats shader_cost;
+  NamedTimeStats object_cost;
 };
 
 class UpdateTimeStats {
@@ -77,6 +77,13 @@ inline int2 hilbert_index_to_pos(int n, int d)
   return xy;
 }
 
+/* Tiles are not subdivided below this size in either dimension, to keep the per-tile overhead
+ * small compared to the actual rendering work. */
+const int TAIL_SPLIT_MIN_SIZE = 16;
+
+/* Maximum number of tile splits per tile queue, each split adds up to three new tiles. */
+const int TAIL_SPLIT_MAX_SPLITS_PER_THREAD = 4;
+
 enum SpiralDirection {
   DIRECTION_UP,
   DIRECTION_LEFT,
@@ -102,6 +109,7 @@ TileManager::TileManager(bool progressive_,
   start_resolution = start_resolution_;
   pixel_size = pixel_size_;
   slice_overlap = 0;
+  tail_split_threshold = 0;
   num_samples = num_samples_;
   num_devices = num_devices_;
   preserve_tile_device = preserve_tile_device_;
@@ -382,6 +390,13 @@ void TileManager::set_tiles()
 
   state.num_tiles = gen_tiles(!background);
 
+  if (tail_split_threshold > 0) {
+    /* Tiles are handed out by pointer and used outside of the tile lock, so make sure splitting
+     * tiles later on never reallocates the tile array. */
+    const int max_splits = tail_split_threshold * TAIL_SPLIT_MAX_SPLITS_PER_THREAD;
+    state.tiles.reserve(state.tiles.size() + 3 * max_splits * state.render_tiles.size());
+  }
+
   state.buffer.width = image_w;
   state.buffer.height = image_h;
 
@@ -495,6 +510,75 @@ bool TileManager::finish_tile(const int index, const bool need_denoise, bool &de
   }
 }
 
+/* Split the tile in the list at the given position into up to four tiles. The new tiles are
+ * inserted right after it, so the tile order is roughly preserved. */
+bool TileManager::split_tile(list<int>::iterator it, list<int> &render_tiles)
+{
+  if (state.tiles.size() + 3 > state.tiles.capacity()) {
+    return false;
+  }
+
+  Tile &tile = state.tiles[*it];
+  const int num_x = (tile.w >= 2 * TAIL_SPLIT_MIN_SIZE) ? 2 : 1;
+  const int num_y = (tile.h >= 2 * TAIL_SPLIT_MIN_SIZE) ? 2 : 1;
+  if (num_x == 1 && num_y == 1) {
+    return false;
+  }
+
+  const int x = tile.x, y = tile.y, w = tile.w, h = tile.h;
+  const int split_w = w / num_x, split_h = h / num_y;
+
+  /* The original tile becomes the first part, the others are appended to the tile array. */
+  tile.w = split_w;
+  tile.h = split_h;
+
+  list<int>::iterator insert_it = it;
+  insert_it++;
+
+  for (int j = 0; j < num_y; j++) {
+    for (int i = 0; i < num_x; i++) {
+      if (i == 0 && j == 0) {
+        continue;
+      }
+
+      const int tile_x = x + i * split_w;
+      const int tile_y = y + j * split_h;
+      const int tile_w = (i == num_x - 1) ? w - i * split_w : split_w;
+      const int tile_h = (j == num_y - 1) ? h - j * split_h : split_h;
+
+      const int index = state.tiles.size();
+      state.tiles.push_back(
+          Tile(index, tile_x, tile_y, tile_w, tile_h, tile.device, Tile::RENDER));
+      render_tiles.insert(insert_it, index);
+      state.num_tiles++;
+    }
+  }
+
+  return true;
+}
+
+/* Subdivide the largest remaining tiles until there are enough tiles left to keep all render
+ * threads busy. */
+void TileManager::split_tail_tiles(list<int> &render_tiles)
+{
+  while ((int)render_tiles.size() < tail_split_threshold) {
+    list<int>::iterator largest = render_tiles.end();
+    int largest_area = 0;
+
+    for (list<int>::iterator it = render_tiles.begin(); it != render_tiles.end(); it++) {
+      const Tile &tile = state.tiles[*it];
+      if (tile.w * tile.h > largest_area) {
+        largest = it;
+        largest_area = tile.w * tile.h;
+      }
+    }
+
+    if (largest == render_tiles.end() || !split_tile(largest, render_tiles)) {
+      break;
+    }
+  }
+}
+
 bool TileManager::next_tile(Tile *&tile, int device, uint tile_types)
 {
   /* Preserve device if requested, unless this is a separate denoising device that just wants to
@@ -542,6 +626,11 @@ bool TileManager::next_tile(Tile *&tile, int device, uint tile_types)
         }
       }
 
+      if (tail_split_threshold > 0 &&
+          (int)state.render_tiles[logical_device].size() < tail_split_threshold) {
+        split_tail_tiles(state.render_tiles[logical_device]);
+      }
+
       tile_index = state.render_tiles[logical_device].front();
       state.render_tiles[logical_device].pop_front();
       break;
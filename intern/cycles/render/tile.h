@@ -91,6 +91,12 @@ class TileManager {
   int num_samples;
   int slice_overlap;
 
+  /* Subdivide the remaining tiles once fewer than this many are left in the render queue, so
+   * that all render threads stay busy until the end of the render instead of idling while a few
+   * threads finish the last tiles. Zero disables subdivision. Only valid when tiles are not
+   * denoised and own their buffers, since split tiles do not follow the regular tile grid. */
+  int tail_split_threshold;
+
   TileManager(bool progressive,
               int num_samples,
               int2 tile_size,
@@ -135,6 +141,8 @@ class TileManager {
 
  protected:
   void set_tiles();
+  void split_tail_tiles(list<int> &render_tiles);
+  bool split_tile(list<int>::iterator it, list<int> &render_tiles);
 
   bool progressive;
   int2 tile_size;
@@ -44,6 +44,10 @@ struct SubdParams {
   Camera *camera;
   Transform objecttoworld;
 
+  /* Keep the tessellation around, so syncing the mesh again without changes does not need to
+   * dice it again. Costs memory, so only used for interactive rendering. */
+  bool use_cache;
+
   SubdParams(Mesh *mesh_, bool ptex_ = false)
   {
     mesh = mesh_;
@@ -54,6 +58,7 @@ struct SubdParams {
     dicing_rate = 1.0f;
     max_level = 12;
     camera = NULL;
+    use_cache = false;
   }
 };
 
@@ -72,9 +77,9 @@ class EdgeDice {
   void reserve(int num_verts, int num_triangles);
 
   void set_vert(Patch *patch, int index, float2 uv);
-  void add_triangle(Patch *patch, int v0, int v1, int v2);
+  void set_triangle(Patch *patch, int index, int v0, int v1, int v2);
 
-  void stitch_triangles(Subpatch &sub, int edge);
+  void stitch_triangles(Subpatch &sub, int edge, int &triangle_index);
 };
 
 /* Quad EdgeDice */
@@ -88,14 +93,21 @@ class QuadDice : public EdgeDice {
   float2 map_uv(Subpatch &sub, float u, float v);
   void set_vert(Subpatch &sub, int index, float u, float v);
 
-  void add_grid(Subpatch &sub, int Mu, int Mv, int offset);
+  void add_grid(Subpatch &sub, int Mu, int Mv, int offset, int &triangle_index);
 
   void set_side(Subpatch &sub, int edge);
 
   float quad_area(const float3 &a, const float3 &b, const float3 &c, const float3 &d);
   float scale_factor(Subpatch &sub, int Mu, int Mv);
 
-  void dice(Subpatch &sub);
+  void grid_size(Subpatch &sub, int &Mu, int &Mv);
+
+  /* Dicing happens in three passes over all subpatches. Inner grids and the triangles stitching
+   * them to the sides only touch data owned by the subpatch and can be diced in parallel, verts
+   * on the sides are shared with neighboring subpatches. */
+  void dice_grid(Subpatch &sub);
+  void dice_sides(Subpatch &sub);
+  void dice_stitch(Subpatch &sub);
 };
 
 CCL_NAMESPACE_END
@@ -25,6 +25,7 @@
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_math.h"
+#include "util/util_tbb.h"
 #include "util/util_types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -337,11 +338,10 @@ Edge *DiagSplit::alloc_edge()
   return &edges.back();
 }
 
-void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
+void DiagSplit::split_faces(
+    Patch *patches, size_t patches_byte_stride, int face_start, int face_end, int patch_index)
 {
-  int patch_index = 0;
-
-  for (int f = 0; f < params.mesh->subd_faces.size(); f++) {
+  for (int f = face_start; f < face_end; f++) {
     Mesh::SubdFace &face = params.mesh->subd_faces[f];
 
     Patch *patch = (Patch *)(((char *)patches) + patch_index * patches_byte_stride);
@@ -357,6 +357,68 @@ void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
       split_ngon(face, patch, patches_byte_stride);
     }
   }
+}
+
+void DiagSplit::append_block(DiagSplit &block)
+{
+  /* Verts were allocated per block, offset them to follow the ones allocated so far. Indices of
+   * split edges are still unset at this point, they are derived from their neighbors later. */
+  int vert_offset = alloc_verts(block.num_alloced_verts);
+
+  foreach (Edge &edge, block.edges) {
+    if (edge.start_vert_index >= 0) {
+      edge.start_vert_index += vert_offset;
+    }
+    if (edge.end_vert_index >= 0) {
+      edge.end_vert_index += vert_offset;
+    }
+  }
+
+  subpatches.insert(subpatches.end(), block.subpatches.begin(), block.subpatches.end());
+  push_block_edges(block.edges);
+}
+
+void DiagSplit::push_block_edges(deque<Edge> &block)
+{
+  /* Swapping keeps the edges in place, so pointers to them remain valid. */
+  block_edges.push_back(unique_ptr<deque<Edge>>(new deque<Edge>()));
+  block_edges.back()->swap(block);
+}
+
+void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
+{
+  /* Faces are split independently of each other, so blocks of faces are split in parallel.
+   * Appending the blocks in face order gives the same result as splitting all faces in order. */
+  static const int FACES_PER_BLOCK = 256;
+
+  const int num_faces = params.mesh->subd_faces.size();
+  const int num_blocks = divide_up(num_faces, FACES_PER_BLOCK);
+
+  vector<int> block_patch_index(num_blocks);
+  int patch_index = 0;
+
+  for (int f = 0; f < num_faces; f++) {
+    if (f % FACES_PER_BLOCK == 0) {
+      block_patch_index[f / FACES_PER_BLOCK] = patch_index;
+    }
+    patch_index += params.mesh->subd_faces[f].num_ptex_faces();
+  }
+
+  vector<unique_ptr<DiagSplit>> blocks(num_blocks);
+
+  parallel_for(blocked_range<size_t>(0, num_blocks, 1), [&](const blocked_range<size_t> &r) {
+    for (size_t b = r.begin(); b != r.end(); b++) {
+      const int face_start = b * FACES_PER_BLOCK;
+      const int face_end = min(face_start + FACES_PER_BLOCK, num_faces);
+      blocks[b].reset(new DiagSplit(params));
+      blocks[b]->split_faces(
+          patches, patches_byte_stride, face_start, face_end, block_patch_index[b]);
+    }
+  });
+
+  foreach (unique_ptr<DiagSplit> &block, blocks) {
+    append_block(*block);
+  }
 
   params.mesh->vert_to_stitching_key_map.clear();
   params.mesh->vert_stitching_map.clear();
@@ -605,16 +667,21 @@ void DiagSplit::post_split()
 {
   int num_stitch_verts = 0;
 
+  /* Edges of faces that were split directly go after the ones of split blocks. */
+  push_block_edges(edges);
+
   /* All patches are now split, and all T values known. */
 
-  foreach (Edge &edge, edges) {
-    if (edge.second_vert_index < 0) {
-      edge.second_vert_index = alloc_verts(edge.T - 1);
-    }
+  foreach (unique_ptr<deque<Edge>> &block, block_edges) {
+    foreach (Edge &edge, *block) {
+      if (edge.second_vert_index < 0) {
+        edge.second_vert_index = alloc_verts(edge.T - 1);
+      }
 
-    if (edge.is_stitch_edge) {
-      num_stitch_verts = max(num_stitch_verts,
-                             max(edge.stitch_start_vert_index, edge.stitch_end_vert_index));
+      if (edge.is_stitch_edge) {
+        num_stitch_verts = max(num_stitch_verts,
+                               max(edge.stitch_start_vert_index, edge.stitch_end_vert_index));
+      }
     }
   }
 
@@ -630,44 +697,52 @@ void DiagSplit::post_split()
   typedef unordered_map<pair<int, int>, int, pair_hasher> edge_stitch_verts_map_t;
   edge_stitch_verts_map_t edge_stitch_verts_map;
 
-  foreach (Edge &edge, edges) {
-    if (edge.is_stitch_edge) {
-      if (edge.stitch_edge_T == 0) {
-        edge.stitch_edge_T = edge.T;
-      }
+  foreach (unique_ptr<deque<Edge>> &block, block_edges) {
+    foreach (Edge &edge, *block) {
+      if (edge.is_stitch_edge) {
+        if (edge.stitch_edge_T == 0) {
+          edge.stitch_edge_T = edge.T;
+        }
 
-      if (edge_stitch_verts_map.find(edge.stitch_edge_key) == edge_stitch_verts_map.end()) {
-        edge_stitch_verts_map[edge.stitch_edge_key] = num_stitch_verts;
-        num_stitch_verts += edge.stitch_edge_T - 1;
+        if (edge_stitch_verts_map.find(edge.stitch_edge_key) == edge_stitch_verts_map.end()) {
+          edge_stitch_verts_map[edge.stitch_edge_key] = num_stitch_verts;
+          num_stitch_verts += edge.stitch_edge_T - 1;
+        }
       }
     }
   }
 
   /* Set start and end indices for edges generated from a split. */
-  foreach (Edge &edge, edges) {
-    if (edge.start_vert_index < 0) {
-      /* Fixup offsets. */
-      if (edge.top_indices_decrease) {
-        edge.top_offset = edge.top->T - edge.top_offset;
+  foreach (unique_ptr<deque<Edge>> &block, block_edges) {
+    foreach (Edge &edge, *block) {
+      if (edge.start_vert_index < 0) {
+        /* Fixup offsets. */
+        if (edge.top_indices_decrease) {
+          edge.top_offset = edge.top->T - edge.top_offset;
+        }
+
+        edge.start_vert_index = edge.top->get_vert_along_edge(edge.top_offset);
       }
 
-      edge.start_vert_index = edge.top->get_vert_along_edge(edge.top_offset);
-    }
+      if (edge.end_vert_index < 0) {
+        if (edge.bottom_indices_decrease) {
+          edge.bottom_offset = edge.bottom->T - edge.bottom_offset;
+        }
 
-    if (edge.end_vert_index < 0) {
-      if (edge.bottom_indices_decrease) {
-        edge.bottom_offset = edge.bottom->T - edge.bottom_offset;
+        edge.end_vert_index = edge.bottom->get_vert_along_edge(edge.bottom_offset);
       }
-
-      edge.end_vert_index = edge.bottom->get_vert_along_edge(edge.bottom_offset);
     }
   }
 
   int vert_offset = params.mesh->verts.size();
 
   /* Add verts to stitching map. */
-  foreach (const Edge &edge, edges) {
-    if (edge.is_stitch_edge) {
+  foreach (const unique_ptr<deque<Edge>> &block, block_edges) {
+    foreach (const Edge &edge, *block) {
+      if (!edge.is_stitch_edge) {
+        continue;
+      }
+
       int second_stitch_vert_index = edge_stitch_verts_map[edge.stitch_edge_key];
 
       for (int i = 0; i <= edge.T; i++) {
@@ -721,14 +796,6 @@ void DiagSplit::post_split()
   int num_verts = num_alloced_verts;
   int num_triangles = 0;
 
-  for (size_t i = 0; i < subpatches.size(); i++) {
-    subpatches[i].inner_grid_vert_offset = num_verts;
-    num_verts += subpatches[i].calc_num_inner_verts();
-    num_triangles += subpatches[i].calc_num_triangles();
-  }
-
-  dice.reserve(num_verts, num_triangles);
-
   for (size_t i = 0; i < subpatches.size(); i++) {
     Subpatch &sub = subpatches[i];
 
@@ -737,12 +804,38 @@ void DiagSplit::post_split()
     sub.edge_v0.T = max(sub.edge_v0.T, 1);
     sub.edge_v1.T = max(sub.edge_v1.T, 1);
 
-    dice.dice(sub);
+    sub.inner_grid_vert_offset = num_verts;
+    sub.triangle_offset = num_triangles;
+    num_verts += sub.calc_num_inner_verts();
+    num_triangles += sub.calc_num_triangles();
+  }
+
+  dice.reserve(num_verts, num_triangles);
+
+  /* Verts on the sides are shared between neighboring subpatches, set them in order so the
+   * result does not depend on thread scheduling. */
+  static const int SUBPATCHES_PER_TASK = 64;
+  const blocked_range<size_t> range(0, subpatches.size(), SUBPATCHES_PER_TASK);
+
+  parallel_for(range, [&](const blocked_range<size_t> &r) {
+    for (size_t i = r.begin(); i != r.end(); i++) {
+      dice.dice_grid(subpatches[i]);
+    }
+  });
+
+  foreach (Subpatch &sub, subpatches) {
+    dice.dice_sides(sub);
   }
 
+  parallel_for(range, [&](const blocked_range<size_t> &r) {
+    for (size_t i = r.begin(); i != r.end(); i++) {
+      dice.dice_stitch(subpatches[i]);
+    }
+  });
+
   /* Cleanup */
   subpatches.clear();
-  edges.clear();
+  block_edges.clear();
 }
 
 CCL_NAMESPACE_END
@@ -27,6 +27,7 @@
 
 #include "util/util_deque.h"
 #include "util/util_types.h"
+#include "util/util_unique_ptr.h"
 #include "util/util_vector.h"
 
 #include <deque>
@@ -42,6 +43,12 @@ class DiagSplit {
   vector<Subpatch> subpatches;
   /* deque is used so that element pointers remain vaild when size is changed. */
   deque<Edge> edges;
+  /* Edges of blocks of faces that were split in parallel. Each block is allocated separately,
+   * as the vector may copy rather than move the deques when it grows, which would invalidate
+   * pointers to their edges. */
+  vector<unique_ptr<deque<Edge>>> block_edges;
+
+  void push_block_edges(deque<Edge> &block);
 
   float3 to_world(Patch *patch, float2 uv);
   int T(Patch *patch, float2 Pstart, float2 Pend, bool recursive_resolve = false);
@@ -57,11 +64,20 @@ class DiagSplit {
   int num_alloced_verts = 0;
   int alloc_verts(int n); /* Returns start index of new verts. */
 
+  void split_faces(
+      Patch *patches, size_t patches_byte_stride, int face_start, int face_end, int patch_index);
+  void append_block(DiagSplit &block);
+
  public:
   Edge *alloc_edge();
 
   explicit DiagSplit(const SubdParams &params);
 
+  const SubdParams &get_params() const
+  {
+    return params;
+  }
+
   void split_patches(Patch *patches, size_t patches_byte_stride);
 
   void split_quad(const Mesh::SubdFace &face, Patch *patch);
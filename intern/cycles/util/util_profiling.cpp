@@ -82,6 +82,8 @@ void Profiler::reset(int num_shaders, int num_objects)
   /* Resize and clear the accumulation vectors. */
   shader_hits.assign(num_shaders, 0);
   object_hits.assign(num_objects, 0);
+  shader_cost.assign(num_shaders, 0.0);
+  object_cost.assign(num_objects, 0.0);
 
   event_samples.assign(PROFILING_NUM_EVENTS, 0);
   shader_samples.assign(num_shaders, 0);
@@ -121,11 +123,14 @@ void Profiler::add_state(ProfilingState *state)
   /* Resize thread-local hit counters. */
   state->shader_hits.assign(shader_hits.size(), 0);
   state->object_hits.assign(object_hits.size(), 0);
+  state->shader_cost.assign(shader_cost.size(), 0.0);
+  state->object_cost.assign(object_cost.size(), 0.0);
 
   /* Initialize the state. */
   state->event = PROFILING_UNKNOWN;
   state->shader = -1;
   state->object = -1;
+  state->reset_primary();
   state->active = true;
 }
 
@@ -147,6 +152,14 @@ void Profiler::remove_state(ProfilingState *state)
   for (int i = 0; i < object_hits.size(); i++) {
     object_hits[i] += state->object_hits[i];
   }
+
+  /* Merge thread-local render cost. */
+  for (int i = 0; i < shader_cost.size(); i++) {
+    shader_cost[i] += state->shader_cost[i];
+  }
+  for (int i = 0; i < object_cost.size(); i++) {
+    object_cost[i] += state->object_cost[i];
+  }
 }
 
 uint64_t Profiler::get_event(ProfilingEvent event)
@@ -177,4 +190,22 @@ bool Profiler::get_object(int object, uint64_t &samples, uint64_t &hits)
   return true;
 }
 
+bool Profiler::get_shader_cost(int shader, double &cost)
+{
+  if (shader >= shader_cost.size() || shader_cost[shader] == 0.0) {
+    return false;
+  }
+  cost = shader_cost[shader];
+  return true;
+}
+
+bool Profiler::get_object_cost(int object, double &cost)
+{
+  if (object >= object_cost.size() || object_cost[object] == 0.0) {
+    return false;
+  }
+  cost = object_cost[object];
+  return true;
+}
+
 CCL_NAMESPACE_END
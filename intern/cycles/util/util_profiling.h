@@ -85,6 +85,31 @@ struct ProfilingState {
 
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
+
+  /* First shader and object set since the last reset, which for a camera path are the ones of
+   * the surface seen directly. Used to attribute the per-pixel render cost. */
+  int32_t primary_shader = -1;
+  int32_t primary_object = -1;
+
+  /* Render cost in seconds, attributed by primary shader and object. */
+  vector<double> shader_cost;
+  vector<double> object_cost;
+
+  inline void reset_primary()
+  {
+    primary_shader = -1;
+    primary_object = -1;
+  }
+
+  inline void add_primary_cost(double cost)
+  {
+    if (primary_shader >= 0 && primary_shader < shader_cost.size()) {
+      shader_cost[primary_shader] += cost;
+    }
+    if (primary_object >= 0 && primary_object < object_cost.size()) {
+      object_cost[primary_object] += cost;
+    }
+  }
 };
 
 class Profiler {
@@ -104,6 +129,9 @@ class Profiler {
   bool get_shader(int shader, uint64_t &samples, uint64_t &hits);
   bool get_object(int object, uint64_t &samples, uint64_t &hits);
 
+  bool get_shader_cost(int shader, double &cost);
+  bool get_object_cost(int object, double &cost);
+
  protected:
   void run();
 
@@ -121,6 +149,11 @@ class Profiler {
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
 
+  /* Measured render cost in seconds of the pixels where the shader or object was the first one
+   * hit, only gathered when the render cost pass is enabled. */
+  vector<double> shader_cost;
+  vector<double> object_cost;
+
   volatile bool do_stop_worker;
   thread *worker;
 
@@ -148,6 +181,9 @@ class ProfilingHelper {
       assert(shader < state->shader_hits.size());
       state->shader_hits[shader]++;
     }
+    if (state->primary_shader == -1) {
+      state->primary_shader = shader;
+    }
   }
 
   inline void set_object(int object)
@@ -157,6 +193,9 @@ class ProfilingHelper {
       assert(object < state->object_hits.size());
       state->object_hits[object]++;
     }
+    if (state->primary_object == -1) {
+      state->primary_object = object;
+    }
   }
 
   ~ProfilingHelper()
@@ -149,6 +149,10 @@ class GRAPH_MT_view(Menu):
         layout.operator("graph.view_selected")
         layout.operator("graph.view_frame")
 
+        if st.mode == 'DRIVERS':
+            layout.separator()
+            layout.operator("anim.driver_python_report")
+
         # Add this to show key-binding (reverse action in dope-sheet).
         layout.separator()
         props = layout.operator("wm.context_set_enum", text="Toggle Dope Sheet")
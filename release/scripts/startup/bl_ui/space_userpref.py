@@ -608,6 +608,11 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
 
         layout.separator()
 
+        col = layout.column()
+        col.prop(system, "modifier_cache_limit", text="Modifier Cache Limit")
+
+        layout.separator()
+
         col = layout.column()
         col.prop(system, "scrollback", text="Console Scrollback Lines")
 
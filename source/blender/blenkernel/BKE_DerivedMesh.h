@@ -366,6 +366,9 @@ float (*editbmesh_vert_coords_alloc(struct BMEditMesh *em, int *r_vert_len))[3];
 bool editbmesh_modifier_is_enabled(struct Scene *scene,
                                    struct ModifierData *md,
                                    bool has_prev_mesh);
+
+void mesh_modifier_stack_cache_free(struct Object *ob);
+
 void makeDerivedMesh(struct Depsgraph *depsgraph,
                      struct Scene *scene,
                      struct Object *ob,
@@ -28,9 +28,11 @@ extern "C" {
 #endif
 
 struct CacheFile;
+struct CacheFilePrefetch;
 struct CacheReader;
 struct Depsgraph;
 struct Main;
+struct Mesh;
 struct Object;
 
 void BKE_cachefiles_init(void);
@@ -62,6 +64,26 @@ void BKE_cachefile_reader_open(struct CacheFile *cache_file,
                                const char *object_path);
 void BKE_cachefile_reader_free(struct CacheFile *cache_file, struct CacheReader **reader);
 
+/* Reading of upcoming frames of a mesh reader in a background thread,
+ * into a ring buffer of `frames_num` meshes. */
+void BKE_cachefile_prefetch_ensure(struct CacheFile *cache_file,
+                                   struct CacheFilePrefetch **prefetch,
+                                   struct CacheReader *reader,
+                                   struct Object *object,
+                                   const int frames_num,
+                                   const int read_flag);
+void BKE_cachefile_prefetch_free(struct CacheFilePrefetch **prefetch);
+unsigned int BKE_cachefile_prefetch_input_hash(const struct Mesh *mesh);
+struct Mesh *BKE_cachefile_prefetch_mesh_pop(struct CacheFilePrefetch *prefetch,
+                                             const unsigned int input_hash,
+                                             const int frame,
+                                             const float time);
+void BKE_cachefile_prefetch_mesh_push(struct CacheFilePrefetch *prefetch,
+                                      const unsigned int input_hash,
+                                      const struct Mesh *mesh_read,
+                                      const int frame,
+                                      const float fps);
+
 #ifdef __cplusplus
 }
 #endif
@@ -74,6 +74,12 @@ typedef enum eCDAllocType {
   CD_REFERENCE = 3,
   /** Do a full copy of all layers, only allowed if source has same number of elements. */
   CD_DUPLICATE = 4,
+  /**
+   * Use data pointers of the source layers and keep them alive as long as any copy uses them.
+   * Layers are flagged NOFREE, so they get duplicated once written to, like #CD_REFERENCE.
+   * Layers which can not be shared are duplicated right away.
+   */
+  CD_SHARE = 5,
 } eCDAllocType;
 
 #define CD_TYPE_AS_MASK(_type) (CustomDataMask)((CustomDataMask)1 << (CustomDataMask)(_type))
@@ -233,6 +239,12 @@ void *CustomData_duplicate_referenced_layer_named(struct CustomData *data,
                                                   const int totelem);
 bool CustomData_is_referenced_layer(struct CustomData *data, int type);
 
+/* make sure the data of the first layer of type is not shared with layers copied
+ * with CD_SHARE, so it can be freed or modified in place. returns the layer data */
+void *CustomData_unshare_layer(struct CustomData *data, const int type, const int totelem);
+/* same as above, for all layers of data */
+void CustomData_unshare_layers(struct CustomData *data);
+
 /* set the CD_FLAG_NOCOPY flag in custom data layers where the mask is
  * zero for the layer type, so only layer types specified by the mask
  * will be copied
@@ -395,6 +407,7 @@ void CustomData_set_layer_stencil_index(struct CustomData *data, int type, int n
 void CustomData_set_layer_flag(struct CustomData *data, int type, int flag);
 void CustomData_clear_layer_flag(struct CustomData *data, int type, int flag);
 
+void CustomData_bmesh_alloc_block(struct CustomData *data, void **block);
 void CustomData_bmesh_set_default(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block_data(struct CustomData *data, void *block);
@@ -29,6 +29,7 @@
 extern "C" {
 #endif
 
+struct DataTransferRemapCache;
 struct Depsgraph;
 struct Object;
 struct ReportList;
@@ -175,8 +176,12 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  const float mix_factor,
                                  const char *vgroup_name,
                                  const bool invert_vgroup,
+                                 const float remap_cache_tolerance,
+                                 struct DataTransferRemapCache **remap_cache,
                                  struct ReportList *reports);
 
+void BKE_object_data_transfer_remap_cache_free(struct DataTransferRemapCache *remap_cache);
+
 #ifdef __cplusplus
 }
 #endif
@@ -293,6 +293,7 @@ void correct_bezpart(const float v1[2], float v2[2], float v3[2], const float v4
 
 /* evaluate fcurve */
 float evaluate_fcurve(struct FCurve *fcu, float evaltime);
+float evaluate_fcurve_with_hint(struct FCurve *fcu, float evaltime, int *segment_hint);
 float evaluate_fcurve_only_curve(struct FCurve *fcu, float evaltime);
 float evaluate_fcurve_driver(struct PathResolvedRNA *anim_rna,
                              struct FCurve *fcu,
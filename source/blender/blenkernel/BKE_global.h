@@ -156,6 +156,9 @@ enum {
   G_DEBUG_XR_TIME = (1 << 22),               /* XR/OpenXR timing messages */
 
   G_DEBUG_GHOST = (1 << 23), /* Debug GHOST module. */
+
+  G_DEBUG_DEPSGRAPH_NO_PRIORITY = (1 << 24),       /* depsgraph without critical path scheduling */
+  G_DEBUG_DEPSGRAPH_INCREMENTAL_CHECK = (1 << 25), /* compare incremental depsgraph builds */
 };
 
 #define G_DEBUG_ALL \
@@ -38,17 +38,34 @@ struct MLoop;
 struct MLoopTri;
 struct MVertTri;
 struct Mesh;
+struct MeshElemMap;
 struct Object;
 struct Scene;
 
 void BKE_mesh_runtime_reset(struct Mesh *mesh);
 void BKE_mesh_runtime_reset_on_copy(struct Mesh *mesh, const int flag);
+void BKE_mesh_runtime_geometry_stamp_update(struct Mesh *mesh);
 int BKE_mesh_runtime_looptri_len(const struct Mesh *mesh);
 void BKE_mesh_runtime_looptri_recalc(struct Mesh *mesh);
 const struct MLoopTri *BKE_mesh_runtime_looptri_ensure(struct Mesh *mesh);
+/* Lazily calculated normals and vertex adjacency, kept in #Mesh_Runtime until freed by:
+ * - #BKE_mesh_runtime_clear_normals, required after writing vertex positions in place (apart from
+ *   #BKE_mesh_vert_coords_apply and #BKE_mesh_transform, which call it), the auto-smooth
+ *   settings or custom normals.
+ * - #BKE_mesh_runtime_clear_topology_maps, required after changing edges, faces or corners of an
+ *   existing mesh (#BM_mesh_bm_to_me does so through #BKE_mesh_runtime_clear_geometry).
+ * - #BKE_mesh_runtime_clear_geometry, which frees both.
+ * Evaluated meshes are not modified after evaluation, so they can keep these until freed. */
+const float (*BKE_mesh_runtime_poly_normals_ensure(struct Mesh *mesh))[3];
+const float (*BKE_mesh_runtime_loop_normals_ensure(struct Mesh *mesh))[3];
+const struct MeshElemMap *BKE_mesh_runtime_vert_poly_map_ensure(struct Mesh *mesh);
+const struct MeshElemMap *BKE_mesh_runtime_vert_loop_map_ensure(struct Mesh *mesh);
+const struct MeshElemMap *BKE_mesh_runtime_vert_edge_map_ensure(struct Mesh *mesh);
 bool BKE_mesh_runtime_ensure_edit_data(struct Mesh *mesh);
 bool BKE_mesh_runtime_clear_edit_data(struct Mesh *mesh);
 bool BKE_mesh_runtime_reset_edit_data(struct Mesh *mesh);
+void BKE_mesh_runtime_clear_normals(struct Mesh *mesh);
+void BKE_mesh_runtime_clear_topology_maps(struct Mesh *mesh);
 void BKE_mesh_runtime_clear_geometry(struct Mesh *mesh);
 void BKE_mesh_runtime_clear_cache(struct Mesh *mesh);
 
@@ -437,6 +437,11 @@ void BKE_modifiers_foreach_tex_link(struct Object *ob, TexWalkFunc walk, void *u
 struct ModifierData *BKE_modifiers_findby_type(struct Object *ob, ModifierType type);
 struct ModifierData *BKE_modifiers_findby_name(struct Object *ob, const char *name);
 void BKE_modifiers_clear_errors(struct Object *ob);
+void BKE_modifiers_clear_eval_stats(struct Object *ob);
+void BKE_modifier_eval_stats_add(struct ModifierData *md,
+                                 const double start_time,
+                                 const struct Mesh *mesh_result);
+void BKE_modifiers_eval_stats_log(const struct Object *ob, const float ctime);
 int BKE_modifiers_get_cage_index(struct Scene *scene,
                                  struct Object *ob,
                                  int *r_lastPossibleCageIndex,
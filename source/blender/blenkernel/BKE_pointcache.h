@@ -49,6 +49,8 @@ extern "C" {
 
 /* Add the blendfile name after blendcache_ */
 #define PTCACHE_EXT ".bphys"
+/* Single file holding all frames, for #PTCACHE_DISK_CACHE_PACKED. */
+#define PTCACHE_PACKED_EXT ".pack" PTCACHE_EXT
 #define PTCACHE_PATH "blendcache_"
 
 /* File open options, for BKE_ptcache_file_open */
@@ -86,6 +88,7 @@ struct Main;
 struct Object;
 struct ParticleKey;
 struct ParticleSystem;
+struct PTCachePack;
 struct PointCache;
 struct RigidBodyWorld;
 struct Scene;
@@ -106,6 +109,11 @@ typedef struct PTCacheData {
 
 typedef struct PTCacheFile {
   FILE *fp;
+  /** Used instead of `fp` for frames of packed disk caches. */
+  unsigned char *mem;
+  size_t mem_len, mem_alloc, mem_pos;
+  /** Packed file the frame is appended to when closing after writing. */
+  struct PTCachePack *pack;
 
   int frame, old_format;
   unsigned int totpoint, type;
@@ -298,6 +306,8 @@ bool BKE_ptcache_object_has(struct Scene *scene, struct Object *ob, int duplis);
 
 /***************** Global funcs ****************************/
 void BKE_ptcache_remove(void);
+/* Finish background writes to packed disk caches and close their files. */
+void BKE_ptcache_packed_close_all(void);
 
 /************ ID specific functions ************************/
 void BKE_ptcache_id_clear(PTCacheID *id, int mode, unsigned int cfra);
@@ -360,6 +370,9 @@ void BKE_ptcache_mem_to_disk(struct PTCacheID *pid);
 /* Convert disk cache to memory cache and vice versa. Clears the cache that was converted. */
 void BKE_ptcache_toggle_disk_cache(struct PTCacheID *pid);
 
+/* Convert a disk cache between one file per frame and a single packed file. */
+void BKE_ptcache_toggle_disk_cache_packed(struct PTCacheID *pid);
+
 /* Rename all disk cache files with a new name. Doesn't touch the actual content of the files. */
 void BKE_ptcache_disk_cache_rename(struct PTCacheID *pid,
                                    const char *name_src,
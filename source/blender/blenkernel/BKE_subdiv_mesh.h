@@ -49,6 +49,13 @@ struct Mesh *BKE_subdiv_to_mesh(struct Subdiv *subdiv,
                                 const SubdivToMeshSettings *settings,
                                 const struct Mesh *coarse_mesh);
 
+/* Re-evaluate vertices of a mesh created by BKE_subdiv_to_mesh() for a coarse mesh which only
+ * differs in its vertices, keeping edges, loops and polygons. */
+bool BKE_subdiv_to_mesh_update_vertices(struct Subdiv *subdiv,
+                                        const SubdivToMeshSettings *settings,
+                                        const struct Mesh *coarse_mesh,
+                                        struct Mesh *subdiv_mesh);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,20 +27,28 @@
 #include "MEM_guardedalloc.h"
 
 #include "DNA_cloth_types.h"
+#include "DNA_color_types.h"
+#include "DNA_curveprofile_types.h"
 #include "DNA_customdata_types.h"
+#include "DNA_genfile.h"
 #include "DNA_key_types.h"
 #include "DNA_material_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_sdna_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_array.h"
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
+#include "BLI_session_uuid.h"
 #include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_DerivedMesh.h"
@@ -72,6 +80,8 @@
 
 #include "CLG_log.h"
 
+#include "PIL_time.h"
+
 #ifdef WITH_OPENSUBDIV
 #  include "DNA_userdef_types.h"
 #endif
@@ -869,6 +879,515 @@ void BKE_mesh_wrapper_deferred_finalize(Mesh *me_eval,
   BLI_assert(me_eval->runtime.wrapper_type_finalize == 0);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Modifier Stack Cache
+ *
+ * The results of expensive modifiers are kept on the evaluated object, together with a key
+ * hashing everything the stack up to that modifier depends on: the input mesh, the settings of
+ * the modifiers and the object state they read. When a modifier further down the stack changes,
+ * evaluation resumes from the deepest result that is still valid instead of the input mesh.
+ *
+ * Only leading modifiers that depend on nothing else than the mesh, their settings and helper
+ * empties can be cached. The first modifier reading time, textures, other geometry or simulation
+ * data ends the part of the stack that is cached.
+ * \{ */
+
+/* Results of modifiers faster than this are not worth the memory, in seconds. */
+#define STACK_CACHE_MIN_EXECUTION_TIME 0.002
+
+typedef struct StackCacheStats {
+  double execution_time;
+  int output_memory;
+} StackCacheStats;
+
+typedef struct ModifierStackCacheEntry {
+  struct ModifierStackCacheEntry *next, *prev;
+  /* Link in #stack_cache_lru and the cache of the object owning the entry. */
+  LinkData lru_link;
+  struct ModifierStackCache *cache;
+  /* Identifies the modifier over copy-on-write updates of the object. */
+  SessionUUID session_uuid;
+  uint64_t key;
+  Mesh *mesh;
+  /* Result of the leading deform modifiers, so the deform mesh can be created without running
+   * them again. Only known with has_deform_co, NULL when they don't change the input mesh. */
+  bool has_deform_co;
+  float (*deform_co)[3];
+  /* Statistics of the modifiers up to this one, from the evaluation computing the result. */
+  StackCacheStats *stats;
+  int stats_len;
+  size_t memory;
+} ModifierStackCacheEntry;
+
+typedef struct ModifierStackCache {
+  ListBase entries;
+} ModifierStackCache;
+
+/* Copy of a cached result, owned by the evaluation resuming from it. */
+typedef struct StackCacheResume {
+  ModifierData *md;
+  Mesh *mesh;
+  bool has_deform_co;
+  float (*deform_co)[3];
+  StackCacheStats *stats;
+  int stats_len;
+} StackCacheResume;
+
+/* Entries of all objects, least recently used first. The memory limit
+ * (#UserDef.modifier_cache_limit) applies to all objects together, so room is made by dropping
+ * entries of any object. Objects are evaluated in parallel, the mutex guards the entries and the
+ * memory count. Evaluation only ever uses copies of the cached meshes, so dropping entries of
+ * other objects is safe. */
+static ListBase stack_cache_lru = {NULL, NULL};
+static size_t stack_cache_memory = 0;
+static ThreadMutex stack_cache_mutex = BLI_MUTEX_INITIALIZER;
+
+typedef struct StackCacheHash {
+  /* Two differently seeded hashes, for 64 bit keys. */
+  BLI_HashMurmur2A mm2[2];
+} StackCacheHash;
+
+static void stack_cache_hash_init(StackCacheHash *hash)
+{
+  BLI_hash_mm2a_init(&hash->mm2[0], 0);
+  BLI_hash_mm2a_init(&hash->mm2[1], 0x9e3779b9);
+}
+
+static void stack_cache_hash_add(StackCacheHash *hash, const void *data, const size_t len)
+{
+  BLI_hash_mm2a_add(&hash->mm2[0], data, len);
+  BLI_hash_mm2a_add(&hash->mm2[1], data, len);
+}
+
+static void stack_cache_hash_add_int(StackCacheHash *hash, const int value)
+{
+  stack_cache_hash_add(hash, &value, sizeof(value));
+}
+
+static uint64_t stack_cache_hash_get(const StackCacheHash *hash)
+{
+  /* Finalizing changes the state, keep the running hash intact for following modifiers. */
+  BLI_HashMurmur2A mm2[2] = {hash->mm2[0], hash->mm2[1]};
+  return ((uint64_t)BLI_hash_mm2a_end(&mm2[0]) << 32) | (uint64_t)BLI_hash_mm2a_end(&mm2[1]);
+}
+
+typedef struct StackCacheIDWalkData {
+  StackCacheHash *hash;
+  bool is_cacheable;
+} StackCacheIDWalkData;
+
+static void stack_cache_id_walk(void *user_data,
+                                Object *UNUSED(ob),
+                                ID **idpoin,
+                                int UNUSED(cb_flag))
+{
+  StackCacheIDWalkData *data = user_data;
+  const ID *id = *idpoin;
+  if (id == NULL) {
+    return;
+  }
+  /* Helper empties only provide their transform, there is no way to tell whether the data of
+   * other IDs changed. */
+  if (GS(id->name) == ID_OB && ((const Object *)id)->type == OB_EMPTY) {
+    stack_cache_hash_add(data->hash, ((const Object *)id)->obmat, sizeof(float[4][4]));
+  }
+  else {
+    data->is_cacheable = false;
+  }
+}
+
+static void stack_cache_hash_curve_mapping(StackCacheHash *hash, const CurveMapping *cumap)
+{
+  stack_cache_hash_add_int(hash, cumap->flag);
+  stack_cache_hash_add(hash, &cumap->clipr, sizeof(cumap->clipr));
+  for (int i = 0; i < ARRAY_SIZE(cumap->cm); i++) {
+    const CurveMap *cuma = &cumap->cm[i];
+    stack_cache_hash_add_int(hash, cuma->totpoint);
+    stack_cache_hash_add(hash, cuma->ext_in, sizeof(cuma->ext_in));
+    stack_cache_hash_add(hash, cuma->ext_out, sizeof(cuma->ext_out));
+    if (cuma->curve) {
+      stack_cache_hash_add(hash, cuma->curve, sizeof(*cuma->curve) * (size_t)cuma->totpoint);
+    }
+  }
+}
+
+static void stack_cache_hash_curve_profile(StackCacheHash *hash, const CurveProfile *profile)
+{
+  stack_cache_hash_add_int(hash, profile->preset);
+  stack_cache_hash_add_int(hash, profile->flag);
+  stack_cache_hash_add_int(hash, profile->path_len);
+  for (int i = 0; i < profile->path_len; i++) {
+    /* Up to the runtime pointer back to the profile. */
+    stack_cache_hash_add(hash, &profile->path[i], offsetof(CurveProfilePoint, _pad));
+  }
+}
+
+static bool stack_cache_sdna_type_is_id(const SDNA *sdna, const int type_nr)
+{
+  const int struct_nr = DNA_struct_find_nr(sdna, sdna->types[type_nr]);
+  if (struct_nr == -1) {
+    return false;
+  }
+  const SDNA_Struct *struct_info = sdna->structs[struct_nr];
+  return struct_info->members_len > 0 && STREQ(sdna->types[struct_info->members[0].type], "ID");
+}
+
+/**
+ * Hash the settings of the modifier, the members following the common #ModifierData.
+ * Data owned through pointers is hashed for the types modifiers use for their settings (curve
+ * mappings and profiles), IDs are handled by the caller.
+ *
+ * \return False when the modifier owns other data through pointers (bind data for example),
+ * which can change without the settings changing, so its result can't be cached.
+ */
+static bool stack_cache_hash_modifier_settings(StackCacheHash *hash, const ModifierData *md)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
+  const SDNA *sdna = DNA_sdna_current_get();
+  const int struct_nr = DNA_struct_find_nr(sdna, mti->structName);
+  BLI_assert(struct_nr != -1);
+  if (struct_nr == -1) {
+    return false;
+  }
+
+  const SDNA_Struct *struct_info = sdna->structs[struct_nr];
+  const char *data = (const char *)md;
+  int offset = 0;
+  for (int i = 0; i < struct_info->members_len; i++) {
+    const SDNA_StructMember *member = &struct_info->members[i];
+    const char *name = sdna->names[member->name];
+    const int size = DNA_elem_size_nr(sdna, member->type, member->name);
+    if (offset < (int)sizeof(ModifierData)) {
+      offset += size;
+      continue;
+    }
+
+    /* Pointer names start with '*', or "(*" for pointers to arrays and functions. */
+    if (ELEM(name[0], '*', '(')) {
+      const void *pointer = *(const void *const *)(data + offset);
+      const char *type = sdna->types[member->type];
+      stack_cache_hash_add_int(hash, pointer != NULL);
+      if (pointer == NULL || (name[1] != '*' && stack_cache_sdna_type_is_id(sdna, member->type))) {
+        /* Nothing to hash, or an ID pointer. */
+      }
+      else if (name[1] != '*' && STREQ(type, "CurveMapping")) {
+        stack_cache_hash_curve_mapping(hash, pointer);
+      }
+      else if (name[1] != '*' && STREQ(type, "CurveProfile")) {
+        stack_cache_hash_curve_profile(hash, pointer);
+      }
+      else {
+        return false;
+      }
+    }
+    else {
+      stack_cache_hash_add(hash, data + offset, (size_t)size);
+    }
+    offset += size;
+  }
+  return true;
+}
+
+static bool stack_cache_modifier_is_cacheable(ModifierData *md)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
+
+  if (md->mode & eModifierMode_Virtual) {
+    return false;
+  }
+  if (mti->flags & eModifierTypeFlag_UsesPointCache) {
+    return false;
+  }
+  if (mti->dependsOnTime && mti->dependsOnTime(md)) {
+    return false;
+  }
+  /* Modifiers depending on particles or sculpt data, or on data changed by operators (hook). */
+  if (ELEM(md->type,
+           eModifierType_Hook,
+           eModifierType_Multires,
+           eModifierType_ParticleSystem,
+           eModifierType_ParticleInstance,
+           eModifierType_Explode,
+           eModifierType_DynamicPaint,
+           eModifierType_Collision,
+           eModifierType_Surface)) {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Compute the keys identifying the results of the leading modifiers of the stack that can be
+ * cached, in \a r_keys with one item per modifier.
+ *
+ * \return The number of keys, zero when nothing can be cached.
+ */
+static int stack_cache_keys_calc(const Scene *scene,
+                                 Object *ob,
+                                 ModifierData *firstmd,
+                                 const CDMaskLink *datamasks,
+                                 const int required_mode,
+                                 const int eval_flag,
+                                 const Mesh *mesh_input,
+                                 uint64_t *r_keys)
+{
+  StackCacheHash hash;
+  stack_cache_hash_init(&hash);
+
+  /* Input mesh and evaluation settings. */
+  stack_cache_hash_add(&hash, &mesh_input->runtime.geometry_stamp, sizeof(uint64_t));
+  stack_cache_hash_add_int(&hash, eval_flag);
+
+  /* Object and scene state read by modifiers. */
+  stack_cache_hash_add(&hash, ob->obmat, sizeof(ob->obmat));
+  stack_cache_hash_add_int(&hash, ob->totcol);
+  LISTBASE_FOREACH (const bDeformGroup *, dg, &ob->defbase) {
+    stack_cache_hash_add(&hash, dg->name, strlen(dg->name) + 1);
+  }
+  stack_cache_hash_add_int(&hash, scene->r.mode & R_SIMPLIFY);
+  stack_cache_hash_add_int(&hash, scene->r.simplify_subsurf);
+  stack_cache_hash_add_int(&hash, scene->r.simplify_subsurf_render);
+
+  int keys_len = 0;
+  const CDMaskLink *md_datamask = datamasks;
+  for (ModifierData *md = firstmd; md; md = md->next, md_datamask = md_datamask->next) {
+    const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
+    const bool is_enabled = BKE_modifier_is_enabled(scene, md, required_mode);
+
+    stack_cache_hash_add_int(&hash, md->type);
+    stack_cache_hash_add_int(&hash, is_enabled);
+
+    if (is_enabled) {
+      if (!stack_cache_modifier_is_cacheable(md)) {
+        break;
+      }
+
+      StackCacheIDWalkData walk_data = {&hash, true};
+      if (mti->foreachIDLink) {
+        mti->foreachIDLink(md, ob, stack_cache_id_walk, &walk_data);
+      }
+      if (!walk_data.is_cacheable) {
+        break;
+      }
+
+      stack_cache_hash_add_int(&hash, md->mode);
+      stack_cache_hash_add_int(&hash, md->update_count);
+      if (!stack_cache_hash_modifier_settings(&hash, md)) {
+        break;
+      }
+      stack_cache_hash_add(&hash, &md_datamask->mask, sizeof(md_datamask->mask));
+    }
+
+    r_keys[keys_len++] = stack_cache_hash_get(&hash);
+  }
+
+  return keys_len;
+}
+
+static size_t stack_cache_limit(void)
+{
+  return (size_t)U.modifier_cache_limit * 1024 * 1024;
+}
+
+/* The mutex must be held. */
+static void stack_cache_entry_free(ModifierStackCacheEntry *entry)
+{
+  stack_cache_memory -= entry->memory;
+  BKE_id_free(NULL, entry->mesh);
+  MEM_SAFE_FREE(entry->deform_co);
+  MEM_SAFE_FREE(entry->stats);
+  BLI_remlink(&stack_cache_lru, &entry->lru_link);
+  BLI_freelinkN(&entry->cache->entries, entry);
+}
+
+static bool stack_cache_entry_is_valid(const ModifierStackCacheEntry *entry,
+                                       ModifierData *firstmd,
+                                       const uint64_t *keys,
+                                       const int keys_len)
+{
+  int i = 0;
+  for (ModifierData *md = firstmd; md && i < keys_len; md = md->next, i++) {
+    if (BLI_session_uuid_is_equal(&md->session_uuid, &entry->session_uuid)) {
+      return keys[i] == entry->key;
+    }
+  }
+  return false;
+}
+
+/**
+ * Free the entries that don't match the current stack and find the deepest valid result.
+ * \a r_resume gets a copy of it, its modifier is NULL when there is none.
+ */
+static void stack_cache_lookup(Object *ob,
+                               ModifierData *firstmd,
+                               const uint64_t *keys,
+                               const int keys_len,
+                               StackCacheResume *r_resume)
+{
+  memset(r_resume, 0, sizeof(*r_resume));
+
+  BLI_mutex_lock(&stack_cache_mutex);
+
+  ModifierStackCache *cache = ob->runtime.modifier_stack_cache;
+  if (cache == NULL) {
+    BLI_mutex_unlock(&stack_cache_mutex);
+    return;
+  }
+
+  LISTBASE_FOREACH_MUTABLE (ModifierStackCacheEntry *, entry, &cache->entries) {
+    if (!stack_cache_entry_is_valid(entry, firstmd, keys, keys_len)) {
+      stack_cache_entry_free(entry);
+    }
+  }
+
+  ModifierStackCacheEntry *resume_entry = NULL;
+  for (ModifierData *md = firstmd; md; md = md->next) {
+    LISTBASE_FOREACH (ModifierStackCacheEntry *, entry, &cache->entries) {
+      if (BLI_session_uuid_is_equal(&md->session_uuid, &entry->session_uuid)) {
+        r_resume->md = md;
+        resume_entry = entry;
+      }
+    }
+  }
+
+  if (resume_entry != NULL) {
+    /* Not referencing the cached data: evaluation writes to the mesh in place, and other objects
+     * may drop the entry meanwhile. */
+    r_resume->mesh = BKE_mesh_copy_for_eval(resume_entry->mesh, false);
+    r_resume->has_deform_co = resume_entry->has_deform_co;
+    if (resume_entry->deform_co) {
+      r_resume->deform_co = MEM_dupallocN(resume_entry->deform_co);
+    }
+    r_resume->stats = MEM_dupallocN(resume_entry->stats);
+    r_resume->stats_len = resume_entry->stats_len;
+    BLI_remlink(&stack_cache_lru, &resume_entry->lru_link);
+    BLI_addtail(&stack_cache_lru, &resume_entry->lru_link);
+  }
+
+  BLI_mutex_unlock(&stack_cache_mutex);
+}
+
+/**
+ * Report the statistics of the evaluation that computed the cached result for the modifiers
+ * skipped by resuming from it. Leading deform modifiers that did run keep their own.
+ */
+static void stack_cache_resume_stats_apply(ModifierData *firstmd, const StackCacheResume *resume)
+{
+  ModifierData *md = firstmd;
+  for (int i = 0; i < resume->stats_len && md; i++, md = md->next) {
+    if (md->execution_time == 0.0) {
+      md->execution_time = resume->stats[i].execution_time;
+      md->output_memory = resume->stats[i].output_memory;
+      md->flag |= eModifierFlag_EvalStatsCached;
+    }
+  }
+}
+
+/**
+ * Keep a copy of the result of \a md, when it is worth it and fits in the memory limit.
+ * \a mesh_deform is the result of the leading deform modifiers when it was requested,
+ * \a is_deformed tells whether they changed the input mesh.
+ */
+static void stack_cache_store(Object *ob,
+                              ModifierData *firstmd,
+                              ModifierData *md,
+                              const uint64_t *keys,
+                              const int keys_len,
+                              const Mesh *mesh,
+                              const Mesh *mesh_deform,
+                              const bool is_deformed)
+{
+  if ((md->flag & eModifierFlag_NoStackCache) ||
+      (md->execution_time < STACK_CACHE_MIN_EXECUTION_TIME) ||
+      (mesh->runtime.wrapper_type != ME_WRAPPER_TYPE_MDATA)) {
+    return;
+  }
+
+  int md_index = 0;
+  for (ModifierData *md_iter = firstmd; md_iter != md; md_iter = md_iter->next) {
+    /* Modifiers reporting errors are evaluated again, so the error is shown. */
+    if (md_iter->error != NULL) {
+      return;
+    }
+    md_index++;
+  }
+  if (md_index >= keys_len || md->error != NULL) {
+    return;
+  }
+
+  const bool store_deform_co = (mesh_deform != NULL && is_deformed);
+  const size_t memory = BKE_mesh_memory_size(mesh) +
+                        (store_deform_co ? sizeof(float[3]) * (size_t)mesh_deform->totvert : 0);
+  const size_t limit = stack_cache_limit();
+  if (memory > limit) {
+    return;
+  }
+
+  ModifierStackCacheEntry *entry = MEM_callocN(sizeof(*entry), __func__);
+  entry->lru_link.data = entry;
+  entry->session_uuid = md->session_uuid;
+  entry->key = keys[md_index];
+  entry->mesh = BKE_mesh_copy_for_eval((Mesh *)mesh, false);
+  entry->has_deform_co = (mesh_deform != NULL);
+  if (store_deform_co) {
+    entry->deform_co = BKE_mesh_vert_coords_alloc(mesh_deform, NULL);
+  }
+  entry->stats_len = md_index + 1;
+  entry->stats = MEM_malloc_arrayN(entry->stats_len, sizeof(*entry->stats), __func__);
+  ModifierData *md_iter = firstmd;
+  for (int i = 0; i < entry->stats_len; i++, md_iter = md_iter->next) {
+    entry->stats[i].execution_time = md_iter->execution_time;
+    entry->stats[i].output_memory = md_iter->output_memory;
+  }
+  entry->memory = memory;
+
+  BLI_mutex_lock(&stack_cache_mutex);
+
+  ModifierStackCache *cache = ob->runtime.modifier_stack_cache;
+  if (cache == NULL) {
+    cache = ob->runtime.modifier_stack_cache = MEM_callocN(sizeof(*cache), __func__);
+  }
+
+  /* Replace the previous result of the modifier, then make room by dropping the least recently
+   * used results of all objects. */
+  LISTBASE_FOREACH (ModifierStackCacheEntry *, entry_iter, &cache->entries) {
+    if (BLI_session_uuid_is_equal(&md->session_uuid, &entry_iter->session_uuid)) {
+      stack_cache_entry_free(entry_iter);
+      break;
+    }
+  }
+  while (stack_cache_lru.first && stack_cache_memory + memory > limit) {
+    stack_cache_entry_free(((LinkData *)stack_cache_lru.first)->data);
+  }
+
+  entry->cache = cache;
+  BLI_addtail(&cache->entries, entry);
+  BLI_addtail(&stack_cache_lru, &entry->lru_link);
+  stack_cache_memory += memory;
+
+  BLI_mutex_unlock(&stack_cache_mutex);
+}
+
+/**
+ * Free the cached modifier results of the evaluated object.
+ */
+void mesh_modifier_stack_cache_free(Object *ob)
+{
+  ModifierStackCache *cache = ob->runtime.modifier_stack_cache;
+  if (cache == NULL) {
+    return;
+  }
+  BLI_mutex_lock(&stack_cache_mutex);
+  while (cache->entries.first) {
+    stack_cache_entry_free(cache->entries.first);
+  }
+  BLI_mutex_unlock(&stack_cache_mutex);
+  MEM_freeN(cache);
+  ob->runtime.modifier_stack_cache = NULL;
+}
+
+/** \} */
+
 static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
                                 Scene *scene,
                                 Object *ob,
@@ -951,12 +1470,40 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* XXX Always copying POLYINDEX, else tessellated data are no more valid! */
   CustomData_MeshMasks append_mask = CD_MASK_BAREMESH_ORIGINDEX;
 
-  /* Clear errors before evaluation. */
+  /* Clear errors and statistics before evaluation. */
   BKE_modifiers_clear_errors(ob);
+  BKE_modifiers_clear_eval_stats(ob);
+
+  /* Look up results of the leading modifiers from previous evaluations. The cache is only used
+   * for regular evaluation in object mode, and not when the stack runs for orco data, since
+   * modifiers would have to be evaluated for the orco mesh as well. */
+  uint64_t *stack_cache_keys = NULL;
+  int stack_cache_keys_len = 0;
+  StackCacheResume stack_cache_resume = {NULL};
+  if (use_cache && index == -1 && ob->mode == OB_MODE_OBJECT && previewmd == NULL &&
+      datamasks && !(datamasks->mask.vmask & (CD_MASK_ORCO | CD_MASK_CLOTH_ORCO))) {
+    int modifiers_len = 0;
+    for (ModifierData *md_iter = firstmd; md_iter; md_iter = md_iter->next) {
+      modifiers_len++;
+    }
+    const int eval_flag = (useDeform + 1) | (need_mapping << 2) | (mectx.flag << 3);
+    stack_cache_keys = MEM_malloc_arrayN(modifiers_len, sizeof(*stack_cache_keys), __func__);
+    stack_cache_keys_len = stack_cache_keys_calc(
+        scene, ob, firstmd, datamasks, required_mode, eval_flag, mesh_input, stack_cache_keys);
+    stack_cache_lookup(ob, firstmd, stack_cache_keys, stack_cache_keys_len, &stack_cache_resume);
+  }
+  else if (use_cache) {
+    mesh_modifier_stack_cache_free(ob);
+  }
+
+  /* When resuming from a cached result, the leading deform modifiers only have to run for the
+   * deform mesh, when their result isn't cached as well. */
+  const bool skip_leading_deform = stack_cache_resume.md != NULL &&
+                                   (r_deform == NULL || stack_cache_resume.has_deform_co);
 
   /* Apply all leading deform modifiers. */
   if (useDeform) {
-    for (; md; md = md->next, md_datamask = md_datamask->next) {
+    for (; md && !skip_leading_deform; md = md->next, md_datamask = md_datamask->next) {
       const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
 
       if (!BKE_modifier_is_enabled(scene, md, required_mode)) {
@@ -979,7 +1526,9 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
           BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
         }
 
+        const double md_start_time = PIL_check_seconds_timer();
         BKE_modifier_deform_verts(md, &mectx, mesh_final, deformed_verts, num_deformed_verts);
+        BKE_modifier_eval_stats_add(md, md_start_time, NULL);
 
         isPrevDeform = true;
       }
@@ -1003,14 +1552,35 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       if (deformed_verts) {
         BKE_mesh_vert_coords_apply(mesh_deform, deformed_verts);
       }
+      else if (stack_cache_resume.deform_co) {
+        BKE_mesh_vert_coords_apply(mesh_deform, stack_cache_resume.deform_co);
+      }
     }
   }
+  const bool is_leading_deformed = (deformed_verts != NULL || stack_cache_resume.deform_co);
 
   /* Apply all remaining constructive and deforming modifiers. */
   bool have_non_onlydeform_modifiers_appled = false;
   for (; md; md = md->next, md_datamask = md_datamask->next) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
 
+    /* Skip the modifiers up to the cached result, and continue from there. */
+    if (stack_cache_resume.md != NULL) {
+      if (md == stack_cache_resume.md) {
+        if (mesh_final) {
+          BKE_id_free(NULL, mesh_final);
+        }
+        mesh_final = stack_cache_resume.mesh;
+        stack_cache_resume.mesh = NULL;
+        stack_cache_resume_stats_apply(firstmd, &stack_cache_resume);
+        MEM_SAFE_FREE(deformed_verts);
+        have_non_onlydeform_modifiers_appled = true;
+        isPrevDeform = false;
+        stack_cache_resume.md = NULL;
+      }
+      continue;
+    }
+
     if (!BKE_modifier_is_enabled(scene, md, required_mode)) {
       continue;
     }
@@ -1098,7 +1668,9 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
         }
         BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
       }
+      const double md_start_time = PIL_check_seconds_timer();
       BKE_modifier_deform_verts(md, &mectx, mesh_final, deformed_verts, num_deformed_verts);
+      BKE_modifier_eval_stats_add(md, md_start_time, NULL);
     }
     else {
       bool check_for_needs_mapping = false;
@@ -1180,7 +1752,9 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
         }
       }
 
+      double md_start_time = PIL_check_seconds_timer();
       Mesh *mesh_next = BKE_modifier_modify_mesh(md, &mectx, mesh_final);
+      BKE_modifier_eval_stats_add(md, md_start_time, mesh_next);
       ASSERT_IS_VALID_MESH(mesh_next);
 
       if (mesh_next) {
@@ -1216,7 +1790,9 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
         CustomData_MeshMasks_update(&temp_cddata_masks, &nextmask);
         mesh_set_only_copy(mesh_orco, &temp_cddata_masks);
 
+        md_start_time = PIL_check_seconds_timer();
         mesh_next = BKE_modifier_modify_mesh(md, &mectx_orco, mesh_orco);
+        BKE_modifier_eval_stats_add(md, md_start_time, NULL);
         ASSERT_IS_VALID_MESH(mesh_next);
 
         if (mesh_next) {
@@ -1242,7 +1818,9 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
         nextmask.pmask |= CD_MASK_ORIGINDEX;
         mesh_set_only_copy(mesh_orco_cloth, &nextmask);
 
+        md_start_time = PIL_check_seconds_timer();
         mesh_next = BKE_modifier_modify_mesh(md, &mectx_orco, mesh_orco_cloth);
+        BKE_modifier_eval_stats_add(md, md_start_time, NULL);
         ASSERT_IS_VALID_MESH(mesh_next);
 
         if (mesh_next) {
@@ -1263,6 +1841,17 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       }
 
       mesh_final->runtime.deformed_only = false;
+
+      if (stack_cache_keys_len != 0) {
+        stack_cache_store(ob,
+                          firstmd,
+                          md,
+                          stack_cache_keys,
+                          stack_cache_keys_len,
+                          mesh_final,
+                          mesh_deform,
+                          is_leading_deformed);
+      }
     }
 
     isPrevDeform = (mti->type == eModifierTypeType_OnlyDeform);
@@ -1278,6 +1867,12 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   }
 
   BLI_linklist_free((LinkNode *)datamasks, NULL);
+  MEM_SAFE_FREE(stack_cache_keys);
+  MEM_SAFE_FREE(stack_cache_resume.deform_co);
+  MEM_SAFE_FREE(stack_cache_resume.stats);
+  if (stack_cache_resume.mesh) {
+    BKE_id_free(NULL, stack_cache_resume.mesh);
+  }
 
   for (md = firstmd; md; md = md->next) {
     BKE_modifier_free_temporary_data(md);
@@ -1353,6 +1948,8 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
     mesh_calc_finalize(mesh_input, mesh_final);
   }
 
+  BKE_modifiers_eval_stats_log(ob, DEG_get_ctime(depsgraph));
+
   /* Return final mesh */
   *r_final = mesh_final;
   if (r_deform) {
@@ -1514,8 +2111,9 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
         em_input, &final_datamask, NULL, mesh_input);
   }
 
-  /* Clear errors before evaluation. */
+  /* Clear errors and statistics before evaluation. */
   BKE_modifiers_clear_errors(ob);
+  BKE_modifiers_clear_eval_stats(ob);
 
   for (int i = 0; md; i++, md = md->next, md_datamask = md_datamask->next) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
@@ -1558,6 +2156,7 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
         BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
       }
 
+      const double md_start_time = PIL_check_seconds_timer();
       if (mti->deformVertsEM) {
         BKE_modifier_deform_vertsEM(
             md, &mectx, em_input, mesh_final, deformed_verts, num_deformed_verts);
@@ -1565,6 +2164,7 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
       else {
         BKE_modifier_deform_verts(md, &mectx, mesh_final, deformed_verts, num_deformed_verts);
       }
+      BKE_modifier_eval_stats_add(md, md_start_time, NULL);
     }
     else {
       /* apply vertex coordinates or build a DerivedMesh as necessary */
@@ -1601,7 +2201,9 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
         mask.pmask |= CD_MASK_ORIGINDEX;
         mesh_set_only_copy(mesh_orco, &mask);
 
+        const double md_start_time = PIL_check_seconds_timer();
         Mesh *mesh_next = BKE_modifier_modify_mesh(md, &mectx_orco, mesh_orco);
+        BKE_modifier_eval_stats_add(md, md_start_time, NULL);
         ASSERT_IS_VALID_MESH(mesh_next);
 
         if (mesh_next) {
@@ -1632,7 +2234,9 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
         }
       }
 
+      const double md_start_time = PIL_check_seconds_timer();
       Mesh *mesh_next = BKE_modifier_modify_mesh(md, &mectx, mesh_final);
+      BKE_modifier_eval_stats_add(md, md_start_time, mesh_next);
       ASSERT_IS_VALID_MESH(mesh_next);
 
       if (mesh_next) {
@@ -1729,6 +2333,8 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
     editbmesh_calc_modifier_final_normals(mesh_cage, &final_datamask);
   }
 
+  BKE_modifiers_eval_stats_log(ob, DEG_get_ctime(depsgraph));
+
   /* Return final mesh. */
   *r_final = mesh_final;
   if (r_cage) {
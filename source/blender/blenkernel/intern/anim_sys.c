@@ -36,6 +36,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -582,6 +583,24 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/* Check whether the F-Curve takes part in evaluation, i.e. is not muted, disabled or empty. */
+static bool animsys_fcurve_is_evaluated(FCurve *fcu)
+{
+  /* Check if this F-Curve doesn't belong to a muted group. */
+  if ((fcu->grp != NULL) && (fcu->grp->flag & AGRP_MUTED)) {
+    return false;
+  }
+  /* Check if this curve should be skipped. */
+  if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED))) {
+    return false;
+  }
+  /* Skip empty curves, as if muted. */
+  if (BKE_fcurve_is_empty(fcu)) {
+    return false;
+  }
+  return true;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -594,16 +613,7 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
 {
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
-    /* Check if this F-Curve doesn't belong to a muted group. */
-    if ((fcu->grp != NULL) && (fcu->grp->flag & AGRP_MUTED)) {
-      continue;
-    }
-    /* Check if this curve should be skipped. */
-    if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED))) {
-      continue;
-    }
-    /* Skip empty curves, as if muted. */
-    if (BKE_fcurve_is_empty(fcu)) {
+    if (!animsys_fcurve_is_evaluated(fcu)) {
       continue;
     }
     PathResolvedRNA anim_rna;
@@ -773,6 +783,212 @@ void animsys_evaluate_action(PointerRNA *ptr,
   animsys_evaluate_action_ex(ptr, act, anim_eval_context, flush_to_original);
 }
 
+/* ----------------------------------------- */
+
+/* Action Evaluation Plan
+ *
+ * Resolving RNA paths is the most expensive part of evaluating actions with many channels, so for
+ * evaluated ID-blocks the resolved properties of the active action are kept in the AnimData
+ * runtime between frames. Every channel remembers the F-Curve and path it was resolved for, so
+ * that an update of the action (which re-allocates its F-Curves, possibly at the same addresses)
+ * only re-resolves the channels which did change. The plan is freed together with the AnimData,
+ * which happens whenever copy-on-write of the ID-block is updated.
+ */
+
+typedef struct ActionEvalChannel {
+  FCurve *fcu;
+  /* Copy of the path the channel was resolved for. */
+  char *rna_path;
+  int array_index;
+  /* Keyframe segment found by the previous evaluation, see evaluate_fcurve_with_hint(). */
+  int segment_hint;
+  /* The property is resolved and is owned by the animated ID-block itself, so it stays valid for
+   * as long as the evaluated ID-block does. */
+  bool is_cached;
+  PathResolvedRNA anim_rna;
+} ActionEvalChannel;
+
+typedef struct ActionEvalPlan {
+  ActionEvalChannel *channels;
+  /* Values of all channels, evaluated before any of them is written. */
+  float *values;
+  int channels_num;
+} ActionEvalPlan;
+
+/* Curve evaluation of actions with more channels than this is done in parallel. */
+#define ACTION_EVAL_PLAN_PARALLEL_THRESHOLD 1024
+
+void BKE_animsys_action_eval_plan_free(AnimData *adt)
+{
+  ActionEvalPlan *plan = adt->action_eval_plan;
+  if (plan == NULL) {
+    return;
+  }
+  for (int i = 0; i < plan->channels_num; i++) {
+    MEM_SAFE_FREE(plan->channels[i].rna_path);
+  }
+  MEM_freeN(plan->channels);
+  MEM_freeN(plan->values);
+  MEM_freeN(plan);
+  adt->action_eval_plan = NULL;
+}
+
+static bool animsys_action_eval_plan_is_supported(ID *id, bAction *act)
+{
+  /* Properties of original ID-blocks can be re-allocated at any time by edits. */
+  if (!DEG_is_evaluated_id(id)) {
+    return false;
+  }
+  /* Mesh and grease pencil element arrays are not guaranteed to stay at the same address for the
+   * lifetime of the evaluated ID-block. */
+  if (ELEM(GS(id->name), ID_ME, ID_GD)) {
+    return false;
+  }
+  /* Action F-Curves are not supposed to have drivers, but nothing prevents it either. */
+  LISTBASE_FOREACH (FCurve *, fcu, &act->curves) {
+    if (fcu->driver != NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool action_eval_channel_matches(const ActionEvalChannel *channel, const FCurve *fcu)
+{
+  if (channel->fcu != fcu || channel->array_index != fcu->array_index) {
+    return false;
+  }
+  if (channel->rna_path == NULL || fcu->rna_path == NULL) {
+    return channel->rna_path == fcu->rna_path;
+  }
+  return STREQ(channel->rna_path, fcu->rna_path);
+}
+
+static ActionEvalPlan *animsys_action_eval_plan_ensure(AnimData *adt, bAction *act)
+{
+  const int channels_num = BLI_listbase_count(&act->curves);
+  ActionEvalPlan *plan = adt->action_eval_plan;
+  if (plan != NULL && plan->channels_num != channels_num) {
+    BKE_animsys_action_eval_plan_free(adt);
+    plan = NULL;
+  }
+  if (plan == NULL) {
+    plan = MEM_callocN(sizeof(ActionEvalPlan), "ActionEvalPlan");
+    plan->channels = MEM_calloc_arrayN(channels_num, sizeof(ActionEvalChannel), __func__);
+    plan->values = MEM_malloc_arrayN(channels_num, sizeof(float), __func__);
+    plan->channels_num = channels_num;
+    adt->action_eval_plan = plan;
+  }
+
+  int channel_index = 0;
+  LISTBASE_FOREACH (FCurve *, fcu, &act->curves) {
+    ActionEvalChannel *channel = &plan->channels[channel_index++];
+    if (action_eval_channel_matches(channel, fcu)) {
+      continue;
+    }
+    MEM_SAFE_FREE(channel->rna_path);
+    channel->fcu = fcu;
+    channel->rna_path = (fcu->rna_path != NULL) ? BLI_strdup(fcu->rna_path) : NULL;
+    channel->array_index = fcu->array_index;
+    channel->segment_hint = 0;
+    channel->is_cached = false;
+  }
+  return plan;
+}
+
+typedef struct ActionEvalPlanData {
+  ActionEvalPlan *plan;
+  float eval_time;
+} ActionEvalPlanData;
+
+static void action_eval_plan_curves_cb(void *__restrict userdata,
+                                       const int channel_index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ActionEvalPlanData *data = userdata;
+  ActionEvalChannel *channel = &data->plan->channels[channel_index];
+  FCurve *fcu = channel->fcu;
+  if (!animsys_fcurve_is_evaluated(fcu)) {
+    return;
+  }
+  const float curval = evaluate_fcurve_with_hint(fcu, data->eval_time, &channel->segment_hint);
+  fcu->curval = curval; /* debug display only, not thread safe! */
+  data->plan->values[channel_index] = curval;
+}
+
+static bool action_eval_channel_resolve(ActionEvalChannel *channel, PointerRNA *ptr)
+{
+  if (channel->is_cached) {
+    /* Animatable state of a property can depend on other settings. */
+    return RNA_property_animateable(&channel->anim_rna.ptr, channel->anim_rna.prop);
+  }
+  if (!BKE_animsys_store_rna_setting(
+          ptr, channel->fcu->rna_path, channel->fcu->array_index, &channel->anim_rna)) {
+    /* Paths which can not be resolved are tried again on the next evaluation, same as without
+     * the plan. */
+    return false;
+  }
+  /* Properties of other ID-blocks (for example, object data) can be re-allocated by their own
+   * copy-on-write updates, so only properties of this ID-block are kept. */
+  channel->is_cached = (channel->anim_rna.ptr.owner_id == ptr->owner_id);
+  return true;
+}
+
+/* Same as animsys_evaluate_action_ex(), but using the evaluation plan stored in the AnimData. */
+static void animsys_evaluate_action_plan(PointerRNA *ptr,
+                                         AnimData *adt,
+                                         bAction *act,
+                                         const AnimationEvalContext *anim_eval_context,
+                                         const bool flush_to_original)
+{
+  action_idcode_patch_check(ptr->owner_id, act);
+
+  ActionEvalPlan *plan = animsys_action_eval_plan_ensure(adt, act);
+
+  /* Evaluate all curves first, this doesn't touch the ID-block and can be done in parallel. */
+  ActionEvalPlanData data = {
+      .plan = plan,
+      .eval_time = anim_eval_context->eval_time,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (plan->channels_num > ACTION_EVAL_PLAN_PARALLEL_THRESHOLD);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, plan->channels_num, &data, action_eval_plan_curves_cb, &settings);
+
+  /* Write values in the order of the curves, since RNA setters can have side effects. */
+  for (int i = 0; i < plan->channels_num; i++) {
+    ActionEvalChannel *channel = &plan->channels[i];
+    FCurve *fcu = channel->fcu;
+    if (!animsys_fcurve_is_evaluated(fcu)) {
+      continue;
+    }
+    if (!action_eval_channel_resolve(channel, ptr)) {
+      continue;
+    }
+    const float curval = plan->values[i];
+    BKE_animsys_write_rna_setting(&channel->anim_rna, curval);
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+    }
+  }
+}
+
+/* Evaluate the active action of an ID-block which doesn't use the NLA. */
+static void animsys_evaluate_active_action(PointerRNA *ptr,
+                                           AnimData *adt,
+                                           const AnimationEvalContext *anim_eval_context,
+                                           const bool flush_to_original)
+{
+  ID *id = ptr->owner_id;
+  if (!animsys_action_eval_plan_is_supported(id, adt->action)) {
+    BKE_animsys_action_eval_plan_free(adt);
+    animsys_evaluate_action_ex(ptr, adt->action, anim_eval_context, flush_to_original);
+    return;
+  }
+  animsys_evaluate_action_plan(ptr, adt, adt->action, anim_eval_context, flush_to_original);
+}
+
 /* ***************************************** */
 /* NLA System - Evaluation */
 
@@ -2639,7 +2855,7 @@ void BKE_animsys_evaluate_animdata(ID *id,
     }
     /* evaluate Active Action only */
     else if (adt->action) {
-      animsys_evaluate_action_ex(&id_ptr, adt->action, anim_eval_context, flush_to_original);
+      animsys_evaluate_active_action(&id_ptr, adt, anim_eval_context, flush_to_original);
     }
   }
 
@@ -21,19 +21,28 @@
  * \ingroup bke
  */
 
+#include <limits.h>
 #include <string.h>
 
+#include "MEM_guardedalloc.h"
+
 #include "DNA_anim_types.h"
 #include "DNA_cachefile_types.h"
 #include "DNA_constraint_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
 #include "BLI_fileops.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -41,9 +50,11 @@
 
 #include "BKE_anim_data.h"
 #include "BKE_cachefile.h"
+#include "BKE_customdata.h"
 #include "BKE_idtype.h"
 #include "BKE_lib_id.h"
 #include "BKE_main.h"
+#include "BKE_mesh.h"
 #include "BKE_modifier.h"
 #include "BKE_scene.h"
 
@@ -78,6 +89,7 @@ static void cache_file_copy_data(Main *UNUSED(bmain),
 
   cache_file_dst->handle = NULL;
   cache_file_dst->handle_readers = NULL;
+  cache_file_dst->handle_prefetches = NULL;
   BLI_duplicatelist(&cache_file_dst->object_paths, &cache_file_src->object_paths);
 }
 
@@ -97,6 +109,7 @@ static void cache_file_blend_write(BlendWriter *writer, ID *id, const void *id_a
     cache_file->handle = NULL;
     memset(cache_file->handle_filepath, 0, sizeof(cache_file->handle_filepath));
     cache_file->handle_readers = NULL;
+    cache_file->handle_prefetches = NULL;
 
     BLO_write_id_struct(writer, CacheFile, id_address, &cache_file->id);
 
@@ -113,6 +126,7 @@ static void cache_file_blend_read_data(BlendDataReader *reader, ID *id)
   cache_file->handle = NULL;
   cache_file->handle_filepath[0] = '\0';
   cache_file->handle_readers = NULL;
+  cache_file->handle_prefetches = NULL;
 
   /* relink animdata */
   BLO_read_data_address(reader, &cache_file->adt);
@@ -144,6 +158,9 @@ IDTypeInfo IDType_ID_CF = {
 
 /* TODO: make this per cache file to avoid global locks. */
 static SpinLock spin;
+/* Stopping a prefetch waits for its reads, so this is done outside of the spin lock.
+ * Held while prefetches are released, so they're not freed meanwhile. */
+static ThreadMutex prefetch_release_mutex = BLI_MUTEX_INITIALIZER;
 
 void BKE_cachefiles_init(void)
 {
@@ -212,12 +229,432 @@ void BKE_cachefile_reader_free(CacheFile *cache_file, struct CacheReader **reade
 #endif
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh Prefetching
+ *
+ * During playback the frames after the current one are read in a background thread, into
+ * copies of the last mesh that was read by the modifier. The meshes are stored in a ring buffer
+ * indexed by frame, so evaluating a frame that was prefetched only takes the mesh out of it.
+ *
+ * Vertex positions are always read, everything else in a prefetched mesh may come from the mesh
+ * the modifier got when the template was read. So prefetched meshes are only used as long as the
+ * hash of that input (see #BKE_cachefile_prefetch_input_hash) stays the same.
+ * \{ */
+
+typedef struct CacheFilePrefetchSlot {
+  int frame;
+  float time;
+  /** Incremented when the slot is reused, so reads of the previous frame are discarded. */
+  int generation;
+  bool is_ready;
+  /** Result of the read, NULL when it failed. */
+  Mesh *mesh;
+} CacheFilePrefetchSlot;
+
+typedef struct CacheFilePrefetch {
+  /** NULL once the handle of the cache file was freed, the prefetch is recreated then. */
+  CacheFile *cache_file;
+  struct CacheReader *reader;
+  Object *object;
+  int read_flag;
+  /** Only vertex positions change over time, so only those are read in the background. */
+  bool is_topology_constant;
+
+  /** Copy of the last mesh read by the modifier, meshes are prefetched into copies of it. */
+  Mesh *mesh_template;
+  /** Hash of the mesh passed to the modifier when the template was read. */
+  uint input_hash;
+
+  TaskPool *task_pool;
+  ThreadMutex mutex;
+  ThreadCondition cond;
+  CacheFilePrefetchSlot *slots;
+  int slots_num;
+} CacheFilePrefetch;
+
+typedef struct CacheFilePrefetchTask {
+  int slot_index;
+  int generation;
+  float time;
+} CacheFilePrefetchTask;
+
+#ifdef WITH_ALEMBIC
+
+static bool cachefile_prefetch_mesh_size_matches(const Mesh *mesh, const Mesh *mesh_other)
+{
+  return (mesh->totvert == mesh_other->totvert) && (mesh->totedge == mesh_other->totedge) &&
+         (mesh->totloop == mesh_other->totloop) && (mesh->totpoly == mesh_other->totpoly);
+}
+
+static Mesh *cachefile_prefetch_mesh_read(CacheFilePrefetch *prefetch, const float time)
+{
+  Mesh *mesh = BKE_mesh_copy_for_eval(prefetch->mesh_template, false);
+  int read_flag = prefetch->read_flag;
+  const char *err_str = NULL;
+
+  BLI_assert(read_flag & MOD_MESHSEQ_READ_VERT);
+  if (prefetch->is_topology_constant) {
+    /* Faces, UVs and attributes of the template are still valid. */
+    read_flag &= (MOD_MESHSEQ_READ_VERT | MOD_MESHSEQ_INTERPOLATE_VERTICES);
+  }
+
+  Mesh *result = ABC_read_mesh(
+      prefetch->reader, prefetch->object, mesh, time, &err_str, read_flag);
+
+  if (result != mesh) {
+    BKE_id_free(NULL, mesh);
+  }
+
+  /* Leave errors and warnings to the modifier, which reads the frame again. */
+  if (err_str != NULL) {
+    if (result != NULL) {
+      BKE_id_free(NULL, result);
+    }
+    return NULL;
+  }
+
+  if (result != NULL && prefetch->is_topology_constant) {
+    /* Normals aren't stored in the archive in this case, see #ABC_mesh_topology_is_constant. */
+    BKE_mesh_calc_normals(result);
+  }
+
+  return result;
+}
+
+static void cachefile_prefetch_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  CacheFilePrefetch *prefetch = BLI_task_pool_user_data(pool);
+  const CacheFilePrefetchTask *task = taskdata;
+  CacheFilePrefetchSlot *slot = &prefetch->slots[task->slot_index];
+
+  BLI_mutex_lock(&prefetch->mutex);
+  const bool is_stale = (slot->generation != task->generation);
+  BLI_mutex_unlock(&prefetch->mutex);
+
+  if (is_stale || BLI_task_pool_canceled(pool)) {
+    return;
+  }
+
+  Mesh *mesh = cachefile_prefetch_mesh_read(prefetch, task->time);
+
+  BLI_mutex_lock(&prefetch->mutex);
+  if (slot->generation == task->generation) {
+    slot->mesh = mesh;
+    slot->is_ready = true;
+    mesh = NULL;
+    BLI_condition_notify_all(&prefetch->cond);
+  }
+  BLI_mutex_unlock(&prefetch->mutex);
+
+  if (mesh != NULL) {
+    BKE_id_free(NULL, mesh);
+  }
+}
+
+/**
+ * Cancel the reads and free the meshes that were read, must be called before the template
+ * changes. New reads are queued in a new task pool, as canceling ends the background thread.
+ */
+static void cachefile_prefetch_stop(CacheFilePrefetch *prefetch)
+{
+  if (prefetch->task_pool != NULL) {
+    BLI_task_pool_cancel(prefetch->task_pool);
+    BLI_task_pool_free(prefetch->task_pool);
+    prefetch->task_pool = NULL;
+  }
+
+  BLI_mutex_lock(&prefetch->mutex);
+  for (int i = 0; i < prefetch->slots_num; i++) {
+    CacheFilePrefetchSlot *slot = &prefetch->slots[i];
+    if (slot->mesh != NULL) {
+      BKE_id_free(NULL, slot->mesh);
+      slot->mesh = NULL;
+    }
+    slot->frame = INT_MIN;
+    slot->is_ready = false;
+    slot->generation++;
+  }
+  BLI_condition_notify_all(&prefetch->cond);
+  BLI_mutex_unlock(&prefetch->mutex);
+}
+
+/** Stop reading and release the reader and template, the prefetch itself is kept. */
+static void cachefile_prefetch_release(CacheFilePrefetch *prefetch)
+{
+  cachefile_prefetch_stop(prefetch);
+
+  if (prefetch->mesh_template != NULL) {
+    BKE_id_free(NULL, prefetch->mesh_template);
+    prefetch->mesh_template = NULL;
+  }
+  if (prefetch->reader != NULL) {
+    CacheReader_free(prefetch->reader);
+    prefetch->reader = NULL;
+  }
+  prefetch->cache_file = NULL;
+}
+
+#endif /* WITH_ALEMBIC */
+
+/**
+ * Hash of the data of a mesh passed to the modifier that can end up in its result. Vertex
+ * positions and normals are left out, since they're always read from the archive.
+ */
+uint BKE_cachefile_prefetch_input_hash(const Mesh *mesh)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+
+  const CustomData *cdata_array[4] = {&mesh->vdata, &mesh->edata, &mesh->ldata, &mesh->pdata};
+  const int cdata_len_array[4] = {mesh->totvert, mesh->totedge, mesh->totloop, mesh->totpoly};
+
+  for (int i = 0; i < ARRAY_SIZE(cdata_array); i++) {
+    const CustomData *cdata = cdata_array[i];
+    const int len = cdata_len_array[i];
+    BLI_hash_mm2a_add_int(&mm2, len);
+
+    for (int layer_index = 0; layer_index < cdata->totlayer; layer_index++) {
+      const CustomDataLayer *layer = &cdata->layers[layer_index];
+      BLI_hash_mm2a_add_int(&mm2, layer->type);
+      if (layer->data == NULL) {
+        continue;
+      }
+
+      if (layer->type == CD_MVERT) {
+        const MVert *mvert = layer->data;
+        for (int j = 0; j < len; j++) {
+          BLI_hash_mm2a_add_int(&mm2, mvert[j].flag | (mvert[j].bweight << 8));
+        }
+      }
+      else if (layer->type == CD_MDEFORMVERT) {
+        /* Weights are stored outside of the layer. */
+        const MDeformVert *dvert = layer->data;
+        for (int j = 0; j < len; j++) {
+          BLI_hash_mm2a_add_int(&mm2, dvert[j].totweight);
+          if (dvert[j].dw != NULL) {
+            BLI_hash_mm2a_add(&mm2,
+                              (const unsigned char *)dvert[j].dw,
+                              sizeof(*dvert[j].dw) * (size_t)dvert[j].totweight);
+          }
+        }
+      }
+      else {
+        BLI_hash_mm2a_add(&mm2,
+                          (const unsigned char *)layer->data,
+                          (size_t)CustomData_sizeof(layer->type) * (size_t)len);
+      }
+    }
+  }
+
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+void BKE_cachefile_prefetch_free(CacheFilePrefetch **prefetch_p)
+{
+#ifdef WITH_ALEMBIC
+  CacheFilePrefetch *prefetch = *prefetch_p;
+  if (prefetch == NULL) {
+    return;
+  }
+
+  /* Multiple modifiers can call this function concurrently. The handle of the cache file may be
+   * releasing this prefetch, in which case it's no longer registered. */
+  BLI_mutex_lock(&prefetch_release_mutex);
+  BLI_spin_lock(&spin);
+  if (prefetch->cache_file && prefetch->cache_file->handle_prefetches) {
+    BLI_gset_remove(prefetch->cache_file->handle_prefetches, prefetch, NULL);
+  }
+  BLI_spin_unlock(&spin);
+
+  cachefile_prefetch_release(prefetch);
+  BLI_mutex_unlock(&prefetch_release_mutex);
+
+  BLI_mutex_end(&prefetch->mutex);
+  BLI_condition_end(&prefetch->cond);
+  MEM_freeN(prefetch->slots);
+  MEM_freeN(prefetch);
+  *prefetch_p = NULL;
+#else
+  UNUSED_VARS(prefetch_p);
+#endif
+}
+
+void BKE_cachefile_prefetch_ensure(CacheFile *cache_file,
+                                   CacheFilePrefetch **prefetch_p,
+                                   struct CacheReader *reader,
+                                   Object *object,
+                                   const int frames_num,
+                                   const int read_flag)
+{
+#ifdef WITH_ALEMBIC
+  BLI_assert(cache_file->id.tag & LIB_TAG_COPIED_ON_WRITE);
+  BLI_assert(frames_num > 0);
+
+  CacheFilePrefetch *prefetch = *prefetch_p;
+  if (prefetch != NULL) {
+    if ((prefetch->cache_file == cache_file) && (prefetch->reader == reader) &&
+        (prefetch->object == object) && (prefetch->slots_num == frames_num) &&
+        (prefetch->read_flag == read_flag)) {
+      return;
+    }
+    BKE_cachefile_prefetch_free(prefetch_p);
+  }
+
+  prefetch = MEM_callocN(sizeof(*prefetch), __func__);
+  prefetch->cache_file = cache_file;
+  prefetch->reader = reader;
+  prefetch->object = object;
+  prefetch->read_flag = read_flag;
+  prefetch->is_topology_constant = ABC_mesh_topology_is_constant(reader);
+  BLI_mutex_init(&prefetch->mutex);
+  BLI_condition_init(&prefetch->cond);
+  prefetch->slots_num = frames_num;
+  prefetch->slots = MEM_calloc_arrayN(frames_num, sizeof(*prefetch->slots), __func__);
+  for (int i = 0; i < frames_num; i++) {
+    prefetch->slots[i].frame = INT_MIN;
+  }
+
+  /* The background thread keeps using the reader when the modifier reopens it. */
+  CacheReader_incref(reader);
+
+  /* Register in set so we can stop reading before the cache file handle is freed. */
+  BLI_spin_lock(&spin);
+  if (cache_file->handle_prefetches == NULL) {
+    cache_file->handle_prefetches = BLI_gset_ptr_new("CacheFile.handle_prefetches");
+  }
+  BLI_gset_insert(cache_file->handle_prefetches, prefetch);
+  BLI_spin_unlock(&spin);
+
+  *prefetch_p = prefetch;
+#else
+  UNUSED_VARS(cache_file, prefetch_p, reader, object, frames_num, read_flag);
+#endif
+}
+
+Mesh *BKE_cachefile_prefetch_mesh_pop(CacheFilePrefetch *prefetch,
+                                      const uint input_hash,
+                                      const int frame,
+                                      const float time)
+{
+#ifdef WITH_ALEMBIC
+  if ((prefetch->mesh_template == NULL) || (prefetch->input_hash != input_hash)) {
+    return NULL;
+  }
+
+  CacheFilePrefetchSlot *slot = &prefetch->slots[mod_i(frame, prefetch->slots_num)];
+  Mesh *mesh = NULL;
+
+  BLI_mutex_lock(&prefetch->mutex);
+  if ((slot->frame == frame) && (slot->time == time)) {
+    /* The frame is being read, waiting for it is faster than reading it again. */
+    const int generation = slot->generation;
+    while (!slot->is_ready && (slot->generation == generation)) {
+      BLI_condition_wait(&prefetch->cond, &prefetch->mutex);
+    }
+    if (slot->generation == generation) {
+      mesh = slot->mesh;
+      slot->mesh = NULL;
+      slot->frame = INT_MIN;
+      slot->is_ready = false;
+      slot->generation++;
+    }
+  }
+  BLI_mutex_unlock(&prefetch->mutex);
+
+  return mesh;
+#else
+  UNUSED_VARS(prefetch, input_hash, frame, time);
+  return NULL;
+#endif
+}
+
+void BKE_cachefile_prefetch_mesh_push(CacheFilePrefetch *prefetch,
+                                      const uint input_hash,
+                                      const Mesh *mesh_read,
+                                      const int frame,
+                                      const float fps)
+{
+#ifdef WITH_ALEMBIC
+  if (prefetch->cache_file == NULL) {
+    return;
+  }
+
+  /* Replace the template when the topology or the input mesh changed. Frames read into the
+   * previous template are dropped, the template isn't replaced for every frame so reads that
+   * are still in progress are kept. */
+  if ((mesh_read != NULL) &&
+      ((prefetch->mesh_template == NULL) ||
+       !cachefile_prefetch_mesh_size_matches(mesh_read, prefetch->mesh_template) ||
+       (prefetch->input_hash != input_hash))) {
+    cachefile_prefetch_stop(prefetch);
+
+    if (prefetch->mesh_template != NULL) {
+      BKE_id_free(NULL, prefetch->mesh_template);
+    }
+    prefetch->mesh_template = BKE_mesh_copy_for_eval((Mesh *)mesh_read, false);
+    prefetch->input_hash = input_hash;
+  }
+  else if (prefetch->input_hash != input_hash) {
+    /* The input changed but this frame wasn't read, frames read for the old input are unusable. */
+    cachefile_prefetch_stop(prefetch);
+    return;
+  }
+
+  if (prefetch->mesh_template == NULL) {
+    return;
+  }
+
+  if (prefetch->task_pool == NULL) {
+    prefetch->task_pool = BLI_task_pool_create_background_serial(prefetch, TASK_PRIORITY_LOW);
+  }
+
+  /* Queue the following frames, the slot of the current frame is reused for the last one. */
+  for (int i = 1; i <= prefetch->slots_num; i++) {
+    const int frame_next = frame + i;
+    const float time = BKE_cachefile_time_offset(prefetch->cache_file, (float)frame_next, fps);
+    CacheFilePrefetchSlot *slot = &prefetch->slots[mod_i(frame_next, prefetch->slots_num)];
+    Mesh *mesh_unused = NULL;
+
+    BLI_mutex_lock(&prefetch->mutex);
+    if ((slot->frame == frame_next) && (slot->time == time)) {
+      BLI_mutex_unlock(&prefetch->mutex);
+      continue;
+    }
+    mesh_unused = slot->mesh;
+    slot->mesh = NULL;
+    slot->frame = frame_next;
+    slot->time = time;
+    slot->is_ready = false;
+    slot->generation++;
+
+    CacheFilePrefetchTask *task = MEM_mallocN(sizeof(*task), __func__);
+    task->slot_index = (int)(slot - prefetch->slots);
+    task->generation = slot->generation;
+    task->time = time;
+    BLI_mutex_unlock(&prefetch->mutex);
+
+    if (mesh_unused != NULL) {
+      BKE_id_free(NULL, mesh_unused);
+    }
+
+    BLI_task_pool_push(prefetch->task_pool, cachefile_prefetch_task_run, task, true, NULL);
+  }
+#else
+  UNUSED_VARS(prefetch, input_hash, mesh_read, frame, fps);
+#endif
+}
+
+/** \} */
+
 static void cachefile_handle_free(CacheFile *cache_file)
 {
 #ifdef WITH_ALEMBIC
-  /* Free readers in all modifiers and constraints that use the handle, before
-   * we free the handle itself. */
+  /* Stop background reads of modifiers, and free readers in all modifiers and constraints
+   * that use the handle, before we free the handle itself. */
+  BLI_mutex_lock(&prefetch_release_mutex);
   BLI_spin_lock(&spin);
+  GSet *prefetches = cache_file->handle_prefetches;
+  cache_file->handle_prefetches = NULL;
   if (cache_file->handle_readers) {
     GSetIterator gs_iter;
     GSET_ITER (gs_iter, cache_file->handle_readers) {
@@ -233,6 +670,16 @@ static void cachefile_handle_free(CacheFile *cache_file)
   }
   BLI_spin_unlock(&spin);
 
+  if (prefetches) {
+    GSetIterator gs_iter;
+    GSET_ITER (gs_iter, prefetches) {
+      CacheFilePrefetch *prefetch = BLI_gsetIterator_getKey(&gs_iter);
+      cachefile_prefetch_release(prefetch);
+    }
+    BLI_gset_free(prefetches, NULL);
+  }
+  BLI_mutex_unlock(&prefetch_release_mutex);
+
   /* Free handle. */
   if (cache_file->handle) {
     ABC_free_handle(cache_file->handle);
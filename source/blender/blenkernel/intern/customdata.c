@@ -61,6 +61,8 @@
 
 #include "CLG_log.h"
 
+#include "atomic_ops.h"
+
 /* only for customdata_data_transfer_interp_normal_normals */
 #include "data_transfer_intern.h"
 
@@ -2138,6 +2140,95 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 }
 #endif
 
+/* Shared layer data, see CD_SHARE.
+ *
+ * All layers using the data, the source included, are flagged NOFREE, so code modifying them
+ * duplicates the data first, the same way as for referenced layers. Unlike with CD_REFERENCE,
+ * the data stays alive until the last layer using it is freed, so copies can outlive the source.
+ * Code writing to arrays in place without checking for referenced layers (sculpt and paint
+ * modes, RNA) has to call #CustomData_unshare_layer or #CustomData_unshare_layers before.
+ *
+ * Referencing a shared layer with CD_REFERENCE gives a plain reference, which does not keep the
+ * data alive. */
+
+typedef struct CustomDataSharing {
+  /** Number of layers using the data. */
+  int users;
+} CustomDataSharing;
+
+static bool customData_layer_can_share(const CustomDataLayer *layer)
+{
+  if (layer->data == NULL || (layer->flag & CD_FLAG_EXTERNAL)) {
+    return false;
+  }
+  /* Referenced data is owned by someone else, who does not know about the copy. */
+  if ((layer->flag & CD_FLAG_NOFREE) && layer->sharing == NULL) {
+    return false;
+  }
+  /* Elements owning allocations of their own (vertex groups, multires displacement, ...) would
+   * have those freed or reallocated by the source on modification. */
+  const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+  return typeInfo->free == NULL;
+}
+
+static void customData_layer_share(CustomDataLayer *source, CustomDataLayer *dest)
+{
+  if (source->sharing == NULL) {
+    source->sharing = MEM_mallocN(sizeof(CustomDataSharing), __func__);
+    source->sharing->users = 1;
+    source->flag |= CD_FLAG_NOFREE;
+  }
+  atomic_add_and_fetch_int32(&source->sharing->users, 1);
+  dest->sharing = source->sharing;
+}
+
+/* Stop using shared data, freeing it when this was the last user. */
+static void customData_layer_sharing_release(CustomDataLayer *layer)
+{
+  if (atomic_sub_and_fetch_int32(&layer->sharing->users, 1) == 0) {
+    MEM_freeN(layer->sharing);
+    if (layer->data) {
+      MEM_freeN(layer->data);
+    }
+  }
+  layer->sharing = NULL;
+  layer->data = NULL;
+}
+
+/* Give the layer its own copy of shared data, so it can be modified and freed freely. */
+static void customData_layer_unshare(CustomDataLayer *layer)
+{
+  if (layer->sharing == NULL) {
+    return;
+  }
+
+  /* Take the data over when this is its only user. Clearing the count in the same atomic step
+   * as checking it leaves no window in which another layer still releases or copies the data. */
+  if (atomic_cas_int32(&layer->sharing->users, 1, 0) == 1) {
+    MEM_freeN(layer->sharing);
+    layer->sharing = NULL;
+  }
+  else {
+    /* Shared layers have no custom copy and free callbacks, so a plain copy is enough. */
+    void *data = MEM_dupallocN(layer->data);
+    customData_layer_sharing_release(layer);
+    layer->data = data;
+  }
+
+  layer->flag &= ~CD_FLAG_NOFREE;
+}
+
+/* Replace the data of a layer for #CustomData_set_layer. The caller takes care of the previous
+ * data and the new one, unless the previous data was shared, then this layer's share in it is
+ * released. The layer stays flagged NOFREE then, like a reference to data owned by the caller. */
+static void customData_layer_set_data(CustomDataLayer *layer, void *ptr)
+{
+  if (layer->sharing) {
+    customData_layer_sharing_release(layer);
+  }
+  layer->data = ptr;
+}
+
 bool CustomData_merge(const struct CustomData *source,
                       struct CustomData *dest,
                       CustomDataMask mask,
@@ -2189,6 +2280,7 @@ bool CustomData_merge(const struct CustomData *source,
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
         data = layer->data;
         break;
       default:
@@ -2196,7 +2288,20 @@ bool CustomData_merge(const struct CustomData *source,
         break;
     }
 
-    if ((alloctype == CD_ASSIGN) && (flag & CD_FLAG_NOFREE)) {
+    if (alloctype == CD_SHARE) {
+      if (customData_layer_can_share(layer)) {
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_REFERENCE, data, totelem, layer->name);
+        if (newlayer) {
+          customData_layer_share(layer, newlayer);
+        }
+      }
+      else {
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_DUPLICATE, data, totelem, layer->name);
+      }
+    }
+    else if ((alloctype == CD_ASSIGN) && (flag & CD_FLAG_NOFREE)) {
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
@@ -2204,6 +2309,12 @@ bool CustomData_merge(const struct CustomData *source,
       newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
     }
 
+    if (newlayer && (alloctype == CD_ASSIGN)) {
+      /* Ownership of the data moves to the new layer, including its share in shared data. */
+      newlayer->sharing = layer->sharing;
+      layer->sharing = NULL;
+    }
+
     if (newlayer) {
       newlayer->uid = layer->uid;
 
@@ -2226,9 +2337,11 @@ void CustomData_realloc(CustomData *data, int totelem)
   for (int i = 0; i < data->totlayer; i++) {
     CustomDataLayer *layer = &data->layers[i];
     const LayerTypeInfo *typeInfo;
-    if (layer->flag & CD_FLAG_NOFREE) {
+    if ((layer->flag & CD_FLAG_NOFREE) && layer->sharing == NULL) {
       continue;
     }
+    /* Other layers sharing the data keep using it at its current size. */
+    customData_layer_unshare(layer);
     typeInfo = layerType_getInfo(layer->type);
     layer->data = MEM_reallocN(layer->data, (size_t)totelem * typeInfo->size);
   }
@@ -2253,6 +2366,11 @@ static void customData_free_layer__internal(CustomDataLayer *layer, int totelem)
 {
   const LayerTypeInfo *typeInfo;
 
+  if (layer->sharing) {
+    customData_layer_sharing_release(layer);
+    return;
+  }
+
   if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
     typeInfo = layerType_getInfo(layer->type);
 
@@ -2628,6 +2746,7 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
   data->layers[index].type = type;
   data->layers[index].flag = flag;
   data->layers[index].data = newlayerdata;
+  data->layers[index].sharing = NULL;
 
   /* Set default name if none exists. Note we only call DATA_()  once
    * we know there is a default name, to avoid overhead of locale lookups
@@ -2809,7 +2928,11 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
 
   CustomDataLayer *layer = &data->layers[layer_index];
 
-  if (layer->flag & CD_FLAG_NOFREE) {
+  if (layer->sharing) {
+    /* Only copies the data when another layer still uses it. */
+    customData_layer_unshare(layer);
+  }
+  else if (layer->flag & CD_FLAG_NOFREE) {
     /* MEM_dupallocN won't work in case of complex layers, like e.g.
      * CD_MDEFORMVERT, which has pointers to allocated data...
      * So in case a custom copy function is defined, use it!
@@ -2862,6 +2985,27 @@ void *CustomData_duplicate_referenced_layer_named(CustomData *data,
   return customData_duplicate_referenced_layer_index(data, layer_index, totelem);
 }
 
+void *CustomData_unshare_layer(CustomData *data, const int type, const int totelem)
+{
+  int layer_index = CustomData_get_active_layer_index(data, type);
+  if (layer_index == -1) {
+    return NULL;
+  }
+
+  CustomDataLayer *layer = &data->layers[layer_index];
+  if (layer->sharing) {
+    return customData_duplicate_referenced_layer_index(data, layer_index, totelem);
+  }
+  return layer->data;
+}
+
+void CustomData_unshare_layers(CustomData *data)
+{
+  for (int i = 0; i < data->totlayer; i++) {
+    customData_layer_unshare(&data->layers[i]);
+  }
+}
+
 bool CustomData_is_referenced_layer(struct CustomData *data, int type)
 {
   /* get the layer index of the first layer of type */
@@ -3287,7 +3431,7 @@ void *CustomData_set_layer(const CustomData *data, int type, void *ptr)
     return NULL;
   }
 
-  data->layers[layer_index].data = ptr;
+  customData_layer_set_data(&data->layers[layer_index], ptr);
 
   return ptr;
 }
@@ -3300,7 +3444,7 @@ void *CustomData_set_layer_n(const struct CustomData *data, int type, int n, voi
     return NULL;
   }
 
-  data->layers[layer_index].data = ptr;
+  customData_layer_set_data(&data->layers[layer_index], ptr);
 
   return ptr;
 }
@@ -3660,7 +3804,14 @@ void CustomData_bmesh_free_block_data(CustomData *data, void *block)
   }
 }
 
-static void CustomData_bmesh_alloc_block(CustomData *data, void **block)
+/**
+ * Allocate an uninitialized block from the layers memory pool,
+ * freeing the block that was previously there.
+ *
+ * \note The pool isn't thread-safe, callers filling blocks from multiple threads
+ * should allocate them up-front.
+ */
+void CustomData_bmesh_alloc_block(CustomData *data, void **block)
 {
   if (*block) {
     CustomData_bmesh_free_block(data, block);
@@ -4259,7 +4410,9 @@ void CustomData_blend_write_prepare(CustomData *data,
         }
         write_layers_size += chunk_size;
       }
-      write_layers[j++] = *layer;
+      write_layers[j] = *layer;
+      write_layers[j].sharing = NULL;
+      j++;
     }
   }
   BLI_assert(j == data->totlayer);
@@ -5182,6 +5335,7 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, int count)
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+    layer->sharing = NULL;
 
     if (CustomData_verify_versions(data, i)) {
       BLO_read_data_address(reader, &layer->data);
@@ -0,0 +1,157 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 by Blender Foundation.
+ */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BKE_customdata.h"
+
+#include "DNA_customdata_types.h"
+#include "DNA_meshdata_types.h"
+
+namespace blender::bke::tests {
+
+static const int NUM_VERTS = 16;
+
+static void customdata_init_verts(CustomData *data)
+{
+  CustomData_reset(data);
+  MVert *mvert = (MVert *)CustomData_add_layer(data, CD_MVERT, CD_CALLOC, NULL, NUM_VERTS);
+  for (int i = 0; i < NUM_VERTS; i++) {
+    mvert[i].co[0] = (float)i;
+  }
+}
+
+TEST(customdata_share, SharesData)
+{
+  CustomData source, copy;
+  customdata_init_verts(&source);
+  CustomData_copy(&source, &copy, CD_MASK_MVERT, CD_SHARE, NUM_VERTS);
+
+  EXPECT_EQ(CustomData_get_layer(&source, CD_MVERT), CustomData_get_layer(&copy, CD_MVERT));
+  EXPECT_TRUE(CustomData_is_referenced_layer(&copy, CD_MVERT));
+  EXPECT_TRUE(CustomData_is_referenced_layer(&source, CD_MVERT));
+
+  CustomData_free(&copy, NUM_VERTS);
+  CustomData_free(&source, NUM_VERTS);
+}
+
+TEST(customdata_share, CopyOutlivesSource)
+{
+  CustomData source, copy;
+  customdata_init_verts(&source);
+  CustomData_copy(&source, &copy, CD_MASK_MVERT, CD_SHARE, NUM_VERTS);
+  CustomData_free(&source, NUM_VERTS);
+
+  const MVert *mvert = (const MVert *)CustomData_get_layer(&copy, CD_MVERT);
+  EXPECT_EQ(mvert[NUM_VERTS - 1].co[0], (float)(NUM_VERTS - 1));
+
+  CustomData_free(&copy, NUM_VERTS);
+}
+
+TEST(customdata_share, DuplicateOnWrite)
+{
+  CustomData source, copy;
+  customdata_init_verts(&source);
+  CustomData_copy(&source, &copy, CD_MASK_MVERT, CD_SHARE, NUM_VERTS);
+
+  MVert *mvert = (MVert *)CustomData_duplicate_referenced_layer(&copy, CD_MVERT, NUM_VERTS);
+  EXPECT_NE(mvert, CustomData_get_layer(&source, CD_MVERT));
+  EXPECT_FALSE(CustomData_is_referenced_layer(&copy, CD_MVERT));
+
+  mvert[0].co[0] = -1.0f;
+  const MVert *source_mvert = (const MVert *)CustomData_get_layer(&source, CD_MVERT);
+  EXPECT_EQ(source_mvert[0].co[0], 0.0f);
+
+  CustomData_free(&source, NUM_VERTS);
+  CustomData_free(&copy, NUM_VERTS);
+}
+
+TEST(customdata_share, LastUserTakesOver)
+{
+  CustomData source, copy;
+  customdata_init_verts(&source);
+  CustomData_copy(&source, &copy, CD_MASK_MVERT, CD_SHARE, NUM_VERTS);
+  void *shared = CustomData_get_layer(&source, CD_MVERT);
+  CustomData_free(&source, NUM_VERTS);
+
+  /* No other user left, so no copy is needed. */
+  EXPECT_EQ(CustomData_duplicate_referenced_layer(&copy, CD_MVERT, NUM_VERTS), shared);
+  EXPECT_FALSE(CustomData_is_referenced_layer(&copy, CD_MVERT));
+
+  CustomData_free(&copy, NUM_VERTS);
+}
+
+TEST(customdata_share, ReferenceIsPlain)
+{
+  CustomData source, copy, reference;
+  customdata_init_verts(&source);
+  CustomData_copy(&source, &copy, CD_MASK_MVERT, CD_SHARE, NUM_VERTS);
+  CustomData_copy(&copy, &reference, CD_MASK_MVERT, CD_REFERENCE, NUM_VERTS);
+
+  /* Replacing the array of a reference leaves the shared data alone. */
+  MVert *mvert = (MVert *)MEM_dupallocN(CustomData_get_layer(&reference, CD_MVERT));
+  CustomData_set_layer(&reference, CD_MVERT, mvert);
+  CustomData_free(&reference, NUM_VERTS);
+  MEM_freeN(mvert);
+
+  EXPECT_EQ(CustomData_get_layer(&source, CD_MVERT), CustomData_get_layer(&copy, CD_MVERT));
+  const MVert *copy_mvert = (const MVert *)CustomData_get_layer(&copy, CD_MVERT);
+  EXPECT_EQ(copy_mvert[1].co[0], 1.0f);
+
+  CustomData_free(&source, NUM_VERTS);
+  CustomData_free(&copy, NUM_VERTS);
+}
+
+TEST(customdata_share, SetLayerReleasesShare)
+{
+  CustomData source, copy;
+  customdata_init_verts(&source);
+  CustomData_copy(&source, &copy, CD_MASK_MVERT, CD_SHARE, NUM_VERTS);
+
+  MVert *mvert = (MVert *)MEM_dupallocN(CustomData_get_layer(&copy, CD_MVERT));
+  CustomData_set_layer(&copy, CD_MVERT, mvert);
+  CustomData_free(&copy, NUM_VERTS);
+  MEM_freeN(mvert);
+
+  /* The source is the last user of its data again. */
+  const MVert *source_mvert = (const MVert *)CustomData_get_layer(&source, CD_MVERT);
+  EXPECT_EQ(CustomData_duplicate_referenced_layer(&source, CD_MVERT, NUM_VERTS), source_mvert);
+  EXPECT_EQ(source_mvert[1].co[0], 1.0f);
+
+  CustomData_free(&source, NUM_VERTS);
+}
+
+TEST(customdata_share, UnshareSource)
+{
+  CustomData source, copy;
+  customdata_init_verts(&source);
+  CustomData_copy(&source, &copy, CD_MASK_MVERT, CD_SHARE, NUM_VERTS);
+
+  CustomData_unshare_layers(&source);
+  MVert *mvert = (MVert *)CustomData_get_layer(&source, CD_MVERT);
+  EXPECT_NE(mvert, CustomData_get_layer(&copy, CD_MVERT));
+  mvert[1].co[0] = -1.0f;
+  const MVert *copy_mvert = (const MVert *)CustomData_get_layer(&copy, CD_MVERT);
+  EXPECT_EQ(copy_mvert[1].co[0], 1.0f);
+
+  CustomData_free(&source, NUM_VERTS);
+  CustomData_free(&copy, NUM_VERTS);
+}
+
+}  // namespace blender::bke::tests
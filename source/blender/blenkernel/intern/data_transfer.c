@@ -33,6 +33,7 @@
 #include "DNA_scene_types.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
 
@@ -1371,6 +1372,162 @@ void BKE_object_data_transfer_layout(struct Depsgraph *depsgraph,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Geometry Mappings Cache
+ *
+ * Computing the mappings between source and destination elements is by far the most expensive
+ * part of a transfer. When source and destination topologies did not change, and their vertices
+ * did not move further than a given tolerance, the mappings of a previous transfer can be used
+ * again (e.g. by the Data Transfer modifier, when only the weights or the mix factor changed,
+ * or when the meshes are only slightly deformed).
+ * \{ */
+
+typedef struct DataTransferRemapCacheMesh {
+  int totvert, totedge, totloop, totpoly;
+  uint32_t topology_hash;
+  /** Vertex positions the mappings were computed with. */
+  float (*vert_coords)[3];
+} DataTransferRemapCacheMesh;
+
+typedef struct DataTransferRemapCache {
+  /* Settings the mappings were computed with. */
+  int data_types;
+  int map_modes[4];
+  float max_distance;
+  float ray_radius;
+  float islands_handling_precision;
+  bool use_space_transform;
+  SpaceTransform space_transform;
+  bool use_split_nors_dst;
+  float split_angle_dst;
+
+  DataTransferRemapCacheMesh mesh_src;
+  DataTransferRemapCacheMesh mesh_dst;
+
+  /** Indexed by the VDATA, EDATA, LDATA and PDATA element types. */
+  MeshPairRemap geom_map[4];
+  bool geom_map_init[4];
+} DataTransferRemapCache;
+
+static uint32_t data_transfer_remap_cache_topology_hash(const Mesh *me)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+
+  for (int i = 0; i < me->totedge; i++) {
+    BLI_hash_mm2a_add_int(&mm2, (int)me->medge[i].v1);
+    BLI_hash_mm2a_add_int(&mm2, (int)me->medge[i].v2);
+  }
+  for (int i = 0; i < me->totpoly; i++) {
+    BLI_hash_mm2a_add_int(&mm2, me->mpoly[i].loopstart);
+    BLI_hash_mm2a_add_int(&mm2, me->mpoly[i].totloop);
+  }
+  BLI_hash_mm2a_add(&mm2, (const unsigned char *)me->mloop, sizeof(*me->mloop) * me->totloop);
+
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+static bool data_transfer_remap_cache_mesh_matches(const DataTransferRemapCacheMesh *cache_mesh,
+                                                   const Mesh *me,
+                                                   const float tolerance)
+{
+  if (cache_mesh->vert_coords == NULL || cache_mesh->totvert != me->totvert ||
+      cache_mesh->totedge != me->totedge || cache_mesh->totloop != me->totloop ||
+      cache_mesh->totpoly != me->totpoly) {
+    return false;
+  }
+
+  const float tolerance_sq = tolerance * tolerance;
+  for (int i = 0; i < me->totvert; i++) {
+    if (len_squared_v3v3(cache_mesh->vert_coords[i], me->mvert[i].co) > tolerance_sq) {
+      return false;
+    }
+  }
+
+  return cache_mesh->topology_hash == data_transfer_remap_cache_topology_hash(me);
+}
+
+static void data_transfer_remap_cache_mesh_store(DataTransferRemapCacheMesh *cache_mesh,
+                                                 const Mesh *me)
+{
+  MEM_SAFE_FREE(cache_mesh->vert_coords);
+
+  cache_mesh->totvert = me->totvert;
+  cache_mesh->totedge = me->totedge;
+  cache_mesh->totloop = me->totloop;
+  cache_mesh->totpoly = me->totpoly;
+  cache_mesh->topology_hash = data_transfer_remap_cache_topology_hash(me);
+  cache_mesh->vert_coords = BKE_mesh_vert_coords_alloc(me, NULL);
+}
+
+/**
+ * Clear the cached mappings if they were computed from different settings or geometry,
+ * and store the current ones as reference for next transfers.
+ */
+static void data_transfer_remap_cache_validate(DataTransferRemapCache *cache,
+                                               const Mesh *me_src,
+                                               const Mesh *me_dst,
+                                               const int data_types,
+                                               const int map_modes[4],
+                                               const SpaceTransform *space_transform,
+                                               const float max_distance,
+                                               const float ray_radius,
+                                               const float islands_handling_precision,
+                                               const float tolerance)
+{
+  const bool use_split_nors_dst = (me_dst->flag & ME_AUTOSMOOTH) != 0;
+
+  if (cache->data_types == data_types &&
+      memcmp(cache->map_modes, map_modes, sizeof(cache->map_modes)) == 0 &&
+      cache->max_distance == max_distance && cache->ray_radius == ray_radius &&
+      cache->islands_handling_precision == islands_handling_precision &&
+      cache->use_space_transform == (space_transform != NULL) &&
+      (space_transform == NULL ||
+       memcmp(&cache->space_transform, space_transform, sizeof(*space_transform)) == 0) &&
+      cache->use_split_nors_dst == use_split_nors_dst &&
+      cache->split_angle_dst == me_dst->smoothresh &&
+      data_transfer_remap_cache_mesh_matches(&cache->mesh_src, me_src, tolerance) &&
+      data_transfer_remap_cache_mesh_matches(&cache->mesh_dst, me_dst, tolerance)) {
+    return;
+  }
+
+  for (int i = 0; i < ARRAY_SIZE(cache->geom_map); i++) {
+    BKE_mesh_remap_free(&cache->geom_map[i]);
+    cache->geom_map_init[i] = false;
+  }
+
+  cache->data_types = data_types;
+  memcpy(cache->map_modes, map_modes, sizeof(cache->map_modes));
+  cache->max_distance = max_distance;
+  cache->ray_radius = ray_radius;
+  cache->islands_handling_precision = islands_handling_precision;
+  cache->use_space_transform = (space_transform != NULL);
+  if (space_transform) {
+    cache->space_transform = *space_transform;
+  }
+  cache->use_split_nors_dst = use_split_nors_dst;
+  cache->split_angle_dst = me_dst->smoothresh;
+
+  data_transfer_remap_cache_mesh_store(&cache->mesh_src, me_src);
+  data_transfer_remap_cache_mesh_store(&cache->mesh_dst, me_dst);
+}
+
+void BKE_object_data_transfer_remap_cache_free(DataTransferRemapCache *remap_cache)
+{
+  if (remap_cache == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < ARRAY_SIZE(remap_cache->geom_map); i++) {
+    BKE_mesh_remap_free(&remap_cache->geom_map[i]);
+  }
+  MEM_SAFE_FREE(remap_cache->mesh_src.vert_coords);
+  MEM_SAFE_FREE(remap_cache->mesh_dst.vert_coords);
+  MEM_freeN(remap_cache);
+}
+
+/** \} */
+
 bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  Scene *scene,
                                  Object *ob_src,
@@ -1393,6 +1550,8 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  const float mix_factor,
                                  const char *vgroup_name,
                                  const bool invert_vgroup,
+                                 const float remap_cache_tolerance,
+                                 DataTransferRemapCache **remap_cache,
                                  ReportList *reports)
 {
 #define VDATA 0
@@ -1411,8 +1570,10 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
   int vg_idx = -1;
   float *weights[DATAMAX] = {NULL};
 
-  MeshPairRemap geom_map[DATAMAX] = {{0}};
-  bool geom_map_init[DATAMAX] = {0};
+  MeshPairRemap geom_map_local[DATAMAX] = {{0}};
+  bool geom_map_init_local[DATAMAX] = {0};
+  MeshPairRemap *geom_map = geom_map_local;
+  bool *geom_map_init = geom_map_init_local;
   ListBase lay_map = {NULL};
   bool changed = false;
   bool is_modifier = false;
@@ -1471,6 +1632,26 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
         me_dst->mvert, me_dst->totvert, me_src, space_transform);
   }
 
+  if (remap_cache) {
+    const int map_modes[DATAMAX] = {map_vert_mode, map_edge_mode, map_loop_mode, map_poly_mode};
+
+    if (*remap_cache == NULL) {
+      *remap_cache = MEM_callocN(sizeof(**remap_cache), __func__);
+    }
+    data_transfer_remap_cache_validate(*remap_cache,
+                                       me_src,
+                                       me_dst,
+                                       data_types,
+                                       map_modes,
+                                       space_transform,
+                                       max_distance,
+                                       ray_radius,
+                                       islands_handling_precision,
+                                       remap_cache_tolerance);
+    geom_map = (*remap_cache)->geom_map;
+    geom_map_init = (*remap_cache)->geom_map_init;
+  }
+
   /* Check all possible data types.
    * Note item mappings and dest mix weights are cached. */
   for (int i = 0; i < DT_TYPE_MAX; i++) {
@@ -1846,7 +2027,7 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
   }
 
   for (int i = 0; i < DATAMAX; i++) {
-    BKE_mesh_remap_free(&geom_map[i]);
+    BKE_mesh_remap_free(&geom_map_local[i]);
     MEM_SAFE_FREE(weights[i]);
   }
 
@@ -1904,5 +2085,7 @@ bool BKE_object_data_transfer_mesh(struct Depsgraph *depsgraph,
                                      mix_factor,
                                      vgroup_name,
                                      invert_vgroup,
+                                     0.0f,
+                                     NULL,
                                      reports);
 }
@@ -1608,9 +1608,28 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
-static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, float evaltime)
+/* Check whether 'evaltime' lies strictly inside of the segment which ends with keyframe 'a', so
+ * that the binary search below would give 'a' as well. */
+static bool fcurve_bezt_segment_contains(const FCurve *fcu,
+                                         const BezTriple *bezts,
+                                         const int a,
+                                         const float evaltime,
+                                         const float threshold)
+{
+  if (a <= 0 || a >= fcu->totvert) {
+    return false;
+  }
+  return (evaltime - bezts[a - 1].vec[1][0] > threshold) &&
+         (bezts[a].vec[1][0] - evaltime > threshold);
+}
+
+static float fcurve_eval_keyframes_interpolate(FCurve *fcu,
+                                               BezTriple *bezts,
+                                               float evaltime,
+                                               int *segment_hint)
 {
   const float eps = 1.e-8f;
+  const float threshold = 0.0001f;
   BezTriple *bezt, *prevbezt;
   unsigned int a;
 
@@ -1627,7 +1646,22 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
    *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  if (segment_hint != NULL &&
+      fcurve_bezt_segment_contains(fcu, bezts, *segment_hint, evaltime, threshold)) {
+    /* Same segment as the previous evaluation, which is the common case during playback. */
+    a = *segment_hint;
+  }
+  else if (segment_hint != NULL &&
+           fcurve_bezt_segment_contains(fcu, bezts, *segment_hint + 1, evaltime, threshold)) {
+    a = *segment_hint + 1;
+    *segment_hint = a;
+  }
+  else {
+    a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, threshold, &exact);
+    if (segment_hint != NULL) {
+      *segment_hint = a;
+    }
+  }
   bezt = bezts + a;
 
   if (exact) {
@@ -1869,8 +1903,12 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
   return 0.0f;
 }
 
-/* Calculate F-Curve value for 'evaltime' using BezTriple keyframes */
-static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime)
+/* Calculate F-Curve value for 'evaltime' using BezTriple keyframes.
+ * The optional 'segment_hint' is the keyframe index found by the previous evaluation. */
+static float fcurve_eval_keyframes(FCurve *fcu,
+                                   BezTriple *bezts,
+                                   float evaltime,
+                                   int *segment_hint)
 {
   if (evaltime <= bezts->vec[1][0]) {
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, 0, +1);
@@ -1881,7 +1919,7 @@ static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, fcu->totvert - 1, -1);
   }
 
-  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime);
+  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime, segment_hint);
 }
 
 /* Calculate F-Curve value for 'evaltime' using FPoint samples */
@@ -1931,7 +1969,7 @@ static float fcurve_eval_samples(FCurve *fcu, FPoint *fpts, float evaltime)
 /* Evaluate and return the value of the given F-Curve at the specified frame ("evaltime")
  * Note: this is also used for drivers
  */
-static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
+static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue, int *segment_hint)
 {
   float devaltime;
 
@@ -1948,7 +1986,7 @@ static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
    *   F-Curve modifier on the stack requested the curve to be evaluated at
    */
   if (fcu->bezt) {
-    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime);
+    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime, segment_hint);
   }
   else if (fcu->fpt) {
     cvalue = fcurve_eval_samples(fcu, fcu->fpt, devaltime);
@@ -1972,7 +2010,17 @@ float evaluate_fcurve(FCurve *fcu, float evaltime)
 {
   BLI_assert(fcu->driver == NULL);
 
-  return evaluate_fcurve_ex(fcu, evaltime, 0.0);
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, NULL);
+}
+
+/* Same as evaluate_fcurve(), but re-uses the keyframe segment found by the previous evaluation
+ * when it still contains 'evaltime'. The hint is to be initialized to 0 by the caller, and is
+ * owned by the caller so that F-Curves themselves are not written to during evaluation. */
+float evaluate_fcurve_with_hint(FCurve *fcu, float evaltime, int *segment_hint)
+{
+  BLI_assert(fcu->driver == NULL);
+
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, segment_hint);
 }
 
 float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime)
@@ -1980,7 +2028,7 @@ float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime)
   /* Can be used to evaluate the (keyframed) fcurve only.
    * Also works for driver-fcurves when the driver itself is not relevant.
    * E.g. when inserting a keyframe in a driver fcurve. */
-  return evaluate_fcurve_ex(fcu, evaltime, 0.0);
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, NULL);
 }
 
 float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
@@ -2028,7 +2076,7 @@ float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
     }
   }
 
-  return evaluate_fcurve_ex(fcu, evaltime, cvalue);
+  return evaluate_fcurve_ex(fcu, evaltime, cvalue, NULL);
 }
 
 /* Checks if the curve has valid keys, drivers or modifiers that produce an actual curve. */
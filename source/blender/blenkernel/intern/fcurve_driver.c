@@ -1088,6 +1088,17 @@ bool BKE_driver_has_simple_expression(ChannelDriver *driver)
   return driver_compile_simple_expr(driver) && BLI_expr_pylike_is_valid(driver->expr_simple);
 }
 
+/* Explain why a Python driver expression can't use the simple expression evaluator.
+ * Returns NULL for simple expressions and drivers that don't use an expression. */
+const char *BKE_driver_simple_expression_error(ChannelDriver *driver)
+{
+  if (!driver_compile_simple_expr(driver)) {
+    return NULL;
+  }
+
+  return BLI_expr_pylike_parse_error(driver->expr_simple);
+}
+
 /* TODO(sergey): This is somewhat weak, but we don't want neither false-positive
  * time dependencies nor special exceptions in the depsgraph evaluation. */
 static bool python_driver_exression_depends_on_time(const char *expression)
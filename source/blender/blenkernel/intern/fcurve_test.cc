@@ -210,6 +210,36 @@ TEST(evaluate_fcurve, ExtrapolationBezierKeys)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 0; i < 10; i++) {
+    insert_vert_fcurve(fcu, i * 2.0f, i * i, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  }
+
+  /* Hinted evaluation gives the same result as the plain binary search, whether playing forward,
+   * jumping backward, or landing on keys. */
+  const float frames[] = {0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f, 17.5f, 3.5f, 11.0f, 10.0f, 0.0f};
+  int segment_hint = 0;
+  for (const float frame : frames) {
+    const float value = evaluate_fcurve_with_hint(fcu, frame, &segment_hint);
+    EXPECT_NEAR(value, evaluate_fcurve(fcu, frame), EPSILON);
+  }
+
+  /* The hint of the last evaluated segment. */
+  evaluate_fcurve_with_hint(fcu, 5.0f, &segment_hint);
+  EXPECT_EQ(segment_hint, 3);
+
+  /* An out of range hint is ignored. */
+  segment_hint = 47;
+  EXPECT_NEAR(
+      evaluate_fcurve_with_hint(fcu, 7.0f, &segment_hint), evaluate_fcurve(fcu, 7.0f), EPSILON);
+  EXPECT_EQ(segment_hint, 4);
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(fcurve_subdivide, BKE_bezt_subdivide_handles)
 {
   FCurve *fcu = BKE_fcurve_create();
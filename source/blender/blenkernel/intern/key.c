@@ -31,6 +31,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -896,6 +897,147 @@ static void cp_cu_key(Curve *cu,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Relative Coordinate Keys
+ *
+ * Mesh and lattice keys only store coordinates, so the output can be split in chunks
+ * of elements that are blended independently. Each task accumulates all keys into its
+ * own chunk, which stays in cache while the (often hundreds of) keys are added.
+ * \{ */
+
+#define KEY_RELATIVE_CHUNK_SIZE 1024
+
+typedef struct KeyRelativeBlend {
+  const float (*from)[3];
+  const float (*reffrom)[3];
+  const float *weights;
+  float influence;
+} KeyRelativeBlend;
+
+typedef struct KeyRelativeData {
+  float (*out)[3];
+  const float (*basis)[3];
+  const KeyRelativeBlend *blends;
+  int blends_len;
+  int tot;
+} KeyRelativeData;
+
+static void key_evaluate_relative_coords_chunk(void *__restrict userdata,
+                                               const int chunk,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KeyRelativeData *data = userdata;
+  const int chunk_start = chunk * KEY_RELATIVE_CHUNK_SIZE;
+  const int chunk_end = min_ii(chunk_start + KEY_RELATIVE_CHUNK_SIZE, data->tot);
+  float(*out)[3] = data->out;
+
+  memcpy(out[chunk_start],
+         data->basis[chunk_start],
+         sizeof(*out) * (size_t)(chunk_end - chunk_start));
+
+  /* Keys are added in the same order as #key_evaluate_relative does, so the result is
+   * identical to blending the whole array one key at a time. */
+  for (int b = 0; b < data->blends_len; b++) {
+    const KeyRelativeBlend *blend = &data->blends[b];
+    const float(*from)[3] = blend->from;
+    const float(*reffrom)[3] = blend->reffrom;
+    const float influence = blend->influence;
+
+    if (blend->weights) {
+      const float *weights = blend->weights;
+      for (int i = chunk_start; i < chunk_end; i++) {
+        const float weight = weights[i] * influence;
+        if (weight != 0.0f) {
+          out[i][0] -= weight * (reffrom[i][0] - from[i][0]);
+          out[i][1] -= weight * (reffrom[i][1] - from[i][1]);
+          out[i][2] -= weight * (reffrom[i][2] - from[i][2]);
+        }
+      }
+    }
+    else {
+      for (int i = chunk_start; i < chunk_end; i++) {
+        out[i][0] -= influence * (reffrom[i][0] - from[i][0]);
+        out[i][1] -= influence * (reffrom[i][1] - from[i][1]);
+        out[i][2] -= influence * (reffrom[i][2] - from[i][2]);
+      }
+    }
+  }
+}
+
+/**
+ * Blend relative keys of meshes and lattices in parallel over ranges of elements.
+ * Keys without influence are skipped up front.
+ *
+ * \return false when the key layout isn't supported, the caller then uses
+ * the generic code-path.
+ */
+static bool key_evaluate_relative_coords(const int tot,
+                                         char *basispoin,
+                                         Key *key,
+                                         KeyBlock *actkb,
+                                         float **per_keyblock_weights)
+{
+  if (key->refkey == NULL || key->refkey->totelem != tot ||
+      key->elemsize != sizeof(float[KEYELEM_FLOAT_LEN_COORD])) {
+    return false;
+  }
+
+  KeyRelativeBlend *blends = MEM_malloc_arrayN((size_t)key->totkey, sizeof(*blends), __func__);
+  char **freedata = MEM_calloc_arrayN((size_t)key->totkey + 1, sizeof(*freedata), __func__);
+  int blends_len = 0;
+  int keyblock_index;
+  KeyBlock *kb;
+
+  for (kb = key->block.first, keyblock_index = 0; kb; kb = kb->next, keyblock_index++) {
+    /* only with value, and no difference allowed */
+    if (kb == key->refkey || (kb->flag & KEYBLOCK_MUTE) || kb->curval == 0.0f ||
+        kb->totelem != tot) {
+      continue;
+    }
+
+    /* reference now can be any block */
+    KeyBlock *refb = BLI_findlink(&key->block, kb->relative);
+    if (refb == NULL || refb->totelem != tot) {
+      continue;
+    }
+
+    KeyRelativeBlend *blend = &blends[blends_len++];
+    blend->from = (const float(*)[3])key_block_get_data(key, actkb, kb, &freedata[blends_len]);
+    /* For meshes, use the original values instead of the bmesh values to
+     * maintain a constant offset. */
+    blend->reffrom = refb->data;
+    blend->weights = per_keyblock_weights ? per_keyblock_weights[keyblock_index] : NULL;
+    blend->influence = kb->curval;
+  }
+
+  KeyRelativeData data = {
+      .out = (float(*)[3])basispoin,
+      .basis = (const float(*)[3])key_block_get_data(key, actkb, key->refkey, &freedata[0]),
+      .blends = blends,
+      .blends_len = blends_len,
+      .tot = tot,
+  };
+
+  const int chunks_len = divide_ceil_u((uint)tot, KEY_RELATIVE_CHUNK_SIZE);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (chunks_len > 1 && blends_len > 0);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, chunks_len, &data, key_evaluate_relative_coords_chunk, &settings);
+
+  for (int i = 0; i <= blends_len; i++) {
+    if (freedata[i]) {
+      MEM_freeN(freedata[i]);
+    }
+  }
+  MEM_freeN(freedata);
+  MEM_freeN(blends);
+
+  return true;
+}
+
+/** \} */
+
 static void key_evaluate_relative(const int start,
                                   int end,
                                   const int tot,
@@ -921,6 +1063,12 @@ static void key_evaluate_relative(const int start,
     end = tot;
   }
 
+  /* Meshes and lattices always blend all elements at once. */
+  if (mode == KEY_MODE_DUMMY && start == 0 && end == tot &&
+      key_evaluate_relative_coords(tot, basispoin, key, actkb, per_keyblock_weights)) {
+    return;
+  }
+
   /* in case of beztriple */
   elemstr[0] = 1; /* nr of ipofloats */
   elemstr[1] = IPO_BEZTRIPLE;
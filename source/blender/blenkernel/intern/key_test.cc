@@ -0,0 +1,205 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation
+ * All rights reserved.
+ */
+#include "testing/testing.h"
+
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+
+#include "BKE_key.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math_vector.h"
+#include "BLI_string.h"
+#include "BLI_timeit.hh"
+
+#include "DNA_ipo_types.h"
+#include "DNA_key_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+namespace blender::bke::tests {
+
+/** Mesh object with relative shape keys, the basis has vertex `i` at `(i, 0, 0)`. */
+class KeyTestObject {
+ public:
+  Object ob;
+  Mesh mesh;
+  Key key;
+
+  KeyTestObject(const int verts_len)
+  {
+    memset(&ob, 0, sizeof(ob));
+    memset(&mesh, 0, sizeof(mesh));
+    memset(&key, 0, sizeof(key));
+
+    STRNCPY(mesh.id.name, "MEKey");
+    mesh.totvert = verts_len;
+    mesh.key = &key;
+
+    ob.type = OB_MESH;
+    ob.data = &mesh;
+    ob.shapenr = 1;
+
+    STRNCPY(key.id.name, "KEKey");
+    key.from = &mesh.id;
+    key.type = KEY_RELATIVE;
+    key.elemsize = sizeof(float[KEYELEM_FLOAT_LEN_COORD]);
+    key.elemstr[0] = KEYELEM_FLOAT_LEN_COORD;
+    key.elemstr[1] = IPO_FLOAT;
+
+    key.refkey = add_keyblock(0.0f);
+    float(*basis_co)[3] = (float(*)[3])key.refkey->data;
+    for (int i = 0; i < verts_len; i++) {
+      copy_v3_fl3(basis_co[i], (float)i, 0.0f, 0.0f);
+    }
+  }
+
+  ~KeyTestObject()
+  {
+    LISTBASE_FOREACH_MUTABLE (KeyBlock *, kb, &key.block) {
+      MEM_freeN(kb->data);
+      MEM_freeN(kb);
+    }
+  }
+
+  /** Add a key relative to the basis, starting out as a copy of it. */
+  KeyBlock *add_keyblock(const float curval)
+  {
+    KeyBlock *kb = (KeyBlock *)MEM_callocN(sizeof(KeyBlock), __func__);
+    kb->data = MEM_malloc_arrayN(mesh.totvert, sizeof(float[3]), __func__);
+    if (key.refkey) {
+      memcpy(kb->data, key.refkey->data, sizeof(float[3]) * mesh.totvert);
+    }
+    kb->totelem = mesh.totvert;
+    kb->curval = curval;
+    BLI_addtail(&key.block, kb);
+    key.totkey++;
+    return kb;
+  }
+
+  float (*evaluate())[3]
+  {
+    int totelem = 0;
+    float(*co)[3] = (float(*)[3])BKE_key_evaluate_object(&ob, &totelem);
+    EXPECT_EQ(totelem, mesh.totvert);
+    return co;
+  }
+};
+
+static float *key_co(KeyBlock *kb, const int index)
+{
+  return ((float(*)[3])kb->data)[index];
+}
+
+TEST(key_evaluate_object, ChunkBoundaries)
+{
+  /* Three chunks of the parallel blending, the last one partial. */
+  const int verts_len = 2 * 1024 + 3;
+  KeyTestObject test(verts_len);
+
+  KeyBlock *kb_offset = test.add_keyblock(1.0f);
+  for (int i = 0; i < verts_len; i++) {
+    key_co(kb_offset, i)[0] += 1.0f;
+  }
+  KeyBlock *kb_lift = test.add_keyblock(0.5f);
+  key_co(kb_lift, 1023)[2] = 1.0f;
+  key_co(kb_lift, 1024)[2] = 1.0f;
+  key_co(kb_lift, verts_len - 1)[2] = 1.0f;
+
+  float(*co)[3] = test.evaluate();
+  for (const int i : {0, 1022, 1023, 1024, 2047, 2048, verts_len - 1}) {
+    const bool lifted = ELEM(i, 1023, 1024, verts_len - 1);
+    EXPECT_FLOAT_EQ(co[i][0], (float)(i + 1));
+    EXPECT_FLOAT_EQ(co[i][1], 0.0f);
+    EXPECT_FLOAT_EQ(co[i][2], lifted ? 0.5f : 0.0f);
+  }
+  MEM_freeN(co);
+}
+
+TEST(key_evaluate_object, SkipsKeysWithoutInfluence)
+{
+  KeyTestObject test(4);
+
+  KeyBlock *kb_muted = test.add_keyblock(1.0f);
+  kb_muted->flag |= KEYBLOCK_MUTE;
+  KeyBlock *kb_zero = test.add_keyblock(0.0f);
+  KeyBlock *kb_active = test.add_keyblock(1.0f);
+  for (int i = 0; i < 4; i++) {
+    key_co(kb_muted, i)[2] = 1.0f;
+    key_co(kb_zero, i)[2] = 1.0f;
+    key_co(kb_active, i)[1] = 2.0f;
+  }
+
+  float(*co)[3] = test.evaluate();
+  for (int i = 0; i < 4; i++) {
+    EXPECT_FLOAT_EQ(co[i][0], (float)i);
+    EXPECT_FLOAT_EQ(co[i][1], 2.0f);
+    EXPECT_FLOAT_EQ(co[i][2], 0.0f);
+  }
+  MEM_freeN(co);
+}
+
+TEST(key_evaluate_object, RelativeToOtherKey)
+{
+  KeyTestObject test(4);
+
+  KeyBlock *kb_base = test.add_keyblock(0.0f);
+  KeyBlock *kb_relative = test.add_keyblock(0.5f);
+  kb_relative->relative = 1;
+  for (int i = 0; i < 4; i++) {
+    key_co(kb_base, i)[2] = 1.0f;
+    key_co(kb_relative, i)[2] = 3.0f;
+  }
+
+  /* Only the difference to the other key is applied. */
+  float(*co)[3] = test.evaluate();
+  for (int i = 0; i < 4; i++) {
+    EXPECT_FLOAT_EQ(co[i][0], (float)i);
+    EXPECT_FLOAT_EQ(co[i][2], 1.0f);
+  }
+  MEM_freeN(co);
+}
+
+#if 0
+TEST(key_evaluate_object, Benchmark)
+{
+  /* Keys of a facial rig mostly move a small part of the mesh each. */
+  const int verts_len = 256 * 256;
+  KeyTestObject test(verts_len);
+  for (int k = 0; k < 250; k++) {
+    KeyBlock *kb = test.add_keyblock((k % 3 == 0) ? 0.0f : 0.5f);
+    for (int i = (k * 997) % (verts_len - 512), n = 0; n < 512; i++, n++) {
+      key_co(kb, i)[2] += 1.0f;
+    }
+  }
+
+  float(*co)[3] = (float(*)[3])MEM_malloc_arrayN(verts_len, sizeof(float[3]), __func__);
+  {
+    SCOPED_TIMER("BKE_key_evaluate_object, 65536 vertices, 250 keys, 10 evaluations");
+    for (int i = 0; i < 10; i++) {
+      BKE_key_evaluate_object_ex(&test.ob, nullptr, (float *)co, sizeof(float[3]) * verts_len);
+    }
+  }
+  MEM_freeN(co);
+}
+#endif /* Benchmark */
+
+}  // namespace blender::bke::tests
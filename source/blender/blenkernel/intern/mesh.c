@@ -125,7 +125,9 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
 
   mesh_dst->mat = MEM_dupallocN(mesh_src->mat);
 
-  const eCDAllocType alloc_type = (flag & LIB_ID_COPY_CD_REFERENCE) ? CD_REFERENCE : CD_DUPLICATE;
+  const eCDAllocType alloc_type = (flag & LIB_ID_COPY_CD_REFERENCE) ?
+                                      CD_REFERENCE :
+                                      (flag & LIB_ID_COPY_CD_SHARE) ? CD_SHARE : CD_DUPLICATE;
   CustomData_copy(&mesh_src->vdata, &mesh_dst->vdata, mask.vmask, alloc_type, mesh_dst->totvert);
   CustomData_copy(&mesh_src->edata, &mesh_dst->edata, mask.emask, alloc_type, mesh_dst->totedge);
   CustomData_copy(&mesh_src->ldata, &mesh_dst->ldata, mask.lmask, alloc_type, mesh_dst->totloop);
@@ -793,6 +795,19 @@ void BKE_mesh_update_customdata_pointers(Mesh *me, const bool do_ensure_tess_cd)
   me->mloopuv = CustomData_get_layer(&me->ldata, CD_MLOOPUV);
 }
 
+/**
+ * Give the mesh its own copy of all layers shared with other meshes (see #CD_SHARE), for code
+ * writing to the arrays in place.
+ */
+void BKE_mesh_unshare_layers(Mesh *me)
+{
+  CustomData_unshare_layers(&me->vdata);
+  CustomData_unshare_layers(&me->edata);
+  CustomData_unshare_layers(&me->ldata);
+  CustomData_unshare_layers(&me->pdata);
+  BKE_mesh_update_customdata_pointers(me, false);
+}
+
 bool BKE_mesh_has_custom_loop_normals(Mesh *me)
 {
   if (me->edit_mesh) {
@@ -1533,6 +1548,8 @@ void BKE_mesh_transform(Mesh *me, const float mat[4][4], bool do_keys)
     }
   }
 
+  BKE_mesh_runtime_clear_normals(me);
+
   /* don't update normals, caller can do this explicitly.
    * We do update loop normals though, those may not be auto-generated
    * (see e.g. STL import script)! */
@@ -1551,6 +1568,7 @@ void BKE_mesh_translate(Mesh *me, const float offset[3], const bool do_keys)
 {
   int i = me->totvert;
   MVert *mvert;
+  me->mvert = CustomData_unshare_layer(&me->vdata, CD_MVERT, me->totvert);
   for (mvert = me->mvert; i--; mvert++) {
     add_v3_v3(mvert->co, offset);
   }
@@ -1761,6 +1779,35 @@ void BKE_mesh_count_selected_items(const Mesh *mesh, int r_count[3])
   /* We could support faces in paint modes. */
 }
 
+static size_t mesh_customdata_memory_size(const CustomData *data, const int totelem)
+{
+  size_t size = 0;
+  for (int i = 0; i < data->totlayer; i++) {
+    const CustomDataLayer *layer = &data->layers[i];
+    /* Layers referenced from another mesh are not owned by this one. */
+    if (layer->data && !(layer->flag & CD_FLAG_NOFREE)) {
+      size += (size_t)CustomData_sizeof(layer->type) * (size_t)totelem;
+    }
+  }
+  return size;
+}
+
+/**
+ * Memory owned by the data layers of the mesh, in bytes.
+ */
+size_t BKE_mesh_memory_size(const Mesh *mesh)
+{
+  if (mesh->runtime.wrapper_type == ME_WRAPPER_TYPE_BMESH) {
+    /* The edit-mesh is owned by the original mesh. */
+    return 0;
+  }
+  return mesh_customdata_memory_size(&mesh->vdata, mesh->totvert) +
+         mesh_customdata_memory_size(&mesh->edata, mesh->totedge) +
+         mesh_customdata_memory_size(&mesh->fdata, mesh->totface) +
+         mesh_customdata_memory_size(&mesh->ldata, mesh->totloop) +
+         mesh_customdata_memory_size(&mesh->pdata, mesh->totpoly);
+}
+
 void BKE_mesh_vert_coords_get(const Mesh *mesh, float (*vert_coords)[3])
 {
   const MVert *mv = mesh->mvert;
@@ -1788,6 +1835,7 @@ void BKE_mesh_vert_coords_apply(Mesh *mesh, const float (*vert_coords)[3])
     copy_v3_v3(mv->co, vert_coords[i]);
   }
   mesh->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
+  BKE_mesh_runtime_clear_normals(mesh);
 }
 
 void BKE_mesh_vert_coords_apply_with_mat4(Mesh *mesh,
@@ -1801,6 +1849,7 @@ void BKE_mesh_vert_coords_apply_with_mat4(Mesh *mesh,
     mul_v3_m4v3(mv->co, mat, vert_coords[i]);
   }
   mesh->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
+  BKE_mesh_runtime_clear_normals(mesh);
 }
 
 void BKE_mesh_vert_normals_apply(Mesh *mesh, const short (*vert_normals)[3])
@@ -2166,6 +2215,7 @@ void BKE_mesh_eval_geometry(Depsgraph *depsgraph, Mesh *mesh)
 {
   DEG_debug_print_eval(depsgraph, __func__, mesh->id.name, mesh);
   BKE_mesh_texspace_calc(mesh);
+  BKE_mesh_runtime_geometry_stamp_update(mesh);
   /* We are here because something did change in the mesh. This means we can not trust the existing
    * evaluated mesh, and we don't know what parts of the mesh did change. So we simply delete the
    * evaluated mesh and let objects to re-create it with updated settings. */
@@ -49,6 +49,7 @@
 #include "BKE_editmesh_cache.h"
 #include "BKE_global.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_runtime.h"
 #include "BKE_multires.h"
 #include "BKE_report.h"
 
@@ -412,6 +413,12 @@ void BKE_mesh_ensure_normals_for_display(Mesh *mesh)
   const bool do_poly_normals = (mesh->runtime.cd_dirty_poly & CD_MASK_NORMAL || poly_nors == NULL);
 
   if (do_vert_normals || do_poly_normals) {
+    /* Normals are written in place, which must not reach the meshes the arrays are referenced
+     * or shared from. */
+    poly_nors = CustomData_duplicate_referenced_layer(&mesh->pdata, CD_NORMAL, mesh->totpoly);
+    if (do_vert_normals) {
+      mesh->mvert = CustomData_duplicate_referenced_layer(&mesh->vdata, CD_MVERT, mesh->totvert);
+    }
     const bool do_add_poly_nors_cddata = (poly_nors == NULL);
     if (do_add_poly_nors_cddata) {
       poly_nors = MEM_malloc_arrayN((size_t)mesh->totpoly, sizeof(*poly_nors), __func__);
@@ -444,6 +451,7 @@ void BKE_mesh_calc_normals(Mesh *mesh)
 #ifdef DEBUG_TIME
   TIMEIT_START_AVERAGED(BKE_mesh_calc_normals);
 #endif
+  mesh->mvert = CustomData_duplicate_referenced_layer(&mesh->vdata, CD_MVERT, mesh->totvert);
   BKE_mesh_calc_normals_poly(mesh->mvert,
                              NULL,
                              mesh->totvert,
@@ -2053,6 +2061,7 @@ static void mesh_set_custom_normals(Mesh *mesh, float (*r_custom_nors)[3], const
   else {
     clnors = CustomData_add_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL, CD_CALLOC, NULL, numloops);
   }
+  BKE_mesh_runtime_clear_normals(mesh);
 
   float(*polynors)[3] = CustomData_get_layer(&mesh->pdata, CD_NORMAL);
   bool free_polynors = false;
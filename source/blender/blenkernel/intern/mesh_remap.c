@@ -36,6 +36,8 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_bvhutils.h"
@@ -367,24 +369,35 @@ void BKE_mesh_remap_free(MeshPairRemap *map)
   map->mem = NULL;
 }
 
-static void mesh_remap_item_define(MeshPairRemap *map,
-                                   const int index,
-                                   const float UNUSED(hit_dist),
-                                   const int island,
-                                   const int sources_num,
-                                   const int *indices_src,
-                                   const float *weights_src)
+/**
+ * \param lock: When not NULL, serializes allocations from the map's memory arena,
+ * so that items can be defined from parallel tasks.
+ */
+static void mesh_remap_item_define_ex(MeshPairRemap *map,
+                                      SpinLock *lock,
+                                      const int index,
+                                      const float UNUSED(hit_dist),
+                                      const int island,
+                                      const int sources_num,
+                                      const int *indices_src,
+                                      const float *weights_src)
 {
   MeshPairRemapItem *mapit = &map->items[index];
   MemArena *mem = map->mem;
 
   if (sources_num) {
+    if (lock) {
+      BLI_spin_lock(lock);
+    }
     mapit->sources_num = sources_num;
     mapit->indices_src = BLI_memarena_alloc(mem,
                                             sizeof(*mapit->indices_src) * (size_t)sources_num);
-    memcpy(mapit->indices_src, indices_src, sizeof(*mapit->indices_src) * (size_t)sources_num);
     mapit->weights_src = BLI_memarena_alloc(mem,
                                             sizeof(*mapit->weights_src) * (size_t)sources_num);
+    if (lock) {
+      BLI_spin_unlock(lock);
+    }
+    memcpy(mapit->indices_src, indices_src, sizeof(*mapit->indices_src) * (size_t)sources_num);
     memcpy(mapit->weights_src, weights_src, sizeof(*mapit->weights_src) * (size_t)sources_num);
   }
   else {
@@ -397,6 +410,18 @@ static void mesh_remap_item_define(MeshPairRemap *map,
   mapit->island = island;
 }
 
+static void mesh_remap_item_define(MeshPairRemap *map,
+                                   const int index,
+                                   const float hit_dist,
+                                   const int island,
+                                   const int sources_num,
+                                   const int *indices_src,
+                                   const float *weights_src)
+{
+  mesh_remap_item_define_ex(
+      map, NULL, index, hit_dist, island, sources_num, indices_src, weights_src);
+}
+
 void BKE_mesh_remap_item_define_invalid(MeshPairRemap *map, const int index)
 {
   mesh_remap_item_define(map, index, FLT_MAX, 0, 0, NULL, NULL);
@@ -491,6 +516,221 @@ typedef struct IslandResult {
 /* Will be enough in 99% of cases. */
 #define MREMAP_DEFAULT_BUFSIZE 32
 
+/* BVH queries are expensive enough to split destination elements in small chunks. */
+#define MREMAP_TASK_MIN_ITER 64
+
+/** Thread-local data of the parallel mapping tasks, lazily allocated. */
+typedef struct MeshRemapTLS {
+  BVHTreeNearest nearest;
+  BVHTreeRayHit rayhit;
+
+  size_t buff_size;
+  float (*vcos)[3];
+  int *indices;
+  float *weights;
+
+  /* Only used when mapping loops. */
+  int islands_res_num;
+  size_t islands_res_buff_size;
+  IslandResult **islands_res;
+  BLI_AStarSolution as_solution;
+} MeshRemapTLS;
+
+/** Data shared by the parallel tasks mapping vertices or polygons. */
+typedef struct MeshRemapTaskData {
+  int mode;
+  const SpaceTransform *space_transform;
+  float max_dist;
+  float max_dist_sq;
+  float ray_radius;
+
+  const MVert *verts_dst;
+  const MLoop *loops_dst;
+  const MPoly *polys_dst;
+  const float (*poly_nors_dst)[3];
+
+  BVHTreeFromMesh *treedata;
+  const MEdge *edges_src;
+  MLoop *loops_src;
+  MPoly *polys_src;
+  const float (*vcos_src)[3];
+
+  MeshPairRemap *r_map;
+  SpinLock *lock;
+} MeshRemapTaskData;
+
+static void mesh_remap_tls_init(MeshRemapTLS *tls_data)
+{
+  memset(tls_data, 0, sizeof(*tls_data));
+  tls_data->nearest.index = -1;
+}
+
+static void mesh_remap_tls_free(const void *__restrict UNUSED(userdata),
+                                void *__restrict chunk)
+{
+  MeshRemapTLS *tls_data = chunk;
+
+  MEM_SAFE_FREE(tls_data->vcos);
+  MEM_SAFE_FREE(tls_data->indices);
+  MEM_SAFE_FREE(tls_data->weights);
+  if (tls_data->islands_res) {
+    for (int i = 0; i < tls_data->islands_res_num; i++) {
+      MEM_SAFE_FREE(tls_data->islands_res[i]);
+    }
+    MEM_freeN(tls_data->islands_res);
+  }
+  BLI_astar_solution_free(&tls_data->as_solution);
+}
+
+static void mesh_remap_task_settings_init(TaskParallelSettings *settings, MeshRemapTLS *tls_data)
+{
+  mesh_remap_tls_init(tls_data);
+
+  BLI_parallel_range_settings_defaults(settings);
+  settings->min_iter_per_thread = MREMAP_TASK_MIN_ITER;
+  settings->userdata_chunk = tls_data;
+  settings->userdata_chunk_size = sizeof(*tls_data);
+  settings->func_free = mesh_remap_tls_free;
+}
+
+static void mesh_remap_calc_verts_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  const MeshRemapTaskData *data = userdata;
+  MeshRemapTLS *tls_data = tls->userdata_chunk;
+  const int mode = data->mode;
+  const SpaceTransform *space_transform = data->space_transform;
+  MeshPairRemap *r_map = data->r_map;
+  SpinLock *lock = data->lock;
+  const float full_weight = 1.0f;
+  float hit_dist;
+  float tmp_co[3], tmp_no[3];
+
+  copy_v3_v3(tmp_co, data->verts_dst[i].co);
+
+  if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
+    normal_short_to_float_v3(tmp_no, data->verts_dst[i].no);
+
+    /* Convert the vertex to tree coordinates, if needed. */
+    if (space_transform) {
+      BLI_space_transform_apply(space_transform, tmp_co);
+      BLI_space_transform_apply_normal(space_transform, tmp_no);
+    }
+
+    if (mesh_remap_bvhtree_query_raycast(data->treedata,
+                                         &tls_data->rayhit,
+                                         tmp_co,
+                                         tmp_no,
+                                         data->ray_radius,
+                                         data->max_dist,
+                                         &hit_dist)) {
+      const MLoopTri *lt = &data->treedata->looptri[tls_data->rayhit.index];
+      MPoly *mp_src = &data->polys_src[lt->poly];
+      const int sources_num = mesh_remap_interp_poly_data_get(mp_src,
+                                                              data->loops_src,
+                                                              data->vcos_src,
+                                                              tls_data->rayhit.co,
+                                                              &tls_data->buff_size,
+                                                              &tls_data->vcos,
+                                                              false,
+                                                              &tls_data->indices,
+                                                              &tls_data->weights,
+                                                              true,
+                                                              NULL);
+
+      mesh_remap_item_define_ex(
+          r_map, lock, i, hit_dist, 0, sources_num, tls_data->indices, tls_data->weights);
+    }
+    else {
+      /* No source for this dest vertex! */
+      BKE_mesh_remap_item_define_invalid(r_map, i);
+    }
+    return;
+  }
+
+  /* Convert the vertex to tree coordinates, if needed. */
+  if (space_transform) {
+    BLI_space_transform_apply(space_transform, tmp_co);
+  }
+
+  if (!mesh_remap_bvhtree_query_nearest(
+          data->treedata, &tls_data->nearest, tmp_co, data->max_dist_sq, &hit_dist)) {
+    /* No source for this dest vertex! */
+    BKE_mesh_remap_item_define_invalid(r_map, i);
+    return;
+  }
+
+  const BVHTreeNearest *nearest = &tls_data->nearest;
+
+  if (mode == MREMAP_MODE_VERT_NEAREST) {
+    mesh_remap_item_define_ex(r_map, lock, i, hit_dist, 0, 1, &nearest->index, &full_weight);
+  }
+  else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
+    const MEdge *me = &data->edges_src[nearest->index];
+    const float *v1cos = data->vcos_src[me->v1];
+    const float *v2cos = data->vcos_src[me->v2];
+
+    if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
+      const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
+      const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
+      const int index = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
+      mesh_remap_item_define_ex(r_map, lock, i, hit_dist, 0, 1, &index, &full_weight);
+    }
+    else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
+      int indices[2];
+      float weights[2];
+
+      indices[0] = (int)me->v1;
+      indices[1] = (int)me->v2;
+
+      /* Weight is inverse of point factor here... */
+      weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
+      CLAMP(weights[0], 0.0f, 1.0f);
+      weights[1] = 1.0f - weights[0];
+
+      mesh_remap_item_define_ex(r_map, lock, i, hit_dist, 0, 2, indices, weights);
+    }
+  }
+  else {
+    const MLoopTri *lt = &data->treedata->looptri[nearest->index];
+    MPoly *mp = &data->polys_src[lt->poly];
+
+    if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
+      int index;
+      mesh_remap_interp_poly_data_get(mp,
+                                      data->loops_src,
+                                      data->vcos_src,
+                                      nearest->co,
+                                      &tls_data->buff_size,
+                                      &tls_data->vcos,
+                                      false,
+                                      &tls_data->indices,
+                                      &tls_data->weights,
+                                      false,
+                                      &index);
+
+      mesh_remap_item_define_ex(r_map, lock, i, hit_dist, 0, 1, &index, &full_weight);
+    }
+    else if (mode == MREMAP_MODE_VERT_POLYINTERP_NEAREST) {
+      const int sources_num = mesh_remap_interp_poly_data_get(mp,
+                                                              data->loops_src,
+                                                              data->vcos_src,
+                                                              nearest->co,
+                                                              &tls_data->buff_size,
+                                                              &tls_data->vcos,
+                                                              false,
+                                                              &tls_data->indices,
+                                                              &tls_data->weights,
+                                                              true,
+                                                              NULL);
+
+      mesh_remap_item_define_ex(
+          r_map, lock, i, hit_dist, 0, sources_num, tls_data->indices, tls_data->weights);
+    }
+  }
+}
+
 void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
                                          const SpaceTransform *space_transform,
                                          const float max_dist,
@@ -515,202 +755,63 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
       mesh_remap_item_define(r_map, i, FLT_MAX, 0, 1, &i, &full_weight);
     }
   }
-  else {
+  else if (ELEM(mode,
+                MREMAP_MODE_VERT_NEAREST,
+                MREMAP_MODE_VERT_EDGE_NEAREST,
+                MREMAP_MODE_VERT_EDGEINTERP_NEAREST,
+                MREMAP_MODE_VERT_POLY_NEAREST,
+                MREMAP_MODE_VERT_POLYINTERP_NEAREST,
+                MREMAP_MODE_VERT_POLYINTERP_VNORPROJ)) {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    float hit_dist;
-    float tmp_co[3], tmp_no[3];
+    float(*vcos_src)[3] = NULL;
+    SpinLock lock;
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
     }
     else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
-      MEdge *edges_src = me_src->medge;
-      float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
-
+      vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          MEdge *me = &edges_src[nearest.index];
-          const float *v1cos = vcos_src[me->v1];
-          const float *v2cos = vcos_src[me->v2];
-
-          if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
-            const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
-            const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
-            const int index = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-          }
-          else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
-            int indices[2];
-            float weights[2];
-
-            indices[0] = (int)me->v1;
-            indices[1] = (int)me->v2;
-
-            /* Weight is inverse of point factor here... */
-            weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
-            CLAMP(weights[0], 0.0f, 1.0f);
-            weights[1] = 1.0f - weights[0];
-
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 2, indices, weights);
-          }
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-
-      MEM_freeN(vcos_src);
     }
-    else if (ELEM(mode,
-                  MREMAP_MODE_VERT_POLY_NEAREST,
-                  MREMAP_MODE_VERT_POLYINTERP_NEAREST,
-                  MREMAP_MODE_VERT_POLYINTERP_VNORPROJ)) {
-      MPoly *polys_src = me_src->mpoly;
-      MLoop *loops_src = me_src->mloop;
-      float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
-
-      size_t tmp_buff_size = MREMAP_DEFAULT_BUFSIZE;
-      float(*vcos)[3] = MEM_mallocN(sizeof(*vcos) * tmp_buff_size, __func__);
-      int *indices = MEM_mallocN(sizeof(*indices) * tmp_buff_size, __func__);
-      float *weights = MEM_mallocN(sizeof(*weights) * tmp_buff_size, __func__);
-
+    else {
+      vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
+    }
 
-      if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
-          normal_short_to_float_v3(tmp_no, verts_dst[i].no);
-
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-            BLI_space_transform_apply_normal(space_transform, tmp_no);
-          }
-
-          if (mesh_remap_bvhtree_query_raycast(
-                  &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[rayhit.index];
-            MPoly *mp_src = &polys_src[lt->poly];
-            const int sources_num = mesh_remap_interp_poly_data_get(mp_src,
-                                                                    loops_src,
-                                                                    (const float(*)[3])vcos_src,
-                                                                    rayhit.co,
-                                                                    &tmp_buff_size,
-                                                                    &vcos,
-                                                                    false,
-                                                                    &indices,
-                                                                    &weights,
-                                                                    true,
-                                                                    NULL);
-
-            mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
-          }
-        }
-      }
-      else {
-        nearest.index = -1;
-
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
+    BLI_spin_init(&lock);
 
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
+    MeshRemapTaskData data = {
+        .mode = mode,
+        .space_transform = space_transform,
+        .max_dist = max_dist,
+        .max_dist_sq = max_dist_sq,
+        .ray_radius = ray_radius,
+        .verts_dst = verts_dst,
+        .treedata = &treedata,
+        .edges_src = me_src->medge,
+        .loops_src = me_src->mloop,
+        .polys_src = me_src->mpoly,
+        .vcos_src = (const float(*)[3])vcos_src,
+        .r_map = r_map,
+        .lock = &lock,
+    };
 
-          if (mesh_remap_bvhtree_query_nearest(
-                  &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[nearest.index];
-            MPoly *mp = &polys_src[lt->poly];
-
-            if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
-              int index;
-              mesh_remap_interp_poly_data_get(mp,
-                                              loops_src,
-                                              (const float(*)[3])vcos_src,
-                                              nearest.co,
-                                              &tmp_buff_size,
-                                              &vcos,
-                                              false,
-                                              &indices,
-                                              &weights,
-                                              false,
-                                              &index);
+    MeshRemapTLS tls_data;
+    TaskParallelSettings settings;
+    mesh_remap_task_settings_init(&settings, &tls_data);
+    BLI_task_parallel_range(0, numverts_dst, &data, mesh_remap_calc_verts_cb, &settings);
 
-              mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-            }
-            else if (mode == MREMAP_MODE_VERT_POLYINTERP_NEAREST) {
-              const int sources_num = mesh_remap_interp_poly_data_get(mp,
-                                                                      loops_src,
-                                                                      (const float(*)[3])vcos_src,
-                                                                      nearest.co,
-                                                                      &tmp_buff_size,
-                                                                      &vcos,
-                                                                      false,
-                                                                      &indices,
-                                                                      &weights,
-                                                                      true,
-                                                                      NULL);
-
-              mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-            }
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
-          }
-        }
-      }
+    BLI_spin_end(&lock);
 
+    if (vcos_src) {
       MEM_freeN(vcos_src);
-      MEM_freeN(vcos);
-      MEM_freeN(indices);
-      MEM_freeN(weights);
-    }
-    else {
-      CLOG_WARN(&LOG, "Unsupported mesh-to-mesh vertex mapping mode (%d)!", mode);
-      memset(r_map->items, 0, sizeof(*r_map->items) * (size_t)numverts_dst);
     }
-
     free_bvhtree_from_mesh(&treedata);
   }
+  else {
+    CLOG_WARN(&LOG, "Unsupported mesh-to-mesh vertex mapping mode (%d)!", mode);
+    memset(r_map->items, 0, sizeof(*r_map->items) * (size_t)numverts_dst);
+  }
 }
 
 void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
@@ -747,13 +848,11 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
     float tmp_co[3], tmp_no[3];
 
     if (mode == MREMAP_MODE_EDGE_VERT_NEAREST) {
-      const int num_verts_src = me_src->totvert;
-      const int num_edges_src = me_src->totedge;
       MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
-      MeshElemMap *vert_to_edge_src_map;
-      int *vert_to_edge_src_map_mem;
+      /* Cached on the source mesh, which is usually used for many evaluations of the target. */
+      const MeshElemMap *vert_to_edge_src_map = BKE_mesh_runtime_vert_edge_map_ensure(me_src);
 
       struct {
         float hit_dist;
@@ -765,12 +864,6 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
         v_dst_to_src_map[i].hit_dist = -1.0f;
       }
 
-      BKE_mesh_vert_edge_map_create(&vert_to_edge_src_map,
-                                    &vert_to_edge_src_map_mem,
-                                    edges_src,
-                                    num_verts_src,
-                                    num_edges_src);
-
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
       nearest.index = -1;
 
@@ -810,7 +903,8 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
           const unsigned int vidx_dst = j ? e_dst->v1 : e_dst->v2;
           const float first_dist = v_dst_to_src_map[vidx_dst].hit_dist;
           const int vidx_src = v_dst_to_src_map[vidx_dst].index;
-          int *eidx_src, k;
+          const int *eidx_src;
+          int k;
 
           if (vidx_src < 0) {
             continue;
@@ -870,8 +964,6 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
 
       MEM_freeN(vcos_src);
       MEM_freeN(v_dst_to_src_map);
-      MEM_freeN(vert_to_edge_src_map);
-      MEM_freeN(vert_to_edge_src_map_mem);
     }
     else if (mode == MREMAP_MODE_EDGE_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
@@ -1245,114 +1337,703 @@ static float mesh_remap_calc_loops_astar_f_cost(BLI_AStarGraph *as_graph,
 
 #define ASTAR_STEPS_MAX 64
 
-void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
-                                         const SpaceTransform *space_transform,
-                                         const float max_dist,
-                                         const float ray_radius,
-                                         MVert *verts_dst,
-                                         const int numverts_dst,
-                                         MEdge *edges_dst,
-                                         const int numedges_dst,
-                                         MLoop *loops_dst,
-                                         const int numloops_dst,
-                                         MPoly *polys_dst,
-                                         const int numpolys_dst,
-                                         CustomData *ldata_dst,
-                                         CustomData *pdata_dst,
-                                         const bool use_split_nors_dst,
-                                         const float split_angle_dst,
-                                         const bool dirty_nors_dst,
-                                         Mesh *me_src,
-                                         MeshRemapIslandsCalc gen_islands_src,
-                                         const float islands_precision_src,
-                                         MeshPairRemap *r_map)
+/** Data shared by the parallel tasks mapping loops, one destination polygon at a time. */
+typedef struct MeshRemapLoopsTaskData {
+  int mode;
+  const SpaceTransform *space_transform;
+  float max_dist;
+  float max_dist_sq;
+  float ray_radius;
+
+  MVert *verts_dst;
+  MLoop *loops_dst;
+  MPoly *polys_dst;
+  float (*poly_nors_dst)[3];
+  float (*loop_nors_dst)[3];
+
+  BVHTreeFromMesh *treedata;
+  int num_trees;
+  bool use_from_vert;
+  bool use_islands;
+  const MeshIslandStore *island_store;
+  BLI_AStarGraph *as_graphdata;
+  int isld_steps_src;
+
+  MVert *verts_src;
+  MLoop *loops_src;
+  MPoly *polys_src;
+  const MLoopTri *looptri_src;
+  float (*vcos_src)[3];
+  float (*poly_nors_src)[3];
+  float (*loop_nors_src)[3];
+  float (*poly_cents_src)[3];
+  const MeshElemMap *vert_to_loop_map_src;
+  const MeshElemMap *vert_to_poly_map_src;
+  MeshElemMap *poly_to_looptri_map_src;
+  int *loop_to_poly_map_src;
+
+  MeshPairRemap *r_map;
+  SpinLock *lock;
+} MeshRemapLoopsTaskData;
+
+static void mesh_remap_calc_loops_poly_cb(void *__restrict userdata,
+                                          const int pidx_dst,
+                                          const TaskParallelTLS *__restrict tls)
 {
+  const MeshRemapLoopsTaskData *data = userdata;
+  MeshRemapTLS *tls_data = tls->userdata_chunk;
+
+  const int mode = data->mode;
+  const SpaceTransform *space_transform = data->space_transform;
+  const float max_dist = data->max_dist;
+  const float max_dist_sq = data->max_dist_sq;
+  const float ray_radius = data->ray_radius;
   const float full_weight = 1.0f;
-  const float max_dist_sq = max_dist * max_dist;
 
-  int i;
+  MVert *verts_dst = data->verts_dst;
+  MLoop *loops_dst = data->loops_dst;
+  float(*poly_nors_dst)[3] = data->poly_nors_dst;
+  float(*loop_nors_dst)[3] = data->loop_nors_dst;
+
+  BVHTreeFromMesh *treedata = data->treedata;
+  const int num_trees = data->num_trees;
+  const bool use_from_vert = data->use_from_vert;
+  const bool use_islands = data->use_islands;
+  const MeshIslandStore *island_store = data->island_store;
+  BLI_AStarGraph *as_graphdata = data->as_graphdata;
+  const int isld_steps_src = data->isld_steps_src;
+
+  MVert *verts_src = data->verts_src;
+  MLoop *loops_src = data->loops_src;
+  MPoly *polys_src = data->polys_src;
+  const MLoopTri *looptri_src = data->looptri_src;
+  float(*vcos_src)[3] = data->vcos_src;
+  float(*poly_nors_src)[3] = data->poly_nors_src;
+  float(*loop_nors_src)[3] = data->loop_nors_src;
+  float(*poly_cents_src)[3] = data->poly_cents_src;
+  const MeshElemMap *vert_to_loop_map_src = data->vert_to_loop_map_src;
+  const MeshElemMap *vert_to_poly_map_src = data->vert_to_poly_map_src;
+  MeshElemMap *poly_to_looptri_map_src = data->poly_to_looptri_map_src;
+  int *loop_to_poly_map_src = data->loop_to_poly_map_src;
+
+  MeshPairRemap *r_map = data->r_map;
+  SpinLock *lock = data->lock;
+
+  BVHTreeNearest *nearest = &tls_data->nearest;
+  BVHTreeRayHit *rayhit = &tls_data->rayhit;
+  BLI_AStarSolution *as_solution = &tls_data->as_solution;
+  IslandResult **islands_res;
+
+  MPoly *mp_dst = &data->polys_dst[pidx_dst];
+  MLoop *ml_src, *ml_dst;
+  MPoly *mp_src;
+  int i, tindex, lidx_dst, plidx_dst, pidx_src, lidx_src, plidx_src;
+  float hit_dist;
+  float tmp_co[3], tmp_no[3];
 
-  BLI_assert(mode & MREMAP_MODE_LOOP);
-  BLI_assert((islands_precision_src >= 0.0f) && (islands_precision_src <= 1.0f));
+  if (tls_data->islands_res == NULL) {
+    tls_data->islands_res = MEM_callocN(sizeof(*tls_data->islands_res) * (size_t)num_trees,
+                                        __func__);
+    tls_data->islands_res_num = num_trees;
+  }
+  islands_res = tls_data->islands_res;
 
-  BKE_mesh_remap_init(r_map, numloops_dst);
+  float pnor_dst[3];
 
-  if (mode == MREMAP_MODE_TOPOLOGY) {
-    /* In topology mapping, we assume meshes are identical, islands included! */
-    BLI_assert(numloops_dst == me_src->totloop);
-    for (i = 0; i < numloops_dst; i++) {
-      mesh_remap_item_define(r_map, i, FLT_MAX, 0, 1, &i, &full_weight);
+  /* Only in use_from_vert case, we may need polys' centers as fallback
+   * in case we cannot decide which corner to use from normals only. */
+  float pcent_dst[3];
+  bool pcent_dst_valid = false;
+
+  if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) {
+    copy_v3_v3(pnor_dst, poly_nors_dst[pidx_dst]);
+    if (space_transform) {
+      BLI_space_transform_apply_normal(space_transform, pnor_dst);
     }
   }
-  else {
-    BVHTreeFromMesh *treedata = NULL;
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    int num_trees = 0;
-    float hit_dist;
-    float tmp_co[3], tmp_no[3];
 
-    const bool use_from_vert = (mode & MREMAP_USE_VERT);
+  if ((size_t)mp_dst->totloop > tls_data->islands_res_buff_size) {
+    tls_data->islands_res_buff_size = (size_t)mp_dst->totloop + MREMAP_DEFAULT_BUFSIZE;
+    for (tindex = 0; tindex < num_trees; tindex++) {
+      islands_res[tindex] = MEM_reallocN(
+          islands_res[tindex], sizeof(**islands_res) * tls_data->islands_res_buff_size);
+    }
+  }
 
-    MeshIslandStore island_store = {0};
-    bool use_islands = false;
+  for (tindex = 0; tindex < num_trees; tindex++) {
+    BVHTreeFromMesh *tdata = &treedata[tindex];
 
-    BLI_AStarGraph *as_graphdata = NULL;
-    BLI_AStarSolution as_solution = {0};
-    const int isld_steps_src = (islands_precision_src ?
-                                    max_ii((int)(ASTAR_STEPS_MAX * islands_precision_src + 0.499f),
-                                           1) :
-                                    0);
+    ml_dst = &loops_dst[mp_dst->loopstart];
+    for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++, ml_dst++) {
+      if (use_from_vert) {
+        const MeshElemMap *vert_to_refelem_map_src = NULL;
 
-    float(*poly_nors_src)[3] = NULL;
-    float(*loop_nors_src)[3] = NULL;
-    float(*poly_nors_dst)[3] = NULL;
-    float(*loop_nors_dst)[3] = NULL;
+        copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+        nearest->index = -1;
 
-    float(*poly_cents_src)[3] = NULL;
+        /* Convert the vertex to tree coordinates, if needed. */
+        if (space_transform) {
+          BLI_space_transform_apply(space_transform, tmp_co);
+        }
 
-    MeshElemMap *vert_to_loop_map_src = NULL;
-    int *vert_to_loop_map_src_buff = NULL;
-    MeshElemMap *vert_to_poly_map_src = NULL;
-    int *vert_to_poly_map_src_buff = NULL;
-    MeshElemMap *edge_to_poly_map_src = NULL;
-    int *edge_to_poly_map_src_buff = NULL;
-    MeshElemMap *poly_to_looptri_map_src = NULL;
-    int *poly_to_looptri_map_src_buff = NULL;
+        if (mesh_remap_bvhtree_query_nearest(tdata, nearest, tmp_co, max_dist_sq, &hit_dist)) {
+          float(*nor_dst)[3];
+          float(*nors_src)[3];
+          float best_nor_dot = -2.0f;
+          float best_sqdist_fallback = FLT_MAX;
+          int best_index_src = -1;
 
-    /* Unlike above, those are one-to-one mappings, simpler! */
-    int *loop_to_poly_map_src = NULL;
+          if (mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) {
+            copy_v3_v3(tmp_no, loop_nors_dst[plidx_dst + mp_dst->loopstart]);
+            if (space_transform) {
+              BLI_space_transform_apply_normal(space_transform, tmp_no);
+            }
+            nor_dst = &tmp_no;
+            nors_src = loop_nors_src;
+            vert_to_refelem_map_src = vert_to_loop_map_src;
+          }
+          else { /* if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) { */
+            nor_dst = &pnor_dst;
+            nors_src = poly_nors_src;
+            vert_to_refelem_map_src = vert_to_poly_map_src;
+          }
 
-    MVert *verts_src = me_src->mvert;
-    const int num_verts_src = me_src->totvert;
-    float(*vcos_src)[3] = NULL;
-    MEdge *edges_src = me_src->medge;
-    const int num_edges_src = me_src->totedge;
-    MLoop *loops_src = me_src->mloop;
-    const int num_loops_src = me_src->totloop;
-    MPoly *polys_src = me_src->mpoly;
-    const int num_polys_src = me_src->totpoly;
-    const MLoopTri *looptri_src = NULL;
-    int num_looptri_src = 0;
+          for (i = vert_to_refelem_map_src[nearest->index].count; i--;) {
+            const int index_src = vert_to_refelem_map_src[nearest->index].indices[i];
+            BLI_assert(index_src != -1);
+            const float dot = dot_v3v3(nors_src[index_src], *nor_dst);
+
+            pidx_src = ((mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) ?
+                            loop_to_poly_map_src[index_src] :
+                            index_src);
+            /* WARNING! This is not the *real* lidx_src in case of POLYNOR, we only use it
+             *          to check we stay on current island (all loops from a given poly are
+             *          on same island!). */
+            lidx_src = ((mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) ?
+                            index_src :
+                            polys_src[pidx_src].loopstart);
+
+            /* A same vert may be at the boundary of several islands! Hence, we have to ensure
+             * poly/loop we are currently considering *belongs* to current island! */
+            if (use_islands && island_store->items_to_islands[lidx_src] != tindex) {
+              continue;
+            }
+
+            if (dot > best_nor_dot - 1e-6f) {
+              /* We need something as fallback decision in case dest normal matches several
+               * source normals (see T44522), using distance between polys' centers here. */
+              float *pcent_src;
+              float sqdist;
 
-    size_t buff_size_interp = MREMAP_DEFAULT_BUFSIZE;
-    float(*vcos_interp)[3] = NULL;
-    int *indices_interp = NULL;
-    float *weights_interp = NULL;
+              mp_src = &polys_src[pidx_src];
+              ml_src = &loops_src[mp_src->loopstart];
+
+              if (!pcent_dst_valid) {
+                BKE_mesh_calc_poly_center(
+                    mp_dst, &loops_dst[mp_dst->loopstart], verts_dst, pcent_dst);
+                pcent_dst_valid = true;
+              }
+              pcent_src = poly_cents_src[pidx_src];
+              sqdist = len_squared_v3v3(pcent_dst, pcent_src);
 
-    MLoop *ml_src, *ml_dst;
-    MPoly *mp_src, *mp_dst;
-    int tindex, pidx_dst, lidx_dst, plidx_dst, pidx_src, lidx_src, plidx_src;
+              if ((dot > best_nor_dot + 1e-6f) || (sqdist < best_sqdist_fallback)) {
+                best_nor_dot = dot;
+                best_sqdist_fallback = sqdist;
+                best_index_src = index_src;
+              }
+            }
+          }
+          if (best_index_src == -1) {
+            /* We found no item to map back from closest vertex... */
+            best_nor_dot = -1.0f;
+            hit_dist = FLT_MAX;
+          }
+          else if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) {
+            /* Our best_index_src is a poly one for now!
+             * Have to find its loop matching our closest vertex. */
+            mp_src = &polys_src[best_index_src];
+            ml_src = &loops_src[mp_src->loopstart];
+            for (plidx_src = 0; plidx_src < mp_src->totloop; plidx_src++, ml_src++) {
+              if ((int)ml_src->v == nearest->index) {
+                best_index_src = plidx_src + mp_src->loopstart;
+                break;
+              }
+            }
+          }
+          best_nor_dot = (best_nor_dot + 1.0f) * 0.5f;
+          islands_res[tindex][plidx_dst].factor = hit_dist ? (best_nor_dot / hit_dist) : 1e18f;
+          islands_res[tindex][plidx_dst].hit_dist = hit_dist;
+          islands_res[tindex][plidx_dst].index_src = best_index_src;
+        }
+        else {
+          /* No source for this dest loop! */
+          islands_res[tindex][plidx_dst].factor = 0.0f;
+          islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
+          islands_res[tindex][plidx_dst].index_src = -1;
+        }
+      }
+      else if (mode & MREMAP_USE_NORPROJ) {
+        int n = (ray_radius > 0.0f) ? MREMAP_RAYCAST_APPROXIMATE_NR : 1;
+        float w = 1.0f;
+
+        copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+        copy_v3_v3(tmp_no, loop_nors_dst[plidx_dst + mp_dst->loopstart]);
+
+        /* We do our transform here, since we may do several raycast/nearest queries. */
+        if (space_transform) {
+          BLI_space_transform_apply(space_transform, tmp_co);
+          BLI_space_transform_apply_normal(space_transform, tmp_no);
+        }
+
+        while (n--) {
+          if (mesh_remap_bvhtree_query_raycast(
+                  tdata, rayhit, tmp_co, tmp_no, ray_radius / w, max_dist, &hit_dist)) {
+            islands_res[tindex][plidx_dst].factor = (hit_dist ? (1.0f / hit_dist) : 1e18f) * w;
+            islands_res[tindex][plidx_dst].hit_dist = hit_dist;
+            islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[rayhit->index].poly;
+            copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, rayhit->co);
+            break;
+          }
+          /* Next iteration will get bigger radius but smaller weight! */
+          w /= MREMAP_RAYCAST_APPROXIMATE_FAC;
+        }
+        if (n == -1) {
+          /* Fallback to 'nearest' hit here, loops usually comes in 'face group', not good to
+           * have only part of one dest face's loops to map to source.
+           * Note that since we give this a null weight, if whole weight for a given face
+           * is null, it means none of its loop mapped to this source island,
+           * hence we can skip it later.
+           */
+          copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+          nearest->index = -1;
+
+          /* Convert the vertex to tree coordinates, if needed. */
+          if (space_transform) {
+            BLI_space_transform_apply(space_transform, tmp_co);
+          }
+
+          /* In any case, this fallback nearest hit should have no weight at all
+           * in 'best island' decision! */
+          islands_res[tindex][plidx_dst].factor = 0.0f;
+
+          if (mesh_remap_bvhtree_query_nearest(tdata, nearest, tmp_co, max_dist_sq, &hit_dist)) {
+            islands_res[tindex][plidx_dst].hit_dist = hit_dist;
+            islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[nearest->index].poly;
+            copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, nearest->co);
+          }
+          else {
+            /* No source for this dest loop! */
+            islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
+            islands_res[tindex][plidx_dst].index_src = -1;
+          }
+        }
+      }
+      else { /* Nearest poly either to use all its loops/verts or just closest one. */
+        copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+        nearest->index = -1;
+
+        /* Convert the vertex to tree coordinates, if needed. */
+        if (space_transform) {
+          BLI_space_transform_apply(space_transform, tmp_co);
+        }
+
+        if (mesh_remap_bvhtree_query_nearest(tdata, nearest, tmp_co, max_dist_sq, &hit_dist)) {
+          islands_res[tindex][plidx_dst].factor = hit_dist ? (1.0f / hit_dist) : 1e18f;
+          islands_res[tindex][plidx_dst].hit_dist = hit_dist;
+          islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[nearest->index].poly;
+          copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, nearest->co);
+        }
+        else {
+          /* No source for this dest loop! */
+          islands_res[tindex][plidx_dst].factor = 0.0f;
+          islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
+          islands_res[tindex][plidx_dst].index_src = -1;
+        }
+      }
+    }
+  }
+
+  /* And now, find best island to use! */
+  /* We have to first select the 'best source island' for given dst poly and its loops.
+   * Then, we have to check that poly does not 'spread' across some island's limits
+   * (like inner seams for UVs, etc.).
+   * Note we only still partially support that kind of situation here, i.e.
+   * Polys spreading over actual cracks
+   * (like a narrow space without faces on src, splitting a 'tube-like' geometry).
+   * That kind of situation should be relatively rare, though.
+   */
+  /* XXX This block in itself is big and complex enough to be a separate function but...
+   *     it uses a bunch of locale vars.
+   *     Not worth sending all that through parameters (for now at least). */
+  {
+    BLI_AStarGraph *as_graph = NULL;
+    int *poly_island_index_map = NULL;
+    int pidx_src_prev = -1;
+
+    MeshElemMap *best_island = NULL;
+    float best_island_fac = 0.0f;
+    int best_island_index = -1;
+
+    for (tindex = 0; tindex < num_trees; tindex++) {
+      float island_fac = 0.0f;
+
+      for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++) {
+        island_fac += islands_res[tindex][plidx_dst].factor;
+      }
+      island_fac /= (float)mp_dst->totloop;
+
+      if (island_fac > best_island_fac) {
+        best_island_fac = island_fac;
+        best_island_index = tindex;
+      }
+    }
+
+    if (best_island_index != -1 && isld_steps_src) {
+      best_island = use_islands ? island_store->islands[best_island_index] : NULL;
+      as_graph = &as_graphdata[best_island_index];
+      poly_island_index_map = (int *)as_graph->custom_data;
+      BLI_astar_solution_init(as_graph, as_solution, NULL);
+    }
+
+    for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++) {
+      IslandResult *isld_res;
+      lidx_dst = plidx_dst + mp_dst->loopstart;
+
+      if (best_island_index == -1) {
+        /* No source for any loops of our dest poly in any source islands. */
+        BKE_mesh_remap_item_define_invalid(r_map, lidx_dst);
+        continue;
+      }
+
+      as_solution->custom_data = POINTER_FROM_INT(false);
+
+      isld_res = &islands_res[best_island_index][plidx_dst];
+      if (use_from_vert) {
+        /* Indices stored in islands_res are those of loops, one per dest loop. */
+        lidx_src = isld_res->index_src;
+        if (lidx_src >= 0) {
+          pidx_src = loop_to_poly_map_src[lidx_src];
+          /* If prev and curr poly are the same, no need to do anything more!!! */
+          if (!ELEM(pidx_src_prev, -1, pidx_src) && isld_steps_src) {
+            int pidx_isld_src, pidx_isld_src_prev;
+            if (poly_island_index_map) {
+              pidx_isld_src = poly_island_index_map[pidx_src];
+              pidx_isld_src_prev = poly_island_index_map[pidx_src_prev];
+            }
+            else {
+              pidx_isld_src = pidx_src;
+              pidx_isld_src_prev = pidx_src_prev;
+            }
+
+            BLI_astar_graph_solve(as_graph,
+                                  pidx_isld_src_prev,
+                                  pidx_isld_src,
+                                  mesh_remap_calc_loops_astar_f_cost,
+                                  as_solution,
+                                  isld_steps_src);
+            if (POINTER_AS_INT(as_solution->custom_data) && (as_solution->steps > 0)) {
+              /* Find first 'cutting edge' on path, and bring back lidx_src on poly just
+               * before that edge.
+               * Note we could try to be much smarter, g.g. Storing a whole poly's indices,
+               * and making decision (on which side of cutting edge(s!) to be) on the end,
+               * but this is one more level of complexity, better to first see if
+               * simple solution works!
+               */
+              int last_valid_pidx_isld_src = -1;
+              /* Note we go backward here, from dest to src poly. */
+              for (i = as_solution->steps - 1; i--;) {
+                BLI_AStarGNLink *as_link = as_solution->prev_links[pidx_isld_src];
+                const int eidx = POINTER_AS_INT(as_link->custom_data);
+                pidx_isld_src = as_solution->prev_nodes[pidx_isld_src];
+                BLI_assert(pidx_isld_src != -1);
+                if (eidx != -1) {
+                  /* we are 'crossing' a cutting edge. */
+                  last_valid_pidx_isld_src = pidx_isld_src;
+                }
+              }
+              if (last_valid_pidx_isld_src != -1) {
+                /* Find a new valid loop in that new poly (nearest one for now).
+                 * Note we could be much more subtle here, again that's for later... */
+                int j;
+                float best_dist_sq = FLT_MAX;
+
+                ml_dst = &loops_dst[lidx_dst];
+                copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+
+                /* We do our transform here,
+                 * since we may do several raycast/nearest queries. */
+                if (space_transform) {
+                  BLI_space_transform_apply(space_transform, tmp_co);
+                }
+
+                pidx_src = (use_islands ? best_island->indices[last_valid_pidx_isld_src] :
+                                          last_valid_pidx_isld_src);
+                mp_src = &polys_src[pidx_src];
+                ml_src = &loops_src[mp_src->loopstart];
+                for (j = 0; j < mp_src->totloop; j++, ml_src++) {
+                  const float dist_sq = len_squared_v3v3(verts_src[ml_src->v].co, tmp_co);
+                  if (dist_sq < best_dist_sq) {
+                    best_dist_sq = dist_sq;
+                    lidx_src = mp_src->loopstart + j;
+                  }
+                }
+              }
+            }
+          }
+          mesh_remap_item_define_ex(r_map,
+                                    lock,
+                                    lidx_dst,
+                                    isld_res->hit_dist,
+                                    best_island_index,
+                                    1,
+                                    &lidx_src,
+                                    &full_weight);
+          pidx_src_prev = pidx_src;
+        }
+        else {
+          /* No source for this loop in this island. */
+          /* TODO: would probably be better to get a source
+           * at all cost in best island anyway? */
+          mesh_remap_item_define_ex(
+              r_map, lock, lidx_dst, FLT_MAX, best_island_index, 0, NULL, NULL);
+        }
+      }
+      else {
+        /* Else, we use source poly, indices stored in islands_res are those of polygons. */
+        pidx_src = isld_res->index_src;
+        if (pidx_src >= 0) {
+          float *hit_co = isld_res->hit_point;
+          int best_loop_index_src;
+
+          mp_src = &polys_src[pidx_src];
+          /* If prev and curr poly are the same, no need to do anything more!!! */
+          if (!ELEM(pidx_src_prev, -1, pidx_src) && isld_steps_src) {
+            int pidx_isld_src, pidx_isld_src_prev;
+            if (poly_island_index_map) {
+              pidx_isld_src = poly_island_index_map[pidx_src];
+              pidx_isld_src_prev = poly_island_index_map[pidx_src_prev];
+            }
+            else {
+              pidx_isld_src = pidx_src;
+              pidx_isld_src_prev = pidx_src_prev;
+            }
+
+            BLI_astar_graph_solve(as_graph,
+                                  pidx_isld_src_prev,
+                                  pidx_isld_src,
+                                  mesh_remap_calc_loops_astar_f_cost,
+                                  as_solution,
+                                  isld_steps_src);
+            if (POINTER_AS_INT(as_solution->custom_data) && (as_solution->steps > 0)) {
+              /* Find first 'cutting edge' on path, and bring back lidx_src on poly just
+               * before that edge.
+               * Note we could try to be much smarter: e.g. Storing a whole poly's indices,
+               * and making decision (one which side of cutting edge(s)!) to be on the end,
+               * but this is one more level of complexity, better to first see if
+               * simple solution works!
+               */
+              int last_valid_pidx_isld_src = -1;
+              /* Note we go backward here, from dest to src poly. */
+              for (i = as_solution->steps - 1; i--;) {
+                BLI_AStarGNLink *as_link = as_solution->prev_links[pidx_isld_src];
+                int eidx = POINTER_AS_INT(as_link->custom_data);
+
+                pidx_isld_src = as_solution->prev_nodes[pidx_isld_src];
+                BLI_assert(pidx_isld_src != -1);
+                if (eidx != -1) {
+                  /* we are 'crossing' a cutting edge. */
+                  last_valid_pidx_isld_src = pidx_isld_src;
+                }
+              }
+              if (last_valid_pidx_isld_src != -1) {
+                /* Find a new valid loop in that new poly (nearest point on poly for now).
+                 * Note we could be much more subtle here, again that's for later... */
+                float best_dist_sq = FLT_MAX;
+                int j;
+
+                ml_dst = &loops_dst[lidx_dst];
+                copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
+
+                /* We do our transform here,
+                 * since we may do several raycast/nearest queries. */
+                if (space_transform) {
+                  BLI_space_transform_apply(space_transform, tmp_co);
+                }
+
+                pidx_src = (use_islands ? best_island->indices[last_valid_pidx_isld_src] :
+                                          last_valid_pidx_isld_src);
+                mp_src = &polys_src[pidx_src];
+
+                for (j = poly_to_looptri_map_src[pidx_src].count; j--;) {
+                  float h[3];
+                  const MLoopTri *lt = &looptri_src[poly_to_looptri_map_src[pidx_src].indices[j]];
+                  float dist_sq;
+
+                  closest_on_tri_to_point_v3(h,
+                                             tmp_co,
+                                             vcos_src[loops_src[lt->tri[0]].v],
+                                             vcos_src[loops_src[lt->tri[1]].v],
+                                             vcos_src[loops_src[lt->tri[2]].v]);
+                  dist_sq = len_squared_v3v3(tmp_co, h);
+                  if (dist_sq < best_dist_sq) {
+                    copy_v3_v3(hit_co, h);
+                    best_dist_sq = dist_sq;
+                  }
+                }
+              }
+            }
+          }
+
+          if (mode == MREMAP_MODE_LOOP_POLY_NEAREST) {
+            mesh_remap_interp_poly_data_get(mp_src,
+                                            loops_src,
+                                            (const float(*)[3])vcos_src,
+                                            hit_co,
+                                            &tls_data->buff_size,
+                                            &tls_data->vcos,
+                                            true,
+                                            &tls_data->indices,
+                                            &tls_data->weights,
+                                            false,
+                                            &best_loop_index_src);
+
+            mesh_remap_item_define_ex(r_map,
+                                      lock,
+                                      lidx_dst,
+                                      isld_res->hit_dist,
+                                      best_island_index,
+                                      1,
+                                      &best_loop_index_src,
+                                      &full_weight);
+          }
+          else {
+            const int sources_num = mesh_remap_interp_poly_data_get(mp_src,
+                                                                    loops_src,
+                                                                    (const float(*)[3])vcos_src,
+                                                                    hit_co,
+                                                                    &tls_data->buff_size,
+                                                                    &tls_data->vcos,
+                                                                    true,
+                                                                    &tls_data->indices,
+                                                                    &tls_data->weights,
+                                                                    true,
+                                                                    NULL);
+
+            mesh_remap_item_define_ex(r_map,
+                                      lock,
+                                      lidx_dst,
+                                      isld_res->hit_dist,
+                                      best_island_index,
+                                      sources_num,
+                                      tls_data->indices,
+                                      tls_data->weights);
+          }
+
+          pidx_src_prev = pidx_src;
+        }
+        else {
+          /* No source for this loop in this island. */
+          /* TODO: would probably be better to get a source
+           * at all cost in best island anyway? */
+          mesh_remap_item_define_ex(
+              r_map, lock, lidx_dst, FLT_MAX, best_island_index, 0, NULL, NULL);
+        }
+      }
+    }
+
+    BLI_astar_solution_clear(as_solution);
+  }
+}
+
+void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
+                                         const SpaceTransform *space_transform,
+                                         const float max_dist,
+                                         const float ray_radius,
+                                         MVert *verts_dst,
+                                         const int numverts_dst,
+                                         MEdge *edges_dst,
+                                         const int numedges_dst,
+                                         MLoop *loops_dst,
+                                         const int numloops_dst,
+                                         MPoly *polys_dst,
+                                         const int numpolys_dst,
+                                         CustomData *ldata_dst,
+                                         CustomData *pdata_dst,
+                                         const bool use_split_nors_dst,
+                                         const float split_angle_dst,
+                                         const bool dirty_nors_dst,
+                                         Mesh *me_src,
+                                         MeshRemapIslandsCalc gen_islands_src,
+                                         const float islands_precision_src,
+                                         MeshPairRemap *r_map)
+{
+  const float full_weight = 1.0f;
+  const float max_dist_sq = max_dist * max_dist;
+
+  int i;
+
+  BLI_assert(mode & MREMAP_MODE_LOOP);
+  BLI_assert((islands_precision_src >= 0.0f) && (islands_precision_src <= 1.0f));
+
+  BKE_mesh_remap_init(r_map, numloops_dst);
+
+  if (mode == MREMAP_MODE_TOPOLOGY) {
+    /* In topology mapping, we assume meshes are identical, islands included! */
+    BLI_assert(numloops_dst == me_src->totloop);
+    for (i = 0; i < numloops_dst; i++) {
+      mesh_remap_item_define(r_map, i, FLT_MAX, 0, 1, &i, &full_weight);
+    }
+  }
+  else {
+    BVHTreeFromMesh *treedata = NULL;
+    int num_trees = 0;
+
+    const bool use_from_vert = (mode & MREMAP_USE_VERT);
+
+    MeshIslandStore island_store = {0};
+    bool use_islands = false;
+
+    BLI_AStarGraph *as_graphdata = NULL;
+    const int isld_steps_src = (islands_precision_src ?
+                                    max_ii((int)(ASTAR_STEPS_MAX * islands_precision_src + 0.499f),
+                                           1) :
+                                    0);
+
+    float(*poly_nors_src)[3] = NULL;
+    float(*loop_nors_src)[3] = NULL;
+    float(*poly_nors_dst)[3] = NULL;
+    float(*loop_nors_dst)[3] = NULL;
+
+    float(*poly_cents_src)[3] = NULL;
+
+    const MeshElemMap *vert_to_loop_map_src = NULL;
+    const MeshElemMap *vert_to_poly_map_src = NULL;
+    MeshElemMap *edge_to_poly_map_src = NULL;
+    int *edge_to_poly_map_src_buff = NULL;
+    MeshElemMap *poly_to_looptri_map_src = NULL;
+    int *poly_to_looptri_map_src_buff = NULL;
+
+    /* Unlike above, those are one-to-one mappings, simpler! */
+    int *loop_to_poly_map_src = NULL;
+
+    MVert *verts_src = me_src->mvert;
+    const int num_verts_src = me_src->totvert;
+    float(*vcos_src)[3] = NULL;
+    MEdge *edges_src = me_src->medge;
+    const int num_edges_src = me_src->totedge;
+    MLoop *loops_src = me_src->mloop;
+    const int num_loops_src = me_src->totloop;
+    MPoly *polys_src = me_src->mpoly;
+    const int num_polys_src = me_src->totpoly;
+    const MLoopTri *looptri_src = NULL;
+    int num_looptri_src = 0;
 
-    IslandResult **islands_res;
-    size_t islands_res_buff_size = MREMAP_DEFAULT_BUFSIZE;
+    MLoop *ml_src;
+    MPoly *mp_src;
+    int tindex, pidx_src, lidx_src, plidx_src;
 
     if (!use_from_vert) {
       vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
-
-      vcos_interp = MEM_mallocN(sizeof(*vcos_interp) * buff_size_interp, __func__);
-      indices_interp = MEM_mallocN(sizeof(*indices_interp) * buff_size_interp, __func__);
-      weights_interp = MEM_mallocN(sizeof(*weights_interp) * buff_size_interp, __func__);
     }
 
     {
@@ -1425,21 +2106,10 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     }
 
     if (use_from_vert) {
-      BKE_mesh_vert_loop_map_create(&vert_to_loop_map_src,
-                                    &vert_to_loop_map_src_buff,
-                                    polys_src,
-                                    loops_src,
-                                    num_verts_src,
-                                    num_polys_src,
-                                    num_loops_src);
+      /* Cached on the source mesh, which is usually used for many evaluations of the target. */
+      vert_to_loop_map_src = BKE_mesh_runtime_vert_loop_map_ensure(me_src);
       if (mode & MREMAP_USE_POLY) {
-        BKE_mesh_vert_poly_map_create(&vert_to_poly_map_src,
-                                      &vert_to_poly_map_src_buff,
-                                      polys_src,
-                                      loops_src,
-                                      num_verts_src,
-                                      num_polys_src,
-                                      num_loops_src);
+        vert_to_poly_map_src = BKE_mesh_runtime_vert_poly_map_ensure(me_src);
       }
     }
 
@@ -1609,560 +2279,77 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
       }
     }
 
-    /* And check each dest poly! */
-    islands_res = MEM_mallocN(sizeof(*islands_res) * (size_t)num_trees, __func__);
-    for (tindex = 0; tindex < num_trees; tindex++) {
-      islands_res[tindex] = MEM_mallocN(sizeof(**islands_res) * islands_res_buff_size, __func__);
+    if (!use_from_vert && isld_steps_src) {
+      BKE_mesh_origindex_map_create_looptri(&poly_to_looptri_map_src,
+                                            &poly_to_looptri_map_src_buff,
+                                            polys_src,
+                                            num_polys_src,
+                                            looptri_src,
+                                            num_looptri_src);
     }
 
-    for (pidx_dst = 0, mp_dst = polys_dst; pidx_dst < numpolys_dst; pidx_dst++, mp_dst++) {
-      float pnor_dst[3];
-
-      /* Only in use_from_vert case, we may need polys' centers as fallback
-       * in case we cannot decide which corner to use from normals only. */
-      float pcent_dst[3];
-      bool pcent_dst_valid = false;
-
-      if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) {
-        copy_v3_v3(pnor_dst, poly_nors_dst[pidx_dst]);
-        if (space_transform) {
-          BLI_space_transform_apply_normal(space_transform, pnor_dst);
-        }
-      }
-
-      if ((size_t)mp_dst->totloop > islands_res_buff_size) {
-        islands_res_buff_size = (size_t)mp_dst->totloop + MREMAP_DEFAULT_BUFSIZE;
-        for (tindex = 0; tindex < num_trees; tindex++) {
-          islands_res[tindex] = MEM_reallocN(islands_res[tindex],
-                                             sizeof(**islands_res) * islands_res_buff_size);
-        }
-      }
-
-      for (tindex = 0; tindex < num_trees; tindex++) {
-        BVHTreeFromMesh *tdata = &treedata[tindex];
-
-        ml_dst = &loops_dst[mp_dst->loopstart];
-        for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++, ml_dst++) {
-          if (use_from_vert) {
-            MeshElemMap *vert_to_refelem_map_src = NULL;
-
-            copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-            nearest.index = -1;
-
-            /* Convert the vertex to tree coordinates, if needed. */
-            if (space_transform) {
-              BLI_space_transform_apply(space_transform, tmp_co);
-            }
-
-            if (mesh_remap_bvhtree_query_nearest(
-                    tdata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-              float(*nor_dst)[3];
-              float(*nors_src)[3];
-              float best_nor_dot = -2.0f;
-              float best_sqdist_fallback = FLT_MAX;
-              int best_index_src = -1;
-
-              if (mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) {
-                copy_v3_v3(tmp_no, loop_nors_dst[plidx_dst + mp_dst->loopstart]);
-                if (space_transform) {
-                  BLI_space_transform_apply_normal(space_transform, tmp_no);
-                }
-                nor_dst = &tmp_no;
-                nors_src = loop_nors_src;
-                vert_to_refelem_map_src = vert_to_loop_map_src;
-              }
-              else { /* if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) { */
-                nor_dst = &pnor_dst;
-                nors_src = poly_nors_src;
-                vert_to_refelem_map_src = vert_to_poly_map_src;
-              }
-
-              for (i = vert_to_refelem_map_src[nearest.index].count; i--;) {
-                const int index_src = vert_to_refelem_map_src[nearest.index].indices[i];
-                BLI_assert(index_src != -1);
-                const float dot = dot_v3v3(nors_src[index_src], *nor_dst);
-
-                pidx_src = ((mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) ?
-                                loop_to_poly_map_src[index_src] :
-                                index_src);
-                /* WARNING! This is not the *real* lidx_src in case of POLYNOR, we only use it
-                 *          to check we stay on current island (all loops from a given poly are
-                 *          on same island!). */
-                lidx_src = ((mode == MREMAP_MODE_LOOP_NEAREST_LOOPNOR) ?
-                                index_src :
-                                polys_src[pidx_src].loopstart);
-
-                /* A same vert may be at the boundary of several islands! Hence, we have to ensure
-                 * poly/loop we are currently considering *belongs* to current island! */
-                if (use_islands && island_store.items_to_islands[lidx_src] != tindex) {
-                  continue;
-                }
-
-                if (dot > best_nor_dot - 1e-6f) {
-                  /* We need something as fallback decision in case dest normal matches several
-                   * source normals (see T44522), using distance between polys' centers here. */
-                  float *pcent_src;
-                  float sqdist;
-
-                  mp_src = &polys_src[pidx_src];
-                  ml_src = &loops_src[mp_src->loopstart];
-
-                  if (!pcent_dst_valid) {
-                    BKE_mesh_calc_poly_center(
-                        mp_dst, &loops_dst[mp_dst->loopstart], verts_dst, pcent_dst);
-                    pcent_dst_valid = true;
-                  }
-                  pcent_src = poly_cents_src[pidx_src];
-                  sqdist = len_squared_v3v3(pcent_dst, pcent_src);
-
-                  if ((dot > best_nor_dot + 1e-6f) || (sqdist < best_sqdist_fallback)) {
-                    best_nor_dot = dot;
-                    best_sqdist_fallback = sqdist;
-                    best_index_src = index_src;
-                  }
-                }
-              }
-              if (best_index_src == -1) {
-                /* We found no item to map back from closest vertex... */
-                best_nor_dot = -1.0f;
-                hit_dist = FLT_MAX;
-              }
-              else if (mode == MREMAP_MODE_LOOP_NEAREST_POLYNOR) {
-                /* Our best_index_src is a poly one for now!
-                 * Have to find its loop matching our closest vertex. */
-                mp_src = &polys_src[best_index_src];
-                ml_src = &loops_src[mp_src->loopstart];
-                for (plidx_src = 0; plidx_src < mp_src->totloop; plidx_src++, ml_src++) {
-                  if ((int)ml_src->v == nearest.index) {
-                    best_index_src = plidx_src + mp_src->loopstart;
-                    break;
-                  }
-                }
-              }
-              best_nor_dot = (best_nor_dot + 1.0f) * 0.5f;
-              islands_res[tindex][plidx_dst].factor = hit_dist ? (best_nor_dot / hit_dist) : 1e18f;
-              islands_res[tindex][plidx_dst].hit_dist = hit_dist;
-              islands_res[tindex][plidx_dst].index_src = best_index_src;
-            }
-            else {
-              /* No source for this dest loop! */
-              islands_res[tindex][plidx_dst].factor = 0.0f;
-              islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
-              islands_res[tindex][plidx_dst].index_src = -1;
-            }
-          }
-          else if (mode & MREMAP_USE_NORPROJ) {
-            int n = (ray_radius > 0.0f) ? MREMAP_RAYCAST_APPROXIMATE_NR : 1;
-            float w = 1.0f;
-
-            copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-            copy_v3_v3(tmp_no, loop_nors_dst[plidx_dst + mp_dst->loopstart]);
-
-            /* We do our transform here, since we may do several raycast/nearest queries. */
-            if (space_transform) {
-              BLI_space_transform_apply(space_transform, tmp_co);
-              BLI_space_transform_apply_normal(space_transform, tmp_no);
-            }
-
-            while (n--) {
-              if (mesh_remap_bvhtree_query_raycast(
-                      tdata, &rayhit, tmp_co, tmp_no, ray_radius / w, max_dist, &hit_dist)) {
-                islands_res[tindex][plidx_dst].factor = (hit_dist ? (1.0f / hit_dist) : 1e18f) * w;
-                islands_res[tindex][plidx_dst].hit_dist = hit_dist;
-                islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[rayhit.index].poly;
-                copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, rayhit.co);
-                break;
-              }
-              /* Next iteration will get bigger radius but smaller weight! */
-              w /= MREMAP_RAYCAST_APPROXIMATE_FAC;
-            }
-            if (n == -1) {
-              /* Fallback to 'nearest' hit here, loops usually comes in 'face group', not good to
-               * have only part of one dest face's loops to map to source.
-               * Note that since we give this a null weight, if whole weight for a given face
-               * is null, it means none of its loop mapped to this source island,
-               * hence we can skip it later.
-               */
-              copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-              nearest.index = -1;
-
-              /* Convert the vertex to tree coordinates, if needed. */
-              if (space_transform) {
-                BLI_space_transform_apply(space_transform, tmp_co);
-              }
-
-              /* In any case, this fallback nearest hit should have no weight at all
-               * in 'best island' decision! */
-              islands_res[tindex][plidx_dst].factor = 0.0f;
-
-              if (mesh_remap_bvhtree_query_nearest(
-                      tdata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-                islands_res[tindex][plidx_dst].hit_dist = hit_dist;
-                islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[nearest.index].poly;
-                copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, nearest.co);
-              }
-              else {
-                /* No source for this dest loop! */
-                islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
-                islands_res[tindex][plidx_dst].index_src = -1;
-              }
-            }
-          }
-          else { /* Nearest poly either to use all its loops/verts or just closest one. */
-            copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-            nearest.index = -1;
-
-            /* Convert the vertex to tree coordinates, if needed. */
-            if (space_transform) {
-              BLI_space_transform_apply(space_transform, tmp_co);
-            }
-
-            if (mesh_remap_bvhtree_query_nearest(
-                    tdata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-              islands_res[tindex][plidx_dst].factor = hit_dist ? (1.0f / hit_dist) : 1e18f;
-              islands_res[tindex][plidx_dst].hit_dist = hit_dist;
-              islands_res[tindex][plidx_dst].index_src = (int)tdata->looptri[nearest.index].poly;
-              copy_v3_v3(islands_res[tindex][plidx_dst].hit_point, nearest.co);
-            }
-            else {
-              /* No source for this dest loop! */
-              islands_res[tindex][plidx_dst].factor = 0.0f;
-              islands_res[tindex][plidx_dst].hit_dist = FLT_MAX;
-              islands_res[tindex][plidx_dst].index_src = -1;
-            }
-          }
-        }
-      }
-
-      /* And now, find best island to use! */
-      /* We have to first select the 'best source island' for given dst poly and its loops.
-       * Then, we have to check that poly does not 'spread' across some island's limits
-       * (like inner seams for UVs, etc.).
-       * Note we only still partially support that kind of situation here, i.e.
-       * Polys spreading over actual cracks
-       * (like a narrow space without faces on src, splitting a 'tube-like' geometry).
-       * That kind of situation should be relatively rare, though.
-       */
-      /* XXX This block in itself is big and complex enough to be a separate function but...
-       *     it uses a bunch of locale vars.
-       *     Not worth sending all that through parameters (for now at least). */
-      {
-        BLI_AStarGraph *as_graph = NULL;
-        int *poly_island_index_map = NULL;
-        int pidx_src_prev = -1;
-
-        MeshElemMap *best_island = NULL;
-        float best_island_fac = 0.0f;
-        int best_island_index = -1;
-
-        for (tindex = 0; tindex < num_trees; tindex++) {
-          float island_fac = 0.0f;
-
-          for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++) {
-            island_fac += islands_res[tindex][plidx_dst].factor;
-          }
-          island_fac /= (float)mp_dst->totloop;
-
-          if (island_fac > best_island_fac) {
-            best_island_fac = island_fac;
-            best_island_index = tindex;
-          }
-        }
-
-        if (best_island_index != -1 && isld_steps_src) {
-          best_island = use_islands ? island_store.islands[best_island_index] : NULL;
-          as_graph = &as_graphdata[best_island_index];
-          poly_island_index_map = (int *)as_graph->custom_data;
-          BLI_astar_solution_init(as_graph, &as_solution, NULL);
-        }
-
-        for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++) {
-          IslandResult *isld_res;
-          lidx_dst = plidx_dst + mp_dst->loopstart;
-
-          if (best_island_index == -1) {
-            /* No source for any loops of our dest poly in any source islands. */
-            BKE_mesh_remap_item_define_invalid(r_map, lidx_dst);
-            continue;
-          }
-
-          as_solution.custom_data = POINTER_FROM_INT(false);
-
-          isld_res = &islands_res[best_island_index][plidx_dst];
-          if (use_from_vert) {
-            /* Indices stored in islands_res are those of loops, one per dest loop. */
-            lidx_src = isld_res->index_src;
-            if (lidx_src >= 0) {
-              pidx_src = loop_to_poly_map_src[lidx_src];
-              /* If prev and curr poly are the same, no need to do anything more!!! */
-              if (!ELEM(pidx_src_prev, -1, pidx_src) && isld_steps_src) {
-                int pidx_isld_src, pidx_isld_src_prev;
-                if (poly_island_index_map) {
-                  pidx_isld_src = poly_island_index_map[pidx_src];
-                  pidx_isld_src_prev = poly_island_index_map[pidx_src_prev];
-                }
-                else {
-                  pidx_isld_src = pidx_src;
-                  pidx_isld_src_prev = pidx_src_prev;
-                }
-
-                BLI_astar_graph_solve(as_graph,
-                                      pidx_isld_src_prev,
-                                      pidx_isld_src,
-                                      mesh_remap_calc_loops_astar_f_cost,
-                                      &as_solution,
-                                      isld_steps_src);
-                if (POINTER_AS_INT(as_solution.custom_data) && (as_solution.steps > 0)) {
-                  /* Find first 'cutting edge' on path, and bring back lidx_src on poly just
-                   * before that edge.
-                   * Note we could try to be much smarter, g.g. Storing a whole poly's indices,
-                   * and making decision (on which side of cutting edge(s!) to be) on the end,
-                   * but this is one more level of complexity, better to first see if
-                   * simple solution works!
-                   */
-                  int last_valid_pidx_isld_src = -1;
-                  /* Note we go backward here, from dest to src poly. */
-                  for (i = as_solution.steps - 1; i--;) {
-                    BLI_AStarGNLink *as_link = as_solution.prev_links[pidx_isld_src];
-                    const int eidx = POINTER_AS_INT(as_link->custom_data);
-                    pidx_isld_src = as_solution.prev_nodes[pidx_isld_src];
-                    BLI_assert(pidx_isld_src != -1);
-                    if (eidx != -1) {
-                      /* we are 'crossing' a cutting edge. */
-                      last_valid_pidx_isld_src = pidx_isld_src;
-                    }
-                  }
-                  if (last_valid_pidx_isld_src != -1) {
-                    /* Find a new valid loop in that new poly (nearest one for now).
-                     * Note we could be much more subtle here, again that's for later... */
-                    int j;
-                    float best_dist_sq = FLT_MAX;
-
-                    ml_dst = &loops_dst[lidx_dst];
-                    copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-
-                    /* We do our transform here,
-                     * since we may do several raycast/nearest queries. */
-                    if (space_transform) {
-                      BLI_space_transform_apply(space_transform, tmp_co);
-                    }
-
-                    pidx_src = (use_islands ? best_island->indices[last_valid_pidx_isld_src] :
-                                              last_valid_pidx_isld_src);
-                    mp_src = &polys_src[pidx_src];
-                    ml_src = &loops_src[mp_src->loopstart];
-                    for (j = 0; j < mp_src->totloop; j++, ml_src++) {
-                      const float dist_sq = len_squared_v3v3(verts_src[ml_src->v].co, tmp_co);
-                      if (dist_sq < best_dist_sq) {
-                        best_dist_sq = dist_sq;
-                        lidx_src = mp_src->loopstart + j;
-                      }
-                    }
-                  }
-                }
-              }
-              mesh_remap_item_define(r_map,
-                                     lidx_dst,
-                                     isld_res->hit_dist,
-                                     best_island_index,
-                                     1,
-                                     &lidx_src,
-                                     &full_weight);
-              pidx_src_prev = pidx_src;
-            }
-            else {
-              /* No source for this loop in this island. */
-              /* TODO: would probably be better to get a source
-               * at all cost in best island anyway? */
-              mesh_remap_item_define(r_map, lidx_dst, FLT_MAX, best_island_index, 0, NULL, NULL);
-            }
-          }
-          else {
-            /* Else, we use source poly, indices stored in islands_res are those of polygons. */
-            pidx_src = isld_res->index_src;
-            if (pidx_src >= 0) {
-              float *hit_co = isld_res->hit_point;
-              int best_loop_index_src;
-
-              mp_src = &polys_src[pidx_src];
-              /* If prev and curr poly are the same, no need to do anything more!!! */
-              if (!ELEM(pidx_src_prev, -1, pidx_src) && isld_steps_src) {
-                int pidx_isld_src, pidx_isld_src_prev;
-                if (poly_island_index_map) {
-                  pidx_isld_src = poly_island_index_map[pidx_src];
-                  pidx_isld_src_prev = poly_island_index_map[pidx_src_prev];
-                }
-                else {
-                  pidx_isld_src = pidx_src;
-                  pidx_isld_src_prev = pidx_src_prev;
-                }
-
-                BLI_astar_graph_solve(as_graph,
-                                      pidx_isld_src_prev,
-                                      pidx_isld_src,
-                                      mesh_remap_calc_loops_astar_f_cost,
-                                      &as_solution,
-                                      isld_steps_src);
-                if (POINTER_AS_INT(as_solution.custom_data) && (as_solution.steps > 0)) {
-                  /* Find first 'cutting edge' on path, and bring back lidx_src on poly just
-                   * before that edge.
-                   * Note we could try to be much smarter: e.g. Storing a whole poly's indices,
-                   * and making decision (one which side of cutting edge(s)!) to be on the end,
-                   * but this is one more level of complexity, better to first see if
-                   * simple solution works!
-                   */
-                  int last_valid_pidx_isld_src = -1;
-                  /* Note we go backward here, from dest to src poly. */
-                  for (i = as_solution.steps - 1; i--;) {
-                    BLI_AStarGNLink *as_link = as_solution.prev_links[pidx_isld_src];
-                    int eidx = POINTER_AS_INT(as_link->custom_data);
-
-                    pidx_isld_src = as_solution.prev_nodes[pidx_isld_src];
-                    BLI_assert(pidx_isld_src != -1);
-                    if (eidx != -1) {
-                      /* we are 'crossing' a cutting edge. */
-                      last_valid_pidx_isld_src = pidx_isld_src;
-                    }
-                  }
-                  if (last_valid_pidx_isld_src != -1) {
-                    /* Find a new valid loop in that new poly (nearest point on poly for now).
-                     * Note we could be much more subtle here, again that's for later... */
-                    float best_dist_sq = FLT_MAX;
-                    int j;
-
-                    ml_dst = &loops_dst[lidx_dst];
-                    copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
-
-                    /* We do our transform here,
-                     * since we may do several raycast/nearest queries. */
-                    if (space_transform) {
-                      BLI_space_transform_apply(space_transform, tmp_co);
-                    }
-
-                    pidx_src = (use_islands ? best_island->indices[last_valid_pidx_isld_src] :
-                                              last_valid_pidx_isld_src);
-                    mp_src = &polys_src[pidx_src];
-
-                    /* Create that one on demand. */
-                    if (poly_to_looptri_map_src == NULL) {
-                      BKE_mesh_origindex_map_create_looptri(&poly_to_looptri_map_src,
-                                                            &poly_to_looptri_map_src_buff,
-                                                            polys_src,
-                                                            num_polys_src,
-                                                            looptri_src,
-                                                            num_looptri_src);
-                    }
-
-                    for (j = poly_to_looptri_map_src[pidx_src].count; j--;) {
-                      float h[3];
-                      const MLoopTri *lt =
-                          &looptri_src[poly_to_looptri_map_src[pidx_src].indices[j]];
-                      float dist_sq;
-
-                      closest_on_tri_to_point_v3(h,
-                                                 tmp_co,
-                                                 vcos_src[loops_src[lt->tri[0]].v],
-                                                 vcos_src[loops_src[lt->tri[1]].v],
-                                                 vcos_src[loops_src[lt->tri[2]].v]);
-                      dist_sq = len_squared_v3v3(tmp_co, h);
-                      if (dist_sq < best_dist_sq) {
-                        copy_v3_v3(hit_co, h);
-                        best_dist_sq = dist_sq;
-                      }
-                    }
-                  }
-                }
-              }
-
-              if (mode == MREMAP_MODE_LOOP_POLY_NEAREST) {
-                mesh_remap_interp_poly_data_get(mp_src,
-                                                loops_src,
-                                                (const float(*)[3])vcos_src,
-                                                hit_co,
-                                                &buff_size_interp,
-                                                &vcos_interp,
-                                                true,
-                                                &indices_interp,
-                                                &weights_interp,
-                                                false,
-                                                &best_loop_index_src);
-
-                mesh_remap_item_define(r_map,
-                                       lidx_dst,
-                                       isld_res->hit_dist,
-                                       best_island_index,
-                                       1,
-                                       &best_loop_index_src,
-                                       &full_weight);
-              }
-              else {
-                const int sources_num = mesh_remap_interp_poly_data_get(
-                    mp_src,
-                    loops_src,
-                    (const float(*)[3])vcos_src,
-                    hit_co,
-                    &buff_size_interp,
-                    &vcos_interp,
-                    true,
-                    &indices_interp,
-                    &weights_interp,
-                    true,
-                    NULL);
-
-                mesh_remap_item_define(r_map,
-                                       lidx_dst,
-                                       isld_res->hit_dist,
-                                       best_island_index,
-                                       sources_num,
-                                       indices_interp,
-                                       weights_interp);
-              }
-
-              pidx_src_prev = pidx_src;
-            }
-            else {
-              /* No source for this loop in this island. */
-              /* TODO: would probably be better to get a source
-               * at all cost in best island anyway? */
-              mesh_remap_item_define(r_map, lidx_dst, FLT_MAX, best_island_index, 0, NULL, NULL);
-            }
-          }
-        }
-
-        BLI_astar_solution_clear(&as_solution);
-      }
+    /* And check each dest poly! */
+    {
+      SpinLock lock;
+      BLI_spin_init(&lock);
+
+      MeshRemapLoopsTaskData data = {
+          .mode = mode,
+          .space_transform = space_transform,
+          .max_dist = max_dist,
+          .max_dist_sq = max_dist_sq,
+          .ray_radius = ray_radius,
+          .verts_dst = verts_dst,
+          .loops_dst = loops_dst,
+          .polys_dst = polys_dst,
+          .poly_nors_dst = poly_nors_dst,
+          .loop_nors_dst = loop_nors_dst,
+          .treedata = treedata,
+          .num_trees = num_trees,
+          .use_from_vert = use_from_vert,
+          .use_islands = use_islands,
+          .island_store = &island_store,
+          .as_graphdata = as_graphdata,
+          .isld_steps_src = isld_steps_src,
+          .verts_src = verts_src,
+          .loops_src = loops_src,
+          .polys_src = polys_src,
+          .looptri_src = looptri_src,
+          .vcos_src = vcos_src,
+          .poly_nors_src = poly_nors_src,
+          .loop_nors_src = loop_nors_src,
+          .poly_cents_src = poly_cents_src,
+          .vert_to_loop_map_src = vert_to_loop_map_src,
+          .vert_to_poly_map_src = vert_to_poly_map_src,
+          .poly_to_looptri_map_src = poly_to_looptri_map_src,
+          .loop_to_poly_map_src = loop_to_poly_map_src,
+          .r_map = r_map,
+          .lock = &lock,
+      };
+
+      MeshRemapTLS tls_data;
+      TaskParallelSettings settings;
+      mesh_remap_task_settings_init(&settings, &tls_data);
+      BLI_task_parallel_range(0, numpolys_dst, &data, mesh_remap_calc_loops_poly_cb, &settings);
+
+      BLI_spin_end(&lock);
     }
 
     for (tindex = 0; tindex < num_trees; tindex++) {
-      MEM_freeN(islands_res[tindex]);
       free_bvhtree_from_mesh(&treedata[tindex]);
       if (isld_steps_src) {
         BLI_astar_graph_free(&as_graphdata[tindex]);
       }
     }
-    MEM_freeN(islands_res);
     BKE_mesh_loop_islands_free(&island_store);
     MEM_freeN(treedata);
     if (isld_steps_src) {
       MEM_freeN(as_graphdata);
-      BLI_astar_solution_free(&as_solution);
     }
 
     if (vcos_src) {
       MEM_freeN(vcos_src);
     }
-    if (vert_to_loop_map_src) {
-      MEM_freeN(vert_to_loop_map_src);
-    }
-    if (vert_to_loop_map_src_buff) {
-      MEM_freeN(vert_to_loop_map_src_buff);
-    }
-    if (vert_to_poly_map_src) {
-      MEM_freeN(vert_to_poly_map_src);
-    }
-    if (vert_to_poly_map_src_buff) {
-      MEM_freeN(vert_to_poly_map_src_buff);
-    }
     if (edge_to_poly_map_src) {
       MEM_freeN(edge_to_poly_map_src);
     }
@@ -2181,15 +2368,63 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     if (poly_cents_src) {
       MEM_freeN(poly_cents_src);
     }
-    if (vcos_interp) {
-      MEM_freeN(vcos_interp);
-    }
-    if (indices_interp) {
-      MEM_freeN(indices_interp);
+  }
+}
+
+static void mesh_remap_calc_polys_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  const MeshRemapTaskData *data = userdata;
+  MeshRemapTLS *tls_data = tls->userdata_chunk;
+  const SpaceTransform *space_transform = data->space_transform;
+  const MPoly *mp = &data->polys_dst[i];
+  const float full_weight = 1.0f;
+  float hit_dist;
+  float tmp_co[3], tmp_no[3];
+  bool found;
+  int looptri_index;
+
+  BKE_mesh_calc_poly_center(mp, &data->loops_dst[mp->loopstart], data->verts_dst, tmp_co);
+
+  if (data->mode == MREMAP_MODE_POLY_NEAREST) {
+    /* Convert the vertex to tree coordinates, if needed. */
+    if (space_transform) {
+      BLI_space_transform_apply(space_transform, tmp_co);
     }
-    if (weights_interp) {
-      MEM_freeN(weights_interp);
+
+    found = mesh_remap_bvhtree_query_nearest(
+        data->treedata, &tls_data->nearest, tmp_co, data->max_dist_sq, &hit_dist);
+    looptri_index = tls_data->nearest.index;
+  }
+  else { /* if (data->mode == MREMAP_MODE_POLY_NOR) { */
+    copy_v3_v3(tmp_no, data->poly_nors_dst[i]);
+
+    /* Convert the vertex to tree coordinates, if needed. */
+    if (space_transform) {
+      BLI_space_transform_apply(space_transform, tmp_co);
+      BLI_space_transform_apply_normal(space_transform, tmp_no);
     }
+
+    found = mesh_remap_bvhtree_query_raycast(data->treedata,
+                                             &tls_data->rayhit,
+                                             tmp_co,
+                                             tmp_no,
+                                             data->ray_radius,
+                                             data->max_dist,
+                                             &hit_dist);
+    looptri_index = tls_data->rayhit.index;
+  }
+
+  if (found) {
+    const MLoopTri *lt = &data->treedata->looptri[looptri_index];
+    const int poly_index = (int)lt->poly;
+    mesh_remap_item_define_ex(
+        data->r_map, data->lock, i, hit_dist, 0, 1, &poly_index, &full_weight);
+  }
+  else {
+    /* No source for this dest poly! */
+    BKE_mesh_remap_item_define_invalid(data->r_map, i);
   }
 }
 
@@ -2246,64 +2481,38 @@ void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
     BVHTreeRayHit rayhit = {0};
     float hit_dist;
 
     BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
 
-    if (mode == MREMAP_MODE_POLY_NEAREST) {
-      nearest.index = -1;
-
-      for (i = 0; i < numpolys_dst; i++) {
-        MPoly *mp = &polys_dst[i];
-
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[nearest.index];
-          const int poly_index = (int)lt->poly;
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
-        }
-        else {
-          /* No source for this dest poly! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-    }
-    else if (mode == MREMAP_MODE_POLY_NOR) {
-      BLI_assert(poly_nors_dst);
-
-      for (i = 0; i < numpolys_dst; i++) {
-        MPoly *mp = &polys_dst[i];
-
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
-        copy_v3_v3(tmp_no, poly_nors_dst[i]);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-          BLI_space_transform_apply_normal(space_transform, tmp_no);
-        }
-
-        if (mesh_remap_bvhtree_query_raycast(
-                &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[rayhit.index];
-          const int poly_index = (int)lt->poly;
-
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
-        }
-        else {
-          /* No source for this dest poly! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
+    if (ELEM(mode, MREMAP_MODE_POLY_NEAREST, MREMAP_MODE_POLY_NOR)) {
+      SpinLock lock;
+      BLI_spin_init(&lock);
+
+      BLI_assert((mode != MREMAP_MODE_POLY_NOR) || poly_nors_dst);
+
+      MeshRemapTaskData data = {
+          .mode = mode,
+          .space_transform = space_transform,
+          .max_dist = max_dist,
+          .max_dist_sq = max_dist_sq,
+          .ray_radius = ray_radius,
+          .verts_dst = verts_dst,
+          .loops_dst = loops_dst,
+          .polys_dst = polys_dst,
+          .poly_nors_dst = (const float(*)[3])poly_nors_dst,
+          .treedata = &treedata,
+          .r_map = r_map,
+          .lock = &lock,
+      };
+
+      MeshRemapTLS tls_data;
+      TaskParallelSettings settings;
+      mesh_remap_task_settings_init(&settings, &tls_data);
+      BLI_task_parallel_range(0, numpolys_dst, &data, mesh_remap_calc_polys_cb, &settings);
+
+      BLI_spin_end(&lock);
     }
     else if (mode == MREMAP_MODE_POLY_POLYINTERP_PNORPROJ) {
       /* We cast our rays randomly, with a pseudo-even distribution
@@ -33,8 +33,10 @@
 #include "BLI_threads.h"
 
 #include "BKE_bvhutils.h"
+#include "BKE_customdata.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_shrinkwrap.h"
 #include "BKE_subdiv_ccg.h"
@@ -52,6 +54,7 @@ void BKE_mesh_runtime_reset(Mesh *mesh)
   mesh->runtime.eval_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime eval_mutex");
   BLI_mutex_init(mesh->runtime.eval_mutex);
   mesh->runtime.bvh_cache = NULL;
+  BKE_mesh_runtime_geometry_stamp_update(mesh);
 }
 
 /* Clear all pointers which we don't want to be shared on copying the datablock.
@@ -68,9 +71,29 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
   runtime->bvh_cache = NULL;
   runtime->shrinkwrap_data = NULL;
+  runtime->poly_normals = NULL;
+  runtime->loop_normals = NULL;
+  runtime->vert_to_poly_map = NULL;
+  runtime->vert_to_poly_map_mem = NULL;
+  runtime->vert_to_loop_map = NULL;
+  runtime->vert_to_loop_map_mem = NULL;
+  runtime->vert_to_edge_map = NULL;
+  runtime->vert_to_edge_map_mem = NULL;
 
   mesh->runtime.eval_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime eval_mutex");
   BLI_mutex_init(mesh->runtime.eval_mutex);
+
+  BKE_mesh_runtime_geometry_stamp_update(mesh);
+}
+
+/**
+ * Give the mesh a new #Mesh_Runtime.geometry_stamp, to be called when its data changed.
+ * Stamps are unique for the whole session, so they also tell apart different meshes.
+ */
+void BKE_mesh_runtime_geometry_stamp_update(Mesh *mesh)
+{
+  static uint64_t geometry_stamp = 0;
+  mesh->runtime.geometry_stamp = atomic_add_and_fetch_uint64(&geometry_stamp, 1);
 }
 
 void BKE_mesh_runtime_clear_cache(Mesh *mesh)
@@ -175,6 +198,152 @@ const MLoopTri *BKE_mesh_runtime_looptri_ensure(Mesh *mesh)
   return looptri;
 }
 
+/**
+ * Face normals, calculated on first access and kept until #BKE_mesh_runtime_clear_normals.
+ *
+ * Unlike #BKE_mesh_ensure_normals this never writes to the mesh data itself,
+ * so it can be used on meshes referencing the layers of another mesh,
+ * and from multiple threads at once.
+ */
+const float (*BKE_mesh_runtime_poly_normals_ensure(Mesh *mesh))[3]
+{
+  BLI_assert(mesh->runtime.wrapper_type == ME_WRAPPER_TYPE_MDATA);
+
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  if (mesh->runtime.poly_normals == NULL) {
+    float(*poly_normals)[3] = MEM_malloc_arrayN(
+        (size_t)mesh->totpoly, sizeof(*poly_normals), __func__);
+    BKE_mesh_calc_normals_poly(mesh->mvert,
+                               NULL,
+                               mesh->totvert,
+                               mesh->mloop,
+                               mesh->mpoly,
+                               mesh->totloop,
+                               mesh->totpoly,
+                               poly_normals,
+                               true);
+    mesh->runtime.poly_normals = poly_normals;
+  }
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+
+  return (const float(*)[3])mesh->runtime.poly_normals;
+}
+
+/**
+ * Split (face corner) normals, using the mesh auto-smooth settings and custom normals.
+ * Calculated on first access and kept until #BKE_mesh_runtime_clear_normals.
+ */
+const float (*BKE_mesh_runtime_loop_normals_ensure(Mesh *mesh))[3]
+{
+  /* Before taking the lock, which the poly normals need too. */
+  const float(*poly_normals)[3] = BKE_mesh_runtime_poly_normals_ensure(mesh);
+
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  if (mesh->runtime.loop_normals == NULL) {
+    const bool use_split_normals = (mesh->flag & ME_AUTOSMOOTH) != 0;
+    const float split_angle = use_split_normals ? mesh->smoothresh : (float)M_PI;
+    short(*clnors)[2] = CustomData_get_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL);
+
+    float(*loop_normals)[3] = MEM_malloc_arrayN(
+        (size_t)mesh->totloop, sizeof(*loop_normals), __func__);
+    BKE_mesh_normals_loop_split(mesh->mvert,
+                                mesh->totvert,
+                                mesh->medge,
+                                mesh->totedge,
+                                mesh->mloop,
+                                loop_normals,
+                                mesh->totloop,
+                                mesh->mpoly,
+                                poly_normals,
+                                mesh->totpoly,
+                                use_split_normals,
+                                split_angle,
+                                NULL,
+                                clnors,
+                                NULL);
+    mesh->runtime.loop_normals = loop_normals;
+  }
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+
+  return (const float(*)[3])mesh->runtime.loop_normals;
+}
+
+/**
+ * Vertex to face map, built on first access and kept until
+ * #BKE_mesh_runtime_clear_topology_maps.
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_poly_map_ensure(Mesh *mesh)
+{
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  if (mesh->runtime.vert_to_poly_map == NULL) {
+    BKE_mesh_vert_poly_map_create(&mesh->runtime.vert_to_poly_map,
+                                  &mesh->runtime.vert_to_poly_map_mem,
+                                  mesh->mpoly,
+                                  mesh->mloop,
+                                  mesh->totvert,
+                                  mesh->totpoly,
+                                  mesh->totloop);
+  }
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+
+  return mesh->runtime.vert_to_poly_map;
+}
+
+/**
+ * Vertex to face corner map, built on first access and kept until
+ * #BKE_mesh_runtime_clear_topology_maps.
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_loop_map_ensure(Mesh *mesh)
+{
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  if (mesh->runtime.vert_to_loop_map == NULL) {
+    BKE_mesh_vert_loop_map_create(&mesh->runtime.vert_to_loop_map,
+                                  &mesh->runtime.vert_to_loop_map_mem,
+                                  mesh->mpoly,
+                                  mesh->mloop,
+                                  mesh->totvert,
+                                  mesh->totpoly,
+                                  mesh->totloop);
+  }
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+
+  return mesh->runtime.vert_to_loop_map;
+}
+
+/**
+ * Vertex to edge map, built on first access and kept until
+ * #BKE_mesh_runtime_clear_topology_maps.
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_edge_map_ensure(Mesh *mesh)
+{
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  if (mesh->runtime.vert_to_edge_map == NULL) {
+    BKE_mesh_vert_edge_map_create(&mesh->runtime.vert_to_edge_map,
+                                  &mesh->runtime.vert_to_edge_map_mem,
+                                  mesh->medge,
+                                  mesh->totvert,
+                                  mesh->totedge);
+  }
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+
+  return mesh->runtime.vert_to_edge_map;
+}
+
 /* This is a copy of DM_verttri_from_looptri(). */
 void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
                                            const MLoop *mloop,
@@ -227,8 +396,38 @@ bool BKE_mesh_runtime_clear_edit_data(Mesh *mesh)
   return true;
 }
 
+/**
+ * Free the cached normals, to be called whenever vertex positions,
+ * the auto-smooth settings or custom normals change.
+ *
+ * \note Not thread safe, the caller must have exclusive access to the mesh.
+ */
+void BKE_mesh_runtime_clear_normals(Mesh *mesh)
+{
+  MEM_SAFE_FREE(mesh->runtime.poly_normals);
+  MEM_SAFE_FREE(mesh->runtime.loop_normals);
+}
+
+/**
+ * Free the cached adjacency maps, to be called whenever the topology changes.
+ *
+ * \note Not thread safe, the caller must have exclusive access to the mesh.
+ */
+void BKE_mesh_runtime_clear_topology_maps(Mesh *mesh)
+{
+  MEM_SAFE_FREE(mesh->runtime.vert_to_poly_map);
+  MEM_SAFE_FREE(mesh->runtime.vert_to_poly_map_mem);
+  MEM_SAFE_FREE(mesh->runtime.vert_to_loop_map);
+  MEM_SAFE_FREE(mesh->runtime.vert_to_loop_map_mem);
+  MEM_SAFE_FREE(mesh->runtime.vert_to_edge_map);
+  MEM_SAFE_FREE(mesh->runtime.vert_to_edge_map_mem);
+}
+
 void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
 {
+  BKE_mesh_runtime_clear_normals(mesh);
+  BKE_mesh_runtime_clear_topology_maps(mesh);
+
   if (mesh->runtime.bvh_cache) {
     bvhcache_free(mesh->runtime.bvh_cache);
     mesh->runtime.bvh_cache = NULL;
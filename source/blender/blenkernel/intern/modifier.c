@@ -25,6 +25,7 @@
  */
 
 #include <float.h>
+#include <limits.h>
 #include <math.h>
 #include <stdarg.h>
 #include <stddef.h>
@@ -39,8 +40,10 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_dynstr.h"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_path_util.h"
 #include "BLI_session_uuid.h"
 #include "BLI_string.h"
@@ -73,6 +76,8 @@
 
 #include "MOD_modifiertypes.h"
 
+#include "PIL_time.h"
+
 #include "CLG_log.h"
 
 static CLG_LogRef LOG = {"bke.modifier"};
@@ -275,6 +280,88 @@ void BKE_modifiers_clear_errors(Object *ob)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Evaluation Statistics
+ *
+ * Time and memory of each modifier in the last evaluation of the stack, so that the modifier
+ * slowing down a heavy scene can be found without a profiler. The totals of an object are
+ * logged per evaluation with `--log "bke.modifier.stats" --log-level 1`.
+ *
+ * Modifiers skipped because the stack resumed from a cached result report the statistics of the
+ * evaluation that computed it, flagged with #eModifierFlag_EvalStatsCached.
+ * \{ */
+
+static CLG_LogRef LOG_STATS = {"bke.modifier.stats"};
+
+void BKE_modifiers_clear_eval_stats(Object *ob)
+{
+  LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+    md->execution_time = 0.0;
+    md->output_memory = 0;
+    md->flag &= ~eModifierFlag_EvalStatsCached;
+  }
+}
+
+/**
+ * Accumulate the time since \a start_time (from #PIL_check_seconds_timer) into the statistics
+ * of the modifier, modifiers can be evaluated more than once per stack evaluation for orco
+ * data. \a mesh_result is the mesh returned by the modifier, or NULL for deform modifiers.
+ */
+void BKE_modifier_eval_stats_add(ModifierData *md,
+                                 const double start_time,
+                                 const Mesh *mesh_result)
+{
+  md->execution_time += PIL_check_seconds_timer() - start_time;
+  if (mesh_result != NULL) {
+    md->output_memory = (int)min_zz(BKE_mesh_memory_size(mesh_result) / 1024, INT_MAX);
+  }
+}
+
+/**
+ * Log the statistics of the last evaluation of the modifier stack of the object, one line
+ * for the object and one per modifier, sorted by stack order.
+ */
+void BKE_modifiers_eval_stats_log(const Object *ob, const float ctime)
+{
+  if (!CLOG_CHECK(&LOG_STATS, 1)) {
+    return;
+  }
+
+  double total_time = 0.0;
+  size_t total_memory = 0;
+  LISTBASE_FOREACH (const ModifierData *, md, &ob->modifiers) {
+    total_time += md->execution_time;
+    total_memory += (size_t)md->output_memory;
+  }
+
+  DynStr *dynstr = BLI_dynstr_new();
+  BLI_dynstr_appendf(dynstr,
+                     "%s, frame %.2f: %.3f ms, %zu KB",
+                     ob->id.name + 2,
+                     ctime,
+                     total_time * 1000.0,
+                     total_memory);
+  LISTBASE_FOREACH (const ModifierData *, md, &ob->modifiers) {
+    if (md->execution_time == 0.0) {
+      continue;
+    }
+    BLI_dynstr_appendf(dynstr,
+                       "\n  %-24s %9.3f ms (%5.1f%%) %9d KB%s",
+                       md->name,
+                       md->execution_time * 1000.0,
+                       total_time > 0.0 ? md->execution_time / total_time * 100.0 : 0.0,
+                       md->output_memory,
+                       (md->flag & eModifierFlag_EvalStatsCached) ? " (cached)" : "");
+  }
+
+  char *str = BLI_dynstr_get_cstring(dynstr);
+  CLOG_STR_INFO(&LOG_STATS, 1, str);
+  MEM_freeN(str);
+  BLI_dynstr_free(dynstr);
+}
+
+/** \} */
+
 void BKE_modifiers_foreach_ID_link(Object *ob, IDWalkFunc walk, void *userData)
 {
   ModifierData *md = ob->modifiers.first;
@@ -344,6 +431,7 @@ void BKE_modifier_copydata_ex(ModifierData *md, ModifierData *target, const int
   target->mode = md->mode;
   target->flag = md->flag;
   target->ui_expand_flag = md->ui_expand_flag;
+  target->update_count = md->update_count;
 
   if (mti->copyData) {
     mti->copyData(md, target, flag);
@@ -285,6 +285,7 @@ static void object_free_data(ID *id)
   /* BKE_<id>_free shall never touch to ID->us. Never ever. */
   BKE_object_free_modifiers(ob, LIB_ID_CREATE_NO_USER_REFCOUNT);
   BKE_object_free_shaderfx(ob, LIB_ID_CREATE_NO_USER_REFCOUNT);
+  mesh_modifier_stack_cache_free(ob);
 
   MEM_SAFE_FREE(ob->mat);
   MEM_SAFE_FREE(ob->matbits);
@@ -4265,6 +4266,7 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int UNUSED(flag))
   runtime->data_eval = NULL;
   runtime->mesh_deform_eval = NULL;
   runtime->curve_cache = NULL;
+  runtime->modifier_stack_cache = NULL;
 }
 
 /**
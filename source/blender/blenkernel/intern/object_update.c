@@ -304,7 +304,7 @@ void BKE_object_sync_to_original(Depsgraph *depsgraph, Object *object)
   object_orig->transflag = object->transflag;
   object_orig->flag = object->flag;
 
-  /* Copy back error messages from modifiers. */
+  /* Copy back error messages and evaluation statistics from modifiers. */
   for (ModifierData *md = object->modifiers.first, *md_orig = object_orig->modifiers.first;
        md != NULL && md_orig != NULL;
        md = md->next, md_orig = md_orig->next) {
@@ -313,6 +313,10 @@ void BKE_object_sync_to_original(Depsgraph *depsgraph, Object *object)
     if (md->error != NULL) {
       md_orig->error = BLI_strdup(md->error);
     }
+    md_orig->execution_time = md->execution_time;
+    md_orig->output_memory = md->output_memory;
+    SET_FLAG_FROM_TEST(
+        md_orig->flag, md->flag & eModifierFlag_EvalStatsCached, eModifierFlag_EvalStatsCached);
   }
 }
 
@@ -1759,6 +1759,12 @@ void BKE_sculpt_update_object_for_edit(
 
   BLI_assert(ob_orig == DEG_get_original_object(ob_orig));
 
+  /* Edits write to the arrays in place. The mesh is no longer shared with its evaluated copy
+   * once in a paint mode, but may still be when the mode was just entered. */
+  if (ob_orig->type == OB_MESH) {
+    BKE_mesh_unshare_layers(ob_orig->data);
+  }
+
   sculpt_update_object(depsgraph, ob_orig, me_eval, need_pmap, need_mask, need_colors);
 }
 
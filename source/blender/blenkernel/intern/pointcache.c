@@ -21,6 +21,7 @@
  * \ingroup bke
  */
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -44,8 +45,11 @@
 #include "DNA_simulation_types.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -96,6 +100,14 @@
 #  include "BLI_winstuff.h"
 #endif
 
+/* needed for reading packed disk caches */
+#ifndef WIN32
+#  include <sys/mman.h>
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
 #define PTCACHE_DATA_FROM(data, type, from) \
   if (data[type]) { \
     memcpy(data[type], from, ptcache_data_size[type]); \
@@ -138,6 +150,7 @@ static int ptcache_file_compressed_write(
     PTCacheFile *pf, unsigned char *in, unsigned int in_len, unsigned char *out, int mode);
 static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot, unsigned int size);
 static int ptcache_file_read(PTCacheFile *pf, void *f, unsigned int tot, unsigned int size);
+static void ptcache_file_rewind(PTCacheFile *pf);
 
 /* Common functions */
 static int ptcache_basic_header_read(PTCacheFile *pf)
@@ -145,11 +158,11 @@ static int ptcache_basic_header_read(PTCacheFile *pf)
   int error = 0;
 
   /* Custom functions should read these basic elements too! */
-  if (!error && !fread(&pf->totpoint, sizeof(unsigned int), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &pf->totpoint, 1, sizeof(unsigned int))) {
     error = 1;
   }
 
-  if (!error && !fread(&pf->data_types, sizeof(unsigned int), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &pf->data_types, 1, sizeof(unsigned int))) {
     error = 1;
   }
 
@@ -158,11 +171,11 @@ static int ptcache_basic_header_read(PTCacheFile *pf)
 static int ptcache_basic_header_write(PTCacheFile *pf)
 {
   /* Custom functions should write these basic elements too! */
-  if (!fwrite(&pf->totpoint, sizeof(unsigned int), 1, pf->fp)) {
+  if (!ptcache_file_write(pf, &pf->totpoint, 1, sizeof(unsigned int))) {
     return 0;
   }
 
-  if (!fwrite(&pf->data_types, sizeof(unsigned int), 1, pf->fp)) {
+  if (!ptcache_file_write(pf, &pf->data_types, 1, sizeof(unsigned int))) {
     return 0;
   }
 
@@ -1355,6 +1368,13 @@ static int ptcache_path(PTCacheID *pid, char *filename)
   return BLI_path_slash_ensure(filename); /* new strlen() */
 }
 
+/* External caches are always read from one file per frame. */
+static bool ptcache_use_packed(const PointCache *cache)
+{
+  return (cache->flag & (PTCACHE_DISK_CACHE_PACKED | PTCACHE_EXTERNAL)) ==
+         PTCACHE_DISK_CACHE_PACKED;
+}
+
 static int ptcache_filename(PTCacheID *pid, char *filename, int cfra, short do_path, short do_ext)
 {
   int len = 0;
@@ -1406,6 +1426,10 @@ static int ptcache_filename(PTCacheID *pid, char *filename, int cfra, short do_p
         BLI_snprintf(newname, MAX_PTCACHE_FILE, "_%06d%s", cfra, ext);
       }
     }
+    else if (ptcache_use_packed(pid->cache)) {
+      /* All frames are in one file, `cfra` is unused. */
+      BLI_snprintf(newname, MAX_PTCACHE_FILE, "_%02u" PTCACHE_PACKED_EXT, pid->stack_index);
+    }
     else {
       /* Always 6 chars. */
       BLI_snprintf(newname, MAX_PTCACHE_FILE, "_%06d_%02u%s", cfra, pid->stack_index, ext);
@@ -1416,6 +1440,531 @@ static int ptcache_filename(PTCacheID *pid, char *filename, int cfra, short do_p
   return len; /* make sure the above string is always 16 chars */
 }
 
+/* Packed disk cache
+ *
+ * With #PTCACHE_DISK_CACHE_PACKED all frames of a cache are appended to a single file instead
+ * of writing one file per frame, which avoids creating thousands of small files for long bakes.
+ *
+ * After the #PTCACHE_PACK_HEADER, the file is a sequence of records. Each record is a
+ * #PTCachePackRecord followed by `len` bytes, which are exactly the contents the per-frame
+ * file would have had. A later record for the same frame replaces earlier ones, and records
+ * with #PTCACHE_PACK_RECORD_REMOVED remove the frame, so writing only appends to the file.
+ * A record cut short by an interrupted write is ignored and overwritten by the next append.
+ * Once replaced and removed records take up as much of the file as the live ones, the live
+ * records are rewritten to a new file, see #ptcache_pack_compact.
+ *
+ * The index of frames is built by reading the record headers once, frames are then read back
+ * from a memory map of the file. Frames written during simulation are serialized and
+ * compressed in a task pool, see #ptcache_pack_frame_write_async.
+ */
+
+#define PTCACHE_PACK_HEADER "BPHYPACK"
+#define PTCACHE_PACK_HEADER_LEN 8
+#define PTCACHE_PACK_VERSION 1
+
+#define PTCACHE_PACK_RECORD_REMOVED (1 << 0)
+
+/** Bytes of dead records below which the file isn't compacted. */
+#define PTCACHE_PACK_COMPACT_MIN (16 * 1024 * 1024)
+
+typedef struct PTCachePackRecord {
+  int frame;
+  unsigned int flag;
+  uint64_t len;
+} PTCachePackRecord;
+
+typedef struct PTCachePackFrame {
+  /** Offset of the frame data in the file, -1 while the frame is still being written. */
+  int64_t offset;
+  uint64_t len;
+} PTCachePackFrame;
+
+typedef struct PTCachePack {
+  struct PTCachePack *next, *prev;
+  char filepath[MAX_PTCACHE_FILE];
+
+  /** Protects all members below. */
+  ThreadMutex mutex;
+  /** Frame number to #PTCachePackFrame, NULL until the file was read. */
+  GHash *frames;
+  /** End of the last complete record, where the next one is written. */
+  int64_t file_len;
+  /** Kept open for appending. */
+  FILE *fp;
+#ifndef WIN32
+  int fd;
+  unsigned char *map;
+  size_t map_len;
+#endif
+
+  /** Protects the task pool, separate so waiting for the tasks doesn't block them. */
+  ThreadMutex pool_mutex;
+  TaskPool *pool;
+  int pool_tasks_len;
+} PTCachePack;
+
+/** All packed files that were accessed, so handles and the index are shared between threads. */
+static ListBase ptcache_packs = {NULL, NULL};
+static ThreadMutex ptcache_packs_mutex = BLI_MUTEX_INITIALIZER;
+
+static PTCachePack *ptcache_pack_get(const char *filepath)
+{
+  BLI_mutex_lock(&ptcache_packs_mutex);
+
+  PTCachePack *pack = BLI_findstring(&ptcache_packs, filepath, offsetof(PTCachePack, filepath));
+  if (pack == NULL) {
+    pack = MEM_callocN(sizeof(PTCachePack), "PTCachePack");
+    BLI_strncpy(pack->filepath, filepath, sizeof(pack->filepath));
+    BLI_mutex_init(&pack->mutex);
+    BLI_mutex_init(&pack->pool_mutex);
+#ifndef WIN32
+    pack->fd = -1;
+#endif
+    BLI_addtail(&ptcache_packs, pack);
+  }
+
+  BLI_mutex_unlock(&ptcache_packs_mutex);
+
+  return pack;
+}
+
+static void ptcache_pack_frame_set(PTCachePack *pack, int frame, int64_t offset, uint64_t len)
+{
+  void **val_p;
+  if (!BLI_ghash_ensure_p(pack->frames, POINTER_FROM_INT(frame), &val_p)) {
+    *val_p = MEM_mallocN(sizeof(PTCachePackFrame), __func__);
+  }
+  PTCachePackFrame *entry = *val_p;
+  entry->offset = offset;
+  entry->len = len;
+}
+
+static void ptcache_pack_frame_remove(PTCachePack *pack, int frame)
+{
+  BLI_ghash_remove(pack->frames, POINTER_FROM_INT(frame), NULL, MEM_freeN);
+}
+
+/* Build the index of frames from the record headers, the mutex must be held. */
+static void ptcache_pack_frames_ensure(PTCachePack *pack)
+{
+  if (pack->frames != NULL) {
+    return;
+  }
+
+  pack->frames = BLI_ghash_int_new(__func__);
+  pack->file_len = 0;
+
+  FILE *fp = BLI_fopen(pack->filepath, "rb");
+  if (fp == NULL) {
+    return;
+  }
+
+  const int64_t file_size = (int64_t)BLI_file_size(pack->filepath);
+  char header[PTCACHE_PACK_HEADER_LEN];
+  unsigned int version = 0;
+
+  if (fread(header, sizeof(char), PTCACHE_PACK_HEADER_LEN, fp) == PTCACHE_PACK_HEADER_LEN &&
+      STREQLEN(header, PTCACHE_PACK_HEADER, PTCACHE_PACK_HEADER_LEN) &&
+      fread(&version, sizeof(unsigned int), 1, fp) == 1 && version == PTCACHE_PACK_VERSION) {
+    int64_t offset = PTCACHE_PACK_HEADER_LEN + sizeof(unsigned int);
+    PTCachePackRecord record;
+
+    while (fread(&record, sizeof(PTCachePackRecord), 1, fp) == 1) {
+      const int64_t data_offset = offset + (int64_t)sizeof(PTCachePackRecord);
+      if (data_offset + (int64_t)record.len > file_size) {
+        break;
+      }
+
+      if (record.flag & PTCACHE_PACK_RECORD_REMOVED) {
+        ptcache_pack_frame_remove(pack, record.frame);
+      }
+      else {
+        ptcache_pack_frame_set(pack, record.frame, data_offset, record.len);
+      }
+
+      offset = data_offset + (int64_t)record.len;
+      if (BLI_fseek(fp, offset, SEEK_SET) != 0) {
+        break;
+      }
+    }
+
+    pack->file_len = offset;
+  }
+  else {
+    CLOG_ERROR(&LOG, "Not a packed point cache file: %s", pack->filepath);
+  }
+
+  fclose(fp);
+}
+
+/* Cut the file off after the last complete record. */
+static bool ptcache_pack_truncate(PTCachePack *pack)
+{
+  if (fflush(pack->fp) != 0) {
+    return false;
+  }
+#ifdef WIN32
+  return _chsize_s(_fileno(pack->fp), pack->file_len) == 0;
+#else
+  return ftruncate(fileno(pack->fp), (off_t)pack->file_len) == 0;
+#endif
+}
+
+/* Append a record, the mutex must be held. */
+static bool ptcache_pack_append(
+    PTCachePack *pack, int frame, unsigned int flag, const void *data, uint64_t len)
+{
+  ptcache_pack_frames_ensure(pack);
+
+  if (pack->fp == NULL) {
+    /* Will create the dir if needs be, same as "//textures" is created. */
+    BLI_make_existing_file(pack->filepath);
+
+    if (pack->file_len == 0) {
+      const unsigned int version = PTCACHE_PACK_VERSION;
+      pack->fp = BLI_fopen(pack->filepath, "wb");
+      if (pack->fp == NULL) {
+        return false;
+      }
+      if (fwrite(PTCACHE_PACK_HEADER, sizeof(char), PTCACHE_PACK_HEADER_LEN, pack->fp) !=
+              PTCACHE_PACK_HEADER_LEN ||
+          fwrite(&version, sizeof(unsigned int), 1, pack->fp) != 1) {
+        fclose(pack->fp);
+        pack->fp = NULL;
+        return false;
+      }
+      pack->file_len = PTCACHE_PACK_HEADER_LEN + sizeof(unsigned int);
+    }
+    else {
+      pack->fp = BLI_fopen(pack->filepath, "rb+");
+      if (pack->fp == NULL) {
+        return false;
+      }
+      /* Remove the tail of an interrupted write, which would otherwise be read back as records
+       * once followed by new ones. */
+      if (!ptcache_pack_truncate(pack)) {
+        fclose(pack->fp);
+        pack->fp = NULL;
+        return false;
+      }
+    }
+  }
+
+  const PTCachePackRecord record = {frame, flag, len};
+
+  if (BLI_fseek(pack->fp, pack->file_len, SEEK_SET) != 0 ||
+      fwrite(&record, sizeof(PTCachePackRecord), 1, pack->fp) != 1 ||
+      (len != 0 && fwrite(data, len, 1, pack->fp) != 1) || fflush(pack->fp) != 0) {
+    /* Don't leave a partial record behind. */
+    ptcache_pack_truncate(pack);
+    return false;
+  }
+
+  const int64_t data_offset = pack->file_len + (int64_t)sizeof(PTCachePackRecord);
+  pack->file_len = data_offset + (int64_t)len;
+
+  if (flag & PTCACHE_PACK_RECORD_REMOVED) {
+    ptcache_pack_frame_remove(pack, frame);
+  }
+  else {
+    ptcache_pack_frame_set(pack, frame, data_offset, len);
+  }
+
+  return true;
+}
+
+#ifndef WIN32
+static void ptcache_pack_unmap(PTCachePack *pack)
+{
+  if (pack->map != NULL) {
+    munmap(pack->map, pack->map_len);
+    pack->map = NULL;
+    pack->map_len = 0;
+  }
+  if (pack->fd != -1) {
+    close(pack->fd);
+    pack->fd = -1;
+  }
+}
+#endif
+
+/**
+ * Copy the data of a frame from the file, the mutex must be held.
+ * \return NULL when the frame isn't in the file.
+ */
+static unsigned char *ptcache_pack_frame_read(PTCachePack *pack, int frame, size_t *r_len)
+{
+  ptcache_pack_frames_ensure(pack);
+
+  const PTCachePackFrame *entry = BLI_ghash_lookup(pack->frames, POINTER_FROM_INT(frame));
+  if (entry == NULL || entry->offset < 0) {
+    return NULL;
+  }
+
+  unsigned char *data = MEM_mallocN(max_zz(entry->len, 1), "PTCachePack frame");
+
+#ifndef WIN32
+  /* The file only grows, so the map only needs to be updated when reading appended frames. */
+  const size_t end = (size_t)entry->offset + entry->len;
+  if (pack->map_len < end) {
+    ptcache_pack_unmap(pack);
+
+    pack->fd = BLI_open(pack->filepath, O_BINARY | O_RDONLY, 0);
+    if (pack->fd != -1) {
+      const size_t size = BLI_file_descriptor_size(pack->fd);
+      if (size != (size_t)-1 && size >= end) {
+        void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, pack->fd, 0);
+        if (map != MAP_FAILED) {
+          pack->map = map;
+          pack->map_len = size;
+        }
+      }
+    }
+  }
+
+  if (pack->map == NULL) {
+    MEM_freeN(data);
+    return NULL;
+  }
+  memcpy(data, pack->map + entry->offset, entry->len);
+#else
+  /* The memory map emulation isn't thread safe, read the frame instead. */
+  FILE *fp = BLI_fopen(pack->filepath, "rb");
+  const bool ok = (fp != NULL && BLI_fseek(fp, entry->offset, SEEK_SET) == 0 &&
+                   (entry->len == 0 || fread(data, entry->len, 1, fp) == 1));
+  if (fp != NULL) {
+    fclose(fp);
+  }
+  if (!ok) {
+    MEM_freeN(data);
+    return NULL;
+  }
+#endif
+
+  *r_len = entry->len;
+  return data;
+}
+
+typedef struct PTCachePackCompactItem {
+  int frame;
+  PTCachePackFrame *entry;
+} PTCachePackCompactItem;
+
+static int ptcache_pack_compact_item_cmp(const void *a, const void *b)
+{
+  const PTCachePackCompactItem *item_a = a;
+  const PTCachePackCompactItem *item_b = b;
+  return (item_a->entry->offset > item_b->entry->offset) -
+         (item_a->entry->offset < item_b->entry->offset);
+}
+
+/**
+ * Rewrite the live records to a new file when dead ones (replaced frames and removals) take up
+ * enough of it, the mutex must be held. Frames still being written are appended afterwards.
+ */
+static void ptcache_pack_compact(PTCachePack *pack)
+{
+  ptcache_pack_frames_ensure(pack);
+
+  const int64_t header_len = PTCACHE_PACK_HEADER_LEN + sizeof(unsigned int);
+  int64_t live_len = 0;
+  int items_len = 0;
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, pack->frames) {
+    const PTCachePackFrame *entry = BLI_ghashIterator_getValue(&gh_iter);
+    if (entry->offset >= 0) {
+      live_len += (int64_t)sizeof(PTCachePackRecord) + (int64_t)entry->len;
+      items_len++;
+    }
+  }
+
+  const int64_t dead_len = pack->file_len - header_len - live_len;
+  if (dead_len < PTCACHE_PACK_COMPACT_MIN || dead_len < live_len) {
+    return;
+  }
+
+  /* Keep the records in the order they were written. */
+  PTCachePackCompactItem *items = MEM_malloc_arrayN(items_len, sizeof(*items), __func__);
+  int i = 0;
+  GHASH_ITER (gh_iter, pack->frames) {
+    PTCachePackFrame *entry = BLI_ghashIterator_getValue(&gh_iter);
+    if (entry->offset >= 0) {
+      items[i].frame = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
+      items[i].entry = entry;
+      i++;
+    }
+  }
+  qsort(items, items_len, sizeof(*items), ptcache_pack_compact_item_cmp);
+
+  char filepath_tmp[MAX_PTCACHE_FILE + 4];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.tmp", pack->filepath);
+
+  if (pack->fp != NULL) {
+    fclose(pack->fp);
+    pack->fp = NULL;
+  }
+#ifndef WIN32
+  ptcache_pack_unmap(pack);
+#endif
+
+  FILE *fp_src = BLI_fopen(pack->filepath, "rb");
+  FILE *fp_dst = BLI_fopen(filepath_tmp, "wb");
+  int64_t *offsets = MEM_malloc_arrayN(items_len, sizeof(*offsets), __func__);
+  const unsigned int version = PTCACHE_PACK_VERSION;
+  bool ok = (fp_src != NULL && fp_dst != NULL &&
+             fwrite(PTCACHE_PACK_HEADER, sizeof(char), PTCACHE_PACK_HEADER_LEN, fp_dst) ==
+                 PTCACHE_PACK_HEADER_LEN &&
+             fwrite(&version, sizeof(unsigned int), 1, fp_dst) == 1);
+
+  int64_t offset = header_len;
+  for (i = 0; ok && i < items_len; i++) {
+    const PTCachePackFrame *entry = items[i].entry;
+    const PTCachePackRecord record = {items[i].frame, 0, entry->len};
+    void *data = MEM_mallocN(max_zz(entry->len, 1), __func__);
+    ok = (BLI_fseek(fp_src, entry->offset, SEEK_SET) == 0 &&
+          (entry->len == 0 || fread(data, entry->len, 1, fp_src) == 1) &&
+          fwrite(&record, sizeof(PTCachePackRecord), 1, fp_dst) == 1 &&
+          (entry->len == 0 || fwrite(data, entry->len, 1, fp_dst) == 1));
+    MEM_freeN(data);
+
+    offsets[i] = offset + (int64_t)sizeof(PTCachePackRecord);
+    offset = offsets[i] + (int64_t)entry->len;
+  }
+
+  if (fp_src != NULL) {
+    fclose(fp_src);
+  }
+  if (fp_dst != NULL) {
+    ok = (fclose(fp_dst) == 0) && ok;
+  }
+  ok = ok && (BLI_rename(filepath_tmp, pack->filepath) == 0);
+
+  if (ok) {
+    for (i = 0; i < items_len; i++) {
+      items[i].entry->offset = offsets[i];
+    }
+    pack->file_len = offset;
+  }
+  else {
+    /* The original file is left as it was. */
+    BLI_delete(filepath_tmp, false, false);
+    CLOG_ERROR(&LOG, "Error compacting %s", pack->filepath);
+  }
+
+  MEM_freeN(offsets);
+  MEM_freeN(items);
+}
+
+static bool ptcache_pack_has_frame(const char *filepath, int frame)
+{
+  PTCachePack *pack = ptcache_pack_get(filepath);
+
+  BLI_mutex_lock(&pack->mutex);
+  ptcache_pack_frames_ensure(pack);
+  const bool has_frame = BLI_ghash_haskey(pack->frames, POINTER_FROM_INT(frame));
+  BLI_mutex_unlock(&pack->mutex);
+
+  return has_frame;
+}
+
+/* Wait for the frames that are still being written. */
+static void ptcache_pack_flush(PTCachePack *pack)
+{
+  BLI_mutex_lock(&pack->pool_mutex);
+  if (pack->pool != NULL) {
+    BLI_task_pool_work_and_wait(pack->pool);
+    pack->pool_tasks_len = 0;
+  }
+  BLI_mutex_unlock(&pack->pool_mutex);
+}
+
+static void ptcache_pack_free(PTCachePack *pack)
+{
+  ptcache_pack_flush(pack);
+
+  if (pack->pool != NULL) {
+    BLI_task_pool_free(pack->pool);
+  }
+  if (pack->fp != NULL) {
+    fclose(pack->fp);
+  }
+#ifndef WIN32
+  ptcache_pack_unmap(pack);
+#endif
+  if (pack->frames != NULL) {
+    BLI_ghash_free(pack->frames, NULL, MEM_freeN);
+  }
+
+  BLI_mutex_end(&pack->mutex);
+  BLI_mutex_end(&pack->pool_mutex);
+  MEM_freeN(pack);
+}
+
+/* Close a packed file before it is removed or renamed. */
+static void ptcache_pack_release(const char *filepath)
+{
+  BLI_mutex_lock(&ptcache_packs_mutex);
+  PTCachePack *pack = BLI_findstring(&ptcache_packs, filepath, offsetof(PTCachePack, filepath));
+  if (pack != NULL) {
+    BLI_remlink(&ptcache_packs, pack);
+  }
+  BLI_mutex_unlock(&ptcache_packs_mutex);
+
+  if (pack != NULL) {
+    ptcache_pack_free(pack);
+  }
+}
+
+void BKE_ptcache_packed_close_all(void)
+{
+  BLI_mutex_lock(&ptcache_packs_mutex);
+  ListBase packs = ptcache_packs;
+  BLI_listbase_clear(&ptcache_packs);
+  BLI_mutex_unlock(&ptcache_packs_mutex);
+
+  LISTBASE_FOREACH_MUTABLE (PTCachePack *, pack, &packs) {
+    ptcache_pack_free(pack);
+  }
+}
+
+static PTCacheFile *ptcache_file_mem_create(int cfra)
+{
+  PTCacheFile *pf = MEM_callocN(sizeof(PTCacheFile), "PTCacheFile");
+  pf->frame = cfra;
+  return pf;
+}
+
+/* Frames of packed caches are read and written in memory, see #ptcache_file_close. */
+static PTCacheFile *ptcache_file_packed_open(const char *filepath, int mode, int cfra)
+{
+  PTCachePack *pack = ptcache_pack_get(filepath);
+  PTCacheFile *pf = NULL;
+
+  /* Keep the order of records when the frame is also being written in the background. */
+  ptcache_pack_flush(pack);
+
+  if (mode == PTCACHE_FILE_READ) {
+    size_t len = 0;
+
+    BLI_mutex_lock(&pack->mutex);
+    unsigned char *data = ptcache_pack_frame_read(pack, cfra, &len);
+    BLI_mutex_unlock(&pack->mutex);
+
+    if (data != NULL) {
+      pf = ptcache_file_mem_create(cfra);
+      pf->mem = data;
+      pf->mem_len = pf->mem_alloc = len;
+    }
+  }
+  else if (mode == PTCACHE_FILE_WRITE) {
+    pf = ptcache_file_mem_create(cfra);
+    pf->pack = pack;
+  }
+  /* Records are never updated in place, so #PTCACHE_FILE_UPDATE isn't supported. */
+
+  return pf;
+}
+
 /**
  * Caller must close after!
  */
@@ -1437,6 +1986,10 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
 
   ptcache_filename(pid, filename, cfra, 1, 1);
 
+  if (ptcache_use_packed(pid->cache)) {
+    return ptcache_file_packed_open(filename, mode, cfra);
+  }
+
   if (mode == PTCACHE_FILE_READ) {
     fp = BLI_fopen(filename, "rb");
   }
@@ -1455,7 +2008,7 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
     return NULL;
   }
 
-  pf = MEM_mallocN(sizeof(PTCacheFile), "PTCacheFile");
+  pf = MEM_callocN(sizeof(PTCacheFile), "PTCacheFile");
   pf->fp = fp;
   pf->old_format = 0;
   pf->frame = cfra;
@@ -1465,7 +2018,17 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
 static void ptcache_file_close(PTCacheFile *pf)
 {
   if (pf) {
-    fclose(pf->fp);
+    if (pf->pack) {
+      BLI_mutex_lock(&pf->pack->mutex);
+      if (!ptcache_pack_append(pf->pack, pf->frame, 0, pf->mem, pf->mem_len)) {
+        CLOG_ERROR(&LOG, "Error writing frame %d to %s", pf->frame, pf->pack->filepath);
+      }
+      BLI_mutex_unlock(&pf->pack->mutex);
+    }
+    if (pf->fp) {
+      fclose(pf->fp);
+    }
+    MEM_SAFE_FREE(pf->mem);
     MEM_freeN(pf);
   }
 }
@@ -1592,12 +2155,41 @@ static int ptcache_file_compressed_write(
 }
 static int ptcache_file_read(PTCacheFile *pf, void *f, unsigned int tot, unsigned int size)
 {
+  if (pf->fp == NULL) {
+    const size_t len = (size_t)tot * size;
+    if (pf->mem_pos + len > pf->mem_len) {
+      return 0;
+    }
+    memcpy(f, pf->mem + pf->mem_pos, len);
+    pf->mem_pos += len;
+    return 1;
+  }
   return (fread(f, size, tot, pf->fp) == tot);
 }
 static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot, unsigned int size)
 {
+  if (pf->fp == NULL) {
+    const size_t len = (size_t)tot * size;
+    if (pf->mem_pos + len > pf->mem_alloc) {
+      pf->mem_alloc = max_zz(pf->mem_alloc * 2, pf->mem_pos + len);
+      pf->mem = MEM_reallocN(pf->mem, pf->mem_alloc);
+    }
+    memcpy(pf->mem + pf->mem_pos, f, len);
+    pf->mem_pos += len;
+    pf->mem_len = max_zz(pf->mem_len, pf->mem_pos);
+    return 1;
+  }
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
+static void ptcache_file_rewind(PTCacheFile *pf)
+{
+  if (pf->fp == NULL) {
+    pf->mem_pos = 0;
+  }
+  else {
+    BLI_fseek(pf->fp, 0, SEEK_SET);
+  }
+}
 static int ptcache_file_data_read(PTCacheFile *pf)
 {
   int i;
@@ -1632,7 +2224,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
 
   pf->data_types = 0;
 
-  if (fread(bphysics, sizeof(char), 8, pf->fp) != 8) {
+  if (!ptcache_file_read(pf, bphysics, 8, sizeof(char))) {
     error = 1;
   }
 
@@ -1640,7 +2232,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
     error = 1;
   }
 
-  if (!error && !fread(&typeflag, sizeof(unsigned int), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &typeflag, 1, sizeof(unsigned int))) {
     error = 1;
   }
 
@@ -1649,7 +2241,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
 
   /* if there was an error set file as it was */
   if (error) {
-    BLI_fseek(pf->fp, 0, SEEK_SET);
+    ptcache_file_rewind(pf);
   }
 
   return !error;
@@ -1659,11 +2251,11 @@ static int ptcache_file_header_begin_write(PTCacheFile *pf)
   const char *bphysics = "BPHYSICS";
   unsigned int typeflag = pf->type + pf->flag;
 
-  if (fwrite(bphysics, sizeof(char), 8, pf->fp) != 8) {
+  if (!ptcache_file_write(pf, bphysics, 8, sizeof(char))) {
     return 0;
   }
 
-  if (!fwrite(&typeflag, sizeof(unsigned int), 1, pf->fp)) {
+  if (!ptcache_file_write(pf, &typeflag, 1, sizeof(unsigned int))) {
     return 0;
   }
 
@@ -1986,48 +2578,41 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
 
   return pm;
 }
-static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
+/* Write the frame, only using the cache settings passed in so it can run in a task. */
+static int ptcache_mem_frame_to_file(PTCacheFile *pf,
+                                     PTCacheMem *pm,
+                                     unsigned int type,
+                                     int compression,
+                                     int (*write_header)(PTCacheFile *pf))
 {
-  PTCacheFile *pf = NULL;
   unsigned int i, error = 0;
 
-  BKE_ptcache_id_clear(pid, PTCACHE_CLEAR_FRAME, pm->frame);
-
-  pf = ptcache_file_open(pid, PTCACHE_FILE_WRITE, pm->frame);
-
-  if (pf == NULL) {
-    if (G.debug & G_DEBUG) {
-      printf("Error opening disk cache file for writing\n");
-    }
-    return 0;
-  }
-
   pf->data_types = pm->data_types;
   pf->totpoint = pm->totpoint;
-  pf->type = pid->type;
+  pf->type = type;
   pf->flag = 0;
 
   if (pm->extradata.first) {
     pf->flag |= PTCACHE_TYPEFLAG_EXTRADATA;
   }
 
-  if (pid->cache->compression) {
+  if (compression) {
     pf->flag |= PTCACHE_TYPEFLAG_COMPRESS;
   }
 
-  if (!ptcache_file_header_begin_write(pf) || !pid->write_header(pf)) {
+  if (!ptcache_file_header_begin_write(pf) || !write_header(pf)) {
     error = 1;
   }
 
   if (!error) {
-    if (pid->cache->compression) {
+    if (compression) {
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         if (pm->data[i]) {
           unsigned int in_len = pm->totpoint * ptcache_data_size[i];
           unsigned char *out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
                                                             "pointcache_lzo_buffer");
           ptcache_file_compressed_write(
-              pf, (unsigned char *)(pm->data[i]), in_len, out, pid->cache->compression);
+              pf, (unsigned char *)(pm->data[i]), in_len, out, compression);
           MEM_freeN(out);
         }
       }
@@ -2058,12 +2643,12 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
       ptcache_file_write(pf, &extra->type, 1, sizeof(unsigned int));
       ptcache_file_write(pf, &extra->totdata, 1, sizeof(unsigned int));
 
-      if (pid->cache->compression) {
+      if (compression) {
         unsigned int in_len = extra->totdata * ptcache_extra_datasize[extra->type];
         unsigned char *out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
                                                           "pointcache_lzo_buffer");
         ptcache_file_compressed_write(
-            pf, (unsigned char *)(extra->data), in_len, out, pid->cache->compression);
+            pf, (unsigned char *)(extra->data), in_len, out, compression);
         MEM_freeN(out);
       }
       else {
@@ -2072,13 +2657,143 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
     }
   }
 
+  return error == 0;
+}
+
+static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
+{
+  PTCacheFile *pf = NULL;
+  int ok;
+
+  /* Records of packed caches replace the earlier data of the frame. */
+  if (!ptcache_use_packed(pid->cache)) {
+    BKE_ptcache_id_clear(pid, PTCACHE_CLEAR_FRAME, pm->frame);
+  }
+
+  pf = ptcache_file_open(pid, PTCACHE_FILE_WRITE, pm->frame);
+
+  if (pf == NULL) {
+    if (G.debug & G_DEBUG) {
+      printf("Error opening disk cache file for writing\n");
+    }
+    return 0;
+  }
+
+  ok = ptcache_mem_frame_to_file(pf, pm, pid->type, pid->cache->compression, pid->write_header);
+
   ptcache_file_close(pf);
 
-  if (error && G.debug & G_DEBUG) {
+  if (!ok && G.debug & G_DEBUG) {
     printf("Error writing to disk cache\n");
   }
 
-  return error == 0;
+  return ok;
+}
+
+typedef struct PTCachePackWriteTask {
+  PTCachePack *pack;
+  PTCacheMem *pm;
+  unsigned int type;
+  int compression;
+  int (*write_header)(PTCacheFile *pf);
+} PTCachePackWriteTask;
+
+static void ptcache_pack_write_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  PTCachePackWriteTask *task = taskdata;
+  PTCachePack *pack = task->pack;
+  const int frame = task->pm->frame;
+
+  PTCacheFile *pf = ptcache_file_mem_create(frame);
+  bool ok = ptcache_mem_frame_to_file(
+      pf, task->pm, task->type, task->compression, task->write_header);
+
+  BLI_mutex_lock(&pack->mutex);
+  if (ok) {
+    ok = ptcache_pack_append(pack, frame, 0, pf->mem, pf->mem_len);
+  }
+  if (ok) {
+    /* Frames written again after a partial re-simulation replace earlier records. */
+    ptcache_pack_compact(pack);
+  }
+  if (!ok) {
+    /* Don't leave the frame pending. */
+    const PTCachePackFrame *entry = BLI_ghash_lookup(pack->frames, POINTER_FROM_INT(frame));
+    if (entry != NULL && entry->offset < 0) {
+      ptcache_pack_frame_remove(pack, frame);
+    }
+  }
+  BLI_mutex_unlock(&pack->mutex);
+
+  if (!ok) {
+    CLOG_ERROR(&LOG, "Error writing frame %d to %s", frame, pack->filepath);
+  }
+
+  ptcache_file_close(pf);
+}
+
+static void ptcache_pack_write_task_free(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  PTCachePackWriteTask *task = taskdata;
+  ptcache_mem_clear(task->pm);
+  MEM_freeN(task->pm);
+  MEM_freeN(task);
+}
+
+/**
+ * Serialize, compress and append the frame to the packed file in a task,
+ * so the simulation can continue with the next frame. Takes ownership of \a pm.
+ */
+static int ptcache_pack_frame_write_async(PTCacheID *pid, PTCacheMem *pm)
+{
+  char filepath[MAX_PTCACHE_FILE];
+
+  if (ptcache_filename(pid, filepath, pm->frame, 1, 1) == 0) {
+    ptcache_mem_clear(pm);
+    MEM_freeN(pm);
+    return 0;
+  }
+
+  PTCachePack *pack = ptcache_pack_get(filepath);
+
+  BLI_mutex_lock(&pack->mutex);
+  ptcache_pack_frames_ensure(pack);
+  const PTCachePackFrame *entry = BLI_ghash_lookup(pack->frames, POINTER_FROM_INT(pm->frame));
+  const bool is_pending = (entry != NULL && entry->offset < 0);
+  BLI_mutex_unlock(&pack->mutex);
+
+  /* Records of the same frame must be appended in order. */
+  if (is_pending) {
+    ptcache_pack_flush(pack);
+  }
+
+  /* Mark as pending, so #BKE_ptcache_id_exist doesn't have to wait for the task. */
+  BLI_mutex_lock(&pack->mutex);
+  ptcache_pack_frame_set(pack, pm->frame, -1, 0);
+  BLI_mutex_unlock(&pack->mutex);
+
+  PTCachePackWriteTask *task = MEM_mallocN(sizeof(PTCachePackWriteTask), __func__);
+  task->pack = pack;
+  task->pm = pm;
+  task->type = pid->type;
+  task->compression = pid->cache->compression;
+  task->write_header = pid->write_header;
+
+  BLI_mutex_lock(&pack->pool_mutex);
+  if (pack->pool == NULL) {
+    pack->pool = BLI_task_pool_create(NULL, TASK_PRIORITY_LOW);
+  }
+  /* Limit the memory used by frames waiting to be written. */
+  if (pack->pool_tasks_len >= 2 * BLI_system_thread_count()) {
+    BLI_task_pool_work_and_wait(pack->pool);
+    pack->pool_tasks_len = 0;
+  }
+  BLI_task_pool_push(
+      pack->pool, ptcache_pack_write_task, task, true, ptcache_pack_write_task_free);
+  pack->pool_tasks_len++;
+  BLI_mutex_unlock(&pack->pool_mutex);
+
+  return 1;
 }
 
 static int ptcache_read_stream(PTCacheID *pid, int cfra)
@@ -2343,7 +3058,10 @@ static int ptcache_write_stream(PTCacheID *pid, int cfra, int totpoint)
   PTCacheFile *pf = NULL;
   int error = 0;
 
-  BKE_ptcache_id_clear(pid, PTCACHE_CLEAR_FRAME, cfra);
+  /* Records of packed caches replace the earlier data of the frame. */
+  if (!ptcache_use_packed(pid->cache)) {
+    BKE_ptcache_id_clear(pid, PTCACHE_CLEAR_FRAME, cfra);
+  }
 
   pf = ptcache_file_open(pid, PTCACHE_FILE_WRITE, cfra);
 
@@ -2426,7 +3144,14 @@ static int ptcache_write(PTCacheID *pid, int cfra, int overwrite)
 
   pm->frame = cfra;
 
-  if (cache->flag & PTCACHE_DISK_CACHE) {
+  if ((cache->flag & PTCACHE_DISK_CACHE) && ptcache_use_packed(cache)) {
+    error += !ptcache_pack_frame_write_async(pid, pm);
+
+    if (pm2) {
+      error += !ptcache_pack_frame_write_async(pid, pm2);
+    }
+  }
+  else if (cache->flag & PTCACHE_DISK_CACHE) {
     error += !ptcache_mem_frame_to_disk(pid, pm);
 
     // if (pm) /* pm is always set */
@@ -2547,6 +3272,77 @@ int BKE_ptcache_write(PTCacheID *pid, unsigned int cfra)
  */
 
 /* Clears & resets */
+static void ptcache_pack_clear(PTCacheID *pid, int mode, int cfra)
+{
+  PointCache *cache = pid->cache;
+  const int sta = cache->startframe;
+  const int end = cache->endframe;
+  char filepath[MAX_PTCACHE_FILE];
+
+  if (ptcache_filename(pid, filepath, cfra, 1, 1) == 0) {
+    return;
+  }
+
+  if (mode == PTCACHE_CLEAR_ALL) {
+    ptcache_pack_release(filepath);
+    if (BLI_exists(filepath)) {
+      cache->last_exact = MIN2(cache->startframe, 0);
+      BLI_delete(filepath, false, false);
+    }
+    if (cache->cached_frames) {
+      memset(cache->cached_frames, 0, MEM_allocN_len(cache->cached_frames));
+    }
+    return;
+  }
+
+  if (mode == PTCACHE_CLEAR_FRAME && cache->cached_frames && cfra >= sta && cfra <= end) {
+    cache->cached_frames[cfra - sta] = 0;
+  }
+
+  PTCachePack *pack = ptcache_pack_get(filepath);
+  ptcache_pack_flush(pack);
+
+  BLI_mutex_lock(&pack->mutex);
+  ptcache_pack_frames_ensure(pack);
+
+  /* Collect the frames first, appending the records removes them from the index. */
+  const int frames_len_max = (int)BLI_ghash_len(pack->frames);
+  int *frames = NULL;
+  int frames_len = 0;
+
+  if (frames_len_max != 0) {
+    GHashIterator gh_iter;
+    frames = MEM_malloc_arrayN(frames_len_max, sizeof(int), __func__);
+
+    GHASH_ITER (gh_iter, pack->frames) {
+      const int frame = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
+      if ((mode == PTCACHE_CLEAR_FRAME && frame == cfra) ||
+          (mode == PTCACHE_CLEAR_BEFORE && frame < cfra) ||
+          (mode == PTCACHE_CLEAR_AFTER && frame > cfra)) {
+        frames[frames_len++] = frame;
+      }
+    }
+  }
+
+  for (int i = 0; i < frames_len; i++) {
+    if (!ptcache_pack_append(pack, frames[i], PTCACHE_PACK_RECORD_REMOVED, NULL, 0)) {
+      CLOG_ERROR(&LOG, "Error removing frame %d from %s", frames[i], filepath);
+      break;
+    }
+    if (cache->cached_frames && frames[i] >= sta && frames[i] <= end) {
+      cache->cached_frames[frames[i] - sta] = 0;
+    }
+  }
+
+  if (frames_len != 0) {
+    ptcache_pack_compact(pack);
+  }
+
+  BLI_mutex_unlock(&pack->mutex);
+
+  MEM_SAFE_FREE(frames);
+}
+
 void BKE_ptcache_id_clear(PTCacheID *pid, int mode, unsigned int cfra)
 {
   unsigned int len; /* store the length of the string */
@@ -2580,6 +3376,12 @@ void BKE_ptcache_id_clear(PTCacheID *pid, int mode, unsigned int cfra)
 
   /*if (!G.relbase_valid) return; */ /* save blend file before using pointcache */
 
+  if ((pid->cache->flag & PTCACHE_DISK_CACHE) && ptcache_use_packed(pid->cache)) {
+    ptcache_pack_clear(pid, mode, (int)cfra);
+    pid->cache->flag |= PTCACHE_FLAG_INFO_DIRTY;
+    return;
+  }
+
   const char *fext = ptcache_file_extension(pid);
 
   /* clear all files in the temp dir with the prefix of the ID and the ".bphys" suffix */
@@ -2720,6 +3522,10 @@ int BKE_ptcache_id_exist(PTCacheID *pid, int cfra)
 
     ptcache_filename(pid, filename, cfra, 1, 1);
 
+    if (ptcache_use_packed(pid->cache)) {
+      return filename[0] != '\0' && ptcache_pack_has_frame(filename, cfra);
+    }
+
     return BLI_exists(filename);
   }
 
@@ -2732,6 +3538,32 @@ int BKE_ptcache_id_exist(PTCacheID *pid, int cfra)
   }
   return 0;
 }
+static void ptcache_pack_cached_frames_update(PTCacheID *pid)
+{
+  PointCache *cache = pid->cache;
+  const int sta = cache->startframe;
+  const int end = cache->endframe;
+  char filepath[MAX_PTCACHE_FILE];
+
+  if (ptcache_filename(pid, filepath, 0, 1, 1) == 0) {
+    return;
+  }
+
+  PTCachePack *pack = ptcache_pack_get(filepath);
+
+  BLI_mutex_lock(&pack->mutex);
+  ptcache_pack_frames_ensure(pack);
+
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, pack->frames) {
+    const int frame = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
+    if (frame >= sta && frame <= end) {
+      cache->cached_frames[frame - sta] = 1;
+    }
+  }
+  BLI_mutex_unlock(&pack->mutex);
+}
+
 void BKE_ptcache_id_time(
     PTCacheID *pid, Scene *scene, float cfra, int *startframe, int *endframe, float *timescale)
 {
@@ -2783,7 +3615,10 @@ void BKE_ptcache_id_time(
     cache->cached_frames = MEM_callocN(sizeof(char) * cache->cached_frames_len,
                                        "cached frames array");
 
-    if (pid->cache->flag & PTCACHE_DISK_CACHE) {
+    if ((pid->cache->flag & PTCACHE_DISK_CACHE) && ptcache_use_packed(pid->cache)) {
+      ptcache_pack_cached_frames_update(pid);
+    }
+    else if (pid->cache->flag & PTCACHE_DISK_CACHE) {
       /* mode is same as fopen's modes */
       DIR *dir;
       struct dirent *de;
@@ -3382,6 +4217,9 @@ void BKE_ptcache_bake(PTCacheBaker *baker)
     }
   }
 
+  /* Frames of packed disk caches may still be written in the background. */
+  BKE_ptcache_packed_close_all();
+
   scene->r.framelen = frameleno;
   CFRA = cfrao;
 
@@ -3487,6 +4325,76 @@ void BKE_ptcache_toggle_disk_cache(PTCacheID *pid)
   }
 }
 
+void BKE_ptcache_toggle_disk_cache_packed(PTCacheID *pid)
+{
+  PointCache *cache = pid->cache;
+  int last_exact = cache->last_exact;
+  int baked = cache->flag & PTCACHE_BAKED;
+
+  /* Nothing to convert for memory caches. */
+  if ((cache->flag & PTCACHE_DISK_CACHE) == 0 || !G.relbase_valid) {
+    return;
+  }
+
+  if (cache->cached_frames) {
+    MEM_freeN(cache->cached_frames);
+    cache->cached_frames = NULL;
+    cache->cached_frames_len = 0;
+  }
+
+  /* The flag was changed already, read the frames using the previous layout. */
+  cache->flag ^= PTCACHE_DISK_CACHE_PACKED;
+  cache->flag &= ~PTCACHE_DISK_CACHE;
+  BKE_ptcache_disk_to_mem(pid);
+  cache->flag |= PTCACHE_DISK_CACHE;
+
+  /* Remove possible bake flag to allow clear */
+  cache->flag &= ~PTCACHE_BAKED;
+  BKE_ptcache_id_clear(pid, PTCACHE_CLEAR_ALL, 0);
+  cache->flag ^= PTCACHE_DISK_CACHE_PACKED;
+  cache->flag |= baked;
+
+  BKE_ptcache_mem_to_disk(pid);
+
+  /* Clear the memory cache that was written, unless writing failed. */
+  if (cache->flag & PTCACHE_DISK_CACHE) {
+    cache->flag &= ~(PTCACHE_DISK_CACHE | PTCACHE_BAKED);
+    BKE_ptcache_id_clear(pid, PTCACHE_CLEAR_ALL, 0);
+    cache->flag |= PTCACHE_DISK_CACHE | baked;
+  }
+
+  cache->last_exact = last_exact;
+
+  BKE_ptcache_id_time(pid, NULL, 0.0f, NULL, NULL, NULL);
+
+  cache->flag |= PTCACHE_FLAG_INFO_DIRTY;
+}
+
+static void ptcache_pack_rename(PTCacheID *pid, const char *name_src, const char *name_dst)
+{
+  char old_name[80];
+  char old_filepath[MAX_PTCACHE_FILE];
+  char new_filepath[MAX_PTCACHE_FILE];
+
+  /* save old name */
+  BLI_strncpy(old_name, pid->cache->name, sizeof(old_name));
+
+  BLI_strncpy(pid->cache->name, name_src, sizeof(pid->cache->name));
+  ptcache_filename(pid, old_filepath, 0, 1, 1);
+
+  BLI_strncpy(pid->cache->name, name_dst, sizeof(pid->cache->name));
+  ptcache_filename(pid, new_filepath, 0, 1, 1);
+
+  BLI_strncpy(pid->cache->name, old_name, sizeof(pid->cache->name));
+
+  ptcache_pack_release(old_filepath);
+  ptcache_pack_release(new_filepath);
+
+  if (old_filepath[0] != '\0' && BLI_exists(old_filepath)) {
+    BLI_rename(old_filepath, new_filepath);
+  }
+}
+
 void BKE_ptcache_disk_cache_rename(PTCacheID *pid, const char *name_src, const char *name_dst)
 {
   char old_name[80];
@@ -3500,6 +4408,11 @@ void BKE_ptcache_disk_cache_rename(PTCacheID *pid, const char *name_src, const c
   char old_path_full[MAX_PTCACHE_FILE];
   char ext[MAX_PTCACHE_PATH];
 
+  if (ptcache_use_packed(pid->cache)) {
+    ptcache_pack_rename(pid, name_src, name_dst);
+    return;
+  }
+
   /* save old name */
   BLI_strncpy(old_name, pid->cache->name, sizeof(old_name));
 
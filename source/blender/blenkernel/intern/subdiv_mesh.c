@@ -522,8 +522,24 @@ static bool subdiv_mesh_topology_info(const SubdivForeachContext *foreach_contex
   mask.lmask &= ~CD_MASK_MULTIRES_GRIDS;
 
   SubdivMeshContext *subdiv_context = foreach_context->user_data;
-  subdiv_context->subdiv_mesh = BKE_mesh_new_nomain_from_template_ex(
-      subdiv_context->coarse_mesh, num_vertices, num_edges, 0, num_loops, num_polygons, mask);
+  if (subdiv_context->subdiv_mesh != NULL) {
+    /* Vertices are evaluated into an existing mesh, which must match the topology. */
+    Mesh *subdiv_mesh = subdiv_context->subdiv_mesh;
+    if (subdiv_mesh->totvert != num_vertices || subdiv_mesh->totedge != num_edges ||
+        subdiv_mesh->totloop != num_loops || subdiv_mesh->totpoly != num_polygons) {
+      return false;
+    }
+    if (subdiv_context->have_displacement) {
+      /* Displacement is accumulated in the vertex coordinates, which are expected to be zero. */
+      for (int i = 0; i < num_vertices; i++) {
+        zero_v3(subdiv_mesh->mvert[i].co);
+      }
+    }
+  }
+  else {
+    subdiv_context->subdiv_mesh = BKE_mesh_new_nomain_from_template_ex(
+        subdiv_context->coarse_mesh, num_vertices, num_edges, 0, num_loops, num_polygons, mask);
+  }
   subdiv_mesh_ctx_cache_custom_data_layers(subdiv_context);
   subdiv_mesh_prepare_accumulator(subdiv_context, num_vertices);
   return true;
@@ -1161,6 +1177,7 @@ static void subdiv_mesh_vertex_of_loose_edge(const struct SubdivForeachContext *
  * \{ */
 
 static void setup_foreach_callbacks(const SubdivMeshContext *subdiv_context,
+                                    const bool vertices_only,
                                     SubdivForeachContext *foreach_context)
 {
   memset(foreach_context, 0, sizeof(*foreach_context));
@@ -1178,9 +1195,11 @@ static void setup_foreach_callbacks(const SubdivMeshContext *subdiv_context,
   foreach_context->vertex_corner = subdiv_mesh_vertex_corner;
   foreach_context->vertex_edge = subdiv_mesh_vertex_edge;
   foreach_context->vertex_inner = subdiv_mesh_vertex_inner;
-  foreach_context->edge = subdiv_mesh_edge;
-  foreach_context->loop = subdiv_mesh_loop;
-  foreach_context->poly = subdiv_mesh_poly;
+  if (!vertices_only) {
+    foreach_context->edge = subdiv_mesh_edge;
+    foreach_context->loop = subdiv_mesh_loop;
+    foreach_context->poly = subdiv_mesh_poly;
+  }
   foreach_context->vertex_loose = subdiv_mesh_vertex_loose;
   foreach_context->vertex_of_loose_edge = subdiv_mesh_vertex_of_loose_edge;
   foreach_context->user_data_tls_free = subdiv_mesh_tls_free;
@@ -1192,9 +1211,11 @@ static void setup_foreach_callbacks(const SubdivMeshContext *subdiv_context,
 /** \name Public entry point
  * \{ */
 
-Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
-                         const SubdivToMeshSettings *settings,
-                         const Mesh *coarse_mesh)
+/* Evaluate into the given mesh when it is not NULL, only computing its vertices. */
+static Mesh *subdiv_to_mesh_ex(Subdiv *subdiv,
+                               const SubdivToMeshSettings *settings,
+                               const Mesh *coarse_mesh,
+                               Mesh *subdiv_mesh)
 {
   BKE_subdiv_stats_begin(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH);
   /* Make sure evaluator is up to date with possible new topology, and that
@@ -1215,22 +1236,24 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
   subdiv_context.settings = settings;
   subdiv_context.coarse_mesh = coarse_mesh;
   subdiv_context.subdiv = subdiv;
+  subdiv_context.subdiv_mesh = subdiv_mesh;
   subdiv_context.have_displacement = (subdiv->displacement_evaluator != NULL);
   subdiv_context.can_evaluate_normals = !subdiv_context.have_displacement && subdiv_context.subdiv->settings.is_adaptive;
   /* Multi-threaded traversal/evaluation. */
   BKE_subdiv_stats_begin(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
   SubdivForeachContext foreach_context;
-  setup_foreach_callbacks(&subdiv_context, &foreach_context);
+  setup_foreach_callbacks(&subdiv_context, subdiv_mesh != NULL, &foreach_context);
   SubdivMeshTLS tls = {0};
   foreach_context.user_data = &subdiv_context;
   foreach_context.user_data_tls_size = sizeof(SubdivMeshTLS);
   foreach_context.user_data_tls = &tls;
-  BKE_subdiv_foreach_subdiv_geometry(subdiv, &foreach_context, settings, coarse_mesh);
+  const bool success = BKE_subdiv_foreach_subdiv_geometry(
+      subdiv, &foreach_context, settings, coarse_mesh);
   BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
-  Mesh *result = subdiv_context.subdiv_mesh;
+  Mesh *result = success ? subdiv_context.subdiv_mesh : NULL;
   // BKE_mesh_validate(result, true, true);
   BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH);
-  if (!subdiv_context.can_evaluate_normals) {
+  if (result != NULL && !subdiv_context.can_evaluate_normals) {
     result->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
   }
   /* Free used memory. */
@@ -1238,4 +1261,25 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
   return result;
 }
 
+Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
+                         const SubdivToMeshSettings *settings,
+                         const Mesh *coarse_mesh)
+{
+  return subdiv_to_mesh_ex(subdiv, settings, coarse_mesh, NULL);
+}
+
+/* Re-evaluate vertices of a mesh created by #BKE_subdiv_to_mesh from a coarse mesh with the
+ * same topology and edge, face corner and face data, for example a deformed version of it.
+ *
+ * Edges, loops and polygons of the subdivided mesh are kept as they are, its vertex custom data
+ * is expected to be allocated but not initialized, the same as for a newly created mesh.
+ * Returns false when the number of elements does not match. */
+bool BKE_subdiv_to_mesh_update_vertices(Subdiv *subdiv,
+                                        const SubdivToMeshSettings *settings,
+                                        const Mesh *coarse_mesh,
+                                        Mesh *subdiv_mesh)
+{
+  return subdiv_to_mesh_ex(subdiv, settings, coarse_mesh, subdiv_mesh) != NULL;
+}
+
 /** \} */
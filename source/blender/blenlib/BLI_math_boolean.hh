@@ -49,6 +49,11 @@ int incircle_fast(const double2 &a, const double2 &b, const double2 &c, const do
 int orient3d(const double3 &a, const double3 &b, const double3 &c, const double3 &d);
 int orient3d_fast(const double3 &a, const double3 &b, const double3 &c, const double3 &d);
 
+/* #orient3d_filter is for double approximations of exact (mpq3) coordinates:
+ * if it returns -1 or 1, the exact #orient3d of the original coordinates has that value.
+ * It returns 0 when double arithmetic can't decide, and the exact test is needed. */
+int orient3d_filter(const double3 &a, const double3 &b, const double3 &c, const double3 &d);
+
 int insphere(
     const double3 &a, const double3 &b, const double3 &c, const double3 &d, const double3 &e);
 int insphere_fast(
@@ -29,14 +29,16 @@
  *  - Literals:
  *      floating point and decimal integer.
  *  - Constants:
- *      pi, True, False
+ *      pi, e, tau, inf, True, False
  *  - Operators:
- *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
+ *      +, -, *, /, //, %, **, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
- *      min, max, radians, degrees,
- *      abs, fabs, floor, ceil, trunc, int,
- *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      min, max, radians, degrees, float, bool,
+ *      abs, fabs, floor, ceil, trunc, int, round, copysign,
+ *      sin, cos, tan, asin, acos, atan, atan2, hypot,
+ *      sinh, cosh, tanh, asinh, acosh, atanh,
+ *      exp, log, log2, log10, sqrt, pow, fmod,
+ *      lerp, clamp, smoothstep
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -55,6 +57,7 @@
 #include "BLI_alloca.h"
 #include "BLI_expr_pylike_eval.h"
 #include "BLI_math_base.h"
+#include "BLI_string.h"
 #include "BLI_utildefines.h"
 
 #ifdef _MSC_VER
@@ -74,6 +77,8 @@ typedef enum eOpCode {
   OPCODE_FUNC2,
   /* 3 argument function call: (a b c -> func3(a,b,c)) */
   OPCODE_FUNC3,
+  /* 2 argument function call with a constant second argument: (a -> func2(a,const_arg)) */
+  OPCODE_FUNC2_CONST,
   /* Parameter access: (-> params[ival]) */
   OPCODE_PARAMETER,
   /* Minimum of multiple inputs: (a b c... -> min); ival = arg count */
@@ -109,12 +114,18 @@ typedef struct ExprOp {
     BinaryOpFunc func2;
     TernaryOpFunc func3;
   } arg;
+
+  /* Second argument of OPCODE_FUNC2_CONST. */
+  double const_arg;
 } ExprOp;
 
 struct ExprPyLike_Parsed {
   int ops_count;
   int max_stack;
 
+  /* Description of why parsing failed, NULL on success. */
+  char *error;
+
   ExprOp ops[];
 };
 
@@ -128,6 +139,7 @@ struct ExprPyLike_Parsed {
 void BLI_expr_pylike_free(ExprPyLike_Parsed *expr)
 {
   if (expr != NULL) {
+    MEM_SAFE_FREE(expr->error);
     MEM_freeN(expr);
   }
 }
@@ -138,6 +150,18 @@ bool BLI_expr_pylike_is_valid(ExprPyLike_Parsed *expr)
   return expr != NULL && expr->ops_count > 0;
 }
 
+/**
+ * Get a description of why the expression could not be parsed,
+ * for example an unknown name. Returns NULL when the expression is valid.
+ */
+const char *BLI_expr_pylike_parse_error(ExprPyLike_Parsed *expr)
+{
+  if (expr == NULL || BLI_expr_pylike_is_valid(expr)) {
+    return NULL;
+  }
+  return expr->error ? expr->error : "invalid expression";
+}
+
 /** Check if the parsed expression always evaluates to the same value. */
 bool BLI_expr_pylike_is_constant(ExprPyLike_Parsed *expr)
 {
@@ -225,6 +249,10 @@ eExprPyLike_EvalStatus BLI_expr_pylike_eval(ExprPyLike_Parsed *expr,
         stack[sp - 3] = ops[pc].arg.func3(stack[sp - 3], stack[sp - 2], stack[sp - 1]);
         sp -= 2;
         break;
+      case OPCODE_FUNC2_CONST:
+        FAIL_IF(sp < 1);
+        stack[sp - 1] = ops[pc].arg.func2(stack[sp - 1], ops[pc].const_arg);
+        break;
       case OPCODE_MIN:
         FAIL_IF(sp < ops[pc].arg.ival);
         for (int j = 1; j < ops[pc].arg.ival; j++, sp--) {
@@ -325,6 +353,31 @@ static double op_sub(double a, double b)
   return a - b;
 }
 
+static double op_floordiv(double a, double b)
+{
+  return floor(a / b);
+}
+
+/* Python modulo, the result has the sign of the divisor. */
+static double op_mod(double a, double b)
+{
+  if (b == 0.0) {
+    /* Report division by zero like the `/` operator does. */
+    return a / b;
+  }
+
+  double r = fmod(a, b);
+  if (r != 0.0 && ((r < 0.0) != (b < 0.0))) {
+    r += b;
+  }
+  return r;
+}
+
+static double op_pow(double a, double b)
+{
+  return pow(a, b);
+}
+
 static double op_radians(double arg)
 {
   return arg * M_PI / 180.0;
@@ -369,6 +422,11 @@ static double op_not(double a)
   return a ? 0.0 : 1.0;
 }
 
+static double op_bool(double a)
+{
+  return a ? 1.0 : 0.0;
+}
+
 static double op_eq(double a, double b)
 {
   return a == b ? 1.0 : 0.0;
@@ -405,7 +463,14 @@ typedef struct BuiltinConstDef {
 } BuiltinConstDef;
 
 static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+    {"pi", M_PI},
+    {"e", M_E},
+    {"tau", 2.0 * M_PI},
+    {"inf", INFINITY},
+    {"True", 1.0},
+    {"False", 0.0},
+    {NULL, 0.0},
+};
 
 typedef struct BuiltinOpDef {
   const char *name;
@@ -437,12 +502,23 @@ static BuiltinOpDef builtin_ops[] = {
     {"acos", OPCODE_FUNC1, acos},
     {"atan", OPCODE_FUNC1, atan},
     {"atan2", OPCODE_FUNC2, atan2},
+    {"hypot", OPCODE_FUNC2, hypot},
+    {"sinh", OPCODE_FUNC1, sinh},
+    {"cosh", OPCODE_FUNC1, cosh},
+    {"tanh", OPCODE_FUNC1, tanh},
+    {"asinh", OPCODE_FUNC1, asinh},
+    {"acosh", OPCODE_FUNC1, acosh},
+    {"atanh", OPCODE_FUNC1, atanh},
     {"exp", OPCODE_FUNC1, exp},
     {"log", OPCODE_FUNC1, log},
     {"log", OPCODE_FUNC2, op_log2},
+    {"log2", OPCODE_FUNC1, log2},
+    {"log10", OPCODE_FUNC1, log10},
     {"sqrt", OPCODE_FUNC1, sqrt},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
+    {"copysign", OPCODE_FUNC2, copysign},
+    {"bool", OPCODE_FUNC1, op_bool},
     {"lerp", OPCODE_FUNC3, op_lerp},
     {"clamp", OPCODE_FUNC1, op_clamp},
     {"clamp", OPCODE_FUNC3, op_clamp3},
@@ -477,6 +553,8 @@ static BuiltinOpDef builtin_ops[] = {
 #define TOKEN_NOT MAKE_CHAR2('N', 'O')
 #define TOKEN_IF MAKE_CHAR2('I', 'F')
 #define TOKEN_ELSE MAKE_CHAR2('E', 'L')
+#define TOKEN_POW MAKE_CHAR2('*', '*')
+#define TOKEN_FLOORDIV MAKE_CHAR2('/', '/')
 
 static const char *token_eq_characters = "!=><";
 static const char *token_characters = "~`!@#$%^&*+-=/\\?:;<>(){}[]|.,\"'";
@@ -507,6 +585,10 @@ typedef struct ExprParseState {
   short token;
   char *tokenbuf;
   double tokenval;
+  const char *token_start;
+
+  /* Description of the first error found */
+  char error[128];
 
   /* Opcode buffer */
   int ops_count, max_ops, last_jmp;
@@ -558,6 +640,15 @@ static void parse_set_jump(ExprParseState *state, int jump)
   state->ops[jump - 1].jmp_offset = state->ops_count - jump;
 }
 
+/* Remember the reason of failure, only the first (innermost) one is kept. Always returns false. */
+static bool parse_error(ExprParseState *state, const char *message, const char *name)
+{
+  if (state->error[0] == '\0') {
+    BLI_snprintf(state->error, sizeof(state->error), "%s '%s'", message, name);
+  }
+  return false;
+}
+
 /* Returns the required argument count of the given function call code. */
 static int opcode_arg_count(eOpCode code)
 {
@@ -658,6 +749,8 @@ static bool parse_next_token(ExprParseState *state)
     state->cur++;
   }
 
+  state->token_start = state->cur;
+
   /* End of string. */
   if (*state->cur == 0) {
     state->token = 0;
@@ -713,6 +806,13 @@ static bool parse_next_token(ExprParseState *state)
     return (end == out);
   }
 
+  /* ** and // tokens */
+  if (ELEM(state->cur[0], '*', '/') && state->cur[1] == state->cur[0]) {
+    state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
+    state->cur += 2;
+    return true;
+  }
+
   /* ?= tokens */
   if (state->cur[1] == '=' && strchr(token_eq_characters, state->cur[0])) {
     state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
@@ -792,19 +892,81 @@ static int parse_function_args(ExprParseState *state)
   }
 }
 
-static bool parse_unary(ExprParseState *state)
+static bool parse_unary(ExprParseState *state);
+
+/* Built-in constants and functions, and the min/max special cases. */
+static bool parse_builtin(ExprParseState *state)
 {
   int i;
 
-  switch (state->token) {
-    case '+':
-      return parse_next_token(state) && parse_unary(state);
+  /* Ordinary builtin constants. */
+  for (i = 0; builtin_consts[i].name; i++) {
+    if (STREQ(state->tokenbuf, builtin_consts[i].name)) {
+      parse_add_op(state, OPCODE_CONST, 1)->arg.dval = builtin_consts[i].value;
+      return parse_next_token(state);
+    }
+  }
 
-    case '-':
-      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
-      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
-      return true;
+  /* Ordinary builtin functions. */
+  for (i = 0; builtin_ops[i].name; i++) {
+    if (STREQ(state->tokenbuf, builtin_ops[i].name)) {
+      int args = parse_function_args(state);
+      CHECK_ERROR(args >= 0);
+
+      /* Search for other arg count versions if necessary. */
+      if (args != opcode_arg_count(builtin_ops[i].op)) {
+        for (int j = i + 1; builtin_ops[j].name; j++) {
+          if (opcode_arg_count(builtin_ops[j].op) == args &&
+              STREQ(builtin_ops[j].name, builtin_ops[i].name)) {
+            i = j;
+            break;
+          }
+        }
+      }
+
+      if (args != opcode_arg_count(builtin_ops[i].op)) {
+        return parse_error(
+            state, "wrong number of arguments for function", builtin_ops[i].name);
+      }
+
+      return parse_add_func(state, builtin_ops[i].op, args, builtin_ops[i].funcptr);
+    }
+  }
+
+  /* Specially supported functions. */
+  if (STREQ(state->tokenbuf, "min")) {
+    int cnt = parse_function_args(state);
+    CHECK_ERROR(cnt > 0);
+
+    parse_add_op(state, OPCODE_MIN, 1 - cnt)->arg.ival = cnt;
+    return true;
+  }
+
+  if (STREQ(state->tokenbuf, "max")) {
+    int cnt = parse_function_args(state);
+    CHECK_ERROR(cnt > 0);
+
+    parse_add_op(state, OPCODE_MAX, 1 - cnt)->arg.ival = cnt;
+    return true;
+  }
+
+  /* All values are floating point already. */
+  if (STREQ(state->tokenbuf, "float")) {
+    int cnt = parse_function_args(state);
+    if (cnt != 1) {
+      return parse_error(state, "wrong number of arguments for function", "float");
+    }
+    return true;
+  }
+
+  return parse_error(state, "unknown name", state->tokenbuf);
+}
+
+static bool parse_primary(ExprParseState *state)
+{
+  int i;
 
+  switch (state->token) {
     case '(':
       return parse_next_token(state) && parse_expr(state) && state->token == ')' &&
              parse_next_token(state);
@@ -823,55 +985,39 @@ static bool parse_unary(ExprParseState *state)
         }
       }
 
-      /* Ordinary builtin constants. */
-      for (i = 0; builtin_consts[i].name; i++) {
-        if (STREQ(state->tokenbuf, builtin_consts[i].name)) {
-          parse_add_op(state, OPCODE_CONST, 1)->arg.dval = builtin_consts[i].value;
-          return parse_next_token(state);
-        }
-      }
-
-      /* Ordinary builtin functions. */
-      for (i = 0; builtin_ops[i].name; i++) {
-        if (STREQ(state->tokenbuf, builtin_ops[i].name)) {
-          int args = parse_function_args(state);
-
-          /* Search for other arg count versions if necessary. */
-          if (args != opcode_arg_count(builtin_ops[i].op)) {
-            for (int j = i + 1; builtin_ops[j].name; j++) {
-              if (opcode_arg_count(builtin_ops[j].op) == args &&
-                  STREQ(builtin_ops[j].name, builtin_ops[i].name)) {
-                i = j;
-                break;
-              }
-            }
-          }
+      return parse_builtin(state);
 
-          return parse_add_func(state, builtin_ops[i].op, args, builtin_ops[i].funcptr);
-        }
-      }
+    default:
+      return false;
+  }
+}
 
-      /* Specially supported functions. */
-      if (STREQ(state->tokenbuf, "min")) {
-        int cnt = parse_function_args(state);
-        CHECK_ERROR(cnt > 0);
+/* The power operator binds tighter than unary operators on its left, but not on its right. */
+static bool parse_power(ExprParseState *state)
+{
+  CHECK_ERROR(parse_primary(state));
 
-        parse_add_op(state, OPCODE_MIN, 1 - cnt)->arg.ival = cnt;
-        return true;
-      }
+  if (state->token == TOKEN_POW) {
+    CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+    parse_add_func(state, OPCODE_FUNC2, 2, op_pow);
+  }
 
-      if (STREQ(state->tokenbuf, "max")) {
-        int cnt = parse_function_args(state);
-        CHECK_ERROR(cnt > 0);
+  return true;
+}
 
-        parse_add_op(state, OPCODE_MAX, 1 - cnt)->arg.ival = cnt;
-        return true;
-      }
+static bool parse_unary(ExprParseState *state)
+{
+  switch (state->token) {
+    case '+':
+      return parse_next_token(state) && parse_unary(state);
 
-      return false;
+    case '-':
+      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
+      return true;
 
     default:
-      return false;
+      return parse_power(state);
   }
 }
 
@@ -891,6 +1037,16 @@ static bool parse_mul(ExprParseState *state)
         parse_add_func(state, OPCODE_FUNC2, 2, op_div);
         break;
 
+      case TOKEN_FLOORDIV:
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_floordiv);
+        break;
+
+      case '%':
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_mod);
+        break;
+
       default:
         return true;
     }
@@ -1069,6 +1225,97 @@ static bool parse_expr(ExprParseState *state)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Peephole Optimization
+ * \{ */
+
+static bool opcode_is_jump(eOpCode code)
+{
+  return ELEM(code, OPCODE_JMP, OPCODE_JMP_ELSE, OPCODE_JMP_OR, OPCODE_JMP_AND, OPCODE_CMP_CHAIN);
+}
+
+/* Check if applying the function with the given constant second argument gives the first
+ * argument back unchanged for all values, including NaN and signed zero. */
+static bool func2_const_is_identity(BinaryOpFunc func, double value)
+{
+  if (ELEM(func, op_mul, op_div, op_pow)) {
+    return value == 1.0;
+  }
+  if (func == op_sub) {
+    return value == 0.0;
+  }
+  return false;
+}
+
+/**
+ * Optimize the final operation sequence, which reduces the number of operations executed by
+ * the stack machine for common expressions like "x * 2" or "var > 0.5":
+ * - Binary operations with a constant second argument are merged into a single operation.
+ * - Binary operations which don't change their first argument (x * 1, x - 0) are removed.
+ *
+ * An operation which is the target of a jump is never merged with the preceding operation.
+ */
+static void parse_optimize(ExprParseState *state)
+{
+  const int ops_count = state->ops_count;
+  ExprOp *ops = state->ops;
+
+  bool *is_jump_target = MEM_callocN(sizeof(bool) * (ops_count + 1), __func__);
+  for (int i = 0; i < ops_count; i++) {
+    if (opcode_is_jump(ops[i].opcode)) {
+      is_jump_target[i + 1 + ops[i].jmp_offset] = true;
+    }
+  }
+
+  /* Index of every old operation in the new sequence, and the other way around. */
+  int *new_index = MEM_mallocN(sizeof(int) * (ops_count + 1), __func__);
+  int *old_index = MEM_mallocN(sizeof(int) * ops_count, __func__);
+  int new_count = 0;
+
+  for (int i = 0; i < ops_count; i++) {
+    new_index[i] = new_count;
+
+    if (i + 1 < ops_count && ops[i].opcode == OPCODE_CONST && ops[i + 1].opcode == OPCODE_FUNC2 &&
+        !is_jump_target[i + 1]) {
+      const double value = ops[i].arg.dval;
+      const BinaryOpFunc func = ops[i + 1].arg.func2;
+
+      new_index[i + 1] = new_count;
+      i++;
+
+      if (!func2_const_is_identity(func, value)) {
+        ExprOp *op = &ops[new_count];
+        memset(op, 0, sizeof(ExprOp));
+        op->opcode = OPCODE_FUNC2_CONST;
+        op->arg.func2 = func;
+        op->const_arg = value;
+        old_index[new_count++] = i;
+      }
+      continue;
+    }
+
+    ops[new_count] = ops[i];
+    old_index[new_count++] = i;
+  }
+  new_index[ops_count] = new_count;
+
+  /* Remap jump offsets to the new sequence. */
+  for (int i = 0; i < new_count; i++) {
+    if (opcode_is_jump(ops[i].opcode)) {
+      const int old_target = old_index[i] + 1 + ops[i].jmp_offset;
+      ops[i].jmp_offset = new_index[old_target] - i - 1;
+    }
+  }
+
+  state->ops_count = new_count;
+
+  MEM_freeN(is_jump_target);
+  MEM_freeN(new_index);
+  MEM_freeN(old_index);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Main Parsing Function
  * \{ */
@@ -1103,17 +1350,26 @@ ExprPyLike_Parsed *BLI_expr_pylike_parse(const char *expression,
   if (parse_next_token(&state) && parse_expr(&state) && state.token == 0) {
     BLI_assert(state.stack_ptr == 1);
 
+    parse_optimize(&state);
+
     int bytesize = sizeof(ExprPyLike_Parsed) + state.ops_count * sizeof(ExprOp);
 
     expr = MEM_mallocN(bytesize, "ExprPyLike_Parsed");
     expr->ops_count = state.ops_count;
     expr->max_stack = state.max_stack;
+    expr->error = NULL;
 
     memcpy(expr->ops, state.ops, state.ops_count * sizeof(ExprOp));
   }
   else {
     /* Always return a non-NULL object so that parse failure can be cached. */
     expr = MEM_callocN(sizeof(ExprPyLike_Parsed), "ExprPyLike_Parsed(empty)");
+
+    if (state.error[0] == '\0') {
+      const int column = (int)((state.token_start ? state.token_start : state.cur) - state.expr);
+      BLI_snprintf(state.error, sizeof(state.error), "unsupported syntax at column %d", column + 1);
+    }
+    expr->error = BLI_strdup(state.error);
   }
 
   MEM_freeN(state.tokenbuf);
@@ -2518,6 +2518,59 @@ int orient3d_fast(const double3 &a, const double3 &b, const double3 &c, const do
   return sgn(robust_pred::orient3dfast(a, b, c, d));
 }
 
+/**
+ * The determinant of #orient3d, using absolute values of the inputs and
+ * always adding, to get the error bound. See the Burnikel et al paper
+ * "Exact Geometric Computation in LEDA".
+ */
+static double supremum_orient3d(const double3 &a,
+                                const double3 &b,
+                                const double3 &c,
+                                const double3 &d)
+{
+  double3 abs_a = double3::abs(a);
+  double3 abs_b = double3::abs(b);
+  double3 abs_c = double3::abs(c);
+  double3 abs_d = double3::abs(d);
+  double adx = abs_a[0] + abs_d[0];
+  double bdx = abs_b[0] + abs_d[0];
+  double cdx = abs_c[0] + abs_d[0];
+  double ady = abs_a[1] + abs_d[1];
+  double bdy = abs_b[1] + abs_d[1];
+  double cdy = abs_c[1] + abs_d[1];
+  double adz = abs_a[2] + abs_d[2];
+  double bdz = abs_b[2] + abs_d[2];
+  double cdz = abs_c[2] + abs_d[2];
+
+  double bdxcdy = bdx * cdy;
+  double cdxbdy = cdx * bdy;
+
+  double cdxady = cdx * ady;
+  double adxcdy = adx * cdy;
+
+  double adxbdy = adx * bdy;
+  double bdxady = bdx * ady;
+
+  double det = adz * (bdxcdy + cdxbdy) + bdz * (cdxady + adxcdy) + cdz * (adxbdy + bdxady);
+  return det;
+}
+
+/** Actually index_orient3d = 10 + 4 * (max degree of input coordinates) */
+constexpr int index_orient3d = 14;
+
+int orient3d_filter(const double3 &a, const double3 &b, const double3 &c, const double3 &d)
+{
+  double o3dfast = robust_pred::orient3dfast(a, b, c, d);
+  if (o3dfast == 0.0) {
+    return 0;
+  }
+  double err_bound = supremum_orient3d(a, b, c, d) * index_orient3d * DBL_EPSILON;
+  if (fabs(o3dfast) > err_bound) {
+    return o3dfast > 0.0 ? 1 : -1;
+  }
+  return 0;
+}
+
 int insphere(
     const double3 &a, const double3 &b, const double3 &c, const double3 &d, const double3 &e)
 {
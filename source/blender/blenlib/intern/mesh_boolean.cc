@@ -37,6 +37,7 @@
 #  include "BLI_set.hh"
 #  include "BLI_span.hh"
 #  include "BLI_stack.hh"
+#  include "BLI_task.h"
 #  include "BLI_vector.hh"
 #  include "BLI_vector_set.hh"
 
@@ -44,6 +45,9 @@
 
 namespace blender::meshintersect {
 
+/** For debugging, can disable threading in boolean code with this static constant. */
+static constexpr bool boolean_use_threading = true;
+
 /**
  * Edge as two `const` Vert *'s, in a canonical order (lower vert id first).
  * We use the Vert id field for hashing to get algorithms
@@ -840,9 +844,6 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
   if (dbg_level > 0) {
     std::cout << "classify  e = " << e << "\n";
   }
-  mpq3 a0 = tri0[0]->co_exact;
-  mpq3 a1 = tri0[1]->co_exact;
-  mpq3 a2 = tri0[2]->co_exact;
   bool rev;
   bool rev0;
   const Vert *flapv0 = find_flap_vert(tri0, e, &rev0);
@@ -854,9 +855,13 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
     std::cout << " rev = " << rev << " flapv = " << flapv << "\n";
   }
   BLI_assert(flapv != nullptr && flapv0 != nullptr);
-  const mpq3 flap = flapv->co_exact;
-  /* orient will be positive if flap is below oriented plane of a0,a1,a2. */
-  int orient = orient3d(a0, a1, a2, flap);
+  /* orient will be positive if flap is below oriented plane of a0,a1,a2.
+   * Try double arithmetic with error bounds first, the exact test is only needed
+   * when the flap is (nearly) co-planar with tri0. */
+  int orient = orient3d_filter(tri0[0]->co, tri0[1]->co, tri0[2]->co, flapv->co);
+  if (orient == 0) {
+    orient = orient3d(tri0[0]->co_exact, tri0[1]->co_exact, tri0[2]->co_exact, flapv->co_exact);
+  }
   int ans;
   if (orient > 0) {
     ans = rev0 ? 4 : 3;
@@ -2379,6 +2384,112 @@ static bool point_is_inside_shape(const IMesh &tm,
   return (gwn > 0.01);
 }
 
+/**
+ * Data needed for parallelization of the patch classification in #gwn_boolean.
+ */
+struct GwnPatchData {
+  const IMesh &tm;
+  BoolOpType op;
+  int nshapes;
+  std::function<int(int)> shape_fn;
+  const PatchesInfo &pinfo;
+  /* Parallel to the patches, set by #gwn_classify_patch_range_func. */
+  Array<bool> do_remove;
+  Array<bool> do_flip;
+
+  GwnPatchData(const IMesh &tm,
+               BoolOpType op,
+               int nshapes,
+               std::function<int(int)> shape_fn,
+               const PatchesInfo &pinfo)
+      : tm(tm),
+        op(op),
+        nshapes(nshapes),
+        shape_fn(shape_fn),
+        pinfo(pinfo),
+        do_remove(pinfo.tot_patch(), true),
+        do_flip(pinfo.tot_patch(), false)
+  {
+  }
+};
+
+/**
+ * Decide whether patch \a iter is removed, kept, or kept flipped. Each patch only needs
+ * winding numbers with respect to the whole mesh, so patches are classified in parallel.
+ */
+static void gwn_classify_patch_range_func(void *__restrict userdata,
+                                          const int iter,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  constexpr int dbg_level = 0;
+  GwnPatchData *data = static_cast<GwnPatchData *>(userdata);
+  const IMesh &tm = data->tm;
+  const BoolOpType op = data->op;
+  const int nshapes = data->nshapes;
+  int p = iter;
+  const Patch &patch = data->pinfo.patch(p);
+  /* For test triangle, choose one in the middle of patch list
+   * as the ones near the beginning may be very near other patches. */
+  int test_t_index = patch.tri(patch.tot_tri() / 2);
+  Face &tri_test = *tm.face(test_t_index);
+  /* Assume all triangles in a patch are in the same shape. */
+  int shape = data->shape_fn(tri_test.orig);
+  if (dbg_level > 0) {
+    std::cout << "process patch " << p << " = " << patch << "\n";
+    std::cout << "test tri = " << test_t_index << " = " << &tri_test << "\n";
+    std::cout << "shape = " << shape << "\n";
+  }
+  if (shape == -1) {
+    return;
+  }
+  Array<int> winding(nshapes, 0);
+  mpq3 test_point = calc_point_inside_tri(tri_test);
+  double3 test_point_db(test_point[0].get_d(), test_point[1].get_d(), test_point[2].get_d());
+  if (dbg_level > 0) {
+    std::cout << "test point = " << test_point_db << "\n";
+  }
+  for (int other_shape = 0; other_shape < nshapes; ++other_shape) {
+    if (other_shape == shape) {
+      continue;
+    }
+    /* The point_is_inside_shape function has to approximate if the other
+     * shape is not PWN. For most operations, even a hint of being inside
+     * gives good results, but when shape is a cutter in a Difference
+     * operation, we want to be pretty sure that the point is inside other_shape.
+     * E.g., T75827.
+     */
+    bool need_high_confidence = (op == BoolOpType::Difference) && (shape != 0);
+    bool inside = point_is_inside_shape(
+        tm, data->shape_fn, test_point_db, other_shape, need_high_confidence);
+    if (dbg_level > 0) {
+      std::cout << "test point is " << (inside ? "inside" : "outside") << " other_shape "
+                << other_shape << "\n";
+    }
+    winding[other_shape] = inside;
+  }
+  /* Find out the "in the output volume" flag for each of the cases of winding[shape] == 0
+   * and winding[shape] == 1. If the flags are different, this patch should be in the output.
+   * Also, if this is a Difference and the shape isn't the first one, need to flip the normals.
+   */
+  winding[shape] = 0;
+  bool in_output_volume_0 = apply_bool_op(op, winding);
+  winding[shape] = 1;
+  bool in_output_volume_1 = apply_bool_op(op, winding);
+  bool do_remove = in_output_volume_0 == in_output_volume_1;
+  bool do_flip = !do_remove && op == BoolOpType::Difference && shape != 0;
+  if (dbg_level > 0) {
+    std::cout << "winding = ";
+    for (int i = 0; i < nshapes; ++i) {
+      std::cout << winding[i] << " ";
+    }
+    std::cout << "\niv0=" << in_output_volume_0 << ", iv1=" << in_output_volume_1 << "\n";
+    std::cout << "result for patch " << p << ": remove=" << do_remove << ", flip=" << do_flip
+              << "\n";
+  }
+  data->do_remove[p] = do_remove;
+  data->do_flip[p] = do_flip;
+}
+
 /**
  * Use the Generalized Winding Number method for deciding if a patch of the
  * mesh is supposed to be included or excluded in the boolean result,
@@ -2395,86 +2506,36 @@ static IMesh gwn_boolean(const IMesh &tm,
   if (dbg_level > 0) {
     std::cout << "GWN_BOOLEAN\n";
   }
+  GwnPatchData data(tm, op, nshapes, shape_fn, pinfo);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  settings.use_threading = boolean_use_threading;
+  BLI_task_parallel_range(0, pinfo.tot_patch(), &data, gwn_classify_patch_range_func, &settings);
+
   IMesh ans;
   Vector<Face *> out_faces;
   out_faces.reserve(tm.face_size());
-  Array<int> winding(nshapes, 0);
   for (int p : pinfo.index_range()) {
-    const Patch &patch = pinfo.patch(p);
-    /* For test triangle, choose one in the middle of patch list
-     * as the ones near the beginning may be very near other patches. */
-    int test_t_index = patch.tri(patch.tot_tri() / 2);
-    Face &tri_test = *tm.face(test_t_index);
-    /* Assume all triangles in a patch are in the same shape. */
-    int shape = shape_fn(tri_test.orig);
-    if (dbg_level > 0) {
-      std::cout << "process patch " << p << " = " << patch << "\n";
-      std::cout << "test tri = " << test_t_index << " = " << &tri_test << "\n";
-      std::cout << "shape = " << shape << "\n";
-    }
-    if (shape == -1) {
+    if (data.do_remove[p]) {
       continue;
     }
-    mpq3 test_point = calc_point_inside_tri(tri_test);
-    double3 test_point_db(test_point[0].get_d(), test_point[1].get_d(), test_point[2].get_d());
-    if (dbg_level > 0) {
-      std::cout << "test point = " << test_point_db << "\n";
-    }
-    for (int other_shape = 0; other_shape < nshapes; ++other_shape) {
-      if (other_shape == shape) {
-        continue;
-      }
-      /* The point_is_inside_shape function has to approximate if the other
-       * shape is not PWN. For most operations, even a hint of being inside
-       * gives good results, but when shape is a cutter in a Difference
-       * operation, we want to be pretty sure that the point is inside other_shape.
-       * E.g., T75827.
-       */
-      bool need_high_confidence = (op == BoolOpType::Difference) && (shape != 0);
-      bool inside = point_is_inside_shape(
-          tm, shape_fn, test_point_db, other_shape, need_high_confidence);
-      if (dbg_level > 0) {
-        std::cout << "test point is " << (inside ? "inside" : "outside") << " other_shape "
-                  << other_shape << "\n";
-      }
-      winding[other_shape] = inside;
-    }
-    /* Find out the "in the output volume" flag for each of the cases of winding[shape] == 0
-     * and winding[shape] == 1. If the flags are different, this patch should be in the output.
-     * Also, if this is a Difference and the shape isn't the first one, need to flip the normals.
-     */
-    winding[shape] = 0;
-    bool in_output_volume_0 = apply_bool_op(op, winding);
-    winding[shape] = 1;
-    bool in_output_volume_1 = apply_bool_op(op, winding);
-    bool do_remove = in_output_volume_0 == in_output_volume_1;
-    bool do_flip = !do_remove && op == BoolOpType::Difference && shape != 0;
-    if (dbg_level > 0) {
-      std::cout << "winding = ";
-      for (int i = 0; i < nshapes; ++i) {
-        std::cout << winding[i] << " ";
+    const Patch &patch = pinfo.patch(p);
+    for (int t : patch.tris()) {
+      Face *f = tm.face(t);
+      if (!data.do_flip[p]) {
+        out_faces.append(f);
       }
-      std::cout << "\niv0=" << in_output_volume_0 << ", iv1=" << in_output_volume_1 << "\n";
-      std::cout << "result for patch " << p << ": remove=" << do_remove << ", flip=" << do_flip
-                << "\n";
-    }
-    if (!do_remove) {
-      for (int t : patch.tris()) {
-        Face *f = tm.face(t);
-        if (!do_flip) {
-          out_faces.append(f);
-        }
-        else {
-          Face &tri = *f;
-          /* We need flipped version of f. */
-          Array<const Vert *> flipped_vs = {tri[0], tri[2], tri[1]};
-          Array<int> flipped_e_origs = {tri.edge_orig[2], tri.edge_orig[1], tri.edge_orig[0]};
-          Array<bool> flipped_is_intersect = {
-              tri.is_intersect[2], tri.is_intersect[1], tri.is_intersect[0]};
-          Face *flipped_f = arena->add_face(
-              flipped_vs, f->orig, flipped_e_origs, flipped_is_intersect);
-          out_faces.append(flipped_f);
-        }
+      else {
+        Face &tri = *f;
+        /* We need flipped version of f. */
+        Array<const Vert *> flipped_vs = {tri[0], tri[2], tri[1]};
+        Array<int> flipped_e_origs = {tri.edge_orig[2], tri.edge_orig[1], tri.edge_orig[0]};
+        Array<bool> flipped_is_intersect = {
+            tri.is_intersect[2], tri.is_intersect[1], tri.is_intersect[0]};
+        Face *flipped_f = arena->add_face(
+            flipped_vs, f->orig, flipped_e_origs, flipped_is_intersect);
+        out_faces.append(flipped_f);
       }
     }
   }
@@ -1423,60 +1423,6 @@ static double supremum_dot(const double3 &a, const double3 &b)
   return double3::dot(abs_a, abs_b);
 }
 
-static double supremum_orient3d(const double3 &a,
-                                const double3 &b,
-                                const double3 &c,
-                                const double3 &d)
-{
-  double3 abs_a = double3::abs(a);
-  double3 abs_b = double3::abs(b);
-  double3 abs_c = double3::abs(c);
-  double3 abs_d = double3::abs(d);
-  double adx = abs_a[0] + abs_d[0];
-  double bdx = abs_b[0] + abs_d[0];
-  double cdx = abs_c[0] + abs_d[0];
-  double ady = abs_a[1] + abs_d[1];
-  double bdy = abs_b[1] + abs_d[1];
-  double cdy = abs_c[1] + abs_d[1];
-  double adz = abs_a[2] + abs_d[2];
-  double bdz = abs_b[2] + abs_d[2];
-  double cdz = abs_c[2] + abs_d[2];
-
-  double bdxcdy = bdx * cdy;
-  double cdxbdy = cdx * bdy;
-
-  double cdxady = cdx * ady;
-  double adxcdy = adx * cdy;
-
-  double adxbdy = adx * bdy;
-  double bdxady = bdx * ady;
-
-  double det = adz * (bdxcdy + cdxbdy) + bdz * (cdxady + adxcdy) + cdz * (adxbdy + bdxady);
-  return det;
-}
-
-/** Actually index_orient3d = 10 + 4 * (max degree of input coordinates) */
-constexpr int index_orient3d = 14;
-
-/**
- * Return the approximate orient3d of the four double3's, with
- * the guarantee that if the value is -1 or 1 then the underlying
- * mpq3 test would also have returned that value.
- * When the return value is 0, we are not sure of the sign.
- */
-static int filter_orient3d(const double3 &a, const double3 &b, const double3 &c, const double3 &d)
-{
-  double o3dfast = orient3d_fast(a, b, c, d);
-  if (o3dfast == 0.0) {
-    return 0;
-  }
-  double err_bound = supremum_orient3d(a, b, c, d) * index_orient3d * DBL_EPSILON;
-  if (fabs(o3dfast) > err_bound) {
-    return o3dfast > 0.0 ? 1 : -1;
-  }
-  return 0;
-}
-
 /**
  * Return the approximate orient3d of the triangle plane points and v, with
  * the guarantee that if the value is -1 or 1 then the underlying
@@ -1485,7 +1431,7 @@ static int filter_orient3d(const double3 &a, const double3 &b, const double3 &c,
  */
 static int filter_tri_plane_vert_orient3d(const Face &tri, const Vert *v)
 {
-  return filter_orient3d(tri[0]->co, tri[1]->co, tri[2]->co, v->co);
+  return orient3d_filter(tri[0]->co, tri[1]->co, tri[2]->co, v->co);
 }
 
 /**
@@ -1550,7 +1496,7 @@ static int filter_plane_side(const double3 &p,
   }
   double supremum = double3::dot(abs_p + abs_plane_p, abs_plane_no);
   double err_bound = supremum * index_plane_side * DBL_EPSILON;
-  if (d > err_bound) {
+  if (fabs(d) > err_bound) {
     return d > 0 ? 1 : -1;
   }
   return 0;
@@ -2532,6 +2478,42 @@ class TriOverlaps {
   }
 };
 
+/**
+ * Data needed for parallelization of #populate_overlapping_tri_planes.
+ */
+struct PopulatePlanesData {
+  const IMesh &tm;
+  const TriOverlaps &ov;
+
+  PopulatePlanesData(const IMesh &tm, const TriOverlaps &ov) : tm(tm), ov(ov)
+  {
+  }
+};
+
+static void populate_plane_range_func(void *__restrict userdata,
+                                      const int iter,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PopulatePlanesData *data = static_cast<PopulatePlanesData *>(userdata);
+  if (data->ov.first_overlap_index(iter) != -1) {
+    data->tm.face(iter)->populate_plane(true);
+  }
+}
+
+/**
+ * Calculate the exact planes of the triangles that overlap another one,
+ * which need them for #intersect_tri_tri. Each is independent, so do them in parallel.
+ */
+static void populate_overlapping_tri_planes(const IMesh &tm, const TriOverlaps &ov)
+{
+  PopulatePlanesData data(tm, ov);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1000;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(0, tm.face_size(), &data, populate_plane_range_func, &settings);
+}
+
 /**
  * Data needed for parallelization of #calc_overlap_itts.
  */
@@ -2787,6 +2769,122 @@ static CDT_data calc_cluster_subdivided(const CoplanarClusterInfo &clinfo,
   return cd_data;
 }
 
+/**
+ * Data needed for parallelization of #calc_clusters_subdivided.
+ */
+struct SubdivideClustersData {
+  Array<CDT_data> &r_cluster_subdivided;
+  const CoplanarClusterInfo &clinfo;
+  const IMesh &tm;
+  const TriOverlaps &ov;
+  const Map<std::pair<int, int>, ITT_value> &itt_map;
+  IMeshArena *arena;
+
+  SubdivideClustersData(Array<CDT_data> &r_cluster_subdivided,
+                        const CoplanarClusterInfo &clinfo,
+                        const IMesh &tm,
+                        const TriOverlaps &ov,
+                        const Map<std::pair<int, int>, ITT_value> &itt_map,
+                        IMeshArena *arena)
+      : r_cluster_subdivided(r_cluster_subdivided),
+        clinfo(clinfo),
+        tm(tm),
+        ov(ov),
+        itt_map(itt_map),
+        arena(arena)
+  {
+  }
+};
+
+static void calc_cluster_subdivided_range_func(void *__restrict userdata,
+                                               const int iter,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SubdivideClustersData *data = static_cast<SubdivideClustersData *>(userdata);
+  data->r_cluster_subdivided[iter] = calc_cluster_subdivided(
+      data->clinfo, iter, data->tm, data->ov, data->itt_map, data->arena);
+}
+
+/**
+ * Fill in r_cluster_subdivided with the CDT of each cluster. The clusters are independent
+ * of each other, so the CDTs are done in parallel.
+ */
+static void calc_clusters_subdivided(Array<CDT_data> &r_cluster_subdivided,
+                                     const CoplanarClusterInfo &clinfo,
+                                     const IMesh &tm,
+                                     const TriOverlaps &ov,
+                                     const Map<std::pair<int, int>, ITT_value> &itt_map,
+                                     IMeshArena *arena)
+{
+  SubdivideClustersData data(r_cluster_subdivided, clinfo, tm, ov, itt_map, arena);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(
+      0, clinfo.tot_cluster(), &data, calc_cluster_subdivided_range_func, &settings);
+}
+
+/**
+ * Data needed for parallelization of #extract_subdivided_tris.
+ */
+struct ExtractTrisData {
+  Array<IMesh> &r_tri_subdivided;
+  const IMesh &tm;
+  const CoplanarClusterInfo &clinfo;
+  const Array<CDT_data> &cluster_subdivided;
+  IMeshArena *arena;
+
+  ExtractTrisData(Array<IMesh> &r_tri_subdivided,
+                  const IMesh &tm,
+                  const CoplanarClusterInfo &clinfo,
+                  const Array<CDT_data> &cluster_subdivided,
+                  IMeshArena *arena)
+      : r_tri_subdivided(r_tri_subdivided),
+        tm(tm),
+        clinfo(clinfo),
+        cluster_subdivided(cluster_subdivided),
+        arena(arena)
+  {
+  }
+};
+
+static void extract_subdivided_tri_range_func(void *__restrict userdata,
+                                              const int iter,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ExtractTrisData *data = static_cast<ExtractTrisData *>(userdata);
+  int t = iter;
+  int c = data->clinfo.tri_cluster(t);
+  if (c != NO_INDEX) {
+    BLI_assert(data->r_tri_subdivided[t].face_size() == 0);
+    data->r_tri_subdivided[t] = extract_subdivided_tri(
+        data->cluster_subdivided[c], data->tm, t, data->arena);
+  }
+  else if (data->r_tri_subdivided[t].face_size() == 0) {
+    data->r_tri_subdivided[t] = extract_single_tri(data->tm, t);
+  }
+}
+
+/**
+ * Fill in the slots of r_tri_subdivided not done by #calc_subdivided_tris:
+ * the triangles of clusters, taken from the cluster CDTs, and the triangles
+ * that don't intersect anything. The arena is thread safe, so this is done in parallel.
+ */
+static void extract_subdivided_tris(Array<IMesh> &r_tri_subdivided,
+                                    const IMesh &tm,
+                                    const CoplanarClusterInfo &clinfo,
+                                    const Array<CDT_data> &cluster_subdivided,
+                                    IMeshArena *arena)
+{
+  ExtractTrisData data(r_tri_subdivided, tm, clinfo, cluster_subdivided, arena);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1000;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(0, tm.face_size(), &data, extract_subdivided_tri_range_func, &settings);
+}
+
 static IMesh union_tri_subdivides(const blender::Array<IMesh> &tri_subdivided)
 {
   int tot_tri = 0;
@@ -3077,11 +3175,7 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   double overlap_time = PIL_check_seconds_timer();
   std::cout << "intersect overlaps calculated, time = " << overlap_time - bb_calc_time << "\n";
 #  endif
-  for (int t : tm_clean->face_index_range()) {
-    if (tri_ov.first_overlap_index(t) != -1) {
-      tm_clean->face(t)->populate_plane(true);
-    }
-  }
+  populate_overlapping_tri_planes(*tm_clean, tri_ov);
 #  ifdef PERFDEBUG
   double plane_populate = PIL_check_seconds_timer();
   std::cout << "planes populated, time = " << plane_populate - overlap_time << "\n";
@@ -3113,24 +3207,13 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   std::cout << "subdivided tris found, time = " << subdivided_tris_time - itt_time << "\n";
 #  endif
   Array<CDT_data> cluster_subdivided(clinfo.tot_cluster());
-  for (int c : clinfo.index_range()) {
-    cluster_subdivided[c] = calc_cluster_subdivided(clinfo, c, *tm_clean, tri_ov, itt_map, arena);
-  }
+  calc_clusters_subdivided(cluster_subdivided, clinfo, *tm_clean, tri_ov, itt_map, arena);
 #  ifdef PERFDEBUG
   double cluster_subdivide_time = PIL_check_seconds_timer();
   std::cout << "subdivided clusters found, time = "
             << cluster_subdivide_time - subdivided_tris_time << "\n";
 #  endif
-  for (int t : tm_clean->face_index_range()) {
-    int c = clinfo.tri_cluster(t);
-    if (c != NO_INDEX) {
-      BLI_assert(tri_subdivided[t].face_size() == 0);
-      tri_subdivided[t] = extract_subdivided_tri(cluster_subdivided[c], *tm_clean, t, arena);
-    }
-    else if (tri_subdivided[t].face_size() == 0) {
-      tri_subdivided[t] = extract_single_tri(*tm_clean, t);
-    }
-  }
+  extract_subdivided_tris(tri_subdivided, *tm_clean, clinfo, cluster_subdivided, arena);
 #  ifdef PERFDEBUG
   double extract_time = PIL_check_seconds_timer();
   std::cout << "triangles extracted, time = " << extract_time - cluster_subdivide_time << "\n";
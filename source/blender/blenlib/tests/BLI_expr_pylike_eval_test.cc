@@ -82,6 +82,17 @@ static void expr_pylike_error_test(const char *str, double x, eExprPyLike_EvalSt
   BLI_expr_pylike_free(expr);
 }
 
+static void expr_pylike_parse_error_test(const char *str, const char *message)
+{
+  const char *names[1] = {"x"};
+  ExprPyLike_Parsed *expr = BLI_expr_pylike_parse(str, names, ARRAY_SIZE(names));
+
+  EXPECT_FALSE(BLI_expr_pylike_is_valid(expr));
+  EXPECT_STREQ(BLI_expr_pylike_parse_error(expr), message);
+
+  BLI_expr_pylike_free(expr);
+}
+
 #define TEST_PARSE_FAIL(name, str) \
   TEST(expr_pylike, ParseFail_##name) \
   { \
@@ -111,6 +122,32 @@ TEST_PARSE_FAIL(Truncated7, "1 and")
 TEST_PARSE_FAIL(Truncated8, "1 or")
 TEST_PARSE_FAIL(Truncated9, "sqrt(1")
 TEST_PARSE_FAIL(Truncated10, "fmod(1,")
+TEST_PARSE_FAIL(Truncated11, "2 **")
+
+/* The 'math' module isn't bound in the Python driver namespace either. */
+TEST_PARSE_FAIL(MathAttr1, "math.sin(1)")
+TEST_PARSE_FAIL(MathAttr2, "math.pi")
+
+#define TEST_PARSE_ERROR(name, str, message) \
+  TEST(expr_pylike, ParseError_##name) \
+  { \
+    expr_pylike_parse_error_test(str, message); \
+  }
+
+TEST_PARSE_ERROR(UnknownName, "bpy.data.objects['a'].location.x", "unknown name 'bpy'")
+TEST_PARSE_ERROR(UnknownFunc, "foo(x)", "unknown name 'foo'")
+TEST_PARSE_ERROR(MathAttr, "math.sin(x)", "unknown name 'math'")
+TEST_PARSE_ERROR(ArgCount, "sqrt(x, 2)", "wrong number of arguments for function 'sqrt'")
+TEST_PARSE_ERROR(Syntax, "x[0]", "unsupported syntax at column 2")
+
+TEST(expr_pylike, ParseError_Valid)
+{
+  ExprPyLike_Parsed *expr = parse_for_eval("x + 1", true);
+
+  EXPECT_EQ(BLI_expr_pylike_parse_error(expr), (const char *)NULL);
+
+  BLI_expr_pylike_free(expr);
+}
 
 /* Constant expression with working constant folding */
 #define TEST_CONST(name, str, value) \
@@ -145,6 +182,8 @@ TEST_CONST(Half, ".5", 0.5)
 TEST_CONST(Pi, "pi", M_PI)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
+TEST_CONST(E, "e", M_E)
+TEST_CONST(Tau, "tau", M_PI * 2)
 
 TEST_CONST(Sqrt, "sqrt(4)", 2.0)
 TEST_EVAL(Sqrt, "sqrt(x)", 4.0, 2.0)
@@ -156,6 +195,23 @@ TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
 TEST_CONST(Log2_1, "log(4, 2)", 2.0)
+TEST_CONST(Log2_2, "log2(8)", 3.0)
+TEST_CONST(Log10, "log10(100)", 2.0)
+
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_EVAL(Hypot, "hypot(x, 4)", 3, 5.0)
+
+TEST_CONST(Tanh, "tanh(0)", 0.0)
+TEST_EVAL(Sinh, "sinh(x)", 0, 0.0)
+TEST_EVAL(Cosh, "cosh(x)", 0, 1.0)
+
+TEST_CONST(CopySign, "copysign(2, -1)", -2.0)
+TEST_EVAL(CopySign, "copysign(x, -1)", 2, -2.0)
+
+TEST_EVAL(Float, "float(x)", 1.5, 1.5)
+TEST_CONST(Bool1, "bool(2)", TRUE_VAL)
+TEST_CONST(Bool2, "bool(0)", FALSE_VAL)
+TEST_EVAL(Bool, "bool(x)", -2, TRUE_VAL)
 
 TEST_CONST(Round1, "round(-0.5)", -1.0)
 TEST_CONST(Round2, "round(-0.4)", 0.0)
@@ -205,6 +261,24 @@ TEST_EVAL(BinaryMul, "x*3", 2, 6.0)
 TEST_CONST(BinaryDiv, "3/2", 1.5)
 TEST_EVAL(BinaryDiv, "3/x", 2, 1.5)
 
+TEST_CONST(BinaryPow, "2**3", 8.0)
+TEST_EVAL(BinaryPow, "x**3", 2, 8.0)
+
+TEST_CONST(FloorDiv1, "7 // 2", 3.0)
+TEST_CONST(FloorDiv2, "-7 // 2", -4.0)
+TEST_EVAL(FloorDiv, "x // 2", -7, -4.0)
+
+TEST_CONST(Mod1, "7 % 3", 1.0)
+TEST_CONST(Mod2, "-1 % 3", 2.0)
+TEST_CONST(Mod3, "1 % -3", -2.0)
+TEST_EVAL(Mod, "x % 3", -1, 2.0)
+
+TEST_CONST(Pow1, "-2 ** 2", -4.0)
+TEST_CONST(Pow2, "2 ** 3 ** 2", 512.0)
+TEST_CONST(Pow3, "(-2) ** 2", 4.0)
+TEST_CONST(Pow4, "2 ** -1", 0.5)
+TEST_CONST(Pow5, "2 * 3 ** 2", 18.0)
+
 TEST_CONST(Arith1, "1 + -2 * 3", -5.0)
 TEST_CONST(Arith2, "(1 + -2) * 3", -3.0)
 TEST_CONST(Arith3, "-1 + 2 * 3", 5.0)
@@ -288,6 +362,28 @@ TEST(expr_pylike, Eval_Ternary1)
   BLI_expr_pylike_free(expr);
 }
 
+TEST(expr_pylike, Eval_Ternary2)
+{
+  ExprPyLike_Parsed *expr = parse_for_eval("x*1 + 2 if x*2 < 4 else x**1 - 0 if x < 8 else x % 3",
+                                           true);
+
+  for (int i = 0; i <= 10; i++) {
+    double x = i;
+    double v = (x * 2 < 4) ? (x + 2) : (x < 8) ? x : fmod(x, 3);
+
+    verify_eval_result(expr, x, v);
+  }
+
+  BLI_expr_pylike_free(expr);
+}
+
+/* Identity operations are optimized away, but must not make the expression constant. */
+TEST_EVAL(Identity1, "x * 1", 3, 3.0)
+TEST_EVAL(Identity2, "x / 1", 3, 3.0)
+TEST_EVAL(Identity3, "x - 0", 3, 3.0)
+TEST_EVAL(Identity4, "x ** 1", 3, 3.0)
+TEST_EVAL(Identity5, "-(x * 1)", 3, -3.0)
+
 TEST(expr_pylike, MultipleArgs)
 {
   const char *names[3] = {"x", "y", "x"};
@@ -337,6 +433,10 @@ TEST_ERROR(SqrtDomain3, "sqrt(x)", 0.0, EXPR_PYLIKE_SUCCESS)
 TEST_ERROR(PowDomain1, "pow(-1, 0.5)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain2, "pow(-1, x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain3, "pow(-1, x)", 2.0, EXPR_PYLIKE_SUCCESS)
+TEST_ERROR(PowDomain4, "x ** 0.5", -1.0, EXPR_PYLIKE_MATH_ERROR)
+
+TEST_ERROR(FloorDivZero, "1 // x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
+TEST_ERROR(ModZero, "1 % x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 
 TEST_ERROR(Mixed1, "sqrt(x) + 1 / max(0, x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(Mixed2, "sqrt(x) + 1 / max(0, x)", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
@@ -3546,6 +3546,9 @@ static void direct_link_modifiers(BlendDataReader *reader, ListBase *lb, Object
 
     md->error = NULL;
     md->runtime = NULL;
+    md->execution_time = 0.0;
+    md->output_memory = 0;
+    md->flag &= ~eModifierFlag_EvalStatsCached;
 
     /* Modifier data has been allocated as a part of data migration process and
      * no reading of nested fields from file is needed. */
@@ -806,5 +806,16 @@ void blo_do_versions_290(FileData *fd, Library *UNUSED(lib), Main *bmain)
         }
       }
     }
+
+    if (!DNA_struct_elem_find(
+            fd->filesdna, "MeshSeqCacheModifierData", "int", "prefetch_frames")) {
+      LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+        LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+          if (md->type == eModifierType_MeshSequenceCache) {
+            ((MeshSeqCacheModifierData *)md)->prefetch_frames = 8;
+          }
+        }
+      }
+    }
   }
 }
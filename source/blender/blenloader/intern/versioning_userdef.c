@@ -807,6 +807,9 @@ void blo_do_versions_userdef(UserDef *userdef)
    */
   {
     /* Keep this block, even when empty. */
+    if (userdef->modifier_cache_limit == 0) {
+      userdef->modifier_cache_limit = 256;
+    }
   }
 
   if (userdef->pixelsize == 0.0f) {
@@ -0,0 +1,186 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation
+ * All rights reserved.
+ */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math.h"
+#include "BLI_timeit.hh"
+#include "BLI_utildefines.h"
+
+#include "bmesh.h"
+#include "bmesh_tools.h"
+
+namespace blender::bmesh::tests {
+
+static float grid_height(const float x, const float y, const float amplitude)
+{
+  return amplitude * sinf(x * 0.2f) * cosf(y * 0.2f);
+}
+
+/**
+ * A triangulated height field, like a scan of a terrain.
+ */
+static BMesh *grid_bmesh_create(const int grid_size, const float amplitude)
+{
+  BMeshCreateParams create_params{};
+  create_params.use_toolflags = false;
+  BMesh *bm = BM_mesh_create(&bm_mesh_allocsize_default, &create_params);
+
+  BMVert **verts = (BMVert **)MEM_malloc_arrayN(
+      grid_size * grid_size, sizeof(BMVert *), __func__);
+  for (int y = 0; y < grid_size; y++) {
+    for (int x = 0; x < grid_size; x++) {
+      const float co[3] = {(float)x, (float)y, grid_height(x, y, amplitude)};
+      verts[y * grid_size + x] = BM_vert_create(bm, co, nullptr, BM_CREATE_NOP);
+    }
+  }
+
+  for (int y = 0; y < grid_size - 1; y++) {
+    for (int x = 0; x < grid_size - 1; x++) {
+      const int v = y * grid_size + x;
+      BMVert *tri_a[3] = {verts[v], verts[v + 1], verts[v + 1 + grid_size]};
+      BMVert *tri_b[3] = {verts[v], verts[v + 1 + grid_size], verts[v + grid_size]};
+      BM_face_create_verts(bm, tri_a, 3, nullptr, BM_CREATE_NOP, true);
+      BM_face_create_verts(bm, tri_b, 3, nullptr, BM_CREATE_NOP, true);
+    }
+  }
+  MEM_freeN(verts);
+
+  BM_mesh_normals_update(bm);
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+  return bm;
+}
+
+static float grid_height_error_max(BMesh *bm, const float amplitude)
+{
+  BMIter iter;
+  BMVert *v;
+  float error_max = 0.0f;
+  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+    error_max = max_ff(error_max, fabsf(v->co[2] - grid_height(v->co[0], v->co[1], amplitude)));
+  }
+  return error_max;
+}
+
+TEST(bmesh_decimate_collapse, FlatGridKeepsOutline)
+{
+  const int grid_size = 32;
+  BMesh *bm = grid_bmesh_create(grid_size, 0.0f);
+  const int face_tot_target = bm->totface * 0.25f;
+
+  BM_mesh_decimate_collapse(bm, 0.25f, nullptr, 1.0f, true, -1, 0.0f);
+
+  EXPECT_LE(bm->totface, face_tot_target);
+  EXPECT_TRUE(BM_mesh_validate(bm));
+
+  int corners_len = 0;
+  BMIter iter;
+  BMVert *v;
+  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+    EXPECT_EQ(v->co[2], 0.0f);
+    EXPECT_GE(v->co[0], 0.0f);
+    EXPECT_GE(v->co[1], 0.0f);
+    EXPECT_LE(v->co[0], (float)(grid_size - 1));
+    EXPECT_LE(v->co[1], (float)(grid_size - 1));
+    if (ELEM(v->co[0], 0.0f, (float)(grid_size - 1)) &&
+        ELEM(v->co[1], 0.0f, (float)(grid_size - 1))) {
+      corners_len++;
+    }
+  }
+  EXPECT_EQ(corners_len, 4);
+
+  BM_mesh_free(bm);
+}
+
+/* Partitions are decimated separately, the final pass over the whole mesh should still reach the
+ * target without losing much accuracy compared to a single pass. */
+TEST(bmesh_decimate_collapse, PartitionedMatchesSerial)
+{
+  const int grid_size = 96;
+  const float amplitude = 2.0f;
+  float error_max[2];
+
+  for (int i = 0; i < 2; i++) {
+    BMesh *bm = grid_bmesh_create(grid_size, amplitude);
+    const int face_tot_target = bm->totface * 0.1f;
+
+    BM_mesh_decimate_collapse_ex(bm, 0.1f, nullptr, 1.0f, true, -1, 0.0f, (i == 0) ? 1 : 4);
+
+    EXPECT_LE(bm->totface, face_tot_target);
+    EXPECT_TRUE(BM_mesh_validate(bm));
+    error_max[i] = grid_height_error_max(bm, amplitude);
+    BM_mesh_free(bm);
+  }
+
+  EXPECT_LE(error_max[1], error_max[0] * 2.0f + 0.05f);
+}
+
+/* Vertices with a zero weight can't be collapsed, their weights have to follow them through the
+ * partitions to the merged mesh. */
+TEST(bmesh_decimate_collapse, PartitionedVertexWeights)
+{
+  const int grid_size = 64;
+  BMesh *bm = grid_bmesh_create(grid_size, 2.0f);
+
+  float *vweights = (float *)MEM_malloc_arrayN(bm->totvert, sizeof(float), __func__);
+  BMIter iter;
+  BMVert *v;
+  int i;
+  BM_ITER_MESH_INDEX (v, &iter, bm, BM_VERTS_OF_MESH, i) {
+    vweights[i] = (v->co[1] < grid_size / 2) ? 0.0f : 1.0f;
+  }
+
+  BM_mesh_decimate_collapse_ex(bm, 0.25f, vweights, 1.0f, true, -1, 0.0f, 4);
+  EXPECT_TRUE(BM_mesh_validate(bm));
+
+  int locked_len = 0;
+  BM_mesh_elem_index_ensure(bm, BM_VERT);
+  BM_ITER_MESH_INDEX (v, &iter, bm, BM_VERTS_OF_MESH, i) {
+    if (vweights[i] == 0.0f) {
+      EXPECT_LT(v->co[1], grid_size / 2);
+      EXPECT_EQ(v->co[0], floorf(v->co[0]));
+      EXPECT_EQ(v->co[1], floorf(v->co[1]));
+      locked_len++;
+    }
+  }
+  EXPECT_EQ(locked_len, grid_size * grid_size / 2);
+
+  MEM_freeN(vweights);
+  BM_mesh_free(bm);
+}
+
+#if 0
+TEST(bmesh_decimate_collapse, Performance)
+{
+  const float amplitude = 2.0f;
+  for (int partitions_len : {1, 8}) {
+    BMesh *bm = grid_bmesh_create(1000, amplitude);
+    {
+      SCOPED_TIMER(partitions_len == 1 ? "Decimate collapse, 1000x1000 grid, single pass" :
+                                         "Decimate collapse, 1000x1000 grid, 8 partitions");
+      BM_mesh_decimate_collapse_ex(bm, 0.1f, nullptr, 1.0f, true, -1, 0.0f, partitions_len);
+    }
+    std::cout << "  Largest height error: " << grid_height_error_max(bm, amplitude) << "\n";
+    BM_mesh_free(bm);
+  }
+}
+#endif /* Benchmark */
+
+}  // namespace blender::bmesh::tests
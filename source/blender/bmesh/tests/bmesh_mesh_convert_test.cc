@@ -0,0 +1,281 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation
+ * All rights reserved.
+ */
+#include "testing/testing.h"
+
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math.h"
+#include "BLI_string.h"
+#include "BLI_timeit.hh"
+#include "BLI_utildefines.h"
+
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "bmesh.h"
+
+namespace blender::bmesh::tests {
+
+/**
+ * A row of quads along X, each loop has its own index as UV so the loops can be told apart.
+ */
+static void quad_strip_mesh(Mesh *me, const int quads_len)
+{
+  memset(me, 0, sizeof(*me));
+  STRNCPY(me->id.name, "MEStrip");
+
+  me->totvert = (quads_len + 1) * 2;
+  me->totedge = quads_len * 3 + 1;
+  me->totpoly = quads_len;
+  me->totloop = quads_len * 4;
+
+  CustomData_add_layer(&me->vdata, CD_MVERT, CD_CALLOC, nullptr, me->totvert);
+  CustomData_add_layer(&me->vdata, CD_MDEFORMVERT, CD_CALLOC, nullptr, me->totvert);
+  CustomData_add_layer(&me->edata, CD_MEDGE, CD_CALLOC, nullptr, me->totedge);
+  CustomData_add_layer(&me->ldata, CD_MLOOP, CD_CALLOC, nullptr, me->totloop);
+  CustomData_add_layer_named(&me->ldata, CD_MLOOPUV, CD_CALLOC, nullptr, me->totloop, "UV");
+  CustomData_add_layer(&me->pdata, CD_MPOLY, CD_CALLOC, nullptr, me->totpoly);
+  BKE_mesh_update_customdata_pointers(me, false);
+
+  /* Vertex 2 * i is at the bottom, 2 * i + 1 at the top. Edge 3 * i is vertical,
+   * 3 * i + 1 and 3 * i + 2 are the bottom and top edges going to the next column. */
+  for (int i = 0; i <= quads_len; i++) {
+    copy_v3_fl3(me->mvert[i * 2].co, (float)i, 0.0f, 0.0f);
+    copy_v3_fl3(me->mvert[i * 2 + 1].co, (float)i, 1.0f, 0.0f);
+    me->medge[i * 3].v1 = i * 2;
+    me->medge[i * 3].v2 = i * 2 + 1;
+    if (i < quads_len) {
+      me->medge[i * 3 + 1].v1 = i * 2;
+      me->medge[i * 3 + 1].v2 = i * 2 + 2;
+      me->medge[i * 3 + 2].v1 = i * 2 + 1;
+      me->medge[i * 3 + 2].v2 = i * 2 + 3;
+    }
+  }
+
+  for (int i = 0; i < quads_len; i++) {
+    MPoly *mp = &me->mpoly[i];
+    mp->loopstart = i * 4;
+    mp->totloop = 4;
+    mp->mat_nr = i % 2;
+
+    MLoop *ml = &me->mloop[mp->loopstart];
+    ml[0].v = i * 2;
+    ml[0].e = i * 3 + 1;
+    ml[1].v = i * 2 + 2;
+    ml[1].e = i * 3 + 3;
+    ml[2].v = i * 2 + 3;
+    ml[2].e = i * 3 + 2;
+    ml[3].v = i * 2 + 1;
+    ml[3].e = i * 3;
+
+    for (int j = 0; j < 4; j++) {
+      copy_v2_fl(me->mloopuv[mp->loopstart + j].uv, (float)(mp->loopstart + j));
+    }
+  }
+}
+
+static void mesh_free_data(Mesh *me)
+{
+  CustomData_free(&me->vdata, me->totvert);
+  CustomData_free(&me->edata, me->totedge);
+  CustomData_free(&me->ldata, me->totloop);
+  CustomData_free(&me->pdata, me->totpoly);
+  MEM_SAFE_FREE(me->mselect);
+}
+
+static BMesh *bmesh_from_mesh(const Mesh *me)
+{
+  BMeshCreateParams create_params{};
+  create_params.use_toolflags = false;
+  BMesh *bm = BM_mesh_create(&bm_mesh_allocsize_default, &create_params);
+
+  BMeshFromMeshParams convert_params{};
+  convert_params.calc_face_normal = true;
+  BM_mesh_bm_from_me(bm, me, &convert_params);
+  return bm;
+}
+
+static void bmesh_to_mesh_for_eval(BMesh *bm, Mesh *r_mesh)
+{
+  memset(r_mesh, 0, sizeof(*r_mesh));
+  BM_mesh_bm_to_me_for_eval(bm, r_mesh, nullptr);
+  BKE_mesh_update_customdata_pointers(r_mesh, false);
+}
+
+/* Custom-data is filled in after all elements are created, it must still end up on the loops
+ * and faces it came from. */
+TEST(bmesh_mesh_convert, LoopDataFollowsFaces)
+{
+  Mesh mesh;
+  quad_strip_mesh(&mesh, 3);
+  BMesh *bm = bmesh_from_mesh(&mesh);
+
+  const int cd_loop_uv_offset = CustomData_get_offset(&bm->ldata, CD_MLOOPUV);
+  BMIter iter;
+  BMFace *f;
+  int face_index = 0;
+  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+    EXPECT_EQ(f->mat_nr, face_index % 2);
+    EXPECT_NEAR(f->no[2], 1.0f, 1e-6f);
+
+    BMLoop *l_iter, *l_first;
+    int loop_index = face_index * 4;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      const MLoopUV *luv = (const MLoopUV *)BM_ELEM_CD_GET_VOID_P(l_iter, cd_loop_uv_offset);
+      EXPECT_EQ(luv->uv[0], (float)loop_index);
+      EXPECT_EQ(BM_elem_index_get(l_iter->v), (int)mesh.mloop[loop_index].v);
+      loop_index++;
+    } while ((l_iter = l_iter->next) != l_first);
+    face_index++;
+  }
+
+  BM_mesh_free(bm);
+  mesh_free_data(&mesh);
+}
+
+/* Loop-starts are taken from the loop indices, which have to be recalculated after
+ * removing a face. */
+TEST(bmesh_mesh_convert, RemovedFaceLoopStart)
+{
+  Mesh mesh;
+  quad_strip_mesh(&mesh, 3);
+  BMesh *bm = bmesh_from_mesh(&mesh);
+  BM_face_kill(bm, BM_face_at_index_find(bm, 1));
+
+  Mesh mesh_eval;
+  bmesh_to_mesh_for_eval(bm, &mesh_eval);
+  ASSERT_EQ(mesh_eval.totpoly, 2);
+  ASSERT_EQ(mesh_eval.totloop, 8);
+  EXPECT_EQ(mesh_eval.mpoly[0].loopstart, 0);
+  EXPECT_EQ(mesh_eval.mpoly[1].loopstart, 4);
+  EXPECT_EQ(mesh_eval.mpoly[1].mat_nr, 0);
+  for (int j = 0; j < 4; j++) {
+    /* The loops of the last face of the original mesh. */
+    EXPECT_EQ(mesh_eval.mloopuv[4 + j].uv[0], (float)(8 + j));
+    EXPECT_EQ(mesh_eval.mloop[4 + j].v, mesh.mloop[8 + j].v);
+    EXPECT_EQ(mesh_eval.mloop[4 + j].e, mesh.mloop[8 + j].e);
+  }
+
+  mesh_free_data(&mesh_eval);
+  BM_mesh_free(bm);
+  mesh_free_data(&mesh);
+}
+
+/* Vertex groups own their weights, each conversion has to make its own copy. */
+TEST(bmesh_mesh_convert, VertexGroupsAreCopied)
+{
+  Mesh mesh;
+  quad_strip_mesh(&mesh, 1);
+  for (int i = 0; i < mesh.totvert; i++) {
+    mesh.dvert[i].dw = (MDeformWeight *)MEM_callocN(sizeof(MDeformWeight), __func__);
+    mesh.dvert[i].dw->weight = 0.25f;
+    mesh.dvert[i].totweight = 1;
+  }
+  BMesh *bm = bmesh_from_mesh(&mesh);
+
+  const int cd_dvert_offset = CustomData_get_offset(&bm->vdata, CD_MDEFORMVERT);
+  BMIter iter;
+  BMVert *v;
+  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+    MDeformVert *dv = (MDeformVert *)BM_ELEM_CD_GET_VOID_P(v, cd_dvert_offset);
+    ASSERT_EQ(dv->totweight, 1);
+    EXPECT_NE(dv->dw, mesh.dvert[BM_elem_index_get(v)].dw);
+    dv->dw->weight = 0.75f;
+  }
+
+  Mesh mesh_orig;
+  memset(&mesh_orig, 0, sizeof(mesh_orig));
+  BMeshToMeshParams params{};
+  BM_mesh_bm_to_me(nullptr, bm, &mesh_orig, &params);
+  BM_mesh_free(bm);
+
+  for (int i = 0; i < mesh.totvert; i++) {
+    EXPECT_EQ(mesh.dvert[i].dw->weight, 0.25f);
+    ASSERT_EQ(mesh_orig.dvert[i].totweight, 1);
+    EXPECT_EQ(mesh_orig.dvert[i].dw->weight, 0.75f);
+  }
+
+  mesh_free_data(&mesh_orig);
+  mesh_free_data(&mesh);
+}
+
+/* Large enough for the conversion to be threaded, every element must still be written to
+ * its own index. */
+TEST(bmesh_mesh_convert, ThreadedRoundTrip)
+{
+  Mesh mesh;
+  quad_strip_mesh(&mesh, BM_OMP_LIMIT);
+  BMesh *bm = bmesh_from_mesh(&mesh);
+
+  Mesh mesh_eval;
+  bmesh_to_mesh_for_eval(bm, &mesh_eval);
+  BM_mesh_free(bm);
+
+  ASSERT_EQ(mesh_eval.totvert, mesh.totvert);
+  ASSERT_EQ(mesh_eval.totloop, mesh.totloop);
+  for (int i = 0; i < mesh.totvert; i++) {
+    EXPECT_V3_NEAR(mesh_eval.mvert[i].co, mesh.mvert[i].co, 1e-6f);
+  }
+  for (int i = 0; i < mesh.totloop; i++) {
+    EXPECT_EQ(mesh_eval.mloop[i].v, mesh.mloop[i].v);
+    EXPECT_EQ(mesh_eval.mloop[i].e, mesh.mloop[i].e);
+    EXPECT_EQ(mesh_eval.mloopuv[i].uv[0], (float)i);
+  }
+
+  mesh_free_data(&mesh_eval);
+  mesh_free_data(&mesh);
+}
+
+#if 0
+TEST(bmesh_mesh_convert, Performance)
+{
+  Mesh mesh;
+  quad_strip_mesh(&mesh, 250000);
+  BMesh *bm = nullptr;
+
+  {
+    SCOPED_TIMER("Mesh to BMesh, 250000 quads, 5 conversions");
+    for (int i = 0; i < 5; i++) {
+      if (bm != nullptr) {
+        BM_mesh_free(bm);
+      }
+      bm = bmesh_from_mesh(&mesh);
+    }
+  }
+  {
+    SCOPED_TIMER("BMesh to Mesh for evaluation, 250000 quads, 5 conversions");
+    for (int i = 0; i < 5; i++) {
+      Mesh mesh_eval;
+      bmesh_to_mesh_for_eval(bm, &mesh_eval);
+      mesh_free_data(&mesh_eval);
+    }
+  }
+
+  BM_mesh_free(bm);
+  mesh_free_data(&mesh);
+}
+#endif /* Benchmark */
+
+}  // namespace blender::bmesh::tests
@@ -20,6 +20,14 @@
  * \ingroup bmesh
  */
 
+void BM_mesh_decimate_collapse_ex(BMesh *bm,
+                                  const float factor,
+                                  float *vweights,
+                                  float vweight_factor,
+                                  const bool do_triangulate,
+                                  const int symmetry_axis,
+                                  const float symmetry_eps,
+                                  const int partitions_len);
 void BM_mesh_decimate_collapse(BMesh *bm,
                                const float factor,
                                float *vweights,
@@ -25,6 +25,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_ghash.h"
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
@@ -32,6 +33,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.h"
@@ -76,64 +78,86 @@ typedef enum CD_UseFlag {
 /* BMesh Helper Functions
  * ********************** */
 
+static void bm_decim_face_quadric(BMFace *f, Quadric *r_q)
+{
+  float center[3];
+  double plane_db[4];
+
+  BM_face_calc_center_median(f, center);
+  copy_v3db_v3fl(plane_db, f->no);
+  plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+
+  BLI_quadric_from_plane(r_q, plane_db);
+}
+
 /**
- * \param vquadrics: must be calloc'd
+ * \return false when the edge is degenerate, in that case no quadric is calculated.
  */
-static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+static bool bm_decim_edge_boundary_quadric(BMEdge *e, Quadric *r_q)
 {
-  BMIter iter;
-  BMFace *f;
-  BMEdge *e;
+  float edge_vector[3];
+  float edge_plane[3];
+  double edge_plane_db[4];
+  sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
 
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_first;
-    BMLoop *l_iter;
+  cross_v3_v3v3(edge_plane, edge_vector, e->l->f->no);
+  copy_v3db_v3fl(edge_plane_db, edge_plane);
 
+  if (normalize_v3_db(edge_plane_db) > (double)FLT_EPSILON) {
     float center[3];
-    double plane_db[4];
-    Quadric q;
 
-    BM_face_calc_center_median(f, center);
-    copy_v3db_v3fl(plane_db, f->no);
-    plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+    mid_v3_v3v3(center, e->v1->co, e->v2->co);
+
+    edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
+    BLI_quadric_from_plane(r_q, edge_plane_db);
+    BLI_quadric_mul(r_q, BOUNDARY_PRESERVE_WEIGHT);
+    return true;
+  }
+  return false;
+}
 
-    BLI_quadric_from_plane(&q, plane_db);
+static void bm_decim_build_quadrics_vert_cb(void *userdata, MempoolIterData *mp_v)
+{
+  Quadric *vquadrics = userdata;
+  BMVert *v = (BMVert *)mp_v;
+  Quadric *v_quadric = &vquadrics[BM_elem_index_get(v)];
+  BMIter iter;
+  BMLoop *l;
+  BMEdge *e;
 
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &q);
-    } while ((l_iter = l_iter->next) != l_first);
+  BM_ITER_ELEM (l, &iter, v, BM_LOOPS_OF_VERT) {
+    Quadric q;
+    bm_decim_face_quadric(l->f, &q);
+    BLI_quadric_add_qu_qu(v_quadric, &q);
   }
 
   /* boundary edges */
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
+  BM_ITER_ELEM (e, &iter, v, BM_EDGES_OF_VERT) {
     if (UNLIKELY(BM_edge_is_boundary(e))) {
-      float edge_vector[3];
-      float edge_plane[3];
-      double edge_plane_db[4];
-      sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
-      f = e->l->f;
-
-      cross_v3_v3v3(edge_plane, edge_vector, f->no);
-      copy_v3db_v3fl(edge_plane_db, edge_plane);
-
-      if (normalize_v3_db(edge_plane_db) > (double)FLT_EPSILON) {
-        Quadric q;
-        float center[3];
-
-        mid_v3_v3v3(center, e->v1->co, e->v2->co);
-
-        edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
-        BLI_quadric_from_plane(&q, edge_plane_db);
-        BLI_quadric_mul(&q, BOUNDARY_PRESERVE_WEIGHT);
-
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v1)], &q);
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v2)], &q);
+      Quadric q;
+      if (bm_decim_edge_boundary_quadric(e, &q)) {
+        BLI_quadric_add_qu_qu(v_quadric, &q);
       }
     }
   }
 }
 
+/**
+ * Each vertex gathers the quadrics of its own faces and boundary edges, so vertices are
+ * calculated in parallel. Face quadrics are recalculated for each of their vertices
+ * instead of being stored, an array of them would be larger than the mesh its self.
+ *
+ * \param vquadrics: must be calloc'd
+ */
+static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+{
+  BM_iter_parallel(bm,
+                   BM_VERTS_OF_MESH,
+                   bm_decim_build_quadrics_vert_cb,
+                   vquadrics,
+                   bm->totvert >= BM_OMP_LIMIT);
+}
+
 static void bm_decim_calc_target_co_db(BMEdge *e, double optimize_co[3], const Quadric *vquadrics)
 {
   /* compute an edge contraction target for edge 'e'
@@ -236,18 +260,20 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * \return false when the edge can't be collapsed and shouldn't be in the heap.
+ */
+static bool bm_decim_calc_edge_cost_single(BMEdge *e,
+                                           const Quadric *vquadrics,
+                                           const float *vweights,
+                                           const float vweight_factor,
+                                           float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f)))) {
-    goto clear;
+    return false;
   }
 
   /* check we can collapse, some edges we better not touch */
@@ -257,7 +283,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -266,11 +292,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* end sanity check */
 
@@ -323,14 +349,28 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
 
-clear:
-  if (eheap_table[BM_elem_index_get(e)]) {
-    BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
+
+  if (bm_decim_calc_edge_cost_single(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+  }
+  else {
+    if (eheap_table[BM_elem_index_get(e)]) {
+      BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
+    }
+    eheap_table[BM_elem_index_get(e)] = NULL;
   }
-  eheap_table[BM_elem_index_get(e)] = NULL;
 }
 
 /* use this for degenerate cases - add back to the heap with an invalid cost,
@@ -341,6 +381,32 @@ static void bm_decim_invalid_edge_cost_single(BMEdge *e, Heap *eheap, HeapNode *
   eheap_table[BM_elem_index_get(e)] = BLI_heap_insert(eheap, COST_INVALID, e);
 }
 
+typedef struct DecimEdgeCost {
+  float cost;
+  bool is_valid;
+} DecimEdgeCost;
+
+typedef struct DecimBuildEdgeCostData {
+  const Quadric *vquadrics;
+  const float *vweights;
+  float vweight_factor;
+  /** Edge index aligned. */
+  DecimEdgeCost *ecosts;
+} DecimBuildEdgeCostData;
+
+static void bm_decim_build_edge_cost_cb(void *userdata, MempoolIterData *mp_e)
+{
+  DecimBuildEdgeCostData *data = userdata;
+  BMEdge *e = (BMEdge *)mp_e;
+  DecimEdgeCost *ecost = &data->ecosts[BM_elem_index_get(e)];
+
+  ecost->is_valid = bm_decim_calc_edge_cost_single(
+      e, data->vquadrics, data->vweights, data->vweight_factor, &ecost->cost);
+}
+
+/**
+ * Costs are calculated in parallel, the heap is filled afterwards since it's not thread safe.
+ */
 static void bm_decim_build_edge_cost(BMesh *bm,
                                      const Quadric *vquadrics,
                                      const float *vweights,
@@ -352,11 +418,22 @@ static void bm_decim_build_edge_cost(BMesh *bm,
   BMEdge *e;
   uint i;
 
+  DecimBuildEdgeCostData data = {
+      .vquadrics = vquadrics,
+      .vweights = vweights,
+      .vweight_factor = vweight_factor,
+      .ecosts = MEM_mallocN(sizeof(DecimEdgeCost) * bm->totedge, __func__),
+  };
+
+  BM_iter_parallel(
+      bm, BM_EDGES_OF_MESH, bm_decim_build_edge_cost_cb, &data, bm->totedge >= BM_OMP_LIMIT);
+
   BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
-    /* keep sanity check happy */
-    eheap_table[i] = NULL;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+    const DecimEdgeCost *ecost = &data.ecosts[i];
+    eheap_table[i] = ecost->is_valid ? BLI_heap_insert(eheap, ecost->cost, e) : NULL;
   }
+
+  MEM_freeN(data.ecosts);
 }
 
 #ifdef USE_SYMMETRY
@@ -1275,63 +1352,45 @@ static bool bm_decim_edge_collapse(BMesh *bm,
   return false;
 }
 
-/* Main Decimate Function
- * ********************** */
+/* Edge Collapse Pass
+ * ****************** */
 
 /**
- * \brief BM_mesh_decimate
- * \param bm: The mesh
- * \param factor: face count multiplier [0 - 1]
- * \param vweights: Optional array of vertex  aligned weights [0 - 1],
- *        a vertex group is the usual source for this.
- * \param symmetry_axis: Axis of symmetry, -1 to disable mirror decimate.
- * \param symmetry_eps: Threshold when matching mirror verts.
+ * Collapse edges with the lowest cost until \a face_tot_target is reached.
+ *
+ * \param vquadrics: Vertex aligned quadrics, updated as vertices are merged.
  */
-void BM_mesh_decimate_collapse(BMesh *bm,
-                               const float factor,
-                               float *vweights,
-                               float vweight_factor,
-                               const bool do_triangulate,
-                               const int symmetry_axis,
-                               const float symmetry_eps)
+static void bm_decim_collapse_edges(BMesh *bm,
+                                    Quadric *vquadrics,
+                                    float *vweights,
+                                    const float vweight_factor,
+                                    const int face_tot_target,
+                                    const int symmetry_axis,
+                                    const float symmetry_eps,
+                                    const CD_UseFlag customdata_flag)
 {
   /* edge heap */
   Heap *eheap;
   /* edge index aligned table pointing to the eheap */
   HeapNode **eheap_table;
-  /* vert index aligned quadrics */
-  Quadric *vquadrics;
   int tot_edge_orig;
-  int face_tot_target;
-
-  CD_UseFlag customdata_flag = 0;
 
 #ifdef USE_SYMMETRY
   bool use_symmetry = (symmetry_axis != -1);
   int *edge_symmetry_map;
 #endif
 
-#ifdef USE_TRIANGULATE
-  int edges_tri_tot = 0;
-  /* temp convert quads to triangles */
-  bool use_triangulate = bm_decim_triangulate_begin(bm, &edges_tri_tot);
-#else
-  UNUSED_VARS(do_triangulate);
-#endif
-
-  /* alloc vars */
-  vquadrics = MEM_callocN(sizeof(Quadric) * bm->totvert, __func__);
   /* since some edges may be degenerate, we might be over allocing a little here */
   eheap = BLI_heap_new_ex(bm->totedge);
   eheap_table = MEM_mallocN(sizeof(HeapNode *) * bm->totedge, __func__);
   tot_edge_orig = bm->totedge;
 
-  /* build initial edge collapse cost data */
-  bm_decim_build_quadrics(bm, vquadrics);
+  /* parallel mempool iteration can't generate indices inline */
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE);
 
+  /* build initial edge collapse cost data */
   bm_decim_build_edge_cost(bm, vquadrics, vweights, vweight_factor, eheap, eheap_table);
 
-  face_tot_target = bm->totface * factor;
   bm->elem_index_dirty |= BM_ALL;
 
 #ifdef USE_SYMMETRY
@@ -1341,19 +1400,6 @@ void BM_mesh_decimate_collapse(BMesh *bm,
   UNUSED_VARS(symmetry_axis, symmetry_eps);
 #endif
 
-#ifdef USE_CUSTOMDATA
-  /* initialize customdata flag, we only need math for loops */
-  if (CustomData_has_interp(&bm->vdata)) {
-    customdata_flag |= CD_DO_VERT;
-  }
-  if (CustomData_has_interp(&bm->edata)) {
-    customdata_flag |= CD_DO_EDGE;
-  }
-  if (CustomData_has_math(&bm->ldata)) {
-    customdata_flag |= CD_DO_LOOP;
-  }
-#endif
-
   /* iterative edge collapse and maintain the eheap */
 #ifdef USE_SYMMETRY
   if (use_symmetry == false)
@@ -1514,6 +1560,503 @@ void BM_mesh_decimate_collapse(BMesh *bm,
   }
 #endif /* USE_SYMMETRY */
 
+  /* free vars */
+  MEM_freeN(eheap_table);
+  BLI_heap_free(eheap, NULL);
+
+  /* testing only */
+  // BM_mesh_validate(bm);
+
+  /* quiet release build warning */
+  (void)tot_edge_orig;
+}
+
+/* Partitioned Collapse
+ * ********************
+ *
+ * When the caller asks for it, the mesh is split into slabs along its longest axis. Each slab is
+ * copied into its own BMesh and decimated on its own thread, vertices shared between slabs get a
+ * zero weight so they can't be collapsed. The slabs are merged back into the mesh, then the
+ * regular collapse runs over the whole mesh to reach the target face count, including the edges
+ * along the boundaries.
+ *
+ * Quadrics are built once for the whole mesh and carried over to the slabs and back,
+ * so the final pass still accounts for the error of earlier collapses. */
+
+/** Resolution of the face distribution along the axis, used to balance the partitions. */
+#define PARTITION_BINS 1024
+
+typedef struct DecimPartition {
+  BMesh *bm;
+  /** Faces of the source mesh in this partition. */
+  BMFace **faces;
+  int faces_len;
+  /** Vertex count before decimating. */
+  int verts_len;
+  /**
+   * Partition vertex aligned, the vertex in the source mesh. Boundary vertices are kept in the
+   * source mesh so they're set while copying, other vertices are added when merging.
+   * The collapse keeps vertex indices as they are, so they can still be used afterwards.
+   */
+  BMVert **vmap;
+  Quadric *vquadrics;
+  float *vweights;
+} DecimPartition;
+
+typedef struct DecimPartitionData {
+  BMesh *bm_src;
+  DecimPartition *partitions;
+  /** Source vertex aligned partition index, -1 for vertices on a boundary. */
+  const int *vert_partition;
+  /** Source vertex & edge aligned copies of elements in a single partition. */
+  BMVert **vert_copy;
+  BMEdge **edge_copy;
+  const Quadric *vquadrics;
+  const float *vweights;
+  float vweight_factor;
+  float factor;
+  int face_len_max;
+  CD_UseFlag customdata_flag;
+} DecimPartitionData;
+
+/**
+ * Copy face and loop attributes between meshes,
+ * including the loop indices used to join triangles afterwards.
+ */
+static void bm_decim_face_attrs_copy(BMesh *bm_src,
+                                     BMesh *bm_dst,
+                                     const BMFace *f_src,
+                                     BMFace *f_dst)
+{
+  BMLoop *l_iter_src, *l_first_src;
+  BMLoop *l_iter_dst = BM_FACE_FIRST_LOOP(f_dst);
+
+  BM_elem_attrs_copy(bm_src, bm_dst, f_src, f_dst);
+
+  l_iter_src = l_first_src = BM_FACE_FIRST_LOOP(f_src);
+  do {
+    BM_elem_attrs_copy(bm_src, bm_dst, l_iter_src, l_iter_dst);
+    BM_elem_index_set(l_iter_dst, BM_elem_index_get(l_iter_src)); /* set_dirty */
+    l_iter_dst = l_iter_dst->next;
+  } while ((l_iter_src = l_iter_src->next) != l_first_src);
+}
+
+static BMVert *bm_decim_partition_vert_copy(DecimPartitionData *data,
+                                            DecimPartition *part,
+                                            GHash *boundary_copy,
+                                            BMVert *v_src)
+{
+  const int v_src_index = BM_elem_index_get(v_src);
+  const bool is_boundary = (data->vert_partition[v_src_index] == -1);
+  BMVert **v_copy_p;
+
+  if (is_boundary) {
+    if (!BLI_ghash_ensure_p(boundary_copy, v_src, (void ***)&v_copy_p)) {
+      *v_copy_p = NULL;
+    }
+  }
+  else {
+    v_copy_p = &data->vert_copy[v_src_index];
+  }
+
+  if (*v_copy_p == NULL) {
+    BMVert *v = BM_vert_create(part->bm, v_src->co, NULL, BM_CREATE_SKIP_CD);
+    const int v_index = part->bm->totvert - 1;
+    BM_elem_attrs_copy(data->bm_src, part->bm, v_src, v);
+    BM_elem_index_set(v, v_index); /* set_ok */
+
+    BLI_assert(v_index < part->verts_len);
+    part->vmap[v_index] = is_boundary ? v_src : NULL;
+    part->vquadrics[v_index] = data->vquadrics[v_src_index];
+    /* A zero weight keeps the edges using the vertex from being collapsed. */
+    part->vweights[v_index] = is_boundary ? 0.0f :
+                                            (data->vweights ? data->vweights[v_src_index] : 1.0f);
+    *v_copy_p = v;
+  }
+  return *v_copy_p;
+}
+
+static BMEdge *bm_decim_partition_edge_copy(DecimPartitionData *data,
+                                            DecimPartition *part,
+                                            GHash *boundary_copy,
+                                            BMEdge *e_src)
+{
+  BMEdge **e_copy_p;
+
+  /* Only edges between boundary vertices can be in more than one partition. */
+  if ((data->vert_partition[BM_elem_index_get(e_src->v1)] == -1) &&
+      (data->vert_partition[BM_elem_index_get(e_src->v2)] == -1)) {
+    if (!BLI_ghash_ensure_p(boundary_copy, e_src, (void ***)&e_copy_p)) {
+      *e_copy_p = NULL;
+    }
+  }
+  else {
+    e_copy_p = &data->edge_copy[BM_elem_index_get(e_src)];
+  }
+
+  if (*e_copy_p == NULL) {
+    BMVert *v1 = bm_decim_partition_vert_copy(data, part, boundary_copy, e_src->v1);
+    BMVert *v2 = bm_decim_partition_vert_copy(data, part, boundary_copy, e_src->v2);
+    BMEdge *e = BM_edge_create(part->bm, v1, v2, NULL, BM_CREATE_SKIP_CD);
+    BM_elem_attrs_copy(data->bm_src, part->bm, e_src, e);
+    BM_elem_index_set(e, part->bm->totedge - 1); /* set_ok */
+    *e_copy_p = e;
+  }
+  return *e_copy_p;
+}
+
+static void bm_decim_partition_collapse_cb(void *__restrict userdata,
+                                           const int part_index,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DecimPartitionData *data = userdata;
+  DecimPartition *part = &data->partitions[part_index];
+  /* Copies of elements which may also be in other partitions. */
+  GHash *boundary_copy = BLI_ghash_ptr_new(__func__);
+  BMVert **verts = MEM_mallocN(sizeof(*verts) * data->face_len_max, __func__);
+  BMEdge **edges = MEM_mallocN(sizeof(*edges) * data->face_len_max, __func__);
+
+  for (int i = 0; i < part->faces_len; i++) {
+    BMFace *f_src = part->faces[i];
+    BMLoop *l_iter, *l_first;
+    int j = 0;
+
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f_src);
+    do {
+      verts[j] = bm_decim_partition_vert_copy(data, part, boundary_copy, l_iter->v);
+      edges[j] = bm_decim_partition_edge_copy(data, part, boundary_copy, l_iter->e);
+      j++;
+    } while ((l_iter = l_iter->next) != l_first);
+
+    BMFace *f = BM_face_create(part->bm, verts, edges, f_src->len, NULL, BM_CREATE_SKIP_CD);
+    bm_decim_face_attrs_copy(data->bm_src, part->bm, f_src, f);
+  }
+  part->bm->elem_index_dirty &= ~(BM_VERT | BM_EDGE); /* Added in order, clear dirty flag. */
+
+  BLI_ghash_free(boundary_copy, NULL, NULL);
+  MEM_freeN(verts);
+  MEM_freeN(edges);
+
+  bm_decim_collapse_edges(part->bm,
+                          part->vquadrics,
+                          part->vweights,
+                          data->vweight_factor,
+                          part->faces_len * data->factor,
+                          -1,
+                          0.0f,
+                          data->customdata_flag);
+}
+
+/**
+ * Decimate \a partitions_len parts of the mesh in parallel, leaving their boundaries as they are.
+ *
+ * \param vquadrics_p: Vertex aligned quadrics, replaced with the quadrics of the merged mesh.
+ * \param vweights: Optional vertex aligned weights, updated for the merged mesh.
+ */
+static void bm_decim_collapse_partitioned(BMesh *bm,
+                                          const int partitions_len,
+                                          const float factor,
+                                          Quadric **vquadrics_p,
+                                          float *vweights,
+                                          const float vweight_factor,
+                                          const CD_UseFlag customdata_flag)
+{
+  BMIter iter, iter_other;
+  BMVert *v, *v_next;
+  BMEdge *e;
+  BMFace *f, *f_next;
+  int i;
+
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+
+  /* Split along the longest axis, balancing the face count of the partitions. */
+  float min[3], max[3], size[3];
+  INIT_MINMAX(min, max);
+  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+    minmax_v3v3_v3(min, max, v->co);
+  }
+  sub_v3_v3v3(size, max, min);
+  const int axis = axis_dominant_v3_single(size);
+  const float bin_scale = (size[axis] > 0.0f) ? (float)PARTITION_BINS / size[axis] : 0.0f;
+
+  int *face_partition = MEM_mallocN(sizeof(*face_partition) * bm->totface, __func__);
+  int bin_faces_len[PARTITION_BINS] = {0};
+  int bin_partition[PARTITION_BINS];
+  int face_len_max = 0;
+
+  BM_ITER_MESH_INDEX (f, &iter, bm, BM_FACES_OF_MESH, i) {
+    float center[3];
+    BM_face_calc_center_median(f, center);
+    const int bin = clamp_i(
+        (int)((center[axis] - min[axis]) * bin_scale), 0, PARTITION_BINS - 1);
+    face_partition[i] = bin;
+    bin_faces_len[bin]++;
+    face_len_max = max_ii(face_len_max, f->len);
+  }
+  for (int bin = 0, faces_len = 0; bin < PARTITION_BINS; bin++) {
+    bin_partition[bin] = (int)(((int64_t)faces_len * partitions_len) / bm->totface);
+    faces_len += bin_faces_len[bin];
+  }
+
+  DecimPartition *partitions = MEM_callocN(sizeof(*partitions) * partitions_len, __func__);
+  BM_ITER_MESH_INDEX (f, &iter, bm, BM_FACES_OF_MESH, i) {
+    face_partition[i] = bin_partition[face_partition[i]];
+    partitions[face_partition[i]].faces_len++;
+  }
+
+  /* Vertices used by faces of more than one partition are on a boundary, as are vertices of wire
+   * edges and loose vertices, which aren't in any partition. */
+  int *vert_partition = MEM_mallocN(sizeof(*vert_partition) * bm->totvert, __func__);
+  int *partition_visit = MEM_mallocN(sizeof(*partition_visit) * partitions_len, __func__);
+  copy_vn_i(partition_visit, partitions_len, -1);
+
+  BM_ITER_MESH_INDEX (v, &iter, bm, BM_VERTS_OF_MESH, i) {
+    int v_partitions_len = 0;
+    int part_index = -1;
+    bool is_wire = false;
+
+    BM_ITER_ELEM (e, &iter_other, v, BM_EDGES_OF_VERT) {
+      is_wire |= (e->l == NULL);
+    }
+    BM_ITER_ELEM (f, &iter_other, v, BM_FACES_OF_VERT) {
+      part_index = face_partition[BM_elem_index_get(f)];
+      if (partition_visit[part_index] != i) {
+        partition_visit[part_index] = i;
+        partitions[part_index].verts_len++;
+        v_partitions_len++;
+      }
+    }
+    vert_partition[i] = ((v_partitions_len == 1) && !is_wire) ? part_index : -1;
+  }
+  MEM_freeN(partition_visit);
+
+  for (int part_index = 0; part_index < partitions_len; part_index++) {
+    DecimPartition *part = &partitions[part_index];
+    const BMAllocTemplate allocsize = {
+        part->verts_len, part->verts_len * 3, part->faces_len * 3, part->faces_len};
+
+    part->bm = BM_mesh_create(&allocsize,
+                              &((struct BMeshCreateParams){
+                                  .use_toolflags = false,
+                              }));
+    BM_mesh_copy_init_customdata(part->bm, bm, &allocsize);
+
+    part->faces = MEM_mallocN(sizeof(*part->faces) * part->faces_len, __func__);
+    part->vmap = MEM_mallocN(sizeof(*part->vmap) * part->verts_len, __func__);
+    part->vquadrics = MEM_mallocN(sizeof(*part->vquadrics) * part->verts_len, __func__);
+    part->vweights = MEM_mallocN(sizeof(*part->vweights) * part->verts_len, __func__);
+    part->faces_len = 0;
+  }
+  BM_ITER_MESH_INDEX (f, &iter, bm, BM_FACES_OF_MESH, i) {
+    DecimPartition *part = &partitions[face_partition[i]];
+    part->faces[part->faces_len++] = f;
+  }
+  MEM_freeN(face_partition);
+
+  DecimPartitionData data = {
+      .bm_src = bm,
+      .partitions = partitions,
+      .vert_partition = vert_partition,
+      .vert_copy = MEM_callocN(sizeof(*data.vert_copy) * bm->totvert, __func__),
+      .edge_copy = MEM_callocN(sizeof(*data.edge_copy) * bm->totedge, __func__),
+      .vquadrics = *vquadrics_p,
+      .vweights = vweights,
+      /* Without weights, all vertices but the boundary ones get the same weight. */
+      .vweight_factor = vweights ? vweight_factor : 1.0f,
+      .factor = factor,
+      .face_len_max = face_len_max,
+      .customdata_flag = customdata_flag,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, partitions_len, &data, bm_decim_partition_collapse_cb, &settings);
+
+  MEM_freeN(data.vert_copy);
+  MEM_freeN(data.edge_copy);
+
+  /* Replace all but the boundary vertices and the edges between them with the partitions. */
+  BM_ITER_MESH_MUTABLE (v, v_next, &iter, bm, BM_VERTS_OF_MESH) {
+    if (vert_partition[BM_elem_index_get(v)] != -1) {
+      BM_vert_kill(bm, v);
+    }
+  }
+  BM_ITER_MESH_MUTABLE (f, f_next, &iter, bm, BM_FACES_OF_MESH) {
+    BM_face_kill(bm, f);
+  }
+  MEM_freeN(vert_partition);
+
+  int merged_len = 0;
+  for (int part_index = 0; part_index < partitions_len; part_index++) {
+    merged_len += partitions[part_index].bm->totvert;
+  }
+  Quadric *vquadrics_merged = MEM_mallocN(sizeof(*vquadrics_merged) * merged_len, __func__);
+  float *vweights_merged = vweights ? MEM_mallocN(sizeof(float) * merged_len, __func__) : NULL;
+  BMVert **verts = MEM_mallocN(sizeof(*verts) * face_len_max, __func__);
+  int merged_index = 0;
+
+  for (int part_index = 0; part_index < partitions_len; part_index++) {
+    DecimPartition *part = &partitions[part_index];
+    BMesh *bm_part = part->bm;
+
+    BM_ITER_MESH (v, &iter, bm_part, BM_VERTS_OF_MESH) {
+      const int v_index = BM_elem_index_get(v);
+      if (part->vmap[v_index] == NULL) {
+        BMVert *v_dst = BM_vert_create(bm, v->co, NULL, BM_CREATE_SKIP_CD);
+        BM_elem_attrs_copy(bm_part, bm, v, v_dst);
+        /* Negative indices point into the merged arrays, boundary vertices keep theirs. */
+        BM_elem_index_set(v_dst, -(merged_index + 1)); /* set_dirty */
+        vquadrics_merged[merged_index] = part->vquadrics[v_index];
+        if (vweights) {
+          vweights_merged[merged_index] = part->vweights[v_index];
+        }
+        merged_index++;
+        part->vmap[v_index] = v_dst;
+      }
+    }
+
+    BM_ITER_MESH (e, &iter, bm_part, BM_EDGES_OF_MESH) {
+      BMVert *v1 = part->vmap[BM_elem_index_get(e->v1)];
+      BMVert *v2 = part->vmap[BM_elem_index_get(e->v2)];
+      if (BM_edge_exists(v1, v2) == NULL) {
+        BMEdge *e_dst = BM_edge_create(bm, v1, v2, NULL, BM_CREATE_SKIP_CD);
+        BM_elem_attrs_copy(bm_part, bm, e, e_dst);
+      }
+    }
+
+    BM_ITER_MESH (f, &iter, bm_part, BM_FACES_OF_MESH) {
+      BMLoop *l_iter, *l_first;
+      int j = 0;
+      l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+      do {
+        verts[j++] = part->vmap[BM_elem_index_get(l_iter->v)];
+      } while ((l_iter = l_iter->next) != l_first);
+
+      BMFace *f_dst = BM_face_create_verts(bm, verts, f->len, NULL, BM_CREATE_SKIP_CD, true);
+      bm_decim_face_attrs_copy(bm_part, bm, f, f_dst);
+    }
+
+    BM_mesh_free(bm_part);
+    MEM_freeN(part->faces);
+    MEM_freeN(part->vmap);
+    MEM_freeN(part->vquadrics);
+    MEM_freeN(part->vweights);
+  }
+  MEM_freeN(partitions);
+  MEM_freeN(verts);
+
+  /* Gather the quadrics and weights in the order of the merged vertices. */
+  Quadric *vquadrics_src = *vquadrics_p;
+  Quadric *vquadrics_dst = MEM_mallocN(sizeof(*vquadrics_dst) * bm->totvert, __func__);
+  float *vweights_dst = vweights ? MEM_mallocN(sizeof(float) * bm->totvert, __func__) : NULL;
+
+  BM_ITER_MESH_INDEX (v, &iter, bm, BM_VERTS_OF_MESH, i) {
+    const int v_index = BM_elem_index_get(v);
+    if (v_index >= 0) {
+      vquadrics_dst[i] = vquadrics_src[v_index];
+      if (vweights) {
+        vweights_dst[i] = vweights[v_index];
+      }
+    }
+    else {
+      vquadrics_dst[i] = vquadrics_merged[-v_index - 1];
+      if (vweights) {
+        vweights_dst[i] = vweights_merged[-v_index - 1];
+      }
+    }
+    BM_elem_index_set(v, i); /* set_ok */
+  }
+  bm->elem_index_dirty &= ~BM_VERT;
+
+  /* The merged mesh never has more vertices, the weights fit in the callers array. */
+  if (vweights) {
+    memcpy(vweights, vweights_dst, sizeof(float) * bm->totvert);
+    MEM_freeN(vweights_dst);
+    MEM_freeN(vweights_merged);
+  }
+  MEM_freeN(vquadrics_merged);
+  MEM_freeN(vquadrics_src);
+  *vquadrics_p = vquadrics_dst;
+}
+
+/* Main Decimate Function
+ * ********************** */
+
+/**
+ * \brief BM_mesh_decimate
+ * \param bm: The mesh
+ * \param factor: face count multiplier [0 - 1]
+ * \param vweights: Optional array of vertex  aligned weights [0 - 1],
+ *        a vertex group is the usual source for this.
+ * \param symmetry_axis: Axis of symmetry, -1 to disable mirror decimate.
+ * \param symmetry_eps: Threshold when matching mirror verts.
+ * \param partitions_len: Number of parts decimated in parallel before a pass over the whole mesh,
+ *        1 for a single pass. The result depends on it, so it should not be derived from the
+ *        thread count. Not used with symmetry.
+ */
+void BM_mesh_decimate_collapse_ex(BMesh *bm,
+                                  const float factor,
+                                  float *vweights,
+                                  float vweight_factor,
+                                  const bool do_triangulate,
+                                  const int symmetry_axis,
+                                  const float symmetry_eps,
+                                  const int partitions_len)
+{
+  /* vert index aligned quadrics */
+  Quadric *vquadrics;
+  int face_tot_target;
+
+  CD_UseFlag customdata_flag = 0;
+
+#ifdef USE_TRIANGULATE
+  int edges_tri_tot = 0;
+  /* temp convert quads to triangles */
+  bool use_triangulate = bm_decim_triangulate_begin(bm, &edges_tri_tot);
+#else
+  UNUSED_VARS(do_triangulate);
+#endif
+
+  /* alloc vars */
+  vquadrics = MEM_callocN(sizeof(Quadric) * bm->totvert, __func__);
+
+  /* parallel mempool iteration can't generate indices inline */
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE);
+
+  /* build initial edge collapse cost data */
+  bm_decim_build_quadrics(bm, vquadrics);
+
+  face_tot_target = bm->totface * factor;
+
+#ifdef USE_CUSTOMDATA
+  /* initialize customdata flag, we only need math for loops */
+  if (CustomData_has_interp(&bm->vdata)) {
+    customdata_flag |= CD_DO_VERT;
+  }
+  if (CustomData_has_interp(&bm->edata)) {
+    customdata_flag |= CD_DO_EDGE;
+  }
+  if (CustomData_has_math(&bm->ldata)) {
+    customdata_flag |= CD_DO_LOOP;
+  }
+#endif
+
+  /* Mirrored edges may be in different partitions. */
+  if ((partitions_len > 1) && (symmetry_axis == -1) && (bm->totface > face_tot_target)) {
+    bm_decim_collapse_partitioned(
+        bm, partitions_len, factor, &vquadrics, vweights, vweight_factor, customdata_flag);
+  }
+
+  bm_decim_collapse_edges(bm,
+                          vquadrics,
+                          vweights,
+                          vweight_factor,
+                          face_tot_target,
+                          symmetry_axis,
+                          symmetry_eps,
+                          customdata_flag);
+
 #ifdef USE_TRIANGULATE
   if (do_triangulate == false) {
     /* its possible we only had triangles, skip this step in that case */
@@ -1526,12 +2069,16 @@ void BM_mesh_decimate_collapse(BMesh *bm,
 
   /* free vars */
   MEM_freeN(vquadrics);
-  MEM_freeN(eheap_table);
-  BLI_heap_free(eheap, NULL);
-
-  /* testing only */
-  // BM_mesh_validate(bm);
+}
 
-  /* quiet release build warning */
-  (void)tot_edge_orig;
+void BM_mesh_decimate_collapse(BMesh *bm,
+                               const float factor,
+                               float *vweights,
+                               float vweight_factor,
+                               const bool do_triangulate,
+                               const int symmetry_axis,
+                               const float symmetry_eps)
+{
+  BM_mesh_decimate_collapse_ex(
+      bm, factor, vweights, vweight_factor, do_triangulate, symmetry_axis, symmetry_eps, 1);
 }
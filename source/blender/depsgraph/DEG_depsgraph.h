@@ -161,6 +161,33 @@ void DEG_evaluate_on_framechange(Depsgraph *graph, float ctime);
 /* Data changed recalculation entry point. */
 void DEG_evaluate_on_refresh(Depsgraph *graph);
 
+/* Multiple frames evaluation  ------------------- */
+
+/* Evaluation of a sequence of frames, where several frames are evaluated concurrently by their
+ * own dependency graphs. Used by exporters, which visit every frame of a range once. */
+
+typedef struct DEGFramesEvaluator DEGFramesEvaluator;
+
+/* Build the relations of a graph used by the evaluator. When NULL the graph is built from the
+ * view layer of the source graph. */
+typedef void (*DEGFramesBuildFn)(Depsgraph *graph, void *user_data);
+
+/* Returns NULL when frames can not be evaluated concurrently (for example, when the scene has
+ * simulations which depend on the previous frame), in which case the caller is expected to step
+ * through the frames with the source graph.
+ * When max_concurrent is 0 a small default is used. Fewer graphs are used when their memory,
+ * estimated from the first evaluated frame, doesn't fit in half of the system memory. */
+DEGFramesEvaluator *DEG_frames_evaluator_new(Depsgraph *source,
+                                             const float *frames,
+                                             int num_frames,
+                                             int max_concurrent,
+                                             DEGFramesBuildFn build_fn,
+                                             void *user_data);
+/* Get the evaluated graph of the next frame, in the order frames were passed to the evaluator.
+ * The graph stays valid until the next call. Returns NULL once all frames have been visited. */
+Depsgraph *DEG_frames_evaluator_next(DEGFramesEvaluator *evaluator, float *r_frame);
+void DEG_frames_evaluator_free(DEGFramesEvaluator *evaluator);
+
 /* Editors Integration  -------------------------- */
 
 /* Mechanism to allow editors to be informed of depsgraph updates,
@@ -184,6 +211,10 @@ void DEG_editors_set_update_cb(DEG_EditorUpdateIDCb id_func, DEG_EditorUpdateSce
 
 bool DEG_is_evaluating(const struct Depsgraph *depsgraph);
 
+/* Set around the evaluation of the next frame of animation playback. */
+bool DEG_is_playback(const struct Depsgraph *depsgraph);
+void DEG_set_playback(struct Depsgraph *depsgraph, const bool is_playback);
+
 bool DEG_is_active(const struct Depsgraph *depsgraph);
 void DEG_make_active(struct Depsgraph *depsgraph);
 void DEG_make_inactive(struct Depsgraph *depsgraph);
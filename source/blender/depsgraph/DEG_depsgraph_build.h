@@ -78,6 +78,13 @@ void DEG_graph_relations_update(struct Depsgraph *graph);
 /* Tag all relations in the database for update.*/
 void DEG_relations_tag_update(struct Main *bmain);
 
+/* Tag relations of the given ID for update.
+ *
+ * Unlike DEG_relations_tag_update() this allows dependency graphs to only rebuild nodes and
+ * relations of this ID and IDs it is connected to. Only to be used when the change does not affect
+ * which IDs are part of the view layer. */
+void DEG_id_tag_relations_update(struct Main *bmain, struct ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /* Handle for components to define their dependencies from callbacks.
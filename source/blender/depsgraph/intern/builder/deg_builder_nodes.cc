@@ -379,6 +379,57 @@ void DepsgraphNodeBuilder::end_build()
   }
 }
 
+void DepsgraphNodeBuilder::begin_build_incremental(Span<ID *> ids)
+{
+  for (ID *id : ids) {
+    IDNode *id_node = graph_->find_id_node(id);
+    if (id_node == nullptr) {
+      continue;
+    }
+    /* Store copy-on-write datablock and state of the node, same as begin_build() does. */
+    if (deg_copy_on_write_is_needed(id_node->id_type)) {
+      IDInfo *id_info = (IDInfo *)MEM_mallocN(sizeof(IDInfo), "depsgraph id info");
+      if (deg_copy_on_write_is_expanded(id_node->id_cow) && id_node->id_orig != id_node->id_cow) {
+        id_info->id_cow = id_node->id_cow;
+      }
+      else {
+        id_info->id_cow = nullptr;
+      }
+      id_info->previously_visible_components_mask = id_node->visible_components_mask;
+      id_info->previous_eval_flags = id_node->eval_flags;
+      id_info->previous_customdata_masks = id_node->customdata_masks;
+      id_info_hash_.add_new(id_node->id_orig, id_info);
+    }
+    id_node->id_cow = nullptr;
+
+    for (OperationNode *op_node : graph_->entry_tags) {
+      ComponentNode *comp_node = op_node->owner;
+      if (comp_node->owner != id_node) {
+        continue;
+      }
+      SavedEntryTag entry_tag;
+      entry_tag.id_orig = id_node->id_orig;
+      entry_tag.component_type = comp_node->type;
+      entry_tag.opcode = op_node->opcode;
+      entry_tag.name = op_node->name;
+      entry_tag.name_tag = op_node->name_tag;
+      saved_entry_tags_.append(entry_tag);
+    }
+
+    graph_->remove_id_node(id_node);
+  }
+
+  /* Everything what is left in the graph is kept as-is. Make it so the state of those nodes is
+   * considered to be previous one, so that the build finalization only tags changes caused by the
+   * update. */
+  for (IDNode *id_node : graph_->id_nodes) {
+    id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+    built_map_.tagBuild(id_node->id_orig);
+  }
+}
+
 void DepsgraphNodeBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -474,6 +525,12 @@ void DepsgraphNodeBuilder::build_id(ID *id)
     case ID_SIM:
       build_simulation((Simulation *)id);
       break;
+    case ID_PA:
+      build_particle_settings((ParticleSettings *)id);
+      break;
+    case ID_GD:
+      build_gpencil((bGPdata *)id);
+      break;
     default:
       fprintf(stderr, "Unhandled ID %s\n", id->name);
       BLI_assert(!"Should never happen");
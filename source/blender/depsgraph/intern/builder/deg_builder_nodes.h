@@ -101,6 +101,11 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void begin_build();
   virtual void end_build();
 
+  /* Begin incremental update of an already built graph: nodes of the given IDs are removed from
+   * the graph, keeping their copy-on-write datablocks for re-use, and all other IDs which are in
+   * the graph are considered built. */
+  virtual void begin_build_incremental(Span<ID *> ids);
+
   IDNode *add_id_node(ID *id);
   IDNode *find_id_node(ID *id);
   TimeSourceNode *add_time_source();
@@ -162,6 +167,11 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void build_view_layer(Scene *scene,
                                 ViewLayer *view_layer,
                                 eDepsNode_LinkedState_Type linked_state);
+  /* Build nodes of the given objects of the view layer, as if they were built by
+   * build_view_layer(). */
+  virtual void build_view_layer_objects(Scene *scene,
+                                        ViewLayer *view_layer,
+                                        const Set<ID *> &objects);
   virtual void build_collection(LayerCollection *from_layer_collection, Collection *collection);
   virtual void build_object(int base_index,
                             Object *object,
@@ -175,5 +175,25 @@ void DepsgraphNodeBuilder::build_view_layer(Scene *scene,
   }
 }
 
+void DepsgraphNodeBuilder::build_view_layer_objects(Scene *scene,
+                                                    ViewLayer *view_layer,
+                                                    const Set<ID *> &objects)
+{
+  view_layer_index_ = 0;
+  scene_ = scene;
+  view_layer_ = view_layer;
+  /* NOTE: Base index is to match the one used by build_view_layer(). */
+  int base_index = 0;
+  LISTBASE_FOREACH (Base *, base, &view_layer->object_bases) {
+    if (!need_pull_base_into_graph(base)) {
+      continue;
+    }
+    if (objects.contains(&base->object->id)) {
+      build_object(base_index, base->object, DEG_ID_LINKED_DIRECTLY, true);
+    }
+    base_index++;
+  }
+}
+
 }  // namespace deg
 }  // namespace blender
@@ -165,6 +165,10 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   void begin_build();
 
+  /* Begin incremental update of relations of the given IDs: every other ID which is in the graph
+   * is considered built. */
+  void begin_build_incremental(Scene *scene, const Set<ID *> &ids);
+
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
                          const KeyTo &key_to,
@@ -0,0 +1,281 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+#include "pipeline_incremental.h"
+
+#include <cstdio>
+
+#include "BLI_listbase.h"
+#include "BLI_utildefines.h"
+
+#include "DNA_layer_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_force_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_layer.h"
+
+#include "DEG_depsgraph_build.h"
+
+#include "intern/builder/deg_builder_nodes.h"
+#include "intern/builder/deg_builder_relations.h"
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace blender {
+namespace deg {
+
+namespace {
+
+/* Updating this portion of the graph or more is not faster than building it from scratch. */
+const int MAX_INCREMENTAL_IDS_FRACTION = 8;
+
+/* Objects which take part in physics are collected into graph-wide physics relations, which are
+ * used by builders of any other object. */
+bool object_has_physics(const Object *object)
+{
+  if (object->pd != nullptr && (object->pd->forcefield != 0 || object->pd->deflect != 0)) {
+    return true;
+  }
+  if (object->rigidbody_object != nullptr || object->rigidbody_constraint != nullptr) {
+    return true;
+  }
+  if (!BLI_listbase_is_empty(&object->particlesystem)) {
+    return true;
+  }
+  LISTBASE_FOREACH (const ModifierData *, md, &object->modifiers) {
+    if (ELEM(md->type,
+             eModifierType_Collision,
+             eModifierType_Surface,
+             eModifierType_Softbody,
+             eModifierType_Cloth,
+             eModifierType_Fluid,
+             eModifierType_DynamicPaint)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void add_relation_node_id(const Node *node, Set<ID *> &r_ids)
+{
+  if (node->type != NodeType::OPERATION) {
+    return;
+  }
+  const OperationNode *op_node = static_cast<const OperationNode *>(node);
+  r_ids.add(op_node->owner->owner->id_orig);
+}
+
+string node_debug_identifier(const Node *node)
+{
+  if (node->type != NodeType::OPERATION) {
+    return node->identifier();
+  }
+  const OperationNode *op_node = static_cast<const OperationNode *>(node);
+  const ComponentNode *comp_node = op_node->owner;
+  return string(comp_node->owner->id_orig->name) + "/" + comp_node->identifier() + "/" +
+         op_node->identifier();
+}
+
+void graph_debug_collect(const Depsgraph *graph, Set<string> &r_nodes, Set<string> &r_relations)
+{
+  for (const OperationNode *op_node : graph->operations) {
+    const string op_identifier = node_debug_identifier(op_node);
+    r_nodes.add(op_identifier);
+    for (const Relation *rel : op_node->inlinks) {
+      r_relations.add(node_debug_identifier(rel->from) + " -> " + op_identifier + " (" +
+                      rel->name + ")");
+    }
+  }
+}
+
+int print_missing(const char *what, const Set<string> &expected, const Set<string> &actual)
+{
+  int num_missing = 0;
+  for (const string &identifier : expected) {
+    if (!actual.contains(identifier)) {
+      printf("  %s %s\n", what, identifier.c_str());
+      num_missing++;
+    }
+  }
+  return num_missing;
+}
+
+}  // namespace
+
+IncrementalBuilderPipeline::IncrementalBuilderPipeline(::Depsgraph *graph)
+    : AbstractBuilderPipeline(graph)
+{
+  for (ID *id : deg_graph_->relations_update_ids) {
+    ids_.append(id);
+    ids_set_.add(id);
+  }
+}
+
+bool IncrementalBuilderPipeline::is_possible()
+{
+  if (ids_.is_empty()) {
+    return false;
+  }
+  /* Graph was never built. */
+  if (deg_graph_->scene_cow == nullptr) {
+    return false;
+  }
+  if (ids_.size() * MAX_INCREMENTAL_IDS_FRACTION > deg_graph_->id_nodes.size()) {
+    return false;
+  }
+  /* Relations which are built by the scene itself and which can involve any object are not
+   * re-created by the update. */
+  if (scene_->rigidbody_world != nullptr || scene_->adt != nullptr || scene_->ed != nullptr) {
+    return false;
+  }
+  unique_ptr<DepsgraphNodeBuilder> node_builder = construct_node_builder();
+  for (ID *id : ids_) {
+    if (GS(id->name) != ID_OB) {
+      return false;
+    }
+    IDNode *id_node = deg_graph_->find_id_node(id);
+    if (id_node == nullptr || !id_node->has_base ||
+        id_node->linked_state != DEG_ID_LINKED_DIRECTLY) {
+      return false;
+    }
+    Object *object = reinterpret_cast<Object *>(id);
+    /* Proxy and its source share state, which is set up by the builder. */
+    if (object->proxy != nullptr || object->proxy_from != nullptr) {
+      return false;
+    }
+    if (object_has_physics(object)) {
+      return false;
+    }
+    Base *base = BKE_view_layer_base_find(view_layer_, object);
+    if (base == nullptr || !node_builder->need_pull_base_into_graph(base)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void IncrementalBuilderPipeline::build_step_sanity_check()
+{
+  AbstractBuilderPipeline::build_step_sanity_check();
+  BLI_assert(deg_graph_->scene_cow != nullptr);
+}
+
+void IncrementalBuilderPipeline::build_step_nodes()
+{
+  /* Relations of the updated objects are removed together with their nodes. Relations of all IDs
+   * they were connected to are to be built again. */
+  for (ID *id : ids_) {
+    IDNode *id_node = deg_graph_->find_id_node(id);
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      for (OperationNode *op_node : comp_node->operations) {
+        for (Relation *rel : op_node->inlinks) {
+          add_relation_node_id(rel->from, rebuild_ids_);
+        }
+        for (Relation *rel : op_node->outlinks) {
+          add_relation_node_id(rel->to, rebuild_ids_);
+        }
+      }
+    }
+  }
+
+  const int64_t num_kept_id_nodes = deg_graph_->id_nodes.size() - ids_.size();
+  unique_ptr<DepsgraphNodeBuilder> node_builder = construct_node_builder();
+  node_builder->begin_build_incremental(ids_);
+  build_nodes(*node_builder);
+  node_builder->end_build();
+
+  /* ID nodes are appended to the graph, so all nodes past the kept ones are the re-created
+   * objects and IDs which were pulled into the graph by them. */
+  for (int64_t i = num_kept_id_nodes; i < deg_graph_->id_nodes.size(); i++) {
+    rebuild_ids_.add(deg_graph_->id_nodes[i]->id_orig);
+  }
+}
+
+void IncrementalBuilderPipeline::build_step_relations()
+{
+  unique_ptr<DepsgraphRelationBuilder> relation_builder = construct_relation_builder();
+  relation_builder->begin_build_incremental(scene_, rebuild_ids_);
+  /* Relations between the re-built IDs and the rest of the graph might still exist. */
+  deg_graph_->check_relations_before_add = true;
+  build_relations(*relation_builder);
+  for (ID *id : rebuild_ids_) {
+    IDNode *id_node = deg_graph_->find_id_node(id);
+    if (id_node == nullptr) {
+      continue;
+    }
+    relation_builder->build_copy_on_write_relations(id_node);
+    relation_builder->build_driver_relations(id_node);
+  }
+  deg_graph_->check_relations_before_add = false;
+
+  /* Visibility is flushed from the ID nodes by the finalization step. Make it so components do not
+   * keep visibility which was caused by the previous state of the updated objects. */
+  for (IDNode *id_node : deg_graph_->id_nodes) {
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      comp_node->affects_directly_visible = false;
+    }
+  }
+}
+
+void IncrementalBuilderPipeline::build_nodes(DepsgraphNodeBuilder &node_builder)
+{
+  node_builder.build_view_layer_objects(scene_, view_layer_, ids_set_);
+}
+
+void IncrementalBuilderPipeline::build_relations(DepsgraphRelationBuilder &relation_builder)
+{
+  for (ID *id : rebuild_ids_) {
+    relation_builder.build_id(id);
+  }
+}
+
+void IncrementalBuilderPipeline::compare_with_full_build()
+{
+  Depsgraph full_graph(bmain_, scene_, view_layer_, deg_graph_->mode);
+  DEG_graph_build_from_view_layer(reinterpret_cast<::Depsgraph *>(&full_graph));
+
+  Set<string> nodes, relations;
+  Set<string> full_nodes, full_relations;
+  graph_debug_collect(deg_graph_, nodes, relations);
+  graph_debug_collect(&full_graph, full_nodes, full_relations);
+
+  printf("Comparing incremental relations update of %d IDs with full build:\n", (int)ids_.size());
+  int num_differences = 0;
+  num_differences += print_missing("Missing operation", full_nodes, nodes);
+  num_differences += print_missing("Extra operation", nodes, full_nodes);
+  num_differences += print_missing("Missing relation", full_relations, relations);
+  num_differences += print_missing("Extra relation", relations, full_relations);
+  if (num_differences == 0) {
+    printf("  Graphs are identical (%d operations, %d relations).\n",
+           (int)nodes.size(),
+           (int)relations.size());
+  }
+  else {
+    printf("  Found %d differences.\n", num_differences);
+  }
+}
+
+}  // namespace deg
+}  // namespace blender
@@ -0,0 +1,68 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include "pipeline.h"
+
+struct ID;
+
+namespace blender {
+namespace deg {
+
+/* Updates relations of a view layer dependency graph which was built already, only for the IDs
+ * which were tagged with DEG_id_tag_relations_update().
+ *
+ * Nodes of the tagged objects are re-created, and relations are re-built for them, for IDs they
+ * were connected to and for IDs which they pulled into the graph. The rest of the graph is kept
+ * as-is. */
+class IncrementalBuilderPipeline : public AbstractBuilderPipeline {
+ public:
+  IncrementalBuilderPipeline(::Depsgraph *graph);
+
+  /* Check whether the tagged IDs can be updated incrementally. When it is not possible the graph
+   * is to be fully rebuilt. */
+  bool is_possible();
+
+  /* Build the whole graph from scratch and report every node and relation which differs from the
+   * incrementally updated graph. */
+  void compare_with_full_build();
+
+ protected:
+  virtual void build_step_sanity_check() override;
+  virtual void build_step_nodes() override;
+  virtual void build_step_relations() override;
+
+  virtual void build_nodes(DepsgraphNodeBuilder &node_builder) override;
+  virtual void build_relations(DepsgraphRelationBuilder &relation_builder) override;
+
+  /* Objects tagged for relations update. */
+  Vector<ID *> ids_;
+  Set<ID *> ids_set_;
+  /* IDs for which relations are to be built: the tagged objects, IDs which were connected to them
+   * and IDs which were added to the graph by the update. */
+  Set<ID *> rebuild_ids_;
+};
+
+}  // namespace deg
+}  // namespace blender
@@ -36,7 +36,10 @@ namespace blender {
 namespace deg {
 
 DepsgraphDebug::DepsgraphDebug()
-    : flags(G.debug), is_ever_evaluated(false), graph_evaluation_start_time_(0)
+    : flags(G.debug),
+      is_ever_evaluated(false),
+      operations_time(0.0),
+      graph_evaluation_start_time_(0)
 {
 }
 
@@ -58,6 +61,7 @@ void DepsgraphDebug::begin_graph_evaluation()
   }
 
   graph_evaluation_start_time_ = current_time;
+  operations_time = 0.0;
 }
 
 void DepsgraphDebug::end_graph_evaluation()
@@ -67,7 +71,14 @@ void DepsgraphDebug::end_graph_evaluation()
   }
 
   const double graph_eval_end_time = PIL_check_seconds_timer();
-  printf("Depsgraph updated in %f seconds.\n", graph_eval_end_time - graph_evaluation_start_time_);
+  const double graph_eval_time = graph_eval_end_time - graph_evaluation_start_time_;
+  printf("Depsgraph updated in %f seconds.\n", graph_eval_time);
+  if (graph_eval_time > 0.0) {
+    printf("Depsgraph operations took %f seconds, parallelism %.2f (%s scheduling).\n",
+           operations_time,
+           operations_time / graph_eval_time,
+           (G.debug & G_DEBUG_DEPSGRAPH_NO_PRIORITY) ? "ready order" : "critical path");
+  }
   printf("Depsgraph evaluation FPS: %f\n", 1.0f / fps_samples_.get_averaged());
 
   is_ever_evaluated = true;
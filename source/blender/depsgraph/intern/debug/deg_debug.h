@@ -53,6 +53,10 @@ class DepsgraphDebug {
    * This is NOT an indication that depsgraph is at its evaluated state. */
   bool is_ever_evaluated;
 
+  /* Accumulated time of all operations of the current graph evaluation. Compared against the
+   * wall time of the evaluation, it tells how well the evaluation made use of threads. */
+  double operations_time;
+
  protected:
   /* Maximum number of counters used to calculate frame rate of depsgraph update. */
   static const constexpr int MAX_FPS_COUNTERS = 64;
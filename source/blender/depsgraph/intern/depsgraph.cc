@@ -63,6 +63,7 @@ namespace deg {
 Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluationMode mode)
     : time_source(nullptr),
       need_update(true),
+      check_relations_before_add(false),
       bmain(bmain),
       scene(scene),
       view_layer(view_layer),
@@ -71,6 +72,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       scene_cow(nullptr),
       is_active(false),
       is_evaluating(false),
+      is_playback(false),
       is_render_pipeline_depsgraph(false)
 {
   BLI_spin_init(&lock);
@@ -170,11 +172,48 @@ void Depsgraph::clear_id_nodes()
   clear_physics_relations(this);
 }
 
+void Depsgraph::remove_id_node(IDNode *id_node)
+{
+  /* Gather operations and relations first: relations between two operations of the same ID
+   * are to be freed only once. */
+  Set<OperationNode *> removed_operations;
+  Set<Relation *> removed_relations;
+  for (ComponentNode *comp_node : id_node->components.values()) {
+    BLI_assert(comp_node->operations_map == nullptr);
+    for (OperationNode *op_node : comp_node->operations) {
+      removed_operations.add(op_node);
+      for (Relation *rel : op_node->inlinks) {
+        removed_relations.add(rel);
+      }
+      for (Relation *rel : op_node->outlinks) {
+        removed_relations.add(rel);
+      }
+    }
+  }
+  for (Relation *rel : removed_relations) {
+    rel->unlink();
+    delete rel;
+  }
+  int64_t num_kept_operations = 0;
+  for (OperationNode *op_node : operations) {
+    if (!removed_operations.contains(op_node)) {
+      operations[num_kept_operations++] = op_node;
+    }
+  }
+  operations.resize(num_kept_operations);
+  for (OperationNode *op_node : removed_operations) {
+    entry_tags.remove(op_node);
+  }
+  id_hash.remove(id_node->id_orig);
+  id_nodes.remove_first_occurrence_and_reorder(id_node);
+  delete id_node;
+}
+
 /* Add new relation between two nodes */
 Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *description, int flags)
 {
   Relation *rel = nullptr;
-  if (flags & RELATION_CHECK_BEFORE_ADD) {
+  if ((flags & RELATION_CHECK_BEFORE_ADD) || check_relations_before_add) {
     rel = check_nodes_connected(from, to, description);
   }
   if (rel != nullptr) {
@@ -318,6 +357,18 @@ bool DEG_is_evaluating(const struct Depsgraph *depsgraph)
   return deg_graph->is_evaluating;
 }
 
+bool DEG_is_playback(const struct Depsgraph *depsgraph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  return deg_graph->is_playback;
+}
+
+void DEG_set_playback(struct Depsgraph *depsgraph, const bool is_playback)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+  deg_graph->is_playback = is_playback;
+}
+
 bool DEG_is_active(const struct Depsgraph *depsgraph)
 {
   if (depsgraph == nullptr) {
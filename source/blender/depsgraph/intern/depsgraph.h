@@ -74,6 +74,8 @@ struct Depsgraph {
   IDNode *add_id_node(ID *id, ID *id_cow_hint = nullptr);
   void clear_id_nodes();
   void clear_id_nodes_conditional(const std::function<bool(ID_Type id_type)> &filter);
+  /* Remove node of the given ID together with all relations of its operations. */
+  void remove_id_node(IDNode *id_node);
 
   /* Add new relationship between two nodes. */
   Relation *add_new_relation(Node *from, Node *to, const char *description, int flags = 0);
@@ -111,6 +113,15 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update;
 
+  /* IDs for which relations are to be updated. When the graph needs update and this set is
+   * empty relations of the whole graph are rebuilt. */
+  Set<ID *> relations_update_ids;
+
+  /* Skip adding relations which already exist, as if every relation was added with the
+   * RELATION_CHECK_BEFORE_ADD flag. Used by incremental relations update, which re-runs
+   * builders of IDs whose relations are partially kept in the graph. */
+  bool check_relations_before_add;
+
   /* Indicates which ID types were updated. */
   char id_type_updated[MAX_LIBARRAY];
 
@@ -158,6 +169,10 @@ struct Depsgraph {
 
   bool is_evaluating;
 
+  /* Set while evaluating the next frame of animation playback, so evaluation can prepare for the
+   * frames after it. */
+  bool is_playback;
+
   /* Is set to truth for dependency graph which are used for post-processing (compositor and
    * sequencer).
    * Such dependency graph needs all view layers (so render pipeline can access names), but it
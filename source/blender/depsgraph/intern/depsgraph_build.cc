@@ -36,6 +36,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_simulation_types.h"
 
+#include "BKE_global.h"
 #include "BKE_main.h"
 #include "BKE_scene.h"
 
@@ -47,6 +48,7 @@
 #include "builder/pipeline_all_objects.h"
 #include "builder/pipeline_compositor.h"
 #include "builder/pipeline_from_ids.h"
+#include "builder/pipeline_incremental.h"
 #include "builder/pipeline_render.h"
 #include "builder/pipeline_view_layer.h"
 
@@ -246,6 +248,7 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
   deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
   deg_graph->need_update = true;
+  deg_graph->relations_update_ids.clear();
   /* NOTE: When relations are updated, it's quite possible that
    * we've got new bases in the scene. This means, we need to
    * re-create flat array of bases in view layer.
@@ -266,6 +269,21 @@ void DEG_graph_relations_update(Depsgraph *graph)
     /* Graph is up to date, nothing to do. */
     return;
   }
+  if (!deg_graph->relations_update_ids.is_empty()) {
+    deg::IncrementalBuilderPipeline builder(graph);
+    if (builder.is_possible()) {
+      DEG_DEBUG_PRINTF(graph,
+                       BUILD,
+                       "%s: Incremental relations update of %d IDs.\n",
+                       __func__,
+                       (int)deg_graph->relations_update_ids.size());
+      builder.build();
+      if (G.debug & G_DEBUG_DEPSGRAPH_INCREMENTAL_CHECK) {
+        builder.compare_with_full_build();
+      }
+      return;
+    }
+  }
   DEG_graph_build_from_view_layer(graph);
 }
 
@@ -277,3 +295,21 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+/* Tag relations of a single ID for update. */
+void DEG_id_tag_relations_update(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *deg_graph : deg::get_all_registered_graphs(bmain)) {
+    if (deg_graph->need_update && deg_graph->relations_update_ids.is_empty()) {
+      /* Relations of the whole graph are already tagged for update. */
+      continue;
+    }
+    deg_graph->need_update = true;
+    deg_graph->relations_update_ids.add(id);
+    deg::IDNode *id_node = deg_graph->find_id_node(id);
+    if (id_node != nullptr) {
+      id_node->tag_update(deg_graph, deg::DEG_UPDATE_SOURCE_RELATIONS);
+    }
+  }
+}
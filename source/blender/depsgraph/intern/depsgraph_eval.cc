@@ -38,6 +38,7 @@
 
 #include "intern/eval/deg_eval.h"
 #include "intern/eval/deg_eval_flush.h"
+#include "intern/eval/deg_eval_frames.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_operation.h"
@@ -81,3 +82,29 @@ void DEG_evaluate_on_framechange(Depsgraph *graph, float ctime)
   deg_graph->ctime = ctime;
   deg_flush_updates_and_refresh(deg_graph);
 }
+
+DEGFramesEvaluator *DEG_frames_evaluator_new(Depsgraph *source,
+                                             const float *frames,
+                                             int num_frames,
+                                             int max_concurrent,
+                                             DEGFramesBuildFn build_fn,
+                                             void *user_data)
+{
+  deg::FramesEvaluator *evaluator = new deg::FramesEvaluator(
+      source, blender::Span<float>(frames, num_frames), max_concurrent, build_fn, user_data);
+  if (!evaluator->init()) {
+    delete evaluator;
+    return nullptr;
+  }
+  return reinterpret_cast<DEGFramesEvaluator *>(evaluator);
+}
+
+Depsgraph *DEG_frames_evaluator_next(DEGFramesEvaluator *evaluator, float *r_frame)
+{
+  return reinterpret_cast<deg::FramesEvaluator *>(evaluator)->next(r_frame);
+}
+
+void DEG_frames_evaluator_free(DEGFramesEvaluator *evaluator)
+{
+  delete reinterpret_cast<deg::FramesEvaluator *>(evaluator);
+}
@@ -29,10 +29,14 @@
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
+#include "BLI_heap.h"
+#include "BLI_math_base.h"
 #include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
+#include "BKE_scene.h"
 
 #include "DNA_node_types.h"
 #include "DNA_object_types.h"
@@ -69,11 +73,6 @@ void schedule_children(DepsgraphEvalState *state,
                        ScheduleFunction *schedule_function,
                        ScheduleFunctionArgs... schedule_function_args);
 
-void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), TaskPool *pool)
-{
-  BLI_task_pool_push(pool, deg_task_run_func, node, false, NULL);
-}
-
 /* Denotes which part of dependency graph is being evaluated. */
 enum class EvaluationStage {
   /* Stage 1: Only  Copy-on-Write operations are to be evaluated, prior to anything else.
@@ -96,8 +95,34 @@ struct DepsgraphEvalState {
   bool do_stats;
   EvaluationStage stage;
   bool need_single_thread_pass;
+
+  /* Evaluate operations with the longest remaining chain of dependent operations first.
+   *
+   * Ready operations are put into a heap ordered by their critical path time, and every pool
+   * task evaluates the most critical operation which is ready at the time the task runs. This
+   * way long chains (armature, deform, subdivision) start as early as possible instead of
+   * waiting for workers busy with short independent branches. */
+  bool use_priority;
+  Heap *ready_heap;
+  SpinLock ready_lock;
 };
 
+void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), TaskPool *pool)
+{
+  DepsgraphEvalState *state = (DepsgraphEvalState *)BLI_task_pool_user_data(pool);
+  if (state->use_priority) {
+    /* The task picks the most critical ready operation once it runs, which is not necessarily
+     * this one. There is exactly one task per ready operation, so the heap never runs dry. */
+    BLI_spin_lock(&state->ready_lock);
+    BLI_heap_insert(state->ready_heap, -node->critical_path_time, node);
+    BLI_spin_unlock(&state->ready_lock);
+    BLI_task_pool_push(pool, deg_task_run_func, NULL, false, NULL);
+  }
+  else {
+    BLI_task_pool_push(pool, deg_task_run_func, node, false, NULL);
+  }
+}
+
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
@@ -105,10 +130,14 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_stats || state->use_priority) {
     const double start_time = PIL_check_seconds_timer();
     operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    const double time = PIL_check_seconds_timer() - start_time;
+    operation_node->stats.add_average_sample(time);
+    if (state->do_stats) {
+      operation_node->stats.current_time += time;
+    }
   }
   else {
     operation_node->evaluate(depsgraph);
@@ -120,8 +149,14 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
+  if (operation_node == NULL) {
+    BLI_spin_lock(&state->ready_lock);
+    operation_node = (OperationNode *)BLI_heap_pop_min(state->ready_heap);
+    BLI_spin_unlock(&state->ready_lock);
+  }
+
+  /* Evaluate node. */
   evaluate_node(state, operation_node);
 
   /* Schedule children. */
@@ -139,6 +174,11 @@ bool check_operation_node_visible(OperationNode *op_node)
   return comp_node->affects_directly_visible;
 }
 
+bool check_operation_node_pending(OperationNode *op_node)
+{
+  return check_operation_node_visible(op_node) && (op_node->flag & DEPSOP_FLAG_NEEDS_UPDATE);
+}
+
 void calculate_pending_parents_for_node(OperationNode *node)
 {
   /* Update counters, applies for both visible and invisible IDs. */
@@ -178,10 +218,59 @@ void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
+/* Calculate critical path time of all pending operations, walking the graph from the operations
+ * without pending children towards their parents. Uses custom_flags to count children which are
+ * not handled yet. */
+void calculate_critical_path(Depsgraph *graph)
+{
+  Vector<OperationNode *> stack;
+  for (OperationNode *node : graph->operations) {
+    node->critical_path_time = 0.0f;
+    node->custom_flags = 0;
+    if (!check_operation_node_pending(node)) {
+      continue;
+    }
+    for (Relation *rel : node->outlinks) {
+      OperationNode *child = (OperationNode *)rel->to;
+      if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && check_operation_node_pending(child)) {
+        ++node->custom_flags;
+      }
+    }
+    if (node->custom_flags == 0) {
+      stack.append(node);
+    }
+  }
+
+  while (!stack.is_empty()) {
+    OperationNode *node = stack.pop_last();
+    float longest_child_path = 0.0f;
+    for (Relation *rel : node->outlinks) {
+      OperationNode *child = (OperationNode *)rel->to;
+      if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && check_operation_node_pending(child)) {
+        longest_child_path = max_ff(longest_child_path, child->critical_path_time);
+      }
+    }
+    node->critical_path_time = (float)node->stats.average_time + longest_child_path;
+
+    for (Relation *rel : node->inlinks) {
+      if (rel->from->type != NodeType::OPERATION || (rel->flag & RELATION_FLAG_CYCLIC)) {
+        continue;
+      }
+      OperationNode *parent = (OperationNode *)rel->from;
+      if (check_operation_node_pending(parent) && --parent->custom_flags == 0) {
+        stack.append(parent);
+      }
+    }
+  }
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
+  if (state->use_priority) {
+    calculate_critical_path(graph);
+  }
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
     if (do_stats) {
@@ -344,6 +433,9 @@ void depsgraph_ensure_view_layer(Depsgraph *graph)
 
   const IDNode *scene_id_node = graph->find_id_node(&graph->scene->id);
   deg_update_copy_on_write_datablock(graph, scene_id_node);
+  /* Copy-on-write brings the frame of the original scene, which is not necessarily the frame this
+   * graph is evaluated for. */
+  BKE_scene_frame_set(scene_cow, graph->ctime);
 }
 
 }  // namespace
@@ -380,6 +472,13 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
   state.need_single_thread_pass = false;
+  state.use_priority = (G.debug & (G_DEBUG_DEPSGRAPH_NO_THREADS |
+                                   G_DEBUG_DEPSGRAPH_NO_PRIORITY)) == 0;
+  state.ready_heap = NULL;
+  if (state.use_priority) {
+    state.ready_heap = BLI_heap_new();
+    BLI_spin_init(&state.ready_lock);
+  }
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
 
@@ -407,7 +506,11 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    * operation timing here, without aggregating anything to avoid any extra
    * synchronization. */
   if (state.do_stats) {
-    deg_eval_stats_aggregate(graph);
+    graph->debug.operations_time = deg_eval_stats_aggregate(graph);
+  }
+  if (state.use_priority) {
+    BLI_heap_free(state.ready_heap, NULL);
+    BLI_spin_end(&state.ready_lock);
   }
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
@@ -284,7 +284,7 @@ struct ValidateData {
 
 /* Similar to generic BKE_id_copy() but does not require main and assumes pointer
  * is already allocated. */
-bool id_copy_inplace_no_main(const ID *id, ID *newid)
+bool id_copy_inplace_no_main(const ID *id, ID *newid, const int extra_flag = 0)
 {
   const ID *id_for_copy = id;
 
@@ -301,8 +301,10 @@ bool id_copy_inplace_no_main(const ID *id, ID *newid)
   id_for_copy = nested_id_hack_get_discarded_pointers(&id_hack_storage, id);
 #endif
 
-  bool result = BKE_id_copy_ex(
-      nullptr, (ID *)id_for_copy, &newid, (LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE));
+  bool result = BKE_id_copy_ex(nullptr,
+                               (ID *)id_for_copy,
+                               &newid,
+                               (LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE | extra_flag));
 
 #ifdef NESTED_ID_NASTY_WORKAROUND
   if (result) {
@@ -616,6 +618,18 @@ void update_mesh_edit_mode_pointers(const ID *id_orig, ID *id_cow)
   mesh_cow->edit_mesh->mesh_eval_final = nullptr;
 }
 
+/* Sculpt and paint modes write to the arrays of the mesh of the active object in place, so its
+ * evaluated copy must not share them. */
+bool mesh_is_painted(const Depsgraph *depsgraph, const ID *id_orig)
+{
+  const ViewLayer *view_layer = depsgraph->view_layer;
+  if (view_layer == nullptr || view_layer->basact == nullptr) {
+    return false;
+  }
+  const Object *object = view_layer->basact->object;
+  return (object->mode & OB_MODE_ALL_PAINT) && (object->data == id_orig);
+}
+
 /* Edit data is stored and owned by original datablocks, copied ones
  * are simply referencing to them. */
 void update_edit_mode_pointers(const Depsgraph *depsgraph, const ID *id_orig, ID *id_cow)
@@ -859,8 +873,6 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph,
   }
   // BLI_assert(check_datablock_expanded(id_cow) == false);
   /* Copy data from original ID to a copied version. */
-  /* TODO(sergey): Avoid doing full ID copy somehow, make Mesh to reference
-   * original geometry arrays for until those are modified. */
   /* TODO(sergey): We do some trickery with temp bmain and extra ID pointer
    * just to be able to use existing API. Ideally we need to replace this with
    * in-place copy from existing datablock to a prepared memory.
@@ -884,8 +896,13 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph,
       break;
     }
     case ID_ME: {
-      /* TODO(sergey): Ideally we want to handle meshes in a special
-       * manner here to avoid initial copy of all the geometry arrays. */
+      /* Share geometry arrays with the original mesh, they are only copied once the evaluation
+       * modifies them. Limited to the active depsgraph: its evaluation and edits of the original
+       * both happen from the main thread, while other depsgraphs (final render, baking) can be
+       * evaluated while the original is being edited. */
+      if (depsgraph->is_active && !mesh_is_painted(depsgraph, id_orig)) {
+        done = id_copy_inplace_no_main(id_orig, id_cow, LIB_ID_COPY_CD_SHARE);
+      }
       break;
     }
     default:
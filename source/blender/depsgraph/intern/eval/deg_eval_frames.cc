@@ -0,0 +1,210 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2017 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/eval/deg_eval_frames.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math_base.h"
+#include "BLI_system.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_pointcache.h"
+
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "DEG_depsgraph_build.h"
+#include "DEG_depsgraph_query.h"
+
+#include "intern/depsgraph.h"
+#include "intern/node/deg_node_id.h"
+
+namespace blender {
+namespace deg {
+
+/* Every graph holds a fully evaluated copy of the scene, and its evaluation uses the task
+ * scheduler on its own, so a few graphs are enough to keep the caller busy. */
+static const int max_concurrent_default = 3;
+/* Part of the system memory the graphs may use together, besides what is in use already. */
+static const double memory_max_factor = 0.5;
+
+FramesEvaluator::FramesEvaluator(::Depsgraph *source,
+                                 Span<float> frames,
+                                 int max_concurrent,
+                                 DEGFramesBuildFn build_fn,
+                                 void *user_data)
+    : source_(source),
+      frames_(frames),
+      max_concurrent_(max_concurrent),
+      build_fn_(build_fn),
+      user_data_(user_data),
+      threads_({nullptr, nullptr}),
+      threads_initialized_(false),
+      next_frame_index_(0),
+      current_slot_(-1)
+{
+}
+
+FramesEvaluator::~FramesEvaluator()
+{
+  if (threads_initialized_) {
+    /* Wait for the frames which are still being evaluated in the background. */
+    BLI_threadpool_end(&threads_);
+  }
+  for (Slot &slot : slots_) {
+    DEG_graph_free(slot.graph);
+  }
+}
+
+bool FramesEvaluator::init()
+{
+  int num_slots = max_concurrent_ > 0 ? max_concurrent_ : max_concurrent_default;
+  num_slots = min_iii(num_slots, BLI_system_thread_count(), frames_.size());
+  if (num_slots < 2) {
+    return false;
+  }
+
+  /* Threads are referencing slots by pointer, so the storage is not to be re-allocated. */
+  slots_.reserve(num_slots);
+
+  /* The first frame is evaluated right away, to estimate the memory used by every graph. */
+  const size_t memory_before = MEM_get_memory_in_use();
+  ::Depsgraph *graph = build_graph();
+  slots_.append({this, graph, 0.0f});
+  /* All graphs are built in the same way, so checking the first one is enough. */
+  if (graph_has_simulation_state(graph)) {
+    return false;
+  }
+  slots_[0].ctime = frame_ctime(0);
+  evaluate_slot_thread(&slots_[0]);
+
+  const size_t memory_in_use = MEM_get_memory_in_use();
+  const size_t memory_graph = max_zz(memory_in_use - min_zz(memory_before, memory_in_use), 1);
+  const size_t memory_max = (size_t)((double)BLI_system_memory_max_in_megabytes() * 1024.0 *
+                                     1024.0 * memory_max_factor);
+  const size_t memory_free = memory_max - min_zz(memory_max, memory_in_use);
+  num_slots = (int)min_zz((size_t)num_slots, 1 + memory_free / memory_graph);
+  if (num_slots < 2) {
+    return false;
+  }
+
+  for (int i = 1; i < num_slots; i++) {
+    slots_.append({this, build_graph(), 0.0f});
+  }
+
+  BLI_threadpool_init(&threads_, evaluate_slot_thread, num_slots);
+  threads_initialized_ = true;
+  for (int i = 1; i < num_slots; i++) {
+    start_slot(&slots_[i], i);
+  }
+  return true;
+}
+
+::Depsgraph *FramesEvaluator::build_graph()
+{
+  ::Depsgraph *graph = DEG_graph_new(DEG_get_bmain(source_),
+                                     DEG_get_input_scene(source_),
+                                     DEG_get_input_view_layer(source_),
+                                     DEG_get_mode(source_));
+  if (build_fn_ != nullptr) {
+    build_fn_(graph, user_data_);
+  }
+  else {
+    DEG_graph_build_from_view_layer(graph);
+  }
+  return graph;
+}
+
+float FramesEvaluator::frame_ctime(int frame_index) const
+{
+  const Scene *scene = DEG_get_input_scene(source_);
+  return frames_[frame_index] * scene->r.framelen;
+}
+
+::Depsgraph *FramesEvaluator::next(float *r_frame)
+{
+  const int num_slots = slots_.size();
+
+  /* The caller is done with the previously returned frame, re-use its graph for the first frame
+   * which is not scheduled yet. */
+  if (current_slot_ != -1) {
+    const int frame_index = next_frame_index_ - 1 + num_slots;
+    if (frame_index < frames_.size()) {
+      start_slot(&slots_[current_slot_], frame_index);
+    }
+    current_slot_ = -1;
+  }
+
+  if (next_frame_index_ >= frames_.size()) {
+    return nullptr;
+  }
+
+  /* Frames are assigned to slots in a round-robin manner. */
+  current_slot_ = next_frame_index_ % num_slots;
+  Slot *slot = &slots_[current_slot_];
+  BLI_threadpool_remove(&threads_, slot);
+
+  *r_frame = frames_[next_frame_index_];
+  next_frame_index_++;
+  return slot->graph;
+}
+
+void *FramesEvaluator::evaluate_slot_thread(void *slot_v)
+{
+  Slot *slot = static_cast<Slot *>(slot_v);
+  DEG_evaluate_on_framechange(slot->graph, slot->ctime);
+  return nullptr;
+}
+
+void FramesEvaluator::start_slot(Slot *slot, int frame_index)
+{
+  slot->ctime = frame_ctime(frame_index);
+  BLI_threadpool_insert(&threads_, slot);
+}
+
+/* Simulations depend on the state of the previous frame, so their result depends on the order in
+ * which frames are evaluated. Such graphs are to be evaluated frame after frame. */
+bool FramesEvaluator::graph_has_simulation_state(::Depsgraph *graph) const
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  Scene *scene = deg_graph->scene;
+  if (scene->rigidbody_world != nullptr) {
+    return true;
+  }
+  for (const IDNode *id_node : deg_graph->id_nodes) {
+    const ID_Type id_type = id_node->id_type;
+    if (id_type == ID_SIM) {
+      return true;
+    }
+    if (id_type == ID_OB &&
+        BKE_ptcache_object_has(scene, reinterpret_cast<Object *>(id_node->id_orig), 0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace deg
+}  // namespace blender
@@ -0,0 +1,94 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2017 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include "BLI_vector.hh"
+
+#include "DNA_listBase.h"
+
+#include "DEG_depsgraph.h"
+
+struct Depsgraph;
+struct Main;
+struct Scene;
+struct ViewLayer;
+
+namespace blender {
+namespace deg {
+
+/* Evaluates a sequence of frames using several independent dependency graphs, so that a number
+ * of frames are being evaluated in the background while the caller consumes the current one.
+ *
+ * Every graph is built from the same view layer as the source graph, and evaluates one frame at
+ * a time. Frames are handed out to the caller in the order they were requested. */
+class FramesEvaluator {
+ public:
+  FramesEvaluator(::Depsgraph *source,
+                  Span<float> frames,
+                  int max_concurrent,
+                  DEGFramesBuildFn build_fn,
+                  void *user_data);
+  ~FramesEvaluator();
+
+  /* Graphs are built and checked for simulation state. Returns false when frames can not be
+   * evaluated independently from each other, or there isn't enough memory for more than one
+   * graph, in which case the evaluator is not to be used. */
+  bool init();
+
+  /* Wait for the next frame to be evaluated and return the graph which holds its state.
+   * Returns nullptr when all frames have been consumed. */
+  ::Depsgraph *next(float *r_frame);
+
+ private:
+  struct Slot {
+    FramesEvaluator *evaluator;
+    ::Depsgraph *graph;
+    float ctime;
+  };
+
+  static void *evaluate_slot_thread(void *slot_v);
+
+  ::Depsgraph *build_graph();
+  bool graph_has_simulation_state(::Depsgraph *graph) const;
+  float frame_ctime(int frame_index) const;
+  void start_slot(Slot *slot, int frame_index);
+
+  ::Depsgraph *source_;
+  Vector<float> frames_;
+  int max_concurrent_;
+  DEGFramesBuildFn build_fn_;
+  void *user_data_;
+
+  Vector<Slot> slots_;
+  ListBase threads_;
+  bool threads_initialized_;
+
+  /* Index of the frame which will be returned by the next call to next(). */
+  int next_frame_index_;
+  /* Slot which holds the frame returned by the previous call to next(), or -1. */
+  int current_slot_;
+};
+
+}  // namespace deg
+}  // namespace blender
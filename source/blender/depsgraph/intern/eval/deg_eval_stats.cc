@@ -35,7 +35,7 @@
 namespace blender {
 namespace deg {
 
-void deg_eval_stats_aggregate(Depsgraph *graph)
+double deg_eval_stats_aggregate(Depsgraph *graph)
 {
   /* Reset current evaluation stats for ID and component nodes.
    * Those are not filled in by the evaluation engine. */
@@ -47,12 +47,15 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
     id_node->stats.reset_current();
   }
   /* Now accumulate operation timings to components and IDs. */
+  double total_time = 0.0;
   for (OperationNode *op_node : graph->operations) {
     ComponentNode *comp_node = op_node->owner;
     IDNode *id_node = comp_node->owner;
     id_node->stats.current_time += op_node->stats.current_time;
     comp_node->stats.current_time += op_node->stats.current_time;
+    total_time += op_node->stats.current_time;
   }
+  return total_time;
 }
 
 }  // namespace deg
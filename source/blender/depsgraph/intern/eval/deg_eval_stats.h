@@ -28,8 +28,9 @@ namespace deg {
 
 struct Depsgraph;
 
-/* Aggregate operation timings to overall component and ID nodes timing. */
-void deg_eval_stats_aggregate(Depsgraph *graph);
+/* Aggregate operation timings to overall component and ID nodes timing.
+ * Returns the accumulated time of all operations. */
+double deg_eval_stats_aggregate(Depsgraph *graph);
 
 }  // namespace deg
 }  // namespace blender
@@ -279,6 +279,7 @@ Node::Stats::Stats()
 void Node::Stats::reset()
 {
   current_time = 0.0;
+  average_time = 0.0;
 }
 
 void Node::Stats::reset_current()
@@ -286,6 +287,13 @@ void Node::Stats::reset_current()
   current_time = 0.0;
 }
 
+void Node::Stats::add_average_sample(double time)
+{
+  /* Exponential moving average: follows changes in the scene within a few evaluations, while
+   * smoothing out the noise of single ones. */
+  average_time = (average_time == 0.0) ? time : average_time * 0.75 + time * 0.25;
+}
+
 /*******************************************************************************
  * Node itself.
  */
@@ -161,8 +161,12 @@ struct Node {
     /* Reset counters needed for the current graph evaluation, does not
      * touch averaging accumulators. */
     void reset_current();
+    /* Add time of an evaluation to the running average. */
+    void add_average_sample(double time);
     /* Time spend on this node during current graph evaluation. */
     double current_time;
+    /* Running average of the evaluation time, over evaluations this node was part of. */
+    double average_time;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
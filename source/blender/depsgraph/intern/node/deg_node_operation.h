@@ -266,6 +266,10 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Estimated time of the longest chain of pending operations starting with this one, based on
+   * the average evaluation times. Operations with a longer chain are evaluated first. */
+  float critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
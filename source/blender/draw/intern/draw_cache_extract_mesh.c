@@ -129,8 +129,9 @@ typedef struct MeshRenderData {
   BMFace *efa_act_uv;
   /* Data created on-demand (usually not for #BMesh based data). */
   MLoopTri *mlooptri;
-  float (*loop_normals)[3];
-  float (*poly_normals)[3];
+  /** Owned by #Mesh_Runtime, except for #BMesh based data. */
+  const float (*loop_normals)[3];
+  const float (*poly_normals)[3];
   int *lverts, *ledges;
 } MeshRenderData;
 
@@ -246,36 +247,12 @@ static void mesh_render_data_update_normals(MeshRenderData *mr,
 
   if (mr->extract_type != MR_EXTRACT_BMESH) {
     /* Mesh */
+    /* Owned by the mesh runtime, so they are shared between batch cache updates. */
     if (data_flag & (MR_DATA_POLY_NOR | MR_DATA_LOOP_NOR | MR_DATA_TAN_LOOP_NOR)) {
-      mr->poly_normals = MEM_mallocN(sizeof(*mr->poly_normals) * mr->poly_len, __func__);
-      BKE_mesh_calc_normals_poly((MVert *)mr->mvert,
-                                 NULL,
-                                 mr->vert_len,
-                                 mr->mloop,
-                                 mr->mpoly,
-                                 mr->loop_len,
-                                 mr->poly_len,
-                                 mr->poly_normals,
-                                 true);
+      mr->poly_normals = BKE_mesh_runtime_poly_normals_ensure(me);
     }
     if (((data_flag & MR_DATA_LOOP_NOR) && is_auto_smooth) || (data_flag & MR_DATA_TAN_LOOP_NOR)) {
-      mr->loop_normals = MEM_mallocN(sizeof(*mr->loop_normals) * mr->loop_len, __func__);
-      short(*clnors)[2] = CustomData_get_layer(&mr->me->ldata, CD_CUSTOMLOOPNORMAL);
-      BKE_mesh_normals_loop_split(mr->me->mvert,
-                                  mr->vert_len,
-                                  mr->me->medge,
-                                  mr->edge_len,
-                                  mr->me->mloop,
-                                  mr->loop_normals,
-                                  mr->loop_len,
-                                  mr->me->mpoly,
-                                  mr->poly_normals,
-                                  mr->poly_len,
-                                  is_auto_smooth,
-                                  split_angle,
-                                  NULL,
-                                  clnors,
-                                  NULL);
+      mr->loop_normals = BKE_mesh_runtime_loop_normals_ensure(me);
     }
   }
   else {
@@ -295,7 +272,7 @@ static void mesh_render_data_update_normals(MeshRenderData *mr,
         poly_normals = mr->bm_poly_normals;
       }
 
-      mr->loop_normals = MEM_mallocN(sizeof(*mr->loop_normals) * mr->loop_len, __func__);
+      float(*loop_normals)[3] = MEM_mallocN(sizeof(*loop_normals) * mr->loop_len, __func__);
       const int clnors_offset = CustomData_get_offset(&mr->bm->ldata, CD_CUSTOMLOOPNORMAL);
       BM_loops_calc_normal_vcos(mr->bm,
                                 vert_coords,
@@ -303,11 +280,12 @@ static void mesh_render_data_update_normals(MeshRenderData *mr,
                                 poly_normals,
                                 is_auto_smooth,
                                 split_angle,
-                                mr->loop_normals,
+                                loop_normals,
                                 NULL,
                                 NULL,
                                 clnors_offset,
                                 false);
+      mr->loop_normals = loop_normals;
     }
   }
 }
@@ -443,8 +421,9 @@ static MeshRenderData *mesh_render_data_create(Mesh *me,
 static void mesh_render_data_free(MeshRenderData *mr)
 {
   MEM_SAFE_FREE(mr->mlooptri);
-  MEM_SAFE_FREE(mr->poly_normals);
-  MEM_SAFE_FREE(mr->loop_normals);
+  if (mr->extract_type == MR_EXTRACT_BMESH && mr->loop_normals != NULL) {
+    MEM_freeN((void *)mr->loop_normals);
+  }
 
   MEM_SAFE_FREE(mr->lverts);
   MEM_SAFE_FREE(mr->ledges);
@@ -4397,7 +4376,7 @@ static void statvis_calc_distort(const MeshRenderData *mr, float *r_distort)
       float fac = -1.0f;
 
       if (mp->totloop > 3) {
-        float *f_no = mr->poly_normals[mp_index];
+        const float *f_no = mr->poly_normals[mp_index];
         fac = 0.0f;
 
         for (int i = 1; i <= mp->totloop; i++) {
@@ -4492,7 +4471,7 @@ static void statvis_calc_sharp(const MeshRenderData *mr, float *r_sharp)
         void **pval;
         bool value_is_init = BLI_edgehash_ensure_p(eh, l_curr->v, l_next->v, &pval);
         if (!value_is_init) {
-          *pval = mr->poly_normals[mp_index];
+          *pval = (void *)mr->poly_normals[mp_index];
           /* non-manifold edge, yet... */
           continue;
         }
@@ -76,3 +76,6 @@ void ANIM_OT_driver_button_remove(struct wmOperatorType *ot);
 void ANIM_OT_driver_button_edit(struct wmOperatorType *ot);
 void ANIM_OT_copy_driver_button(struct wmOperatorType *ot);
 void ANIM_OT_paste_driver_button(struct wmOperatorType *ot);
+
+/* Driver diagnostics */
+void ANIM_OT_driver_python_report(struct wmOperatorType *ot);
@@ -41,6 +41,7 @@
 #include "BKE_context.h"
 #include "BKE_fcurve.h"
 #include "BKE_fcurve_driver.h"
+#include "BKE_main.h"
 #include "BKE_report.h"
 
 #include "DEG_depsgraph.h"
@@ -1320,4 +1321,69 @@ void ANIM_OT_paste_driver_button(wmOperatorType *ot)
   ot->flag = OPTYPE_UNDO | OPTYPE_INTERNAL;
 }
 
+/* Report Python Drivers Operator ------------------------ */
+
+typedef struct DriverPythonReportData {
+  ReportList *reports;
+  int tot_python;
+  int tot_slow;
+} DriverPythonReportData;
+
+static void driver_python_report_cb(ID *id, AnimData *adt, void *user_data)
+{
+  DriverPythonReportData *data = user_data;
+
+  LISTBASE_FOREACH (FCurve *, fcu, &adt->drivers) {
+    ChannelDriver *driver = fcu->driver;
+
+    if (driver == NULL || driver->type != DRIVER_TYPE_PYTHON) {
+      continue;
+    }
+    data->tot_python++;
+
+    const char *reason = BKE_driver_simple_expression_error(driver);
+    if (reason == NULL) {
+      continue;
+    }
+    data->tot_slow++;
+
+    BKE_reportf(data->reports,
+                RPT_INFO,
+                "%s: %s[%d]: %s",
+                id->name + 2,
+                fcu->rna_path ? fcu->rna_path : "",
+                fcu->array_index,
+                reason);
+  }
+}
+
+static int driver_python_report_exec(bContext *C, wmOperator *op)
+{
+  Main *bmain = CTX_data_main(C);
+  DriverPythonReportData data = {op->reports, 0, 0};
+
+  BKE_animdata_main_cb(bmain, driver_python_report_cb, &data);
+
+  BKE_reportf(op->reports,
+              RPT_INFO,
+              "%d of %d scripted expression drivers require Python",
+              data.tot_slow,
+              data.tot_python);
+
+  return OPERATOR_FINISHED;
+}
+
+void ANIM_OT_driver_python_report(wmOperatorType *ot)
+{
+  /* identifiers */
+  ot->name = "Report Python Drivers";
+  ot->idname = "ANIM_OT_driver_python_report";
+  ot->description =
+      "List the scripted expression drivers that can't use the fast built-in evaluator, "
+      "and the reason why";
+
+  /* callbacks */
+  ot->exec = driver_python_report_exec;
+}
+
 /* ************************************************** */
@@ -234,7 +234,7 @@ ModifierData *ED_object_modifier_add(
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_tag_relations_update(bmain, &ob->id);
 
   return new_md;
 }
@@ -341,6 +341,18 @@ static bool object_modifier_remove(
     return 0;
   }
 
+  /* Physics modifiers are taking part in relations of other objects. */
+  if (ELEM(md->type,
+           eModifierType_ParticleSystem,
+           eModifierType_Softbody,
+           eModifierType_Cloth,
+           eModifierType_Collision,
+           eModifierType_Surface,
+           eModifierType_Fluid,
+           eModifierType_DynamicPaint)) {
+    *r_sort_depsgraph = true;
+  }
+
   /* special cases */
   if (md->type == eModifierType_ParticleSystem) {
     object_remove_particle_system(bmain, scene, ob);
@@ -357,11 +369,6 @@ static bool object_modifier_remove(
     if (ob->pd) {
       ob->pd->deflect = 0;
     }
-
-    *r_sort_depsgraph = true;
-  }
-  else if (md->type == eModifierType_Surface) {
-    *r_sort_depsgraph = true;
   }
   else if (md->type == eModifierType_Multires) {
     /* Delete MDisps layer if not used by another multires modifier */
@@ -402,7 +409,12 @@ bool ED_object_modifier_remove(
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  if (sort_depsgraph) {
+    DEG_relations_tag_update(bmain);
+  }
+  else {
+    DEG_id_tag_relations_update(bmain, &ob->id);
+  }
 
   return true;
 }
@@ -427,7 +439,12 @@ void ED_object_modifier_clear(Main *bmain, Scene *scene, Object *ob)
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  if (sort_depsgraph) {
+    DEG_relations_tag_update(bmain);
+  }
+  else {
+    DEG_id_tag_relations_update(bmain, &ob->id);
+  }
 }
 
 bool ED_object_modifier_move_up(ReportList *reports, Object *ob, ModifierData *md)
@@ -4584,7 +4584,9 @@ static int screen_animation_step(bContext *C, wmOperator *UNUSED(op), const wmEv
 
     /* since we follow drawflags, we can't send notifier but tag regions ourselves */
     if (depsgraph != NULL) {
+      DEG_set_playback(depsgraph, true);
       ED_update_for_newframe(bmain, depsgraph);
+      DEG_set_playback(depsgraph, false);
     }
 
     LISTBASE_FOREACH (wmWindow *, window, &wm->windows) {
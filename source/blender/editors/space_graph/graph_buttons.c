@@ -996,6 +996,11 @@ static void graph_draw_driver_settings_panel(uiLayout *layout,
       }
       else {
         uiItemL(col, TIP_("Slow Python expression"), ICON_INFO);
+
+        const char *reason = BKE_driver_simple_expression_error(driver);
+        if (reason) {
+          uiItemL(col, reason, ICON_BLANK1);
+        }
       }
     }
 
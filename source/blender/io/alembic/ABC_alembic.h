@@ -122,6 +122,10 @@ bool ABC_mesh_topology_changed(struct CacheReader *reader,
                                const float time,
                                const char **err_str);
 
+/* True when only vertex positions change over time: the topology is constant and the face data
+ * read along with it (normals, UVs and attributes) isn't animated. */
+bool ABC_mesh_topology_is_constant(struct CacheReader *reader);
+
 void CacheReader_incref(struct CacheReader *reader);
 void CacheReader_free(struct CacheReader *reader);
 
@@ -40,6 +40,7 @@
 #include "BLI_fileops.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_utildefines.h"
 
 #include "WM_api.h"
 #include "WM_types.h"
@@ -49,6 +50,7 @@ static CLG_LogRef LOG = {"io.alembic"};
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 struct ExportJobData {
   Main *bmain;
@@ -75,6 +77,12 @@ static void build_depsgraph(Depsgraph *depsgraph, const bool visible_objects_onl
   }
 }
 
+static void build_frames_depsgraph(Depsgraph *depsgraph, void *user_data)
+{
+  const AlembicExportParams *params = static_cast<const AlembicExportParams *>(user_data);
+  build_depsgraph(depsgraph, params->visible_objects_only);
+}
+
 static void export_startjob(void *customdata,
                             /* Cannot be const, this function implements wm_jobs_start_callback.
                              * NOLINTNEXTLINE: readability-non-const-parameter. */
@@ -141,6 +149,16 @@ static void export_startjob(void *customdata,
     ABCArchive::Frames::const_iterator frame_it = abc_archive->frames_begin();
     const ABCArchive::Frames::const_iterator frames_end = abc_archive->frames_end();
 
+    // Frames are independent from each other unless there are simulations in the scene, in which
+    // case the evaluator is not created and frames are stepped through one after the other.
+    const std::vector<float> frames(frame_it, frames_end);
+    DEGFramesEvaluator *frames_evaluator = DEG_frames_evaluator_new(data->depsgraph,
+                                                                    frames.data(),
+                                                                    frames.size(),
+                                                                    0,
+                                                                    build_frames_depsgraph,
+                                                                    &data->params);
+
     for (; frame_it != frames_end; frame_it++) {
       double frame = *frame_it;
 
@@ -148,10 +166,17 @@ static void export_startjob(void *customdata,
         break;
       }
 
-      // Update the scene for the next frame to render.
-      scene->r.cfra = static_cast<int>(frame);
-      scene->r.subframe = frame - scene->r.cfra;
-      BKE_scene_graph_update_for_newframe(data->depsgraph);
+      if (frames_evaluator != nullptr) {
+        float evaluated_frame;
+        iter.set_depsgraph(DEG_frames_evaluator_next(frames_evaluator, &evaluated_frame));
+        BLI_assert(evaluated_frame == static_cast<float>(frame));
+      }
+      else {
+        // Update the scene for the next frame to render.
+        scene->r.cfra = static_cast<int>(frame);
+        scene->r.subframe = frame - scene->r.cfra;
+        BKE_scene_graph_update_for_newframe(data->depsgraph);
+      }
 
       CLOG_INFO(&LOG, 2, "Exporting frame %.2f", frame);
       ExportSubset export_subset = abc_archive->export_subset_for_frame(frame);
@@ -161,6 +186,13 @@ static void export_startjob(void *customdata,
       *progress += progress_per_frame;
       *do_update = true;
     }
+
+    if (frames_evaluator != nullptr) {
+      // Writers may reference evaluated data of the frames depsgraphs.
+      iter.release_writers();
+      iter.set_depsgraph(data->depsgraph);
+      DEG_frames_evaluator_free(frames_evaluator);
+    }
   }
   else {
     // If we're not animating, a single iteration over all objects is enough.
@@ -108,9 +108,6 @@ void ABCGenericMeshWriter::create_alembic_objects(const HierarchyContext *contex
     OBoolProperty type(typeContainer, "meshtype");
     type.set(subsurf_modifier_ == nullptr);
   }
-
-  Scene *scene_eval = DEG_get_evaluated_scene(args_.depsgraph);
-  liquid_sim_modifier_ = get_liquid_sim_modifier(scene_eval, context->object);
 }
 
 ABCGenericMeshWriter::~ABCGenericMeshWriter()
@@ -148,8 +145,11 @@ bool ABCGenericMeshWriter::export_as_subdivision_surface(Object *ob_eval) const
   return false;
 }
 
-ModifierData *ABCGenericMeshWriter::get_liquid_sim_modifier(Scene *scene, Object *ob)
+/* Frames can be evaluated by different dependency graphs, so this is looked up from the object
+ * of the frame being written rather than kept. */
+ModifierData *ABCGenericMeshWriter::get_liquid_sim_modifier(Object *ob) const
 {
+  Scene *scene = DEG_get_evaluated_scene(args_.hierarchy_iterator->get_depsgraph());
   ModifierData *md = BKE_modifiers_findby_type(ob, eModifierType_Fluidsim);
 
   if (md && (BKE_modifier_is_enabled(scene, md, eModifierMode_Render))) {
@@ -283,8 +283,9 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
     mesh_sample.setNormals(normals_sample);
   }
 
-  if (liquid_sim_modifier_ != nullptr) {
-    get_velocities(mesh, velocities);
+  ModifierData *liquid_sim_modifier = get_liquid_sim_modifier(context.object);
+  if (liquid_sim_modifier != nullptr) {
+    get_velocities(mesh, liquid_sim_modifier, velocities);
     mesh_sample.setVelocities(V3fArraySample(velocities));
   }
 
@@ -293,7 +294,7 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 
   abc_poly_mesh_schema_.set(mesh_sample);
 
-  write_arb_geo_params(mesh);
+  write_arb_geo_params(context.object, mesh);
 }
 
 void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *mesh)
@@ -343,7 +344,7 @@ void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *me
   subdiv_sample.setSelfBounds(bounding_box_);
   abc_subdiv_schema_.set(subdiv_sample);
 
-  write_arb_geo_params(mesh);
+  write_arb_geo_params(context.object, mesh);
 }
 
 template<typename Schema>
@@ -361,9 +362,9 @@ void ABCGenericMeshWriter::write_face_sets(Object *object, struct Mesh *mesh, Sc
   }
 }
 
-void ABCGenericMeshWriter::write_arb_geo_params(struct Mesh *me)
+void ABCGenericMeshWriter::write_arb_geo_params(Object *object, struct Mesh *me)
 {
-  if (liquid_sim_modifier_ != nullptr) {
+  if (get_liquid_sim_modifier(object) != nullptr) {
     /* We don't need anything more for liquid meshes. */
     return;
   }
@@ -382,14 +383,16 @@ void ABCGenericMeshWriter::write_arb_geo_params(struct Mesh *me)
   write_custom_data(arb_geom_params, m_custom_data_config, &me->ldata, CD_MLOOPCOL);
 }
 
-void ABCGenericMeshWriter::get_velocities(struct Mesh *mesh, std::vector<Imath::V3f> &vels)
+void ABCGenericMeshWriter::get_velocities(struct Mesh *mesh,
+                                          ModifierData *liquid_sim_modifier,
+                                          std::vector<Imath::V3f> &vels)
 {
   const int totverts = mesh->totvert;
 
   vels.clear();
   vels.resize(totverts);
 
-  FluidsimModifierData *fmd = reinterpret_cast<FluidsimModifierData *>(liquid_sim_modifier_);
+  FluidsimModifierData *fmd = reinterpret_cast<FluidsimModifierData *>(liquid_sim_modifier);
   FluidsimSettings *fss = fmd->fss;
 
   if (fss->meshVelocities) {
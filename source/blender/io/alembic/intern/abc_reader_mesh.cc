@@ -41,8 +41,12 @@
 #include "BKE_modifier.h"
 #include "BKE_object.h"
 
+using Alembic::Abc::IArrayProperty;
+using Alembic::Abc::ICompoundProperty;
 using Alembic::Abc::Int32ArraySamplePtr;
+using Alembic::Abc::IScalarProperty;
 using Alembic::Abc::P3fArraySamplePtr;
+using Alembic::Abc::PropertyHeader;
 
 using Alembic::AbcGeom::IFaceSet;
 using Alembic::AbcGeom::IFaceSetSchema;
@@ -579,6 +583,50 @@ bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector
          face_indices->size() != existing_mesh->totloop;
 }
 
+bool AbcMeshReader::topology_is_constant() const
+{
+  if (m_schema.getTopologyVariance() == Alembic::AbcGeom::kHeterogeneousTopology) {
+    return false;
+  }
+
+  /* Normals, UVs and attributes are read along with the faces, so they must be constant too.
+   * Normals are calculated when they are not in the archive. */
+  if (m_schema.getNormalsParam().valid()) {
+    return false;
+  }
+
+  const IV2fGeomParam &uv = m_schema.getUVsParam();
+  if (uv.valid() && !uv.isConstant()) {
+    return false;
+  }
+
+  const ICompoundProperty &arb_geom_params = m_schema.getArbGeomParams();
+  if (!arb_geom_params.valid()) {
+    return true;
+  }
+
+  for (size_t i = 0; i < arb_geom_params.getNumProperties(); i++) {
+    const PropertyHeader &prop_header = arb_geom_params.getPropertyHeader(i);
+
+    if (prop_header.isArray()) {
+      if (!IArrayProperty(arb_geom_params, prop_header.getName()).isConstant()) {
+        return false;
+      }
+    }
+    else if (prop_header.isScalar()) {
+      if (!IScalarProperty(arb_geom_params, prop_header.getName()).isConstant()) {
+        return false;
+      }
+    }
+    else {
+      /* Indexed attributes, don't bother checking their values and indices. */
+      return false;
+    }
+  }
+
+  return true;
+}
+
 Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
                                const ISampleSelector &sample_sel,
                                int read_flag,
@@ -46,6 +46,7 @@ class AbcMeshReader : public AbcObjectReader {
                          const char **err_str) override;
   bool topology_changed(Mesh *existing_mesh,
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
+  bool topology_is_constant() const override;
 
  private:
   void readFaceSetsSample(Main *bmain,
@@ -187,6 +187,11 @@ bool AbcObjectReader::topology_changed(Mesh * /*existing_mesh*/,
   return false;
 }
 
+bool AbcObjectReader::topology_is_constant() const
+{
+  return false;
+}
+
 void AbcObjectReader::setupObjectTransform(const float time)
 {
   bool is_constant = false;
@@ -145,6 +145,8 @@ class AbcObjectReader {
                                  const char **err_str);
   virtual bool topology_changed(Mesh *existing_mesh,
                                 const Alembic::Abc::ISampleSelector &sample_sel);
+  /** True when only vertex positions change over time, see #ABC_mesh_topology_is_constant. */
+  virtual bool topology_is_constant() const;
 
   /** Reads the object matrix and sets up an object transform if animated. */
   void setupObjectTransform(const float time);
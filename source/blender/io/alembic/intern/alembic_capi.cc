@@ -809,6 +809,12 @@ bool ABC_mesh_topology_changed(
   return abc_reader->topology_changed(existing_mesh, sample_sel);
 }
 
+bool ABC_mesh_topology_is_constant(CacheReader *reader)
+{
+  AbcObjectReader *abc_reader = reinterpret_cast<AbcObjectReader *>(reader);
+  return abc_reader->topology_is_constant();
+}
+
 /* ************************************************************************** */
 
 void CacheReader_free(CacheReader *reader)
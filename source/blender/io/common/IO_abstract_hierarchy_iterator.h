@@ -250,6 +250,14 @@ class AbstractHierarchyIterator {
    * previous iteration. */
   void set_export_subset(ExportSubset export_subset_);
 
+  /* Depsgraph which holds the evaluated state of the current (sub)frame.
+   *
+   * The depsgraph can be replaced between calls to iterate_and_write(), for example when frames
+   * are evaluated concurrently by separate depsgraphs. Writers are kept, as they are identified by
+   * their export path and not by the evaluated object. */
+  Depsgraph *get_depsgraph() const;
+  void set_depsgraph(Depsgraph *depsgraph);
+
   /* Convert the given name to something that is valid for the exported file format.
    * This base implementation is a no-op; override in a concrete subclass. */
   virtual std::string make_valid_name(const std::string &name) const;
@@ -220,6 +220,21 @@ void AbstractHierarchyIterator::set_export_subset(ExportSubset export_subset)
   export_subset_ = export_subset;
 }
 
+Depsgraph *AbstractHierarchyIterator::get_depsgraph() const
+{
+  return depsgraph_;
+}
+
+void AbstractHierarchyIterator::set_depsgraph(Depsgraph *depsgraph)
+{
+  if (depsgraph == depsgraph_) {
+    return;
+  }
+  depsgraph_ = depsgraph;
+  /* The map is keyed by evaluated IDs, which are owned by the previous depsgraph. */
+  duplisource_export_path_.clear();
+}
+
 std::string AbstractHierarchyIterator::make_valid_name(const std::string &name) const
 {
   return name;
@@ -1082,6 +1082,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime data, resolved channels of the active action of evaluated ID-blocks. */
+  struct ActionEvalPlan *action_eval_plan;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
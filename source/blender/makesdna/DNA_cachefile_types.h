@@ -94,6 +94,8 @@ typedef struct CacheFile {
   struct AbcArchiveHandle *handle;
   char handle_filepath[1024];
   struct GSet *handle_readers;
+  /** Background mesh reads of modifiers, stopped before the handle is freed. */
+  struct GSet *handle_prefetches;
 } CacheFile;
 
 #ifdef __cplusplus
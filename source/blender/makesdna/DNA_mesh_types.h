@@ -48,6 +48,7 @@ struct MPropCol;
 struct MVert;
 struct Material;
 struct Mesh;
+struct MeshElemMap;
 struct Multires;
 struct SubdivCCG;
 
@@ -106,6 +107,33 @@ typedef struct Mesh_Runtime {
   /** Non-manifold boundary data for Shrinkwrap Target Project. */
   struct ShrinkwrapBoundaryData *shrinkwrap_data;
 
+  /**
+   * Lazily calculated normals, valid while not NULL.
+   * Typical access is done via #BKE_mesh_runtime_poly_normals_ensure,
+   * #BKE_mesh_runtime_loop_normals_ensure, they are freed by #BKE_mesh_runtime_clear_normals.
+   */
+  float (*poly_normals)[3];
+  float (*loop_normals)[3];
+
+  /**
+   * Lazily built vertex adjacency maps (with the memory they point into), valid while not NULL.
+   * Typical access is done via #BKE_mesh_runtime_vert_poly_map_ensure & co,
+   * they are freed by #BKE_mesh_runtime_clear_topology_maps.
+   */
+  struct MeshElemMap *vert_to_poly_map;
+  int *vert_to_poly_map_mem;
+  struct MeshElemMap *vert_to_loop_map;
+  int *vert_to_loop_map_mem;
+  struct MeshElemMap *vert_to_edge_map;
+  int *vert_to_edge_map_mem;
+
+  /**
+   * Unique value that changes whenever the mesh data may have changed: on creation, copy and
+   * geometry evaluation. Results derived from the mesh (like the modifier stack cache) use it
+   * to find out they are out of date without comparing the data itself.
+   */
+  uint64_t geometry_stamp;
+
   /** Set by modifier stack if only deformed from original. */
   char deformed_only;
   /**
@@ -248,6 +248,7 @@
     .map_max_distance = 1.0f, \
     .map_ray_radius = 0.0f, \
     .islands_precision = 0.0f, \
+    .map_cache_tolerance = 0.0f, \
     .layers_select_src = {DT_LAYERS_ALL_SRC, DT_LAYERS_ALL_SRC, DT_LAYERS_ALL_SRC, DT_LAYERS_ALL_SRC}, \
     .layers_select_dst = {DT_LAYERS_NAME_DST, DT_LAYERS_NAME_DST, DT_LAYERS_NAME_DST, DT_LAYERS_NAME_DST}, \
     .mix_mod = CDT_MIX_TRANSFER, \
@@ -415,12 +416,15 @@
     .object_path = "", \
     .read_flag = MOD_MESHSEQ_READ_VERT | MOD_MESHSEQ_READ_POLY | MOD_MESHSEQ_READ_UV | MOD_MESHSEQ_READ_COLOR, \
     .velocity_scale = 1.0f, \
+    .prefetch_frames = 8, \
     .reader = NULL, \
     .reader_object_path = "", \
     .vertex_velocities = NULL, \
     .num_vertices = 0, \
     .velocity_delta = 0.0f, \
     .last_lookup_time = 0.0f, \
+    .prefetch_hits = 0, \
+    .prefetch_misses = 0, \
   }
 
 #define _DNA_DEFAULT_MirrorModifierData \
@@ -132,6 +132,16 @@ typedef struct ModifierData {
 
   /* Runtime field which contains runtime data which is specific to a modifier type. */
   void *runtime;
+
+  /* Runtime statistics of the last evaluation of the modifier stack, see
+   * #BKE_modifier_eval_stats_add. Time in seconds spent evaluating the modifier. */
+  double execution_time;
+  /* Memory in kilobytes owned by the mesh the modifier generated (zero for deform modifiers). */
+  int output_memory;
+  /* Incremented on every update of the settings through RNA, invalidating results of the
+   * modifier kept by the stack cache. Not all edits run such an update (curve widgets for
+   * example), so the cache also compares the settings and the curves owned by the modifier. */
+  int update_count;
 } ModifierData;
 
 typedef enum {
@@ -139,6 +149,11 @@ typedef enum {
   eModifierFlag_OverrideLibrary_Local = (1 << 0),
   /* This modifier does not own its caches, but instead shares them with another modifier. */
   eModifierFlag_SharedCaches = (1 << 1),
+  /* Don't keep the result of the modifier in the modifier stack cache. */
+  eModifierFlag_NoStackCache = (1 << 2),
+  /* Runtime: the statistics of the last evaluation are those of an earlier one, the modifier
+   * was skipped since the stack resumed from a cached result. */
+  eModifierFlag_EvalStatsCached = (1 << 3),
 } ModifierFlag;
 
 /* not a real modifier */
@@ -2016,8 +2031,8 @@ typedef struct DataTransferModifierData {
   float map_max_distance;
   float map_ray_radius;
   float islands_precision;
-
-  char _pad1[4];
+  /** Distance vertices may move before cached mappings are recomputed. */
+  float map_cache_tolerance;
 
   /** DT_MULTILAYER_INDEX_MAX; See DT_FROMLAYERS_ enum in ED_object.h. */
   int layers_select_src[4];
@@ -2038,6 +2053,7 @@ enum {
   MOD_DATATRANSFER_OBSRC_TRANSFORM = 1 << 0,
   MOD_DATATRANSFER_MAP_MAXDIST = 1 << 1,
   MOD_DATATRANSFER_INVERT_VGROUP = 1 << 2,
+  MOD_DATATRANSFER_USE_MAP_CACHE = 1 << 3,
 
   /* Only for UI really. */
   MOD_DATATRANSFER_USE_VERT = 1 << 28,
@@ -2100,9 +2116,14 @@ typedef struct MeshSeqCacheModifierData {
 
   float velocity_scale;
 
+  /** Number of frames after the current one to read in the background during playback. */
+  int prefetch_frames;
+  char _pad0[4];
+
   /* Runtime. */
   struct CacheReader *reader;
   char reader_object_path[1024];
+  /** #CacheFilePrefetch is stored in #ModifierData.runtime. */
 
   /* Vertex velocities read from the cache. The velocities are not automatically read during
    * modifier execution, and therefore have to manually be read when needed. This is only used
@@ -2120,7 +2141,11 @@ typedef struct MeshSeqCacheModifierData {
    * modifier was last executed. Used to access Alembic samples through the RNA. */
   float last_lookup_time;
 
-  int _pad1;
+  /* Frames that were and weren't read in the background, for the UI. */
+  int prefetch_hits;
+  int prefetch_misses;
+
+  char _pad1[4];
 } MeshSeqCacheModifierData;
 
 /* MeshSeqCacheModifierData.read_flag */
@@ -177,6 +177,12 @@ typedef struct Object_Runtime {
   /** Runtime evaluated curve-specific data, not stored in the file. */
   struct CurveCache *curve_cache;
 
+  /**
+   * Results of expensive modifiers from previous evaluations of the modifier stack,
+   * see #mesh_modifier_stack_cache_free.
+   */
+  struct ModifierStackCache *modifier_stack_cache;
+
   unsigned short local_collections_bits;
   short _pad2[3];
 } Object_Runtime;
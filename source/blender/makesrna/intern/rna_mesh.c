@@ -1082,6 +1082,37 @@ static void rna_MeshPoly_material_index_range(
 }
 #  endif
 
+/* Elements are written to in place through these collections, so arrays shared with other
+ * meshes (see #CD_SHARE) are copied first. */
+
+static void rna_Mesh_vertices_begin(CollectionPropertyIterator *iter, PointerRNA *ptr)
+{
+  Mesh *me = rna_mesh(ptr);
+  me->mvert = CustomData_unshare_layer(&me->vdata, CD_MVERT, me->totvert);
+  rna_iterator_array_begin(iter, me->mvert, sizeof(MVert), me->totvert, false, NULL);
+}
+
+static void rna_Mesh_edges_begin(CollectionPropertyIterator *iter, PointerRNA *ptr)
+{
+  Mesh *me = rna_mesh(ptr);
+  me->medge = CustomData_unshare_layer(&me->edata, CD_MEDGE, me->totedge);
+  rna_iterator_array_begin(iter, me->medge, sizeof(MEdge), me->totedge, false, NULL);
+}
+
+static void rna_Mesh_loops_begin(CollectionPropertyIterator *iter, PointerRNA *ptr)
+{
+  Mesh *me = rna_mesh(ptr);
+  me->mloop = CustomData_unshare_layer(&me->ldata, CD_MLOOP, me->totloop);
+  rna_iterator_array_begin(iter, me->mloop, sizeof(MLoop), me->totloop, false, NULL);
+}
+
+static void rna_Mesh_polygons_begin(CollectionPropertyIterator *iter, PointerRNA *ptr)
+{
+  Mesh *me = rna_mesh(ptr);
+  me->mpoly = CustomData_unshare_layer(&me->pdata, CD_MPOLY, me->totpoly);
+  rna_iterator_array_begin(iter, me->mpoly, sizeof(MPoly), me->totpoly, false, NULL);
+}
+
 static int rna_MeshVertex_index_get(PointerRNA *ptr)
 {
   Mesh *me = rna_mesh(ptr);
@@ -2927,6 +2958,8 @@ static void rna_def_mesh(BlenderRNA *brna)
 
   prop = RNA_def_property(srna, "vertices", PROP_COLLECTION, PROP_NONE);
   RNA_def_property_collection_sdna(prop, NULL, "mvert", "totvert");
+  RNA_def_property_collection_funcs(
+      prop, "rna_Mesh_vertices_begin", NULL, NULL, NULL, NULL, NULL, NULL, NULL);
   RNA_def_property_struct_type(prop, "MeshVertex");
   RNA_def_property_override_flag(prop, PROPOVERRIDE_IGNORE);
   RNA_def_property_ui_text(prop, "Vertices", "Vertices of the mesh");
@@ -2934,6 +2967,8 @@ static void rna_def_mesh(BlenderRNA *brna)
 
   prop = RNA_def_property(srna, "edges", PROP_COLLECTION, PROP_NONE);
   RNA_def_property_collection_sdna(prop, NULL, "medge", "totedge");
+  RNA_def_property_collection_funcs(
+      prop, "rna_Mesh_edges_begin", NULL, NULL, NULL, NULL, NULL, NULL, NULL);
   RNA_def_property_struct_type(prop, "MeshEdge");
   RNA_def_property_override_flag(prop, PROPOVERRIDE_IGNORE);
   RNA_def_property_ui_text(prop, "Edges", "Edges of the mesh");
@@ -2941,6 +2976,8 @@ static void rna_def_mesh(BlenderRNA *brna)
 
   prop = RNA_def_property(srna, "loops", PROP_COLLECTION, PROP_NONE);
   RNA_def_property_collection_sdna(prop, NULL, "mloop", "totloop");
+  RNA_def_property_collection_funcs(
+      prop, "rna_Mesh_loops_begin", NULL, NULL, NULL, NULL, NULL, NULL, NULL);
   RNA_def_property_struct_type(prop, "MeshLoop");
   RNA_def_property_override_flag(prop, PROPOVERRIDE_IGNORE);
   RNA_def_property_ui_text(prop, "Loops", "Loops of the mesh (polygon corners)");
@@ -2948,6 +2985,8 @@ static void rna_def_mesh(BlenderRNA *brna)
 
   prop = RNA_def_property(srna, "polygons", PROP_COLLECTION, PROP_NONE);
   RNA_def_property_collection_sdna(prop, NULL, "mpoly", "totpoly");
+  RNA_def_property_collection_funcs(
+      prop, "rna_Mesh_polygons_begin", NULL, NULL, NULL, NULL, NULL, NULL, NULL);
   RNA_def_property_struct_type(prop, "MeshPolygon");
   RNA_def_property_override_flag(prop, PROPOVERRIDE_IGNORE);
   RNA_def_property_ui_text(prop, "Polygons", "Polygons of the mesh");
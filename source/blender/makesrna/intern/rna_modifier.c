@@ -658,6 +658,10 @@ static char *rna_Modifier_path(PointerRNA *ptr)
 
 static void rna_Modifier_update(Main *UNUSED(bmain), Scene *UNUSED(scene), PointerRNA *ptr)
 {
+  if (RNA_struct_is_a(ptr->type, &RNA_Modifier)) {
+    /* Invalidate cached results of the modifier, see #ModifierData.update_count. */
+    ((ModifierData *)ptr->data)->update_count++;
+  }
   DEG_id_tag_update(ptr->owner_id, ID_RECALC_GEOMETRY);
   WM_main_add_notifier(NC_OBJECT | ND_MODIFIER, ptr->owner_id);
 }
@@ -665,7 +669,7 @@ static void rna_Modifier_update(Main *UNUSED(bmain), Scene *UNUSED(scene), Point
 static void rna_Modifier_dependency_update(Main *bmain, Scene *scene, PointerRNA *ptr)
 {
   rna_Modifier_update(bmain, scene, ptr);
-  DEG_relations_tag_update(bmain);
+  DEG_id_tag_relations_update(bmain, ptr->owner_id);
 }
 
 /* Vertex Groups */
@@ -6165,6 +6169,25 @@ static void rna_def_modifier_meshseqcache(BlenderRNA *brna)
       "Multiplier used to control the magnitude of the velocity vectors for time effects");
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_property(srna, "prefetch_frames", PROP_INT, PROP_NONE);
+  RNA_def_property_range(prop, 0, 250);
+  RNA_def_property_ui_text(
+      prop,
+      "Prefetch Frames",
+      "Number of frames after the current one to read in the background during playback");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  prop = RNA_def_property(srna, "prefetch_hits", PROP_INT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(
+      prop, "Prefetch Hits", "Number of evaluated frames that were read in the background");
+
+  prop = RNA_def_property(srna, "prefetch_misses", PROP_INT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Prefetch Misses",
+                           "Number of evaluated frames that had to be read when evaluated");
+
   /* -------------------------- Velocity Vectors -------------------------- */
 
   prop = RNA_def_property(srna, "vertex_velocities", PROP_COLLECTION, PROP_NONE);
@@ -6576,6 +6599,29 @@ static void rna_def_modifier_datatransfer(BlenderRNA *brna)
   RNA_def_property_subtype(prop, PROP_DISTANCE);
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_boolean(srna,
+                         "use_map_cache",
+                         false,
+                         "Cache Mapping",
+                         "Reuse the mapping between source and destination elements as long as "
+                         "their topology does not change and vertices do not move further than "
+                         "the cache tolerance");
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", MOD_DATATRANSFER_USE_MAP_CACHE);
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  prop = RNA_def_float(srna,
+                       "map_cache_tolerance",
+                       0.0f,
+                       0.0f,
+                       FLT_MAX,
+                       "Cache Tolerance",
+                       "Distance source or destination vertices may move before the cached "
+                       "mapping is computed again",
+                       0.0f,
+                       1.0f);
+  RNA_def_property_subtype(prop, PROP_DISTANCE);
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   /* How to handle multi-layers types of data. */
   prop = RNA_def_enum(srna,
                       "layers_vgroup_select_src",
@@ -7131,6 +7177,32 @@ void RNA_def_modifier(BlenderRNA *brna)
   RNA_def_property_ui_icon(prop, ICON_SURFACE_DATA, 0);
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_property(srna, "use_stack_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_negative_sdna(prop, NULL, "flag", eModifierFlag_NoStackCache);
+  RNA_def_property_override_flag(prop, PROPOVERRIDE_OVERRIDABLE_LIBRARY);
+  RNA_def_property_ui_text(prop,
+                           "Cache Result",
+                           "Keep the result of this modifier in memory, so that changes to "
+                           "modifiers further down the stack don't evaluate it again");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  prop = RNA_def_property(srna, "execution_time", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_float_sdna(prop, NULL, "execution_time");
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(
+      prop,
+      "Execution Time",
+      "Time in seconds that the modifier took to evaluate in the last evaluation of the "
+      "modifier stack");
+
+  prop = RNA_def_property(srna, "output_memory", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "output_memory");
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Output Memory",
+                           "Memory in kilobytes of the mesh generated by the modifier in the last "
+                           "evaluation of the modifier stack, zero for deform modifiers");
+
   /* types */
   rna_def_modifier_subsurf(brna);
   rna_def_modifier_lattice(brna);
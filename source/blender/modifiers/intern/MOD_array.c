@@ -27,7 +27,9 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_hash.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -110,44 +112,106 @@ static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphConte
   }
 }
 
-BLI_INLINE float sum_v3(const float v[3])
+BLI_INLINE bool co_in_bounds_v3(const float co[3], const float min[3], const float max[3])
 {
-  return v[0] + v[1] + v[2];
+  return (co[0] >= min[0]) && (co[1] >= min[1]) && (co[2] >= min[2]) && (co[0] <= max[0]) &&
+         (co[1] <= max[1]) && (co[2] <= max[2]);
 }
 
-/* Structure used for sorting vertices, when processing doubles */
-typedef struct SortVertsElem {
-  int vertex_num; /* The original index of the vertex, prior to sorting */
-  float co[3];    /* Its coordinates */
-  float sum_co;   /* sum_v3(co), just so we don't do the sum many times.  */
-} SortVertsElem;
-
-static int svert_sum_cmp(const void *e1, const void *e2)
+/* Structure used for finding doubles, target vertices are sorted into a uniform grid of cells
+ * at least twice the merge distance, so each source vertex is only compared against the
+ * 8 cells closest to it. */
+typedef struct DoublesHash {
+  const MVert *mverts;
+  const int *doubles_map;
+  float dist;
+
+  float grid_min[3];
+  float cell_size_inv;
+
+  /** Target vertices sorted by the bucket their cell hashes to, and their cells. */
+  uint buckets_mask;
+  int *bucket_offsets;
+  int *bucket_verts;
+  int (*bucket_verts_cell)[3];
+
+  /** Source vertices to map, and the target found for each. */
+  const int *source_verts;
+  int *source_targets;
+} DoublesHash;
+
+BLI_INLINE void doubles_hash_cell(const DoublesHash *dhash, const float co[3], int r_cell[3])
 {
-  const SortVertsElem *sv1 = e1;
-  const SortVertsElem *sv2 = e2;
-
-  if (sv1->sum_co > sv2->sum_co) {
-    return 1;
-  }
-  if (sv1->sum_co < sv2->sum_co) {
-    return -1;
+  for (int axis = 0; axis < 3; axis++) {
+    r_cell[axis] = (int)floorf((co[axis] - dhash->grid_min[axis]) * dhash->cell_size_inv);
   }
+}
 
-  return 0;
+BLI_INLINE uint doubles_hash_bucket(const DoublesHash *dhash, const int cell[3])
+{
+  const uint hash = BLI_hash_int_2d(BLI_hash_int_2d((uint)cell[0], (uint)cell[1]),
+                                    (uint)cell[2]);
+  return hash & dhash->buckets_mask;
 }
 
-static void svert_from_mvert(SortVertsElem *sv,
-                             const MVert *mv,
-                             const int i_begin,
-                             const int i_end)
+static void doubles_hash_map_source_cb(void *__restrict userdata,
+                                       const int index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  int i;
-  for (i = i_begin; i < i_end; i++, sv++, mv++) {
-    sv->vertex_num = i;
-    copy_v3_v3(sv->co, mv->co);
-    sv->sum_co = sum_v3(mv->co);
+  const DoublesHash *dhash = userdata;
+  const int *doubles_map = dhash->doubles_map;
+  const MVert *mverts = dhash->mverts;
+  const int v_source = dhash->source_verts[index];
+  const float *co = mverts[v_source].co;
+  int best_target_vertex = -1;
+  float best_dist_sq = dhash->dist * dhash->dist;
+  int cell_source[3], cell_side[3];
+
+  /* Cells are twice the merge distance, so only the cells on the side of the
+   * closest cell boundary along each axis can contain doubles. */
+  doubles_hash_cell(dhash, co, cell_source);
+  for (int axis = 0; axis < 3; axis++) {
+    const float cell_fac = (co[axis] - dhash->grid_min[axis]) * dhash->cell_size_inv -
+                           (float)cell_source[axis];
+    cell_side[axis] = (cell_fac < 0.5f) ? -1 : 1;
   }
+
+  for (int n = 0; n < 8; n++) {
+    int cell[3];
+    for (int axis = 0; axis < 3; axis++) {
+      cell[axis] = cell_source[axis] + ((n & (1 << axis)) ? cell_side[axis] : 0);
+    }
+    const uint bucket = doubles_hash_bucket(dhash, cell);
+    for (int i = dhash->bucket_offsets[bucket]; i < dhash->bucket_offsets[bucket + 1]; i++) {
+      /* Different cells can share a bucket, only take the vertices of this cell. */
+      if (!equals_v3v3_int(dhash->bucket_verts_cell[i], cell)) {
+        continue;
+      }
+      float dist_sq;
+      if ((dist_sq = len_squared_v3v3(co, mverts[dhash->bucket_verts[i]].co)) <= best_dist_sq) {
+        /* Potential double found */
+        best_dist_sq = dist_sq;
+        best_target_vertex = dhash->bucket_verts[i];
+
+        /* If target is already mapped, we only follow that mapping if final target remains
+         * close enough from current vert (otherwise no mapping at all).
+         * Note that if we later find another target closer than this one, then we check it.
+         * But if other potential targets are farther,
+         * then there will be no mapping at all for this source. */
+        while (best_target_vertex != -1 &&
+               !ELEM(doubles_map[best_target_vertex], -1, best_target_vertex)) {
+          if (compare_len_v3v3(co, mverts[doubles_map[best_target_vertex]].co, dhash->dist)) {
+            best_target_vertex = doubles_map[best_target_vertex];
+          }
+          else {
+            best_target_vertex = -1;
+          }
+        }
+      }
+    }
+  }
+
+  dhash->source_targets[index] = best_target_vertex;
 }
 
 /**
@@ -156,6 +220,9 @@ static void svert_from_mvert(SortVertsElem *sv,
  * It builds a mapping for all vertices within source,
  * to vertices within target, or -1 if no double found.
  * The int doubles_map[num_verts_source] array must have been allocated by caller.
+ *
+ * Only the vertices of each set within merge distance of the bounds of the other set are
+ * tested, for copies placed next to each other these are the vertices at their boundary.
  */
 static void dm_mvert_map_doubles(int *doubles_map,
                                  const MVert *mverts,
@@ -165,110 +232,119 @@ static void dm_mvert_map_doubles(int *doubles_map,
                                  const int source_num_verts,
                                  const float dist)
 {
-  const float dist3 = ((float)M_SQRT3 + 0.00005f) * dist; /* Just above sqrt(3) */
-  int i_source, i_target, i_target_low_bound, target_end, source_end;
-  SortVertsElem *sorted_verts_target, *sorted_verts_source;
-  SortVertsElem *sve_source, *sve_target, *sve_target_low_bound;
-  bool target_scan_completed;
-
-  target_end = target_start + target_num_verts;
-  source_end = source_start + source_num_verts;
-
-  /* build array of MVerts to be tested for merging */
-  sorted_verts_target = MEM_malloc_arrayN(target_num_verts, sizeof(SortVertsElem), __func__);
-  sorted_verts_source = MEM_malloc_arrayN(source_num_verts, sizeof(SortVertsElem), __func__);
-
-  /* Copy target vertices index and cos into SortVertsElem array */
-  svert_from_mvert(sorted_verts_target, mverts + target_start, target_start, target_end);
-
-  /* Copy source vertices index and cos into SortVertsElem array */
-  svert_from_mvert(sorted_verts_source, mverts + source_start, source_start, source_end);
-
-  /* sort arrays according to sum of vertex coordinates (sumco) */
-  qsort(sorted_verts_target, target_num_verts, sizeof(SortVertsElem), svert_sum_cmp);
-  qsort(sorted_verts_source, source_num_verts, sizeof(SortVertsElem), svert_sum_cmp);
-
-  sve_target_low_bound = sorted_verts_target;
-  i_target_low_bound = 0;
-  target_scan_completed = false;
-
-  /* Scan source vertices, in SortVertsElem sorted array, */
-  /* all the while maintaining the lower bound of possible doubles in target vertices */
-  for (i_source = 0, sve_source = sorted_verts_source; i_source < source_num_verts;
-       i_source++, sve_source++) {
-    int best_target_vertex = -1;
-    float best_dist_sq = dist * dist;
-    float sve_source_sumco;
-
-    /* If source has already been assigned to a target (in an earlier call, with other chunks) */
-    if (doubles_map[sve_source->vertex_num] != -1) {
-      continue;
-    }
-
-    /* If target fully scanned already, then all remaining source vertices cannot have a double */
-    if (target_scan_completed) {
-      doubles_map[sve_source->vertex_num] = -1;
-      continue;
-    }
+  const int target_end = target_start + target_num_verts;
+  const int source_end = source_start + source_num_verts;
+  float target_min[3], target_max[3], source_min[3], source_max[3];
+  int *target_verts, *source_verts;
+  int targets_len = 0, sources_len = 0;
+  int i;
 
-    sve_source_sumco = sum_v3(sve_source->co);
+  if (target_num_verts == 0 || source_num_verts == 0) {
+    return;
+  }
 
-    /* Skip all target vertices that are more than dist3 lower in terms of sumco */
-    /* and advance the overall lower bound, applicable to all remaining vertices as well. */
-    while ((i_target_low_bound < target_num_verts) &&
-           (sve_target_low_bound->sum_co < sve_source_sumco - dist3)) {
-      i_target_low_bound++;
-      sve_target_low_bound++;
-    }
-    /* If end of target list reached, then no more possible doubles */
-    if (i_target_low_bound >= target_num_verts) {
-      doubles_map[sve_source->vertex_num] = -1;
-      target_scan_completed = true;
-      continue;
+  INIT_MINMAX(target_min, target_max);
+  for (i = target_start; i < target_end; i++) {
+    minmax_v3v3_v3(target_min, target_max, mverts[i].co);
+  }
+  INIT_MINMAX(source_min, source_max);
+  for (i = source_start; i < source_end; i++) {
+    minmax_v3v3_v3(source_min, source_max, mverts[i].co);
+  }
+  add_v3_fl(target_min, -dist);
+  add_v3_fl(target_max, dist);
+  add_v3_fl(source_min, -dist);
+  add_v3_fl(source_max, dist);
+
+  /* Sources which have already been assigned to a target (in an earlier call, with other
+   * chunks) are skipped. */
+  source_verts = MEM_malloc_arrayN(source_num_verts, sizeof(int), __func__);
+  for (i = source_start; i < source_end; i++) {
+    if (doubles_map[i] == -1 && co_in_bounds_v3(mverts[i].co, target_min, target_max)) {
+      source_verts[sources_len++] = i;
     }
-    /* Test target candidates starting at the low bound of possible doubles,
-     * ordered in terms of sumco. */
-    i_target = i_target_low_bound;
-    sve_target = sve_target_low_bound;
+  }
+  if (sources_len == 0) {
+    MEM_freeN(source_verts);
+    return;
+  }
 
-    /* i_target will scan vertices in the
-     * [v_source_sumco - dist3;  v_source_sumco + dist3] range */
+  target_verts = MEM_malloc_arrayN(target_num_verts, sizeof(int), __func__);
+  for (i = target_start; i < target_end; i++) {
+    if (co_in_bounds_v3(mverts[i].co, source_min, source_max)) {
+      target_verts[targets_len++] = i;
+    }
+  }
+  if (targets_len == 0) {
+    MEM_freeN(source_verts);
+    MEM_freeN(target_verts);
+    return;
+  }
 
-    while ((i_target < target_num_verts) && (sve_target->sum_co <= sve_source_sumco + dist3)) {
-      /* Testing distance for candidate double in target */
-      /* v_target is within dist3 of v_source in terms of sumco;  check real distance */
-      float dist_sq;
-      if ((dist_sq = len_squared_v3v3(sve_source->co, sve_target->co)) <= best_dist_sq) {
-        /* Potential double found */
-        best_dist_sq = dist_sq;
-        best_target_vertex = sve_target->vertex_num;
+  /* Limit the cell count along each axis, so cell coordinates can't overflow. */
+  float size[3];
+  sub_v3_v3v3(size, target_max, target_min);
+  float cell_size = max_ff(dist * 2.0f, max_fff(size[0], size[1], size[2]) / (float)(1 << 20));
+  if (cell_size == 0.0f) {
+    cell_size = 1.0f;
+  }
 
-        /* If target is already mapped, we only follow that mapping if final target remains
-         * close enough from current vert (otherwise no mapping at all).
-         * Note that if we later find another target closer than this one, then we check it.
-         * But if other potential targets are farther,
-         * then there will be no mapping at all for this source. */
-        while (best_target_vertex != -1 &&
-               !ELEM(doubles_map[best_target_vertex], -1, best_target_vertex)) {
-          if (compare_len_v3v3(mverts[sve_source->vertex_num].co,
-                               mverts[doubles_map[best_target_vertex]].co,
-                               dist)) {
-            best_target_vertex = doubles_map[best_target_vertex];
-          }
-          else {
-            best_target_vertex = -1;
-          }
-        }
-      }
-      i_target++;
-      sve_target++;
-    }
-    /* End of candidate scan: if none found then no doubles */
-    doubles_map[sve_source->vertex_num] = best_target_vertex;
+  const uint buckets_len = power_of_2_max_u((uint)targets_len);
+  DoublesHash dhash = {
+      .mverts = mverts,
+      .doubles_map = doubles_map,
+      .dist = dist,
+      .cell_size_inv = 1.0f / cell_size,
+      .buckets_mask = buckets_len - 1,
+      .source_verts = source_verts,
+  };
+  copy_v3_v3(dhash.grid_min, target_min);
+
+  /* Counting sort of the target vertices into buckets. */
+  int(*target_cells)[3] = MEM_malloc_arrayN(targets_len, sizeof(*target_cells), __func__);
+  uint *target_buckets = MEM_malloc_arrayN(targets_len, sizeof(uint), __func__);
+  dhash.bucket_offsets = MEM_calloc_arrayN(buckets_len + 1, sizeof(int), __func__);
+  for (i = 0; i < targets_len; i++) {
+    doubles_hash_cell(&dhash, mverts[target_verts[i]].co, target_cells[i]);
+    target_buckets[i] = doubles_hash_bucket(&dhash, target_cells[i]);
+    dhash.bucket_offsets[target_buckets[i] + 1]++;
+  }
+  for (i = 0; i < (int)buckets_len; i++) {
+    dhash.bucket_offsets[i + 1] += dhash.bucket_offsets[i];
+  }
+  dhash.bucket_verts = MEM_malloc_arrayN(targets_len, sizeof(int), __func__);
+  dhash.bucket_verts_cell = MEM_malloc_arrayN(targets_len, sizeof(*target_cells), __func__);
+  for (i = 0; i < targets_len; i++) {
+    const int bucket_index = dhash.bucket_offsets[target_buckets[i]]++;
+    dhash.bucket_verts[bucket_index] = target_verts[i];
+    copy_v3_v3_int(dhash.bucket_verts_cell[bucket_index], target_cells[i]);
+  }
+  /* Filling moved each offset to the start of the next bucket, shift them back. */
+  memmove(&dhash.bucket_offsets[1], &dhash.bucket_offsets[0], sizeof(int) * buckets_len);
+  dhash.bucket_offsets[0] = 0;
+  MEM_freeN(target_buckets);
+  MEM_freeN(target_cells);
+  MEM_freeN(target_verts);
+
+  /* Sources are mapped in parallel, and only written to the doubles map afterwards, so mapping
+   * chains are followed as they were before this call. */
+  dhash.source_targets = MEM_malloc_arrayN(sources_len, sizeof(int), __func__);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (sources_len > 10000);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, sources_len, &dhash, doubles_hash_map_source_cb, &settings);
+
+  for (i = 0; i < sources_len; i++) {
+    doubles_map[source_verts[i]] = dhash.source_targets[i];
   }
 
-  MEM_freeN(sorted_verts_source);
-  MEM_freeN(sorted_verts_target);
+  MEM_freeN(dhash.source_targets);
+  MEM_freeN(dhash.bucket_verts_cell);
+  MEM_freeN(dhash.bucket_verts);
+  MEM_freeN(dhash.bucket_offsets);
+  MEM_freeN(source_verts);
 }
 
 static void mesh_merge_transform(Mesh *result,
@@ -353,16 +429,121 @@ static void mesh_merge_transform(Mesh *result,
   }
 }
 
+/* Structure used for copying the chunks in parallel, in blocks of consecutive chunks. */
+typedef struct ArrayChunksCopyData {
+  Mesh *mesh;
+  Mesh *result;
+  const float (*offset)[4];
+  /** Cumulative offset of the first chunk of each block. */
+  const float (*block_offsets)[4][4];
+  int block_len;
+  int count;
+  bool use_recalc_normals;
+  bool use_uv_offset;
+  float uv_offset[2];
+} ArrayChunksCopyData;
+
+static void array_chunk_copy(const ArrayChunksCopyData *data,
+                             const int c,
+                             const float current_offset[4][4])
+{
+  Mesh *mesh = data->mesh;
+  Mesh *result = data->result;
+  const int chunk_nverts = mesh->totvert;
+  const int chunk_nedges = mesh->totedge;
+  const int chunk_nloops = mesh->totloop;
+  const int chunk_npolys = mesh->totpoly;
+  MVert *mv;
+  MEdge *me;
+  MLoop *ml;
+  MPoly *mp;
+  int i;
+
+  /* copy customdata to new geometry */
+  CustomData_copy_data(&mesh->vdata, &result->vdata, 0, c * chunk_nverts, chunk_nverts);
+  CustomData_copy_data(&mesh->edata, &result->edata, 0, c * chunk_nedges, chunk_nedges);
+  CustomData_copy_data(&mesh->ldata, &result->ldata, 0, c * chunk_nloops, chunk_nloops);
+  CustomData_copy_data(&mesh->pdata, &result->pdata, 0, c * chunk_npolys, chunk_npolys);
+
+  /* apply offset to all new verts */
+  mv = result->mvert + c * chunk_nverts;
+  for (i = 0; i < chunk_nverts; i++, mv++) {
+    mul_m4_v3(current_offset, mv->co);
+
+    /* We have to correct normals too, if we do not tag them as dirty! */
+    if (!data->use_recalc_normals) {
+      float no[3];
+      normal_short_to_float_v3(no, mv->no);
+      mul_mat3_m4_v3(current_offset, no);
+      normalize_v3(no);
+      normal_float_to_short_v3(mv->no, no);
+    }
+  }
+
+  /* adjust edge vertex indices */
+  me = result->medge + c * chunk_nedges;
+  for (i = 0; i < chunk_nedges; i++, me++) {
+    me->v1 += c * chunk_nverts;
+    me->v2 += c * chunk_nverts;
+  }
+
+  mp = result->mpoly + c * chunk_npolys;
+  for (i = 0; i < chunk_npolys; i++, mp++) {
+    mp->loopstart += c * chunk_nloops;
+  }
+
+  /* adjust loop vertex and edge indices */
+  ml = result->mloop + c * chunk_nloops;
+  for (i = 0; i < chunk_nloops; i++, ml++) {
+    ml->v += c * chunk_nverts;
+    ml->e += c * chunk_nedges;
+  }
+
+  /* handle UVs */
+  if (data->use_uv_offset) {
+    const float uv_offset[2] = {
+        data->uv_offset[0] * (float)c,
+        data->uv_offset[1] * (float)c,
+    };
+    const int totuv = CustomData_number_of_layers(&result->ldata, CD_MLOOPUV);
+    for (i = 0; i < totuv; i++) {
+      MLoopUV *dmloopuv = CustomData_get_layer_n(&result->ldata, CD_MLOOPUV, i);
+      dmloopuv += c * chunk_nloops;
+      int l_index = chunk_nloops;
+      for (; l_index-- != 0; dmloopuv++) {
+        dmloopuv->uv[0] += uv_offset[0];
+        dmloopuv->uv[1] += uv_offset[1];
+      }
+    }
+  }
+}
+
+static void array_chunks_copy_block_cb(void *__restrict userdata,
+                                       const int block,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ArrayChunksCopyData *data = userdata;
+  const int c_start = 1 + block * data->block_len;
+  const int c_end = min_ii(c_start + data->block_len, data->count);
+  float current_offset[4][4];
+
+  /* The offset is accumulated in the same order as when copying all chunks in one loop. */
+  copy_m4_m4(current_offset, data->block_offsets[block]);
+  for (int c = c_start; c < c_end; c++) {
+    if (c != c_start) {
+      mul_m4_m4m4(current_offset, current_offset, data->offset);
+    }
+    array_chunk_copy(data, c, current_offset);
+  }
+}
+
 static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
                                    const ModifierEvalContext *ctx,
                                    Mesh *mesh)
 {
   const MVert *src_mvert;
-  MVert *mv, *mv_prev, *result_dm_verts;
+  MVert *result_dm_verts;
 
-  MEdge *me;
-  MLoop *ml;
-  MPoly *mp;
   int i, j, c, count;
   float length = amd->length;
   /* offset matrix */
@@ -567,62 +748,57 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
   first_chunk_start = 0;
   first_chunk_nverts = chunk_nverts;
 
+  /* Accumulate the offsets, keeping the first of each block of chunks copied together. */
+  const int block_len = max_ii(1, 1024 / max_ii(chunk_nverts, 1));
+  const int blocks_len = (count - 1 + block_len - 1) / block_len;
+  float(*block_offsets)[4][4] = MEM_malloc_arrayN(
+      max_ii(blocks_len, 1), sizeof(*block_offsets), __func__);
+
   unit_m4(current_offset);
   for (c = 1; c < count; c++) {
-    /* copy customdata to new geometry */
-    CustomData_copy_data(&mesh->vdata, &result->vdata, 0, c * chunk_nverts, chunk_nverts);
-    CustomData_copy_data(&mesh->edata, &result->edata, 0, c * chunk_nedges, chunk_nedges);
-    CustomData_copy_data(&mesh->ldata, &result->ldata, 0, c * chunk_nloops, chunk_nloops);
-    CustomData_copy_data(&mesh->pdata, &result->pdata, 0, c * chunk_npolys, chunk_npolys);
-
-    mv_prev = result_dm_verts;
-    mv = mv_prev + c * chunk_nverts;
-
     /* recalculate cumulative offset here */
     mul_m4_m4m4(current_offset, current_offset, offset);
-
-    /* apply offset to all new verts */
-    for (i = 0; i < chunk_nverts; i++, mv++, mv_prev++) {
-      mul_m4_v3(current_offset, mv->co);
-
-      /* We have to correct normals too, if we do not tag them as dirty! */
-      if (!use_recalc_normals) {
-        float no[3];
-        normal_short_to_float_v3(no, mv->no);
-        mul_mat3_m4_v3(current_offset, no);
-        normalize_v3(no);
-        normal_float_to_short_v3(mv->no, no);
-      }
-    }
-
-    /* adjust edge vertex indices */
-    me = result->medge + c * chunk_nedges;
-    for (i = 0; i < chunk_nedges; i++, me++) {
-      me->v1 += c * chunk_nverts;
-      me->v2 += c * chunk_nverts;
+    if ((c - 1) % block_len == 0) {
+      copy_m4_m4(block_offsets[(c - 1) / block_len], current_offset);
     }
+  }
 
-    mp = result->mpoly + c * chunk_npolys;
-    for (i = 0; i < chunk_npolys; i++, mp++) {
-      mp->loopstart += c * chunk_nloops;
-    }
+  /* Copy all chunks after the first one, each chunk is written to its own range. */
+  if (blocks_len > 0) {
+    ArrayChunksCopyData data = {
+        .mesh = mesh,
+        .result = result,
+        .offset = (const float(*)[4])offset,
+        .block_offsets = (const float(*)[4][4])block_offsets,
+        .block_len = block_len,
+        .count = count,
+        .use_recalc_normals = use_recalc_normals,
+        .use_uv_offset = (chunk_nloops > 0 && is_zero_v2(amd->uv_offset) == false),
+    };
+    copy_v2_v2(data.uv_offset, amd->uv_offset);
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (result_nverts > 10000);
+    BLI_task_parallel_range(0, blocks_len, &data, array_chunks_copy_block_cb, &settings);
+  }
+  MEM_freeN(block_offsets);
 
-    /* adjust loop vertex and edge indices */
-    ml = result->mloop + c * chunk_nloops;
-    for (i = 0; i < chunk_nloops; i++, ml++) {
-      ml->v += c * chunk_nverts;
-      ml->e += c * chunk_nedges;
-    }
+  /* Handle merge between chunk n and n-1 */
+  if (use_merge && (count > 1)) {
+    /* Vertices of the second chunk merged into the first, the only ones
+     * that can be merged for the following chunks when they are translated. */
+    int *merge_verts = NULL;
+    int merge_verts_len = 0;
 
-    /* Handle merge between chunk n and n-1 */
-    if (use_merge && (c >= 1)) {
+    for (c = 1; c < count; c++) {
       if (!offset_has_scale && (c >= 2)) {
         /* Mapping chunk 3 to chunk 2 is a translation of mapping 2 to 1
          * ... that is except if scaling makes the distance grow */
         int k;
-        int this_chunk_index = c * chunk_nverts;
-        int prev_chunk_index = (c - 1) * chunk_nverts;
-        for (k = 0; k < chunk_nverts; k++, this_chunk_index++, prev_chunk_index++) {
+        for (k = 0; k < merge_verts_len; k++) {
+          const int this_chunk_index = c * chunk_nverts + merge_verts[k];
+          const int prev_chunk_index = (c - 1) * chunk_nverts + merge_verts[k];
           int target = full_doubles_map[prev_chunk_index];
           if (target != -1) {
             target += chunk_nverts; /* translate mapping */
@@ -650,28 +826,19 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
                              c * chunk_nverts,
                              chunk_nverts,
                              amd->merge_dist);
-      }
-    }
-  }
 
-  /* handle UVs */
-  if (chunk_nloops > 0 && is_zero_v2(amd->uv_offset) == false) {
-    const int totuv = CustomData_number_of_layers(&result->ldata, CD_MLOOPUV);
-    for (i = 0; i < totuv; i++) {
-      MLoopUV *dmloopuv = CustomData_get_layer_n(&result->ldata, CD_MLOOPUV, i);
-      dmloopuv += chunk_nloops;
-      for (c = 1; c < count; c++) {
-        const float uv_offset[2] = {
-            amd->uv_offset[0] * (float)c,
-            amd->uv_offset[1] * (float)c,
-        };
-        int l_index = chunk_nloops;
-        for (; l_index-- != 0; dmloopuv++) {
-          dmloopuv->uv[0] += uv_offset[0];
-          dmloopuv->uv[1] += uv_offset[1];
+        if (!offset_has_scale && (count > 2)) {
+          merge_verts = MEM_malloc_arrayN(chunk_nverts, sizeof(int), __func__);
+          for (i = 0; i < chunk_nverts; i++) {
+            if (full_doubles_map[chunk_nverts + i] != -1) {
+              merge_verts[merge_verts_len++] = i;
+            }
+          }
         }
       }
     }
+
+    MEM_SAFE_FREE(merge_verts);
   }
 
   last_chunk_start = (count - 1) * chunk_nverts;
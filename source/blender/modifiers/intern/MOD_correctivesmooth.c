@@ -25,7 +25,10 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_bitmap.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -105,12 +108,6 @@ static void freeBind(CorrectiveSmoothModifierData *csmd)
   csmd->bind_coords_num = 0;
 }
 
-static void freeData(ModifierData *md)
-{
-  CorrectiveSmoothModifierData *csmd = (CorrectiveSmoothModifierData *)md;
-  freeBind(csmd);
-}
-
 static void requiredDataMask(Object *UNUSED(ob),
                              ModifierData *md,
                              CustomData_MeshMasks *r_cddata_masks)
@@ -144,231 +141,308 @@ static void mesh_get_weights(MDeformVert *dvert,
   }
 }
 
-static void mesh_get_boundaries(Mesh *mesh, float *smooth_weights)
-{
-  const MPoly *mpoly = mesh->mpoly;
-  const MLoop *mloop = mesh->mloop;
-  const MEdge *medge = mesh->medge;
-  uint mpoly_num, medge_num, i;
-  ushort *boundaries;
-
-  mpoly_num = (uint)mesh->totpoly;
-  medge_num = (uint)mesh->totedge;
+/* -------------------------------------------------------------------- */
+/* Vertex Adjacency
+ *
+ * Vertex neighbors in compressed (CSR) form, kept in the modifier runtime data
+ * so they're only rebuilt when the topology changes, not on every evaluation.
+ */
 
-  boundaries = MEM_calloc_arrayN(medge_num, sizeof(*boundaries), __func__);
+typedef struct CorrectiveSmoothAdjacency {
+  uint verts_num, edges_num, loops_num;
+  uint topology_hash;
+  /** Neighbors of vertex `i` are `vert_indices[vert_offsets[i]]` to `vert_offsets[i + 1]`. */
+  uint *vert_offsets;
+  uint *vert_indices;
+  /** Vertices of edges used by a single face, only initialized when pinning boundaries. */
+  BLI_bitmap *vert_boundary;
+} CorrectiveSmoothAdjacency;
+
+static uint mesh_topology_hash(const Mesh *mesh)
+{
+  BLI_HashMurmur2A mm2;
+  int i;
 
-  /* count the number of adjacent faces */
-  for (i = 0; i < mpoly_num; i++) {
-    const MPoly *p = &mpoly[i];
-    const int totloop = p->totloop;
-    int j;
-    for (j = 0; j < totloop; j++) {
-      boundaries[mloop[p->loopstart + j].e]++;
-    }
+  BLI_hash_mm2a_init(&mm2, 0);
+  for (i = 0; i < mesh->totedge; i++) {
+    BLI_hash_mm2a_add_int(&mm2, (int)mesh->medge[i].v1);
+    BLI_hash_mm2a_add_int(&mm2, (int)mesh->medge[i].v2);
   }
+  /* Edge users of the loops define the boundaries. */
+  BLI_hash_mm2a_add(
+      &mm2, (const uchar *)mesh->mloop, sizeof(*mesh->mloop) * (size_t)mesh->totloop);
 
-  for (i = 0; i < medge_num; i++) {
-    if (boundaries[i] == 1) {
-      smooth_weights[medge[i].v1] = 0.0f;
-      smooth_weights[medge[i].v2] = 0.0f;
-    }
-  }
+  return BLI_hash_mm2a_end(&mm2);
+}
 
-  MEM_freeN(boundaries);
+static void adjacency_free(CorrectiveSmoothAdjacency *adj)
+{
+  MEM_SAFE_FREE(adj->vert_offsets);
+  MEM_SAFE_FREE(adj->vert_indices);
+  MEM_SAFE_FREE(adj->vert_boundary);
+  MEM_freeN(adj);
 }
 
-/* -------------------------------------------------------------------- */
-/* Simple Weighted Smoothing
- *
- * (average of surrounding verts)
- */
-static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
-                                Mesh *mesh,
-                                float (*vertexCos)[3],
-                                uint numVerts,
-                                const float *smooth_weights,
-                                uint iterations)
+static CorrectiveSmoothAdjacency *adjacency_create(const Mesh *mesh, const uint topology_hash)
 {
-  const float lambda = csmd->lambda;
+  CorrectiveSmoothAdjacency *adj = MEM_callocN(sizeof(*adj), __func__);
+  const MEdge *medge = mesh->medge;
+  uint *vert_fill;
   uint i;
 
-  const uint numEdges = (uint)mesh->totedge;
-  const MEdge *edges = mesh->medge;
-  float *vertex_edge_count_div;
-
-  struct SmoothingData_Simple {
-    float delta[3];
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
+  adj->verts_num = (uint)mesh->totvert;
+  adj->edges_num = (uint)mesh->totedge;
+  adj->loops_num = (uint)mesh->totloop;
+  adj->topology_hash = topology_hash;
 
-  vertex_edge_count_div = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
-
-  /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  for (i = 0; i < numEdges; i++) {
-    vertex_edge_count_div[edges[i].v1] += 1.0f;
-    vertex_edge_count_div[edges[i].v2] += 1.0f;
+  /* count the neighbors of each vertex, offset by one for the accumulation below */
+  adj->vert_offsets = MEM_calloc_arrayN(adj->verts_num + 1, sizeof(uint), __func__);
+  for (i = 0; i < adj->edges_num; i++) {
+    adj->vert_offsets[medge[i].v1 + 1]++;
+    adj->vert_offsets[medge[i].v2 + 1]++;
   }
-
-  /* a little confusing, but we can include 'lambda' and smoothing weight
-   * here to avoid multiplying for every iteration */
-  if (smooth_weights == NULL) {
-    for (i = 0; i < numVerts; i++) {
-      vertex_edge_count_div[i] = lambda * (vertex_edge_count_div[i] ?
-                                               (1.0f / vertex_edge_count_div[i]) :
-                                               1.0f);
-    }
+  for (i = 0; i < adj->verts_num; i++) {
+    adj->vert_offsets[i + 1] += adj->vert_offsets[i];
   }
-  else {
-    for (i = 0; i < numVerts; i++) {
-      vertex_edge_count_div[i] = smooth_weights[i] * lambda *
-                                 (vertex_edge_count_div[i] ? (1.0f / vertex_edge_count_div[i]) :
-                                                             1.0f);
-    }
+
+  adj->vert_indices = MEM_malloc_arrayN(adj->edges_num * 2, sizeof(uint), __func__);
+  vert_fill = MEM_dupallocN(adj->vert_offsets);
+  for (i = 0; i < adj->edges_num; i++) {
+    adj->vert_indices[vert_fill[medge[i].v1]++] = medge[i].v2;
+    adj->vert_indices[vert_fill[medge[i].v2]++] = medge[i].v1;
   }
+  MEM_freeN(vert_fill);
 
-  /* -------------------------------------------------------------------- */
-  /* Main Smoothing Loop */
+  return adj;
+}
 
-  while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Simple *sd_v1;
-      struct SmoothingData_Simple *sd_v2;
-      float edge_dir[3];
+static CorrectiveSmoothAdjacency *adjacency_ensure(CorrectiveSmoothModifierData *csmd,
+                                                   const Mesh *mesh)
+{
+  CorrectiveSmoothAdjacency *adj = csmd->modifier.runtime;
+  const uint topology_hash = mesh_topology_hash(mesh);
 
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
+  if (adj && !((adj->verts_num == (uint)mesh->totvert) &&
+               (adj->edges_num == (uint)mesh->totedge) &&
+               (adj->loops_num == (uint)mesh->totloop) && (adj->topology_hash == topology_hash))) {
+    adjacency_free(adj);
+    adj = NULL;
+  }
 
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
+  if (adj == NULL) {
+    adj = adjacency_create(mesh, topology_hash);
+    csmd->modifier.runtime = adj;
+  }
 
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-    }
+  return adj;
+}
 
-    for (i = 0; i < numVerts; i++) {
-      struct SmoothingData_Simple *sd = &smooth_data[i];
-      madd_v3_v3fl(vertexCos[i], sd->delta, vertex_edge_count_div[i]);
-      /* zero for the next iteration (saves memset on entire array) */
-      memset(sd, 0, sizeof(*sd));
-    }
+static void freeRuntimeData(void *runtime_data)
+{
+  if (runtime_data != NULL) {
+    adjacency_free(runtime_data);
   }
+}
+
+static void freeData(ModifierData *md)
+{
+  CorrectiveSmoothModifierData *csmd = (CorrectiveSmoothModifierData *)md;
+  freeBind(csmd);
 
-  MEM_freeN(vertex_edge_count_div);
-  MEM_freeN(smooth_data);
+  freeRuntimeData(md->runtime);
+  md->runtime = NULL;
 }
 
-/* -------------------------------------------------------------------- */
-/* Edge-Length Weighted Smoothing
- */
-static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
-                                       Mesh *mesh,
-                                       float (*vertexCos)[3],
-                                       uint numVerts,
-                                       const float *smooth_weights,
-                                       uint iterations)
+static void mesh_get_boundaries(CorrectiveSmoothAdjacency *adj,
+                                const Mesh *mesh,
+                                float *smooth_weights)
 {
-  const float eps = FLT_EPSILON * 10.0f;
-  const uint numEdges = (uint)mesh->totedge;
-  /* note: the way this smoothing method works, its approx half as strong as the simple-smooth,
-   * and 2.0 rarely spikes, double the value for consistent behavior. */
-  const float lambda = csmd->lambda * 2.0f;
-  const MEdge *edges = mesh->medge;
-  float *vertex_edge_count;
   uint i;
 
-  struct SmoothingData_Weighted {
-    float delta[3];
-    float edge_length_sum;
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
+  if (adj->vert_boundary == NULL) {
+    const MPoly *mpoly = mesh->mpoly;
+    const MLoop *mloop = mesh->mloop;
+    const MEdge *medge = mesh->medge;
+    const uint mpoly_num = (uint)mesh->totpoly;
+    ushort *boundaries = MEM_calloc_arrayN(adj->edges_num, sizeof(*boundaries), __func__);
+
+    /* count the number of adjacent faces */
+    for (i = 0; i < mpoly_num; i++) {
+      const MPoly *p = &mpoly[i];
+      const int totloop = p->totloop;
+      int j;
+      for (j = 0; j < totloop; j++) {
+        boundaries[mloop[p->loopstart + j].e]++;
+      }
+    }
 
-  /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  vertex_edge_count = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
-  for (i = 0; i < numEdges; i++) {
-    vertex_edge_count[edges[i].v1] += 1.0f;
-    vertex_edge_count[edges[i].v2] += 1.0f;
-  }
+    adj->vert_boundary = BLI_BITMAP_NEW(adj->verts_num, __func__);
+    for (i = 0; i < adj->edges_num; i++) {
+      if (boundaries[i] == 1) {
+        BLI_BITMAP_ENABLE(adj->vert_boundary, medge[i].v1);
+        BLI_BITMAP_ENABLE(adj->vert_boundary, medge[i].v2);
+      }
+    }
 
-  /* -------------------------------------------------------------------- */
-  /* Main Smoothing Loop */
+    MEM_freeN(boundaries);
+  }
 
-  while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Weighted *sd_v1;
-      struct SmoothingData_Weighted *sd_v2;
-      float edge_dir[3];
-      float edge_dist;
+  for (i = 0; i < adj->verts_num; i++) {
+    if (BLI_BITMAP_TEST(adj->vert_boundary, i)) {
+      smooth_weights[i] = 0.0f;
+    }
+  }
+}
 
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
-      edge_dist = len_v3(edge_dir);
+/* -------------------------------------------------------------------- */
+/* Smoothing Iterations
+ *
+ * Each iteration reads the positions of the previous one and writes to a second buffer,
+ * so all vertices are independent and smoothed in parallel.
+ */
 
-      /* weight by distance */
-      mul_v3_fl(edge_dir, edge_dist);
+typedef struct SmoothIterData {
+  const CorrectiveSmoothAdjacency *adj;
+  const float (*co_src)[3];
+  float (*co_dst)[3];
+  const float *smooth_weights;
+  float lambda;
+} SmoothIterData;
 
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
+/* -------------------------------------------------------------------- */
+/* Simple Weighted Smoothing
+ *
+ * (average of surrounding verts)
+ */
+static void smooth_iter__simple_cb(void *__restrict userdata,
+                                   const int iter,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothIterData *data = userdata;
+  const CorrectiveSmoothAdjacency *adj = data->adj;
+  const uint i = (uint)iter;
+  const uint *neighbors = &adj->vert_indices[adj->vert_offsets[i]];
+  const uint neighbors_num = adj->vert_offsets[i + 1] - adj->vert_offsets[i];
+  const float *co = data->co_src[i];
+  float delta[3] = {0.0f, 0.0f, 0.0f};
+  float fac;
+  uint j;
+
+  for (j = 0; j < neighbors_num; j++) {
+    float edge_dir[3];
+    sub_v3_v3v3(edge_dir, data->co_src[neighbors[j]], co);
+    add_v3_v3(delta, edge_dir);
+  }
 
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
+  /* a little confusing, but we can include 'lambda' and smoothing weight
+   * here to avoid multiplying for every component */
+  fac = neighbors_num ? (data->lambda / (float)neighbors_num) : data->lambda;
+  if (data->smooth_weights) {
+    fac *= data->smooth_weights[i];
+  }
 
-      sd_v1->edge_length_sum += edge_dist;
-      sd_v2->edge_length_sum += edge_dist;
-    }
+  madd_v3_v3v3fl(data->co_dst[i], co, delta, fac);
+}
 
-    if (smooth_weights == NULL) {
-      /* fast-path */
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
-         * (mean average). */
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-#if 0
-          /* first calculate the new location */
-          mul_v3_fl(sd->delta, 1.0f / div);
-          /* then interpolate */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda);
-#else
-          /* do this in one step */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda / div);
-#endif
-        }
-        /* zero for the next iteration (saves memset on entire array) */
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
-    else {
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-          const float lambda_w = lambda * smooth_weights[i];
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda_w / div);
-        }
-
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
+/* -------------------------------------------------------------------- */
+/* Edge-Length Weighted Smoothing
+ */
+static void smooth_iter__length_weight_cb(void *__restrict userdata,
+                                          const int iter,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const float eps = FLT_EPSILON * 10.0f;
+  const SmoothIterData *data = userdata;
+  const CorrectiveSmoothAdjacency *adj = data->adj;
+  const uint i = (uint)iter;
+  const uint *neighbors = &adj->vert_indices[adj->vert_offsets[i]];
+  const uint neighbors_num = adj->vert_offsets[i + 1] - adj->vert_offsets[i];
+  const float *co = data->co_src[i];
+  float delta[3] = {0.0f, 0.0f, 0.0f};
+  float edge_length_sum = 0.0f;
+  float div;
+  uint j;
+
+  for (j = 0; j < neighbors_num; j++) {
+    float edge_dir[3];
+    float edge_dist;
+
+    sub_v3_v3v3(edge_dir, data->co_src[neighbors[j]], co);
+    edge_dist = len_v3(edge_dir);
+
+    /* weight by distance */
+    madd_v3_v3fl(delta, edge_dir, edge_dist);
+    edge_length_sum += edge_dist;
+  }
+
+  /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
+   * (mean average). */
+  div = edge_length_sum * (float)neighbors_num;
+  if (div > eps) {
+    const float lambda_w = data->smooth_weights ? data->lambda * data->smooth_weights[i] :
+                                                  data->lambda;
+    madd_v3_v3v3fl(data->co_dst[i], co, delta, lambda_w / div);
+  }
+  else {
+    copy_v3_v3(data->co_dst[i], co);
   }
-
-  MEM_freeN(vertex_edge_count);
-  MEM_freeN(smooth_data);
 }
 
 static void smooth_iter(CorrectiveSmoothModifierData *csmd,
-                        Mesh *mesh,
+                        const CorrectiveSmoothAdjacency *adj,
                         float (*vertexCos)[3],
                         uint numVerts,
                         const float *smooth_weights,
                         uint iterations)
 {
+  SmoothIterData data = {.adj = adj, .smooth_weights = smooth_weights};
+  TaskParallelRangeFunc func;
+  TaskParallelSettings settings;
+  float(*co_src)[3], (*co_dst)[3], (*co_tmp)[3];
+  float(*co_buffer)[3];
+
+  if (iterations == 0) {
+    return;
+  }
+
   switch (csmd->smooth_type) {
     case MOD_CORRECTIVESMOOTH_SMOOTH_LENGTH_WEIGHT:
-      smooth_iter__length_weight(csmd, mesh, vertexCos, numVerts, smooth_weights, iterations);
+      /* note: the way this smoothing method works, its approx half as strong as the
+       * simple-smooth, and 2.0 rarely spikes, double the value for consistent behavior. */
+      data.lambda = csmd->lambda * 2.0f;
+      func = smooth_iter__length_weight_cb;
       break;
 
     /* case MOD_CORRECTIVESMOOTH_SMOOTH_SIMPLE: */
     default:
-      smooth_iter__simple(csmd, mesh, vertexCos, numVerts, smooth_weights, iterations);
+      data.lambda = csmd->lambda;
+      func = smooth_iter__simple_cb;
       break;
   }
+
+  co_buffer = MEM_malloc_arrayN(numVerts, sizeof(*co_buffer), __func__);
+  co_src = vertexCos;
+  co_dst = co_buffer;
+
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numVerts > 10000);
+  settings.min_iter_per_thread = 1024;
+
+  while (iterations--) {
+    data.co_src = (const float(*)[3])co_src;
+    data.co_dst = co_dst;
+    BLI_task_parallel_range(0, (int)numVerts, &data, func, &settings);
+
+    co_tmp = co_src;
+    co_src = co_dst;
+    co_dst = co_tmp;
+  }
+
+  if (co_src != vertexCos) {
+    memcpy(vertexCos, co_src, sizeof(*vertexCos) * numVerts);
+  }
+
+  MEM_freeN(co_buffer);
 }
 
 static void smooth_verts(CorrectiveSmoothModifierData *csmd,
@@ -378,8 +452,11 @@ static void smooth_verts(CorrectiveSmoothModifierData *csmd,
                          float (*vertexCos)[3],
                          uint numVerts)
 {
+  CorrectiveSmoothAdjacency *adj = adjacency_ensure(csmd, mesh);
   float *smooth_weights = NULL;
 
+  BLI_assert(adj->verts_num == numVerts);
+
   if (dvert || (csmd->flag & MOD_CORRECTIVESMOOTH_PIN_BOUNDARY)) {
 
     smooth_weights = MEM_malloc_arrayN(numVerts, sizeof(float), __func__);
@@ -396,11 +473,11 @@ static void smooth_verts(CorrectiveSmoothModifierData *csmd,
     }
 
     if (csmd->flag & MOD_CORRECTIVESMOOTH_PIN_BOUNDARY) {
-      mesh_get_boundaries(mesh, smooth_weights);
+      mesh_get_boundaries(adj, mesh, smooth_weights);
     }
   }
 
-  smooth_iter(csmd, mesh, vertexCos, numVerts, smooth_weights, (uint)csmd->repeat);
+  smooth_iter(csmd, adj, vertexCos, numVerts, smooth_weights, (uint)csmd->repeat);
 
   if (smooth_weights) {
     MEM_freeN(smooth_weights);
@@ -863,7 +940,7 @@ ModifierTypeInfo modifierType_CorrectiveSmooth = {
     /* dependsOnNormals */ NULL,
     /* foreachIDLink */ NULL,
     /* foreachTexLink */ NULL,
-    /* freeRuntimeData */ NULL,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ blendWrite,
     /* blendRead */ blendRead,
@@ -87,6 +87,17 @@ static void initData(ModifierData *md)
   dtmd->flags = MOD_DATATRANSFER_OBSRC_TRANSFORM;
 }
 
+static void freeRuntimeData(void *runtime_data)
+{
+  BKE_object_data_transfer_remap_cache_free(runtime_data);
+}
+
+static void freeData(ModifierData *md)
+{
+  freeRuntimeData(md->runtime);
+  md->runtime = NULL;
+}
+
 static void requiredDataMask(Object *UNUSED(ob),
                              ModifierData *md,
                              CustomData_MeshMasks *r_cddata_masks)
@@ -201,6 +212,14 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
     BKE_id_copy_ex(NULL, &me_mod->id, (ID **)&result, LIB_ID_COPY_LOCALIZE);
   }
 
+  struct DataTransferRemapCache **remap_cache = NULL;
+  if (dtmd->flags & MOD_DATATRANSFER_USE_MAP_CACHE) {
+    remap_cache = (struct DataTransferRemapCache **)&md->runtime;
+  }
+  else if (md->runtime != NULL) {
+    freeData(md);
+  }
+
   BKE_reports_init(&reports, RPT_STORE);
 
   /* Note: no islands precision for now here. */
@@ -226,6 +245,8 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
                                   dtmd->mix_factor,
                                   dtmd->defgrp_name,
                                   invert_vgroup,
+                                  dtmd->map_cache_tolerance,
+                                  remap_cache,
                                   &reports)) {
     result->runtime.is_original = false;
   }
@@ -428,6 +449,12 @@ static void advanced_panel_draw(const bContext *UNUSED(C), Panel *panel)
   uiItemR(sub, ptr, "max_distance", 0, "", ICON_NONE);
 
   uiItemR(layout, ptr, "ray_radius", 0, NULL, ICON_NONE);
+
+  row = uiLayoutRowWithHeading(layout, true, IFACE_("Cache Mapping"));
+  uiItemR(row, ptr, "use_map_cache", 0, "", ICON_NONE);
+  sub = uiLayoutRow(row, true);
+  uiLayoutSetActive(sub, RNA_boolean_get(ptr, "use_map_cache"));
+  uiItemR(sub, ptr, "map_cache_tolerance", 0, "", ICON_NONE);
 }
 
 static void panelRegister(ARegionType *region_type)
@@ -489,14 +516,14 @@ ModifierTypeInfo modifierType_DataTransfer = {
 
     /* initData */ initData,
     /* requiredDataMask */ requiredDataMask,
-    /* freeData */ NULL,
+    /* freeData */ freeData,
     /* isDisabled */ isDisabled,
     /* updateDepsgraph */ updateDepsgraph,
     /* dependsOnTime */ NULL,
     /* dependsOnNormals */ dependsOnNormals,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ NULL,
-    /* freeRuntimeData */ NULL,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ NULL,
     /* blendRead */ NULL,
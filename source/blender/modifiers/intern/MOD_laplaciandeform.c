@@ -25,6 +25,7 @@
 
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "MEM_guardedalloc.h"
@@ -339,72 +340,100 @@ static void computeImplictRotations(LaplacianSystem *sys)
   }
 }
 
-static void rotateDifferentialCoordinates(LaplacianSystem *sys)
+typedef struct RotateDifferentialCoordinatesData {
+  LaplacianSystem *sys;
+  float (*rhs)[3];
+} RotateDifferentialCoordinatesData;
+
+static void rotateDifferentialCoordinates_cb(void *__restrict userdata,
+                                             const int i,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
 {
+  RotateDifferentialCoordinatesData *data = userdata;
+  LaplacianSystem *sys = data->sys;
   float alpha, beta, gamma;
   float pj[3], ni[3], di[3];
   float uij[3], dun[3], e2[3], pi[3], fni[3], vn[3][3];
-  int i, j, num_fni, k, fi;
+  int j, num_fni, k, fi;
   int *fidn;
 
-  for (i = 0; i < sys->total_verts; i++) {
-    copy_v3_v3(pi, sys->co[i]);
-    copy_v3_v3(ni, sys->no[i]);
-    k = sys->unit_verts[i];
-    copy_v3_v3(pj, sys->co[k]);
-    sub_v3_v3v3(uij, pj, pi);
-    mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
-    sub_v3_v3(uij, dun);
-    normalize_v3(uij);
-    cross_v3_v3v3(e2, ni, uij);
-    copy_v3_v3(di, sys->delta[i]);
-    alpha = dot_v3v3(ni, di);
-    beta = dot_v3v3(uij, di);
-    gamma = dot_v3v3(e2, di);
-
-    pi[0] = EIG_linear_solver_variable_get(sys->context, 0, i);
-    pi[1] = EIG_linear_solver_variable_get(sys->context, 1, i);
-    pi[2] = EIG_linear_solver_variable_get(sys->context, 2, i);
-    zero_v3(ni);
-    num_fni = sys->ringf_map[i].count;
-    for (fi = 0; fi < num_fni; fi++) {
-      const uint *vin;
-      fidn = sys->ringf_map[i].indices;
-      vin = sys->tris[fidn[fi]];
-      for (j = 0; j < 3; j++) {
-        vn[j][0] = EIG_linear_solver_variable_get(sys->context, 0, vin[j]);
-        vn[j][1] = EIG_linear_solver_variable_get(sys->context, 1, vin[j]);
-        vn[j][2] = EIG_linear_solver_variable_get(sys->context, 2, vin[j]);
-        if (vin[j] == sys->unit_verts[i]) {
-          copy_v3_v3(pj, vn[j]);
-        }
+  copy_v3_v3(pi, sys->co[i]);
+  copy_v3_v3(ni, sys->no[i]);
+  k = sys->unit_verts[i];
+  copy_v3_v3(pj, sys->co[k]);
+  sub_v3_v3v3(uij, pj, pi);
+  mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
+  sub_v3_v3(uij, dun);
+  normalize_v3(uij);
+  cross_v3_v3v3(e2, ni, uij);
+  copy_v3_v3(di, sys->delta[i]);
+  alpha = dot_v3v3(ni, di);
+  beta = dot_v3v3(uij, di);
+  gamma = dot_v3v3(e2, di);
+
+  pi[0] = EIG_linear_solver_variable_get(sys->context, 0, i);
+  pi[1] = EIG_linear_solver_variable_get(sys->context, 1, i);
+  pi[2] = EIG_linear_solver_variable_get(sys->context, 2, i);
+  zero_v3(ni);
+  num_fni = sys->ringf_map[i].count;
+  for (fi = 0; fi < num_fni; fi++) {
+    const uint *vin;
+    fidn = sys->ringf_map[i].indices;
+    vin = sys->tris[fidn[fi]];
+    for (j = 0; j < 3; j++) {
+      vn[j][0] = EIG_linear_solver_variable_get(sys->context, 0, vin[j]);
+      vn[j][1] = EIG_linear_solver_variable_get(sys->context, 1, vin[j]);
+      vn[j][2] = EIG_linear_solver_variable_get(sys->context, 2, vin[j]);
+      if (vin[j] == sys->unit_verts[i]) {
+        copy_v3_v3(pj, vn[j]);
       }
-
-      normal_tri_v3(fni, UNPACK3(vn));
-      add_v3_v3(ni, fni);
     }
 
-    normalize_v3(ni);
-    sub_v3_v3v3(uij, pj, pi);
-    mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
-    sub_v3_v3(uij, dun);
-    normalize_v3(uij);
-    cross_v3_v3v3(e2, ni, uij);
-    fni[0] = alpha * ni[0] + beta * uij[0] + gamma * e2[0];
-    fni[1] = alpha * ni[1] + beta * uij[1] + gamma * e2[1];
-    fni[2] = alpha * ni[2] + beta * uij[2] + gamma * e2[2];
-
-    if (len_squared_v3(fni) > FLT_EPSILON) {
-      EIG_linear_solver_right_hand_side_add(sys->context, 0, i, fni[0]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 1, i, fni[1]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 2, i, fni[2]);
-    }
-    else {
-      EIG_linear_solver_right_hand_side_add(sys->context, 0, i, sys->delta[i][0]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 1, i, sys->delta[i][1]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 2, i, sys->delta[i][2]);
-    }
+    normal_tri_v3(fni, UNPACK3(vn));
+    add_v3_v3(ni, fni);
   }
+
+  normalize_v3(ni);
+  sub_v3_v3v3(uij, pj, pi);
+  mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
+  sub_v3_v3(uij, dun);
+  normalize_v3(uij);
+  cross_v3_v3v3(e2, ni, uij);
+  fni[0] = alpha * ni[0] + beta * uij[0] + gamma * e2[0];
+  fni[1] = alpha * ni[1] + beta * uij[1] + gamma * e2[1];
+  fni[2] = alpha * ni[2] + beta * uij[2] + gamma * e2[2];
+
+  if (len_squared_v3(fni) > FLT_EPSILON) {
+    copy_v3_v3(data->rhs[i], fni);
+  }
+  else {
+    copy_v3_v3(data->rhs[i], sys->delta[i]);
+  }
+}
+
+static void rotateDifferentialCoordinates(LaplacianSystem *sys)
+{
+  RotateDifferentialCoordinatesData data = {
+      .sys = sys,
+      .rhs = MEM_malloc_arrayN(sys->total_verts, sizeof(float[3]), __func__),
+  };
+  TaskParallelSettings settings;
+  int i;
+
+  /* The solution of the previous solve is only read, so vertices are rotated in parallel. */
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (sys->total_verts > 10000);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, sys->total_verts, &data, rotateDifferentialCoordinates_cb, &settings);
+
+  /* Adding to the right hand side is not thread safe. */
+  for (i = 0; i < sys->total_verts; i++) {
+    EIG_linear_solver_right_hand_side_add(sys->context, 0, i, data.rhs[i][0]);
+    EIG_linear_solver_right_hand_side_add(sys->context, 1, i, data.rhs[i][1]);
+    EIG_linear_solver_right_hand_side_add(sys->context, 2, i, data.rhs[i][2]);
+  }
+
+  MEM_freeN(data.rhs);
 }
 
 static void laplacianDeformPreview(LaplacianSystem *sys, float (*vertexCos)[3])
@@ -20,6 +20,7 @@
 
 #include <string.h>
 
+#include "BLI_math_base.h"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
 
@@ -87,6 +88,8 @@ static void freeData(ModifierData *md)
 {
   MeshSeqCacheModifierData *mcmd = (MeshSeqCacheModifierData *)md;
 
+  BKE_cachefile_prefetch_free((struct CacheFilePrefetch **)&md->runtime);
+
   if (mcmd->reader) {
     mcmd->reader_object_path[0] = '\0';
     BKE_cachefile_reader_free(mcmd->cache_file, &mcmd->reader);
@@ -97,6 +100,11 @@ static void freeData(ModifierData *md)
   }
 }
 
+static void freeRuntimeData(void *runtime_data)
+{
+  BKE_cachefile_prefetch_free((struct CacheFilePrefetch **)&runtime_data);
+}
+
 static bool isDisabled(const struct Scene *UNUSED(scene),
                        ModifierData *md,
                        bool UNUSED(useRenderParams))
@@ -107,6 +115,24 @@ static bool isDisabled(const struct Scene *UNUSED(scene),
   return (mcmd->cache_file == NULL) || (mcmd->object_path[0] == '\0');
 }
 
+#ifdef WITH_ALEMBIC
+/**
+ * Frames are read ahead for whole frames, when only vertex positions change between them. Other
+ * data of the result comes from the input mesh, which is checked to be unchanged when a frame is
+ * taken. Sequences open another archive for every frame, and an overridden frame doesn't follow
+ * the scene.
+ */
+static bool mesh_seq_cache_use_prefetch(const MeshSeqCacheModifierData *mcmd,
+                                        const ModifierEvalContext *ctx,
+                                        const float frame)
+{
+  const CacheFile *cache_file = mcmd->cache_file;
+  return (mcmd->prefetch_frames > 0) && (mcmd->read_flag & MOD_MESHSEQ_READ_VERT) &&
+         !(ctx->flag & MOD_APPLY_ORCO) &&
+         !cache_file->is_sequence && !cache_file->override_frame && (frame == floorf(frame));
+}
+#endif
+
 static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mesh)
 {
 #ifdef WITH_ALEMBIC
@@ -121,6 +147,8 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
   const float frame = DEG_get_ctime(ctx->depsgraph);
   const float time = BKE_cachefile_time_offset(cache_file, frame, FPS);
   const char *err_str = NULL;
+  struct CacheFilePrefetch **prefetch = (struct CacheFilePrefetch **)&md->runtime;
+  const bool use_prefetch = mesh_seq_cache_use_prefetch(mcmd, ctx, frame);
 
   if (!mcmd->reader || !STREQ(mcmd->reader_object_path, mcmd->object_path)) {
     STRNCPY(mcmd->reader_object_path, mcmd->object_path);
@@ -139,24 +167,63 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
     return mesh;
   }
 
-  if (me != NULL) {
-    MVert *mvert = mesh->mvert;
-    MEdge *medge = mesh->medge;
-    MPoly *mpoly = mesh->mpoly;
-
-    /* TODO(sybren+bastien): possibly check relevant custom data layers (UV/color depending on
-     * flags) and duplicate those too. */
-    if ((me->mvert == mvert) || (me->medge == medge) || (me->mpoly == mpoly)) {
-      /* We need to duplicate data here, otherwise we'll modify org mesh, see T51701. */
-      BKE_id_copy_ex(NULL,
-                     &mesh->id,
-                     (ID **)&mesh,
-                     LIB_ID_CREATE_NO_MAIN | LIB_ID_CREATE_NO_USER_REFCOUNT |
-                         LIB_ID_CREATE_NO_DEG_TAG | LIB_ID_COPY_NO_PREVIEW);
+  Mesh *result = NULL;
+  bool is_prefetched = false;
+  /* Frames are only queued during playback, scrubbing would mostly read frames never used. */
+  const bool is_playback = DEG_is_playback(ctx->depsgraph);
+  const uint input_hash = use_prefetch ? BKE_cachefile_prefetch_input_hash(org_mesh) : 0;
+
+  if (use_prefetch) {
+    BKE_cachefile_prefetch_ensure(
+        cache_file, prefetch, mcmd->reader, ctx->object, mcmd->prefetch_frames, mcmd->read_flag);
+    result = BKE_cachefile_prefetch_mesh_pop(*prefetch, input_hash, (int)frame, time);
+    is_prefetched = (result != NULL);
+  }
+  else {
+    BKE_cachefile_prefetch_free(prefetch);
+  }
+
+  if (is_prefetched) {
+    mcmd->prefetch_hits++;
+  }
+  else {
+    if (use_prefetch && is_playback) {
+      mcmd->prefetch_misses++;
+    }
+
+    if (me != NULL) {
+      MVert *mvert = mesh->mvert;
+      MEdge *medge = mesh->medge;
+      MPoly *mpoly = mesh->mpoly;
+
+      /* TODO(sybren+bastien): possibly check relevant custom data layers (UV/color depending on
+       * flags) and duplicate those too. */
+      if ((me->mvert == mvert) || (me->medge == medge) || (me->mpoly == mpoly)) {
+        /* We need to duplicate data here, otherwise we'll modify org mesh, see T51701. */
+        BKE_id_copy_ex(NULL,
+                       &mesh->id,
+                       (ID **)&mesh,
+                       LIB_ID_CREATE_NO_MAIN | LIB_ID_CREATE_NO_USER_REFCOUNT |
+                           LIB_ID_CREATE_NO_DEG_TAG | LIB_ID_COPY_NO_PREVIEW);
+      }
     }
+
+    result = ABC_read_mesh(mcmd->reader, ctx->object, mesh, time, &err_str, mcmd->read_flag);
   }
 
-  Mesh *result = ABC_read_mesh(mcmd->reader, ctx->object, mesh, time, &err_str, mcmd->read_flag);
+  if (use_prefetch && is_playback) {
+    /* Following frames are read into copies of meshes read here, which are complete. */
+    const Mesh *mesh_read = (!is_prefetched && err_str == NULL) ? result : NULL;
+    BKE_cachefile_prefetch_mesh_push(*prefetch, input_hash, mesh_read, (int)frame, FPS);
+  }
+
+  if (DEG_is_active(ctx->depsgraph)) {
+    /* Flush statistics back to the original modifier for the UI. */
+    MeshSeqCacheModifierData *mcmd_orig = (MeshSeqCacheModifierData *)BKE_modifier_get_original(
+        md);
+    mcmd_orig->prefetch_hits = mcmd->prefetch_hits;
+    mcmd_orig->prefetch_misses = mcmd->prefetch_misses;
+  }
 
   mcmd->velocity_delta = 1.0f;
   if (mcmd->cache_file->velocity_unit == CACHEFILE_VELOCITY_UNIT_SECOND) {
@@ -238,6 +305,18 @@ static void panel_draw(const bContext *C, Panel *panel)
 
   uiItemR(layout, ptr, "velocity_scale", 0, NULL, ICON_NONE);
 
+  uiItemR(layout, ptr, "prefetch_frames", 0, NULL, ICON_NONE);
+  if (RNA_int_get(ptr, "prefetch_frames") > 0) {
+    char prefetch_info[64];
+    snprintf(prefetch_info,
+             sizeof(prefetch_info),
+             "%s: %d / %d",
+             IFACE_("Prefetched"),
+             RNA_int_get(ptr, "prefetch_hits"),
+             RNA_int_get(ptr, "prefetch_hits") + RNA_int_get(ptr, "prefetch_misses"));
+    uiItemL(layout, prefetch_info, ICON_NONE);
+  }
+
   modifier_panel_end(layout, ptr);
 }
 
@@ -251,6 +330,8 @@ static void blendRead(BlendDataReader *UNUSED(reader), ModifierData *md)
   MeshSeqCacheModifierData *msmcd = (MeshSeqCacheModifierData *)md;
   msmcd->reader = NULL;
   msmcd->reader_object_path[0] = '\0';
+  msmcd->prefetch_hits = 0;
+  msmcd->prefetch_misses = 0;
 }
 
 ModifierTypeInfo modifierType_MeshSequenceCache = {
@@ -282,7 +363,7 @@ ModifierTypeInfo modifierType_MeshSequenceCache = {
     /* dependsOnNormals */ NULL,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ NULL,
-    /* freeRuntimeData */ NULL,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ NULL,
     /* blendRead */ blendRead,
@@ -32,11 +32,14 @@
 
 #include "DNA_defaults.h"
 #include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
 
 #include "BKE_context.h"
+#include "BKE_customdata.h"
+#include "BKE_lib_id.h"
 #include "BKE_mesh.h"
 #include "BKE_scene.h"
 #include "BKE_screen.h"
@@ -66,6 +69,15 @@
 typedef struct SubsurfRuntimeData {
   /* Cached subdivision surface descriptor, with topology and settings. */
   struct Subdiv *subdiv;
+
+  /* Subdivided mesh of the last viewport evaluation. When the next input mesh only differs in
+   * its vertices (typically a deforming animation), its edges, loops and polygons are shared
+   * with the result, and only the vertices are evaluated again. Not used for render. */
+  struct Mesh *mesh_cache;
+  /* Copy of the input mesh #mesh_cache was created from. */
+  struct Mesh *mesh_cache_coarse;
+  SubdivSettings mesh_cache_subdiv_settings;
+  SubdivToMeshSettings mesh_cache_mesh_settings;
 } SubsurfRuntimeData;
 
 static void initData(ModifierData *md)
@@ -118,6 +130,10 @@ static void freeRuntimeData(void *runtime_data_v)
   if (runtime_data->subdiv != NULL) {
     BKE_subdiv_free(runtime_data->subdiv);
   }
+  if (runtime_data->mesh_cache != NULL) {
+    BKE_id_free(NULL, runtime_data->mesh_cache);
+    BKE_id_free(NULL, runtime_data->mesh_cache_coarse);
+  }
   MEM_freeN(runtime_data);
 }
 
@@ -196,10 +212,94 @@ static void subdiv_mesh_settings_init(SubdivToMeshSettings *settings,
                                   !(ctx->flag & MOD_APPLY_TO_BASE_MESH);
 }
 
+static bool subdiv_mesh_cache_layers_equal(const CustomData *data_a,
+                                           const CustomData *data_b,
+                                           const int totelem,
+                                           const bool compare_data)
+{
+  if (data_a->totlayer != data_b->totlayer) {
+    return false;
+  }
+  for (int i = 0; i < data_a->totlayer; i++) {
+    const CustomDataLayer *layer_a = &data_a->layers[i];
+    const CustomDataLayer *layer_b = &data_b->layers[i];
+    if (layer_a->type != layer_b->type || !STREQ(layer_a->name, layer_b->name)) {
+      return false;
+    }
+    /* Multires grids are not used by the subdivided mesh, and store pointers. */
+    if (!compare_data || ELEM(layer_a->type, CD_MDISPS, CD_GRID_PAINT_MASK)) {
+      continue;
+    }
+    if (layer_a->data == layer_b->data) {
+      continue;
+    }
+    const size_t size = (size_t)CustomData_sizeof(layer_a->type) * (size_t)totelem;
+    if (layer_a->data == NULL || layer_b->data == NULL ||
+        memcmp(layer_a->data, layer_b->data, size) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Check whether the cached subdivided mesh can be used for the input mesh, which is the case
+ * when everything but the vertices is the same as for the cached one. Vertex data is evaluated
+ * again, so only the layers have to match. */
+static bool subdiv_mesh_cache_is_valid(const SubsurfRuntimeData *runtime_data,
+                                       const SubdivSettings *subdiv_settings,
+                                       const SubdivToMeshSettings *mesh_settings,
+                                       const Mesh *mesh)
+{
+  const Mesh *mesh_cache_coarse = runtime_data->mesh_cache_coarse;
+  if (runtime_data->mesh_cache == NULL) {
+    return false;
+  }
+  if (!BKE_subdiv_settings_equal(&runtime_data->mesh_cache_subdiv_settings, subdiv_settings) ||
+      runtime_data->mesh_cache_mesh_settings.resolution != mesh_settings->resolution ||
+      runtime_data->mesh_cache_mesh_settings.use_optimal_display !=
+          mesh_settings->use_optimal_display) {
+    return false;
+  }
+  if (mesh_cache_coarse->totvert != mesh->totvert ||
+      mesh_cache_coarse->totedge != mesh->totedge ||
+      mesh_cache_coarse->totloop != mesh->totloop ||
+      mesh_cache_coarse->totpoly != mesh->totpoly) {
+    return false;
+  }
+  return subdiv_mesh_cache_layers_equal(&mesh_cache_coarse->vdata, &mesh->vdata, 0, false) &&
+         subdiv_mesh_cache_layers_equal(
+             &mesh_cache_coarse->edata, &mesh->edata, mesh->totedge, true) &&
+         subdiv_mesh_cache_layers_equal(
+             &mesh_cache_coarse->ldata, &mesh->ldata, mesh->totloop, true) &&
+         subdiv_mesh_cache_layers_equal(
+             &mesh_cache_coarse->pdata, &mesh->pdata, mesh->totpoly, true);
+}
+
+static void subdiv_mesh_cache_clear(SubsurfRuntimeData *runtime_data)
+{
+  if (runtime_data->mesh_cache != NULL) {
+    BKE_id_free(NULL, runtime_data->mesh_cache);
+    BKE_id_free(NULL, runtime_data->mesh_cache_coarse);
+    runtime_data->mesh_cache = NULL;
+    runtime_data->mesh_cache_coarse = NULL;
+  }
+}
+
+/* Copy of the cached mesh which shares its edges, loops and polygons, with newly allocated
+ * vertices. The shared layers are copied once modified by later modifiers. */
+static Mesh *subdiv_mesh_cache_copy(Mesh *mesh_cache)
+{
+  Mesh *result;
+  BKE_id_copy_ex(
+      NULL, &mesh_cache->id, (ID **)&result, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_CD_SHARE);
+  return result;
+}
+
 static Mesh *subdiv_as_mesh(SubsurfModifierData *smd,
                             const ModifierEvalContext *ctx,
                             Mesh *mesh,
-                            Subdiv *subdiv)
+                            Subdiv *subdiv,
+                            const bool use_mesh_cache)
 {
   Mesh *result = mesh;
   SubdivToMeshSettings mesh_settings;
@@ -207,8 +307,41 @@ static Mesh *subdiv_as_mesh(SubsurfModifierData *smd,
   if (mesh_settings.resolution < 3) {
     return result;
   }
-  result = BKE_subdiv_to_mesh(subdiv, &mesh_settings, mesh);
-  return result;
+  SubsurfRuntimeData *runtime_data = (SubsurfRuntimeData *)smd->modifier.runtime;
+  if (!use_mesh_cache) {
+    subdiv_mesh_cache_clear(runtime_data);
+    return BKE_subdiv_to_mesh(subdiv, &mesh_settings, mesh);
+  }
+
+  /* Topology-stable fast path: only evaluate vertices of the result. */
+  if (subdiv_mesh_cache_is_valid(runtime_data, &subdiv->settings, &mesh_settings, mesh)) {
+    result = subdiv_mesh_cache_copy(runtime_data->mesh_cache);
+    CustomData_free(&result->vdata, result->totvert);
+    CustomData_copy(&runtime_data->mesh_cache->vdata,
+                    &result->vdata,
+                    CD_MASK_EVERYTHING.vmask,
+                    CD_CALLOC,
+                    result->totvert);
+    BKE_mesh_update_customdata_pointers(result, false);
+    BKE_mesh_copy_settings(result, mesh);
+    result->cd_flag = mesh->cd_flag;
+    if (BKE_subdiv_to_mesh_update_vertices(subdiv, &mesh_settings, mesh, result)) {
+      return result;
+    }
+    BKE_id_free(NULL, result);
+  }
+
+  subdiv_mesh_cache_clear(runtime_data);
+  Mesh *mesh_cache = BKE_subdiv_to_mesh(subdiv, &mesh_settings, mesh);
+  if (mesh_cache == NULL) {
+    return NULL;
+  }
+  /* The cache is never modified, the result returned to the modifier stack is a copy. */
+  runtime_data->mesh_cache = mesh_cache;
+  runtime_data->mesh_cache_coarse = BKE_mesh_copy_for_eval(mesh, false);
+  runtime_data->mesh_cache_subdiv_settings = subdiv->settings;
+  runtime_data->mesh_cache_mesh_settings = mesh_settings;
+  return subdiv_mesh_cache_copy(mesh_cache);
 }
 
 /* Subdivide into CCG. */
@@ -281,7 +414,12 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
   /* TODO(sergey): Decide whether we ever want to use CCG for subsurf,
    * maybe when it is a last modifier in the stack? */
   if (true) {
-    result = subdiv_as_mesh(smd, ctx, mesh, subdiv);
+    /* Custom normals are calculated from the coarse vertices and interpolated to loops.
+     * Renders evaluate each frame once, keeping a full copy of the result is only worth it for
+     * interactive viewport playback. */
+    const bool use_mesh_cache = !use_clnors &&
+                                !(ctx->flag & (MOD_APPLY_TO_BASE_MESH | MOD_APPLY_RENDER));
+    result = subdiv_as_mesh(smd, ctx, mesh, subdiv, use_mesh_cache);
   }
   else {
     result = subdiv_as_ccg(smd, ctx, mesh, subdiv);
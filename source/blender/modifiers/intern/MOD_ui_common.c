@@ -288,6 +288,13 @@ static void modifier_ops_extra_draw(bContext *C, uiLayout *layout, void *md_v)
   if (!md->next) {
     uiLayoutSetEnabled(row, false);
   }
+
+  /* Stack cache, only results of modifiers generating a mesh are cached. */
+  if (ob->type == OB_MESH &&
+      BKE_modifier_get_info(md->type)->type != eModifierTypeType_OnlyDeform) {
+    uiItemS(layout);
+    uiItemR(layout, &ptr, "use_stack_cache", 0, NULL, ICON_NONE);
+  }
 }
 
 static void modifier_panel_header(const bContext *C, Panel *panel)
@@ -37,8 +37,9 @@
 
 #include "BLI_alloca.h"
 #include "BLI_bitmap.h"
-#include "BLI_kdtree.h"
+#include "BLI_hash.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -1545,6 +1546,256 @@ static void customdata_weld(
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Weld Spatial Hash
+ *
+ * Finds the vertices to merge with a uniform grid of cells at least twice the size of the
+ * merge distance, so each vertex only has to be compared against the 8 cells closest to it.
+ * The neighbor search runs in parallel, the (cheap) assignment of merge targets doesn't,
+ * since merging favors the lowest index, the same as #BLI_kdtree_3d_calc_duplicates_fast.
+ * \{ */
+
+typedef struct WeldSpatialHash {
+  const MVert *mvert;
+  const BLI_bitmap *v_mask;
+  float range_sq;
+
+  /** Grid cell of each vertex. */
+  float grid_min[3];
+  float cell_size_inv;
+  int (*cell_co)[3];
+
+  /** Vertices sorted by the bucket their cell hashes to. */
+  uint buckets_mask;
+  /** Small enough to stay in cache, to quickly skip empty buckets. */
+  BLI_bitmap *bucket_used;
+  uint *bucket_offsets;
+  uint *bucket_verts;
+
+  /** Vertices in range with a higher index, per vertex. */
+  uint *neighbor_offsets;
+  uint *neighbors;
+} WeldSpatialHash;
+
+BLI_INLINE uint weld_spatial_hash_bucket(const WeldSpatialHash *shash, const int cell_co[3])
+{
+  const uint hash = BLI_hash_int_2d(BLI_hash_int_2d((uint)cell_co[0], (uint)cell_co[1]),
+                                    (uint)cell_co[2]);
+  return hash & shash->buckets_mask;
+}
+
+BLI_INLINE bool weld_spatial_hash_vert_test(const WeldSpatialHash *shash, const uint i)
+{
+  return (shash->v_mask == NULL) || BLI_BITMAP_TEST(shash->v_mask, i);
+}
+
+/**
+ * Loop over the vertices with a higher index than \a i within range,
+ * counting them or (when \a r_neighbors is set) writing them.
+ */
+static uint weld_spatial_hash_neighbors(const WeldSpatialHash *shash,
+                                        const uint i,
+                                        uint *r_neighbors)
+{
+  const float *co = shash->mvert[i].co;
+  const int *cell_co_i = shash->cell_co[i];
+  uint neighbors_len = 0;
+
+  /* Cells are twice the merge distance, so only the cells on the side of the
+   * closest cell boundary along each axis can contain vertices in range. */
+  int cell_side[3];
+  for (int axis = 0; axis < 3; axis++) {
+    const float cell_fac = (co[axis] - shash->grid_min[axis]) * shash->cell_size_inv -
+                           (float)cell_co_i[axis];
+    cell_side[axis] = (cell_fac < 0.5f) ? -1 : 1;
+  }
+
+  for (int n = 0; n < 8; n++) {
+    int cell_co[3];
+    for (int axis = 0; axis < 3; axis++) {
+      cell_co[axis] = cell_co_i[axis] + ((n & (1 << axis)) ? cell_side[axis] : 0);
+    }
+    const uint bucket = weld_spatial_hash_bucket(shash, cell_co);
+    if (!BLI_BITMAP_TEST(shash->bucket_used, bucket)) {
+      continue;
+    }
+    const uint *v_iter = &shash->bucket_verts[shash->bucket_offsets[bucket]];
+    const uint *v_end = &shash->bucket_verts[shash->bucket_offsets[bucket + 1]];
+    for (; v_iter != v_end; v_iter++) {
+      const uint j = *v_iter;
+      /* Different cells can share a bucket, only take the vertices of this cell. */
+      if ((j <= i) || !equals_v3v3_int(shash->cell_co[j], cell_co)) {
+        continue;
+      }
+      if (len_squared_v3v3(co, shash->mvert[j].co) <= shash->range_sq) {
+        if (r_neighbors) {
+          r_neighbors[neighbors_len] = j;
+        }
+        neighbors_len++;
+      }
+    }
+  }
+  return neighbors_len;
+}
+
+static void weld_spatial_hash_cell_co_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  WeldSpatialHash *shash = userdata;
+  const float *co = shash->mvert[i].co;
+  for (int axis = 0; axis < 3; axis++) {
+    shash->cell_co[i][axis] = (int)((co[axis] - shash->grid_min[axis]) * shash->cell_size_inv);
+  }
+}
+
+static void weld_spatial_hash_count_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  WeldSpatialHash *shash = userdata;
+  shash->neighbor_offsets[i] = weld_spatial_hash_vert_test(shash, (uint)i) ?
+                                   weld_spatial_hash_neighbors(shash, (uint)i, NULL) :
+                                   0;
+}
+
+static void weld_spatial_hash_fill_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  WeldSpatialHash *shash = userdata;
+  const uint ofs = shash->neighbor_offsets[i];
+  if (shash->neighbor_offsets[i + 1] != ofs) {
+    weld_spatial_hash_neighbors(shash, (uint)i, &shash->neighbors[ofs]);
+  }
+}
+
+/**
+ * Fill \a r_vert_dest_map with the vertex each vertex is merged into,
+ * (#OUT_OF_CONTEXT for vertices which aren't merged).
+ *
+ * \return The number of vertices merged into others.
+ */
+static uint weld_vert_dest_map_calc(const MVert *mvert,
+                                    const uint mvert_len,
+                                    const BLI_bitmap *v_mask,
+                                    const float merge_dist,
+                                    uint *r_vert_dest_map)
+{
+  copy_vn_i((int *)r_vert_dest_map, (int)mvert_len, (int)OUT_OF_CONTEXT);
+
+  float min[3], max[3];
+  uint verts_len = 0;
+  INIT_MINMAX(min, max);
+  for (uint i = 0; i < mvert_len; i++) {
+    if ((v_mask == NULL) || BLI_BITMAP_TEST(v_mask, i)) {
+      minmax_v3v3_v3(min, max, mvert[i].co);
+      verts_len++;
+    }
+  }
+  if (verts_len < 2) {
+    return 0;
+  }
+
+  /* Limit the cell count along each axis, so cell coordinates can't overflow. */
+  float size[3];
+  sub_v3_v3v3(size, max, min);
+  float cell_size = max_ff(merge_dist * 2.0f,
+                           max_fff(size[0], size[1], size[2]) / (float)(1 << 20));
+  if (cell_size == 0.0f) {
+    cell_size = 1.0f;
+  }
+
+  WeldSpatialHash shash = {
+      .mvert = mvert,
+      .v_mask = v_mask,
+      .range_sq = square_f(merge_dist),
+      .cell_size_inv = 1.0f / cell_size,
+  };
+  copy_v3_v3(shash.grid_min, min);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (mvert_len > 10000);
+  settings.min_iter_per_thread = 1024;
+
+  shash.cell_co = MEM_malloc_arrayN(mvert_len, sizeof(*shash.cell_co), __func__);
+  BLI_task_parallel_range(0, (int)mvert_len, &shash, weld_spatial_hash_cell_co_cb, &settings);
+
+  /* Counting sort of the vertices into buckets. */
+  const uint buckets_len = power_of_2_max_u(verts_len);
+  shash.buckets_mask = buckets_len - 1;
+  shash.bucket_offsets = MEM_calloc_arrayN(buckets_len + 1, sizeof(uint), __func__);
+  shash.bucket_used = BLI_BITMAP_NEW(buckets_len, __func__);
+  shash.bucket_verts = MEM_malloc_arrayN(verts_len, sizeof(uint), __func__);
+
+  uint *vert_bucket = MEM_malloc_arrayN(mvert_len, sizeof(uint), __func__);
+  for (uint i = 0; i < mvert_len; i++) {
+    if (weld_spatial_hash_vert_test(&shash, i)) {
+      vert_bucket[i] = weld_spatial_hash_bucket(&shash, shash.cell_co[i]);
+      shash.bucket_offsets[vert_bucket[i] + 1]++;
+      BLI_BITMAP_ENABLE(shash.bucket_used, vert_bucket[i]);
+    }
+  }
+  for (uint i = 0; i < buckets_len; i++) {
+    shash.bucket_offsets[i + 1] += shash.bucket_offsets[i];
+  }
+  for (uint i = 0; i < mvert_len; i++) {
+    if (weld_spatial_hash_vert_test(&shash, i)) {
+      shash.bucket_verts[shash.bucket_offsets[vert_bucket[i]]++] = i;
+    }
+  }
+  /* Filling moved each offset to the start of the next bucket, shift them back. */
+  memmove(&shash.bucket_offsets[1], &shash.bucket_offsets[0], sizeof(uint) * buckets_len);
+  shash.bucket_offsets[0] = 0;
+  MEM_freeN(vert_bucket);
+
+  /* Find the neighbors of each vertex, counting them first to know where to write them. */
+  shash.neighbor_offsets = MEM_malloc_arrayN(mvert_len + 1, sizeof(uint), __func__);
+  BLI_task_parallel_range(0, (int)mvert_len, &shash, weld_spatial_hash_count_cb, &settings);
+
+  uint neighbors_len = 0;
+  for (uint i = 0; i < mvert_len; i++) {
+    const uint count = shash.neighbor_offsets[i];
+    shash.neighbor_offsets[i] = neighbors_len;
+    neighbors_len += count;
+  }
+  shash.neighbor_offsets[mvert_len] = neighbors_len;
+
+  uint vert_kill_len = 0;
+  if (neighbors_len != 0) {
+    shash.neighbors = MEM_malloc_arrayN(neighbors_len, sizeof(uint), __func__);
+    BLI_task_parallel_range(0, (int)mvert_len, &shash, weld_spatial_hash_fill_cb, &settings);
+
+    /* Vertices are merged into the first unmerged vertex in range (in index order),
+     * targets are never merged themselves so there are no chains of merges. */
+    for (uint i = 0; i < mvert_len; i++) {
+      if (!ELEM(r_vert_dest_map[i], OUT_OF_CONTEXT, i)) {
+        continue;
+      }
+      for (uint n = shash.neighbor_offsets[i]; n < shash.neighbor_offsets[i + 1]; n++) {
+        const uint j = shash.neighbors[n];
+        if (r_vert_dest_map[j] == OUT_OF_CONTEXT) {
+          r_vert_dest_map[j] = i;
+          r_vert_dest_map[i] = i;
+          vert_kill_len++;
+        }
+      }
+    }
+    MEM_freeN(shash.neighbors);
+  }
+
+  MEM_freeN(shash.neighbor_offsets);
+  MEM_freeN(shash.bucket_verts);
+  MEM_freeN(shash.bucket_offsets);
+  MEM_freeN(shash.bucket_used);
+  MEM_freeN(shash.cell_co);
+
+  return vert_kill_len;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Weld Modifier Main
  * \{ */
@@ -1567,6 +1818,33 @@ static bool bvhtree_weld_overlap_cb(void *userdata, int index_a, int index_b, in
 }
 #endif
 
+struct WeldRemapData {
+  const uint *vert_final;
+  const uint *edge_final;
+  MEdge *medge;
+  MLoop *mloop;
+};
+
+static void weld_remap_edges_cb(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct WeldRemapData *data = userdata;
+  MEdge *me = &data->medge[i];
+  me->v1 = data->vert_final[me->v1];
+  me->v2 = data->vert_final[me->v2];
+}
+
+static void weld_remap_loops_cb(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct WeldRemapData *data = userdata;
+  MLoop *ml = &data->mloop[i];
+  ml->v = data->vert_final[ml->v];
+  ml->e = data->edge_final[ml->e];
+}
+
 static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContext *ctx, Mesh *mesh)
 {
   Mesh *result = mesh;
@@ -1686,20 +1964,7 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
     }
   }
 #else
-  {
-    KDTree_3d *tree = BLI_kdtree_3d_new(totvert);
-    for (uint i = 0; i < totvert; i++) {
-      if (!(v_mask && !BLI_BITMAP_TEST(v_mask, i))) {
-        BLI_kdtree_3d_insert(tree, i, mvert[i].co);
-      }
-      vert_dest_map[i] = OUT_OF_CONTEXT;
-    }
-
-    BLI_kdtree_3d_balance(tree);
-    vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
-        tree, wmd->merge_dist, true, (int *)vert_dest_map);
-    BLI_kdtree_3d_free(tree);
-  }
+  vert_kill_len = weld_vert_dest_map_calc(mvert, totvert, v_mask, wmd->merge_dist, vert_dest_map);
 #endif
 
   if (v_mask) {
@@ -1776,12 +2041,7 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
       }
       if (count) {
         CustomData_copy_data(&mesh->edata, &result->edata, source_index, dest_index, count);
-        MEdge *me = &result->medge[dest_index];
         dest_index += count;
-        for (; count--; me++) {
-          me->v1 = vert_final[me->v1];
-          me->v2 = vert_final[me->v2];
-        }
       }
       if (i == totedge) {
         break;
@@ -1794,8 +2054,8 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
                         wegrp->group.len,
                         dest_index);
         MEdge *me = &result->medge[dest_index];
-        me->v1 = vert_final[wegrp->v1];
-        me->v2 = vert_final[wegrp->v2];
+        me->v1 = wegrp->v1;
+        me->v2 = wegrp->v2;
         me->flag |= ME_LOOSEEDGE;
 
         *index_iter = dest_index;
@@ -1805,6 +2065,20 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
 
     BLI_assert(dest_index == result_nedges);
 
+    /* Edges still use the original vertex indices, remap them all at once. */
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (result_nedges > 10000);
+    settings.min_iter_per_thread = 1024;
+
+    struct WeldRemapData remap_data = {
+        .vert_final = vert_final,
+        .edge_final = edge_final,
+        .medge = result->medge,
+        .mloop = result->mloop,
+    };
+    BLI_task_parallel_range(0, result_nedges, &remap_data, weld_remap_edges_cb, &settings);
+
     /* Polys/Loops */
 
     mp = &mpoly[0];
@@ -1820,10 +2094,7 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
         uint mp_loop_len = mp->totloop;
         CustomData_copy_data(&mesh->ldata, &result->ldata, mp->loopstart, loop_cur, mp_loop_len);
         loop_cur += mp_loop_len;
-        for (; mp_loop_len--; r_ml++) {
-          r_ml->v = vert_final[r_ml->v];
-          r_ml->e = edge_final[r_ml->e];
-        }
+        r_ml += mp_loop_len;
       }
       else {
         WeldPoly *wp = &weld_mesh.wpoly[poly_ctx];
@@ -1838,10 +2109,9 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
         }
         while (weld_iter_loop_of_poly_next(&iter)) {
           customdata_weld(&mesh->ldata, &result->ldata, group_buffer, iter.group_len, loop_cur);
-          uint v = vert_final[iter.v];
           uint e = edge_final[iter.e];
-          r_ml->v = v;
-          r_ml->e = e;
+          r_ml->v = iter.v;
+          r_ml->e = iter.e;
           r_ml++;
           loop_cur++;
           if (iter.type) {
@@ -1872,10 +2142,9 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
       }
       while (weld_iter_loop_of_poly_next(&iter)) {
         customdata_weld(&mesh->ldata, &result->ldata, group_buffer, iter.group_len, loop_cur);
-        uint v = vert_final[iter.v];
         uint e = edge_final[iter.e];
-        r_ml->v = v;
-        r_ml->e = e;
+        r_ml->v = iter.v;
+        r_ml->e = iter.e;
         r_ml++;
         loop_cur++;
         if (iter.type) {
@@ -1893,6 +2162,10 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
     BLI_assert((int)r_i == result_npolys);
     BLI_assert(loop_cur == result_nloops);
 
+    /* Like edges, loops still use the original vertex & edge indices. */
+    settings.use_threading = (result_nloops > 10000);
+    BLI_task_parallel_range(0, result_nloops, &remap_data, weld_remap_loops_cb, &settings);
+
     /* is this needed? */
     /* recalculate normals */
     result->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
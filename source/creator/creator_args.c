@@ -596,6 +596,8 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-build");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-tag");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-no-threads");
+  BLI_argsPrintArgDoc(ba, "--debug-depsgraph-no-priority");
+  BLI_argsPrintArgDoc(ba, "--debug-depsgraph-incremental-check");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-time");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-pretty");
   BLI_argsPrintArgDoc(ba, "--debug-gpu");
@@ -995,6 +997,14 @@ static const char arg_handle_debug_mode_generic_set_doc_depsgraph_eval[] =
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_no_threads[] =
     "\n\t"
     "Switch dependency graph to a single threaded evaluation.";
+static const char arg_handle_debug_mode_generic_set_doc_depsgraph_no_priority[] =
+    "\n\t"
+    "Evaluate dependency graph operations in the order they become ready, instead of\n\t"
+    "prioritizing the longest chains of dependent operations.";
+static const char arg_handle_debug_mode_generic_set_doc_depsgraph_incremental_check[] =
+    "\n\t"
+    "Compare every incremental update of dependency graph relations with a full rebuild\n\t"
+    "and print the differences.";
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_pretty[] =
     "\n\t"
     "Enable colors for dependency graph debug messages.";
@@ -2203,6 +2213,18 @@ void main_args_setup(bContext *C, bArgs *ba)
               "--debug-depsgraph-no-threads",
               CB_EX(arg_handle_debug_mode_generic_set, depsgraph_no_threads),
               (void *)G_DEBUG_DEPSGRAPH_NO_THREADS);
+  BLI_argsAdd(ba,
+              1,
+              NULL,
+              "--debug-depsgraph-no-priority",
+              CB_EX(arg_handle_debug_mode_generic_set, depsgraph_no_priority),
+              (void *)G_DEBUG_DEPSGRAPH_NO_PRIORITY);
+  BLI_argsAdd(ba,
+              1,
+              NULL,
+              "--debug-depsgraph-incremental-check",
+              CB_EX(arg_handle_debug_mode_generic_set, depsgraph_incremental_check),
+              (void *)G_DEBUG_DEPSGRAPH_INCREMENTAL_CHECK);
   BLI_argsAdd(ba,
               1,
               NULL,